@@ -0,0 +1,55 @@
+/*
+ * Host replacement of the Nuclei SDK nmsis_bench.h, used by host/Makefile.
+ * Provides the BENCH_* macros used by the tests on top of the host cycle
+ * counter, the output keeps the "CSV, <name>, <cycles>" format.
+ */
+
+#ifndef __HOST_NMSIS_BENCH_H__
+#define __HOST_NMSIS_BENCH_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE static inline
+#endif
+#ifndef __STATIC_FORCEINLINE
+#define __STATIC_FORCEINLINE __attribute__((always_inline)) static inline
+#endif
+
+__STATIC_FORCEINLINE uint64_t host_read_cycle(void)
+{
+#if defined(__riscv)
+    uint64_t cycle;
+    // user mode qemu and linux allow rdcycle
+    __asm__ volatile("rdcycle %0" : "=r"(cycle));
+    return cycle;
+#elif defined(__x86_64__) || defined(__i386__)
+    uint32_t lo, hi;
+    __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+#elif defined(__aarch64__)
+    uint64_t cycle;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(cycle));
+    return cycle;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+#define BENCH_DECLARE_VAR() static volatile uint64_t _bc_sttcyc, _bc_endcyc, _bc_usecyc, _bc_ercd;
+
+#define BENCH_INIT() _bc_ercd = 0;
+#define BENCH_RESET(proc) _bc_usecyc = 0;
+#define BENCH_START(proc) _bc_sttcyc = host_read_cycle();
+#define BENCH_SAMPLE(proc) _bc_usecyc = host_read_cycle() - _bc_sttcyc;
+#define BENCH_END(proc)                                                                                                                              \
+    _bc_endcyc = host_read_cycle();                                                                                                                  \
+    _bc_usecyc = _bc_endcyc - _bc_sttcyc;                                                                                                            \
+    printf("CSV, %s, %lu\n", #proc, (unsigned long)_bc_usecyc);
+#define BENCH_GET_USECYC() (_bc_usecyc)
+
+#endif /* __HOST_NMSIS_BENCH_H__ */
@@ -11,7 +11,9 @@ extern "C" {
 #include <stdio.h>
 #include <math.h>
 
+#if defined(__riscv_vector)
 #include <riscv_vector.h>
+#endif
 
 typedef float float32_t;
 typedef _Float16 float16_t;
@@ -60,9 +62,140 @@ struct onnx_node_t {
     void *priv; // private data
 };
 
-// struct onnx_tensor_t *onnx_tensor_alloc(enum onnx_tensor_type_t type, int *dims, int ndim);
-// void onnx_tensor_free(struct onnx_tensor_t *t);
-// void onnx_tensor_reinit(struct onnx_tensor_t *t, enum onnx_tensor_type_t type, int *dims, int ndim);
+typedef void (*onnx_operator_t)(struct onnx_node_t *node);
+typedef int (*onnx_operator_status_t)(struct onnx_node_t *node);
+
+struct onnx_graph_node_t {
+    struct onnx_node_t *node;
+    onnx_operator_t op;
+    onnx_operator_status_t op_status; // used instead of op for operators returning a status, e.g. ConvInteger
+};
+
+struct onnx_graph_tensor_t {
+    struct onnx_tensor_t *tensor;
+    size_t size;   // bytes, rounded up to ONNX_GRAPH_ALIGN
+    size_t offset; // offset inside arena
+    int first;     // index of the node producing the tensor
+    int last;      // index of the last node consuming the tensor
+};
+
+struct onnx_graph_t {
+    struct onnx_graph_node_t *nodes;
+    int nlen;
+    int nmax;
+    struct onnx_graph_tensor_t *tensors; // intermediate tensors placed into arena
+    int ntensor;
+    void *arena;
+    size_t arena_size;
+    int arena_owned;
+};
+
+#define ONNX_GRAPH_ALIGN (64)
+
+#define ONNX_TENSOR_ALIGN (64)
+
+int onnx_tensor_type_sizeof(enum onnx_tensor_type_t type);
+
+/**
+ * Tensor header, dims, strides and data (ONNX_TENSOR_ALIGN aligned) are placed in one block.
+ * After onnx_tensor_pool_init() blocks are bump allocated from the given buffer and
+ * onnx_tensor_pool_reset() releases all of them at once, onnx_tensor_free() only gives
+ * memory back when the tensor is the last one allocated. Without a pool, each block is
+ * one malloc. dims[0] is the innermost dimension, strides[0] == 1.
+ */
+void onnx_tensor_pool_init(void *buf, size_t size);
+void onnx_tensor_pool_reset(void);
+size_t onnx_tensor_pool_used(void);
+struct onnx_tensor_t *onnx_tensor_alloc(enum onnx_tensor_type_t type, int *dims, int ndim);
+void onnx_tensor_free(struct onnx_tensor_t *t);
+/* reuse the block of t for a new type and shape, return -1 when the block is too small */
+int onnx_tensor_reinit(struct onnx_tensor_t *t, enum onnx_tensor_type_t type, int *dims, int ndim);
+
+/**
+ * Graph executor: runs an ordered list of nodes. Every tensor referenced by the
+ * nodes whose datas is NULL when the graph is planned is treated as an
+ * intermediate tensor and placed into one arena, tensors with disjoint
+ * lifetimes share the same memory. Tensors with datas set by the caller
+ * (graph inputs, weights, outputs the caller wants to own) are left untouched.
+ */
+struct onnx_graph_t *onnx_graph_alloc(int max_nodes);
+void onnx_graph_free(struct onnx_graph_t *g);
+int onnx_graph_add_node(struct onnx_graph_t *g, struct onnx_node_t *node, onnx_operator_t op);
+int onnx_graph_add_node_status(struct onnx_graph_t *g, struct onnx_node_t *node, onnx_operator_status_t op);
+/* compute lifetimes and offsets, return arena size in bytes needed by the graph */
+size_t onnx_graph_plan(struct onnx_graph_t *g);
+/* bind intermediate tensors to arena, allocate arena when it is NULL, return 0 on success */
+int onnx_graph_prepare(struct onnx_graph_t *g, void *arena, size_t size);
+/* run all nodes in order, return the first non-zero status or 0 */
+int onnx_graph_run(struct onnx_graph_t *g);
+
+#define ONNX_PARALLEL_MAX_THREADS (16)
+
+typedef void (*onnx_parallel_fn_t)(void *arg, int start, int end);
+
+/**
+ * Parallel execution of the heavy kernels on several harts. With pthreads
+ * (Linux, qemu user mode) onnx_parallel_init() starts n - 1 worker threads.
+ * On bare metal the secondary harts must call onnx_parallel_worker() before
+ * onnx_parallel_init(), it never returns. Without init every loop runs on the
+ * calling hart. Return the number of threads including the caller.
+ */
+int onnx_parallel_init(int n);
+void onnx_parallel_deinit(void);
+void onnx_parallel_worker(int hart);
+int onnx_parallel_nthreads(void);
+/* call fn on sub ranges of [0, n), each start is a multiple of grain */
+void onnx_parallel_for(int n, int grain, onnx_parallel_fn_t fn, void *arg);
+
+/**
+ * Per node profiling, only built with ONNX_PROFILE, otherwise the hooks expand
+ * to nothing. onnx_graph_run() records cycle, instret and ONNX_PROFILE_NHPM
+ * hpm counters (mhpmcounter3 onwards, events set up by the application) of
+ * every node, kernels called directly can be wrapped with the same hooks:
+ *
+ *     ONNX_PROFILE_BEGIN(prof);
+ *     Softmax_float32_rvv(node);
+ *     ONNX_PROFILE_END(prof, "Softmax", NULL, 0);
+ */
+#if defined(ONNX_PROFILE)
+
+#ifndef ONNX_PROFILE_MAX_EVENTS
+#define ONNX_PROFILE_MAX_EVENTS (256)
+#endif
+#ifndef ONNX_PROFILE_NHPM
+#define ONNX_PROFILE_NHPM (0) // at most 4
+#endif
+#ifndef ONNX_PROFILE_CYCLES_PER_US
+#define ONNX_PROFILE_CYCLES_PER_US (1) // core clock in MHz, timestamps of the trace are in cycles by default
+#endif
+
+struct onnx_profile_counter_t {
+    uint64_t cycle;
+    uint64_t instret;
+    uint64_t hpm[ONNX_PROFILE_NHPM > 0 ? ONNX_PROFILE_NHPM : 1];
+};
+
+void onnx_profile_read(struct onnx_profile_counter_t *c);
+/* op may be NULL, the name is then looked up from kernel with onnx_dispatch_name() */
+void onnx_profile_record(const char *op, const void *kernel, int node, const struct onnx_profile_counter_t *start);
+void onnx_profile_reset(void);
+int onnx_profile_count(void);
+/* print cycles, instret and hpm counters aggregated per operator */
+void onnx_profile_summary(void);
+/* print all events as Chrome trace event JSON, open it with chrome://tracing or Perfetto */
+void onnx_profile_trace(void);
+
+#define ONNX_PROFILE_BEGIN(c)                                                                                                                        \
+    struct onnx_profile_counter_t c;                                                                                                                 \
+    onnx_profile_read(&c)
+#define ONNX_PROFILE_END(c, op, kernel, node) onnx_profile_record(op, (const void *)(kernel), node, &c)
+
+#else
+
+#define ONNX_PROFILE_BEGIN(c)
+#define ONNX_PROFILE_END(c, op, kernel, node)
+
+#endif /* defined(ONNX_PROFILE) */
 
 #ifdef __cplusplus
 }
@@ -38,6 +38,19 @@ void *GeneratePowParam(OnnxScalar exponent);
 void FreePowParam(void **pdat);
 void *GenerateFlipParam(int flip_axis0, int flip_axis1);
 void FreeFlipParam(void **pdat);
+/**
+ * @brief MaxPool and AveragePool over kernel_w x kernel_h windows of NHWC
+ * tensors. The padding is left out of MaxPool and of the divisor of
+ * AveragePool, unless count_include_pad. int8 AveragePool keeps the
+ * quantization of the input and rounds half away from zero.
+ *
+ * @param[in] count_include_pad - AveragePool divides by the whole window
+ * @param[in] zero_point - int8 AveragePool, value of the padding in the sum with count_include_pad
+ * @return void* Pool private parameters
+ */
+void *GeneratePoolParam(int kernel_w, int kernel_h, int stride_w, int stride_h, int pad_w, int pad_h, _Bool count_include_pad,
+                        int32_t zero_point);
+void FreePoolParam(void **pdat);
 /**
  * @brief only support 2-D tensor. start[i] == end[i] == 0 is not allowed.
  *
@@ -73,10 +86,243 @@ void FreeSliceParam(void **pdat);
 void *GenerateConvIntegerParam(int32_t in_offset, int32_t out_offset, int32_t stride_w, int32_t stride_h, int32_t dilation_w, int32_t dilation_h,
                                int32_t pad_w, int32_t pad_h, int32_t activation_min, int32_t activation_max, const struct onnx_tensor_t *input,
                                const struct onnx_tensor_t *filter, const struct onnx_tensor_t *output, _Bool rvv);
+/* algorithm of the rvv kernel for 3x3 filters with stride 1, dilation 1 and one group */
+enum conv_integer_algo_t {
+    CONV_INTEGER_ALGO_AUTO = 0,   // the Winograd variant with fewer multiplies for the output size
+    CONV_INTEGER_ALGO_IM2COL,     // im2col GEMM, also used by all other layers
+    CONV_INTEGER_ALGO_WINOGRAD23, // Winograd F(2x2,3x3), im2col with VLEN < 128
+    CONV_INTEGER_ALGO_WINOGRAD43, // Winograd F(4x4,3x3), layers over 114 to 227 input channels are summed in chunks
+};
+/**
+ * @brief GenerateConvIntegerParam with the algorithm of the rvv kernel, the
+ * workspace is sized for it. It is ignored without rvv or when the layer is
+ * not a 3x3 stride 1 convolution.
+ *
+ * @param[in] algo - algorithm of the rvv kernel
+ * @return void* ConvInteger private parameters
+ */
+void *GenerateConvIntegerParamAlgo(int32_t in_offset, int32_t out_offset, int32_t stride_w, int32_t stride_h, int32_t dilation_w,
+                                   int32_t dilation_h, int32_t pad_w, int32_t pad_h, int32_t activation_min, int32_t activation_max,
+                                   const struct onnx_tensor_t *input, const struct onnx_tensor_t *filter, const struct onnx_tensor_t *output,
+                                   _Bool rvv, enum conv_integer_algo_t algo);
+/**
+ * @brief Transform the filter for the Winograd rvv kernel and keep it in the
+ * parameters, so ConvInteger_rvv only transforms input and output per call.
+ * GenerateConvIntegerParam already does it when filter->datas is set, call it
+ * again after the filter data changed.
+ *
+ * @param[in] pdat - ConvInteger private parameters
+ * @param[in] filter - input filter
+ * @return int 0 on success
+ */
+int PrepareConvIntegerWeights(void *pdat, const struct onnx_tensor_t *filter);
 void FreeConvIntegerParam(void **pdat);
 
+/* activation of the fused epilogue */
+enum onnx_activation_t {
+    ONNX_ACTIVATION_NONE = 0,
+    ONNX_ACTIVATION_RELU,
+    ONNX_ACTIVATION_RELU6,
+    ONNX_ACTIVATION_CLAMP, // [min, max]
+    ONNX_ACTIVATION_SILU,
+};
+/**
+ * Epilogue fused into the store of ConvInteger and MatMul, so the Add of a
+ * residual and the activation following the layer need no extra pass:
+ * y = activation(x + residual). Bounds are real values, an int8 tensor holds
+ * real = scale * (q - zero_point) with the output zero point out_offset.
+ */
+struct onnx_epilogue_t {
+    enum onnx_activation_t activation;
+    float32_t min; // bounds of ONNX_ACTIVATION_CLAMP
+    float32_t max;
+    const struct onnx_tensor_t *residual; // same shape and type as the output, NULL without residual
+    float32_t residual_scale;             // scale of the residual, float residuals are multiplied with it
+    int32_t residual_zero_point;          // int8 only
+    float32_t scale;                      // int8 only, scale of the output
+};
+/**
+ * @brief Fuse the epilogue into ConvInteger and ConvInteger_rvv. The residual
+ * is requantized to the output scale and added to the requantized output,
+ * relu, relu6 and clamp narrow activation_min/max and silu is looked up from a
+ * table of the 256 output values. Each call replaces the previous epilogue,
+ * the bounds are narrowed from activation_min/max of GenerateConvIntegerParam.
+ *
+ * @param[in] pdat - ConvInteger private parameters
+ * @param[in] epilogue - copied, residual->datas is read by every call
+ * @return int 0 on success, -1 for a scale <= 0, a residual that is not int8 or
+ *         more than 64 times the output scale
+ */
+int SetConvIntegerEpilogue(void *pdat, const struct onnx_epilogue_t *epilogue);
+
+/**
+ * @brief GenerateConvIntegerParam for ConvIntegerStream, which takes one image
+ * in bands of rows, e.g. from a camera, and computes every output row as soon
+ * as the input rows of its window arrived. Only the last
+ * dilation_h * (kernel_h - 1) + 1 input rows are kept, so neither the latency
+ * of the first output row nor the memory grows with the image height.
+ *
+ * @param[in] input - shape of the whole image, batch 1, datas is not read
+ * @param[in] output - shape of the whole output, datas is not read
+ * @return void* ConvIntegerStream private parameters
+ */
+void *GenerateConvIntegerStreamParam(int32_t in_offset, int32_t out_offset, int32_t stride_w, int32_t stride_h, int32_t dilation_w,
+                                     int32_t dilation_h, int32_t pad_w, int32_t pad_h, int32_t activation_min, int32_t activation_max,
+                                     const struct onnx_tensor_t *input, const struct onnx_tensor_t *filter, const struct onnx_tensor_t *output,
+                                     _Bool rvv);
+/**
+ * @brief Push the next rows of the image and write the output rows they
+ * complete. n->inputs[0] holds the rows [band_h, input_w, input_ch], inputs 1
+ * to 4 are filter, bias, multiply and shift of ConvInteger. The output rows are
+ * written from the start of n->outputs[0], which has room for at least
+ * band_h / stride_h + 1 + pad_h rows. The bottom padding is added after the
+ * last row of the image and the next call starts a new image.
+ *
+ * @param[out] written - number of output rows written, 0 on error
+ * @return int 0 on success, -1 when the rows run past the image or do not fit
+ *         n->outputs[0]
+ */
+int ConvIntegerStream(struct onnx_node_t *n, int32_t *written);
+void FreeConvIntegerStreamParam(void **pdat);
+
+/**
+ * @brief Conv of float32 or float16 tensors, groups are input_ch / kernel_ch.
+ * The bias is the optional third input of the node.
+ *
+ * @param[in] stride_w - kernel stride w
+ * @param[in] stride_h - kernel stride h
+ * @param[in] dilation_w - kernel dilation w
+ * @param[in] dilation_h - kernel dilation h
+ * @param[in] pad_w - kernel padding w
+ * @param[in] pad_h - kernel padding h
+ * @param[in] input - input tensor
+ * @param[in] filter - input filter
+ * @param[in] output - output tensor
+ * @param[in] rvv - whether use rvv, the rvv kernel packs or Winograd transforms the filter into its buffer
+ * @return void* Conv private parameters
+ */
+void *GenerateConvParam(int32_t stride_w, int32_t stride_h, int32_t dilation_w, int32_t dilation_h, int32_t pad_w, int32_t pad_h,
+                        const struct onnx_tensor_t *input, const struct onnx_tensor_t *filter, const struct onnx_tensor_t *output, _Bool rvv);
+/* pack the filter for the rvv kernel, GenerateConvParam already does it when filter->datas is set */
+int PrepareConvWeights(void *pdat, const struct onnx_tensor_t *filter);
+void FreeConvParam(void **pdat);
+
+/**
+ * @brief ConvTranspose of int8 tensors, requantized like ConvInteger. The
+ * filter is [input_ch, kernel_h, kernel_w, output_ch / groups], groups are
+ * output_ch / filter->dims[0]. The output size must be
+ * (input - 1) * stride - 2 * pad + dilation * (kernel - 1) + output_padding + 1.
+ *
+ * @param[in] in_offset - The negative of the zero value for the input tensor
+ * @param[in] out_offset - The negative of the zero value for the output tensor
+ * @param[in] output_padding_w - columns added to the right of the output
+ * @param[in] output_padding_h - rows added to the bottom of the output
+ * @param[in] rvv - whether use rvv, the rvv kernel packs the filter per stride phase into its buffer
+ * @return void* ConvTranspose private parameters
+ */
+void *GenerateConvTransposeIntegerParam(int32_t in_offset, int32_t out_offset, int32_t stride_w, int32_t stride_h, int32_t dilation_w,
+                                        int32_t dilation_h, int32_t pad_w, int32_t pad_h, int32_t output_padding_w, int32_t output_padding_h,
+                                        int32_t activation_min, int32_t activation_max, const struct onnx_tensor_t *input,
+                                        const struct onnx_tensor_t *filter, const struct onnx_tensor_t *output, _Bool rvv);
+/* GenerateConvTransposeIntegerParam for float16 tensors, the bias is the optional third input of the node */
+void *GenerateConvTransposeParam(int32_t stride_w, int32_t stride_h, int32_t dilation_w, int32_t dilation_h, int32_t pad_w, int32_t pad_h,
+                                 int32_t output_padding_w, int32_t output_padding_h, const struct onnx_tensor_t *input,
+                                 const struct onnx_tensor_t *filter, const struct onnx_tensor_t *output, _Bool rvv);
+/* pack the filter for the rvv kernels, the Generate functions already do it when filter->datas is set */
+int PrepareConvTransposeWeights(void *pdat, const struct onnx_tensor_t *filter);
+/* frees the parameters of both Generate functions */
+void FreeConvTransposeParam(void **pdat);
+
+/**
+ * @brief Parameters of the float MatMul, node->priv is NULL or these. With rvv
+ * B is reordered once into the panels of the blocked GEMM, so MatMul_*_rvv
+ * does no layout work on a constant B. A B of another shape or type than the
+ * parameters is packed per call.
+ *
+ * @param[in] b - input B [batch..., k, n], every matrix packed when datas is set
+ * @param[in] rvv - whether use rvv, the rvv kernels pack B into the parameters
+ * @return void* MatMul private parameters
+ */
+void *GenerateMatMulParam(const struct onnx_tensor_t *b, _Bool rvv);
+
+/* precision of the sums of the float16 MatMul, float32 and float MatMul sum in float32 anyway */
+enum matmul_accumulate_t {
+    MATMUL_ACCUMULATE_NATIVE = 0, // float16 sums, the fastest
+    MATMUL_ACCUMULATE_FLOAT32,    // float32 sums of the widened products, rounded to float16 once at the store
+};
+/**
+ * @brief GenerateMatMulParam with the precision of the sums of a float16 B.
+ * Long float16 dot products lose about log2(k) bits, float32 sums keep the
+ * result within an ulp or so of float16 at the cost of widening FMAs on half
+ * as many lanes per register.
+ *
+ * @param[in] b - input B [batch..., k, n], every matrix packed when datas is set
+ * @param[in] rvv - whether use rvv, the rvv kernels pack B into the parameters
+ * @param[in] accumulate - MATMUL_ACCUMULATE_*, ignored unless b is float16
+ * @return void* MatMul private parameters
+ */
+void *GenerateMatMulParamAccumulate(const struct onnx_tensor_t *b, _Bool rvv, enum matmul_accumulate_t accumulate);
+/* pack B for the rvv kernels, GenerateMatMulParam already does it when b->datas is set, -1 for another shape */
+int PrepareMatMulWeights(void *pdat, const struct onnx_tensor_t *b);
+/* epilogue applied before the store of the float MatMul, copied, NULL removes it, -1 for a residual of another type than B */
+int SetMatMulEpilogue(void *pdat, const struct onnx_epilogue_t *epilogue);
+void FreeMatMulParam(void **pdat);
+
+/**
+ * @brief MatMulInteger of int8 a [m, k] and b [k, n] with zero points, inputs 2
+ * to 4 are bias [n], multiply and shift, NULL bias for none. An int32 output is
+ * the sum, an int8 output is requantized with one multiply and shift per
+ * tensor or per column of b like ConvInteger, i.e. QLinearMatMul.
+ *
+ * @param[in] a_offset - The negative of the zero value for a
+ * @param[in] b_offset - The negative of the zero value for b
+ * @param[in] out_offset - The negative of the zero value for the int8 output
+ * @param[in] activation_min - min value of the int8 output
+ * @param[in] activation_max - max value of the int8 output
+ * @param[in] b - input b [k, n], packed when datas is set
+ * @param[in] rvv - whether use rvv, the rvv kernel packs b and its column sums into its buffer
+ * @return void* MatMulInteger private parameters
+ */
+void *GenerateMatMulIntegerParam(int32_t a_offset, int32_t b_offset, int32_t out_offset, int32_t activation_min, int32_t activation_max,
+                                 const struct onnx_tensor_t *b, _Bool rvv);
+/* pack b for the rvv kernel, GenerateMatMulIntegerParam already does it when b->datas is set, -1 for another shape */
+int PrepareMatMulIntegerWeights(void *pdat, const struct onnx_tensor_t *b);
+void FreeMatMulIntegerParam(void **pdat);
+
 /* ---------------- end of helper function ----------------- */
 
+/* ---------------- start of kernel dispatch ----------------- */
+
+#define ONNX_ISA_V (1 << 0)       // vector extension, v or zve32f
+#define ONNX_ISA_ZVFH (1 << 1)    // vector half precision
+#define ONNX_ISA_ELEN64 (1 << 2)  // 64-bit vector elements
+#define ONNX_ISA_SEGMENT (1 << 3) // segment load/store
+#define ONNX_ISA_PERMUTE (1 << 4) // vslide/vgather/vcompress
+/* features a VPU Lite doesn't support, pass it to onnx_dispatch_init */
+#define ONNX_ISA_VPU_LITE (ONNX_ISA_ELEN64 | ONNX_ISA_SEGMENT | ONNX_ISA_PERMUTE)
+
+/**
+ * @brief resolve the kernel of each operator from the vector features of the
+ *        running core: V is probed at run time (hwcap on Linux, misa on bare
+ *        metal) and VLEN read from vlenb, zvfh, ELEN and the others are those
+ *        the binary is built with. Called once at startup, onnx_dispatch_find
+ *        calls it with disable = 0 when it is not called yet.
+ *
+ * @param[in] disable - ONNX_ISA_* features the core doesn't have, e.g. ONNX_ISA_VPU_LITE
+ */
+void onnx_dispatch_init(uint32_t disable);
+uint32_t onnx_dispatch_isa(void);
+int onnx_dispatch_vlen(void);
+/* op is the operator name without type suffix, e.g. "Softmax", NULL when not found */
+onnx_operator_t onnx_dispatch_find(const char *op, enum onnx_tensor_type_t type);
+onnx_operator_status_t onnx_dispatch_find_status(const char *op, enum onnx_tensor_type_t type);
+/* whether the rvv kernel is selected, e.g. for the rvv argument of GenerateConvIntegerParam */
+_Bool onnx_dispatch_rvv(const char *op, enum onnx_tensor_type_t type);
+/* operator name of a kernel in the table, scalar or rvv, NULL when not found */
+const char *onnx_dispatch_name(const void *kernel);
+
+/* ---------------- end of kernel dispatch ----------------- */
+
 /* ---------------- start of operators ----------------- */
 
 void BatchNormalization_float16(struct onnx_node_t *node);
@@ -106,6 +352,11 @@ void Topk_float16_rvv(struct onnx_node_t *n);
 void Topk_float32(struct onnx_node_t *n);
 void Topk_float32_rvv(struct onnx_node_t *n);
 
+/*
+ * a [batch..., m, k] x b [batch..., k, n] with the batch dims broadcast like
+ * numpy.matmul, a missing dim or a dim of 1 repeats its matrices. node->priv is
+ * NULL or the parameters of GenerateMatMulParam, the int8 MatMul takes no parameters
+ */
 void MatMul_int8(struct onnx_node_t *node);
 void MatMul_int8_rvv(struct onnx_node_t *node);
 void MatMul_float16(struct onnx_node_t *node);
@@ -113,6 +364,10 @@ void MatMul_float16_rvv(struct onnx_node_t *node);
 void MatMul_float32(struct onnx_node_t *node);
 void MatMul_float32_rvv(struct onnx_node_t *node);
 
+/* -1 for mismatched shapes or requantization parameters */
+int MatMulInteger(struct onnx_node_t *n);
+int MatMulInteger_rvv(struct onnx_node_t *n);
+
 void Add_int8(struct onnx_node_t *node);
 void Add_int8_rvv(struct onnx_node_t *node);
 void Add_float16(struct onnx_node_t *node);
@@ -321,6 +576,38 @@ void ReduceSum_float32_rvv(struct onnx_node_t *n);
 
 int ConvInteger(struct onnx_node_t *n);
 int ConvInteger_rvv(struct onnx_node_t *n);
+
+void Conv_float16(struct onnx_node_t *n);
+void Conv_float16_rvv(struct onnx_node_t *n);
+void Conv_float32(struct onnx_node_t *n);
+void Conv_float32_rvv(struct onnx_node_t *n);
+
+int ConvTransposeInteger(struct onnx_node_t *n);
+int ConvTransposeInteger_rvv(struct onnx_node_t *n);
+int ConvTranspose_float16(struct onnx_node_t *n);
+int ConvTranspose_float16_rvv(struct onnx_node_t *n);
+
+/* node->priv of GlobalAveragePool is unused */
+void MaxPool_int8(struct onnx_node_t *n);
+void MaxPool_int8_rvv(struct onnx_node_t *n);
+void MaxPool_float16(struct onnx_node_t *n);
+void MaxPool_float16_rvv(struct onnx_node_t *n);
+void MaxPool_float32(struct onnx_node_t *n);
+void MaxPool_float32_rvv(struct onnx_node_t *n);
+
+void AveragePool_int8(struct onnx_node_t *n);
+void AveragePool_int8_rvv(struct onnx_node_t *n);
+void AveragePool_float16(struct onnx_node_t *n);
+void AveragePool_float16_rvv(struct onnx_node_t *n);
+void AveragePool_float32(struct onnx_node_t *n);
+void AveragePool_float32_rvv(struct onnx_node_t *n);
+
+void GlobalAveragePool_int8(struct onnx_node_t *n);
+void GlobalAveragePool_int8_rvv(struct onnx_node_t *n);
+void GlobalAveragePool_float16(struct onnx_node_t *n);
+void GlobalAveragePool_float16_rvv(struct onnx_node_t *n);
+void GlobalAveragePool_float32(struct onnx_node_t *n);
+void GlobalAveragePool_float32_rvv(struct onnx_node_t *n);
 /* ---------------- end of operators ----------------- */
 
 #endif
@@ -17,6 +17,7 @@ void Abs_int8(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Abs_int8_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -36,6 +37,7 @@ void Abs_int8_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Abs_int32(struct onnx_node_t *n)
 {
@@ -49,6 +51,7 @@ void Abs_int32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Abs_int32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -68,6 +71,7 @@ void Abs_int32_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Abs_float16(struct onnx_node_t *n)
 {
@@ -81,6 +85,7 @@ void Abs_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Abs_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -99,6 +104,7 @@ void Abs_float16_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Abs_float32(struct onnx_node_t *n)
 {
@@ -112,6 +118,7 @@ void Abs_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Abs_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -130,3 +137,4 @@ void Abs_float32_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
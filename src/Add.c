@@ -19,6 +19,7 @@ void Add_int8(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Add_int8_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *y = n->outputs[0];
@@ -40,6 +41,7 @@ void Add_int8_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Add_float16(struct onnx_node_t *n)
 {
@@ -55,6 +57,7 @@ void Add_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Add_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *y = n->outputs[0];
@@ -76,6 +79,7 @@ void Add_float16_rvv(struct onnx_node_t *n)
         py += l;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Add_float32(struct onnx_node_t *n)
 {
@@ -91,6 +95,7 @@ void Add_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Add_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *y = n->outputs[0];
@@ -112,4 +117,5 @@ void Add_float32_rvv(struct onnx_node_t *n)
         __riscv_vse32_v_f32m8(py, __riscv_vfadd_vv_f32m8(vx, vy, l), l);
         py += l;
     }
-}
\ No newline at end of file
+}
+#endif /* defined(__riscv_vector) */
\ No newline at end of file
@@ -42,6 +42,7 @@ void BatchNormalization_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void BatchNormalization_float16_rvv(struct onnx_node_t *n)
 {
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
@@ -90,6 +91,7 @@ void BatchNormalization_float16_rvv(struct onnx_node_t *n)
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void BatchNormalization_float32(struct onnx_node_t *n)
 {
@@ -122,6 +124,7 @@ void BatchNormalization_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void BatchNormalization_float32_rvv(struct onnx_node_t *n)
 {
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
@@ -169,6 +172,7 @@ void BatchNormalization_float32_rvv(struct onnx_node_t *n)
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void *GenerateBatchNormParam(float epsilon, float momentum)
 {
@@ -31,6 +31,7 @@ void Clamp_int8(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Clamp_int8_rvv(struct onnx_node_t *n)
 {
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
@@ -53,6 +54,7 @@ void Clamp_int8_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Clamp_int32(struct onnx_node_t *n)
 {
@@ -75,6 +77,7 @@ void Clamp_int32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Clamp_int32_rvv(struct onnx_node_t *n)
 {
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
@@ -97,6 +100,7 @@ void Clamp_int32_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Clamp_float16(struct onnx_node_t *n)
 {
@@ -119,6 +123,7 @@ void Clamp_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Clamp_float16_rvv(struct onnx_node_t *n)
 {
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
@@ -141,6 +146,7 @@ void Clamp_float16_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Clamp_float32(struct onnx_node_t *n)
 {
@@ -163,6 +169,7 @@ void Clamp_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Clamp_float32_rvv(struct onnx_node_t *n)
 {
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
@@ -185,6 +192,7 @@ void Clamp_float32_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void *GenerateClampParam(OnnxScalar min, OnnxScalar max)
 {
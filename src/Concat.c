@@ -60,6 +60,7 @@ void Concat_int8(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Concat_int8_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x;
@@ -106,6 +107,7 @@ void Concat_int8_rvv(struct onnx_node_t *n)
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Concat_int32(struct onnx_node_t *n)
 {
@@ -139,6 +141,7 @@ void Concat_int32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Concat_int32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x;
@@ -185,6 +188,7 @@ void Concat_int32_rvv(struct onnx_node_t *n)
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Concat_float16(struct onnx_node_t *n)
 {
@@ -218,6 +222,7 @@ void Concat_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Concat_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x;
@@ -264,6 +269,7 @@ void Concat_float16_rvv(struct onnx_node_t *n)
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Concat_float32(struct onnx_node_t *n)
 {
@@ -297,6 +303,7 @@ void Concat_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Concat_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x;
@@ -343,3 +350,4 @@ void Concat_float32_rvv(struct onnx_node_t *n)
         }
     }
 }
+#endif /* defined(__riscv_vector) */
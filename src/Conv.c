@@ -0,0 +1,775 @@
+/*
+ * https://onnx.ai/onnx/operators/onnx__Conv.html
+ *
+ * Same NHWC layout as ConvInteger: input [batch, input_h, input_w, input_ch],
+ * filter [output_ch, kernel_h, kernel_w, input_ch / groups] and output
+ * [batch, output_h, output_w, output_ch]. float16 accumulates in float32.
+ */
+
+#include "operators.h"
+#include "utils.h"
+
+typedef struct {
+    int32_t w;
+    int32_t h;
+} Tile;
+
+struct operator_pdata_t {
+    void *buf;
+    size_t buf_size;
+    Tile stride;
+    Tile padding;
+    Tile dilation;
+    int32_t groups;
+    _Bool winograd;         /**< 3x3 filter with stride 1, dilation 1 and one group, Winograd F(4x4,3x3) */
+    void *col;              /**< CONV_ROWS im2col rows inside buf, same type as the input */
+    void *kernel_packed;    /**< filter packed as [groups, rhs_cols, output_ch / groups] inside buf for the rvv im2col path */
+    float32_t *kernel_tm;   /**< Winograd transform of the filter [36, input_ch, output_ch] inside buf */
+    _Bool kernel_ready;     /**< kernel_packed or kernel_tm holds the current filter */
+};
+
+#define CONV_ROWS (4) // output pixels per block of the rvv im2col path
+
+#define WG43_TILE (4)
+#define WG43_DOT_ROWS (4)     // tiles per block of the dot product
+#define WG43_MIN_CHANNELS (16) // below, the transforms cost more than the saved multiplies
+
+static const struct onnx_tensor_t *conv_bias(const struct onnx_node_t *n)
+{
+    return n->ninput > 2 && n->inputs[2] != NULL && n->inputs[2]->datas != NULL ? n->inputs[2] : NULL;
+}
+
+void Conv_float32(struct onnx_node_t *n)
+{
+    const struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const struct onnx_tensor_t *input = n->inputs[0];
+    const struct onnx_tensor_t *filter = n->inputs[1];
+    const struct onnx_tensor_t *bias = conv_bias(n);
+    struct onnx_tensor_t *output = n->outputs[0];
+
+    const int32_t input_ch = input->dims[0];
+    const int32_t input_x = input->dims[1];
+    const int32_t input_y = input->dims[2];
+    const int32_t kernel_ch = filter->dims[0];
+    const int32_t kernel_x = filter->dims[1];
+    const int32_t kernel_y = filter->dims[2];
+    const int32_t output_ch = output->dims[0];
+    const int32_t output_x = output->dims[1];
+    const int32_t output_y = output->dims[2];
+    const int32_t output_ch_per_group = output_ch / pdat->groups;
+    const float32_t *input_data = (const float32_t *)input->datas;
+    const float32_t *filter_data = (const float32_t *)filter->datas;
+    const float32_t *bias_data = bias ? (const float32_t *)bias->datas : NULL;
+    float32_t *output_data = (float32_t *)output->datas;
+
+    for (int32_t b = 0; b < input->dims[3]; b++) {
+        for (int32_t oy = 0; oy < output_y; oy++) {
+            for (int32_t ox = 0; ox < output_x; ox++) {
+                for (int32_t oc = 0; oc < output_ch; oc++) {
+                    const int32_t g = oc / output_ch_per_group;
+                    float32_t sum = bias_data ? bias_data[oc] : 0.0f;
+                    for (int32_t ky = 0; ky < kernel_y; ky++) {
+                        const int32_t iy = oy * pdat->stride.h - pdat->padding.h + ky * pdat->dilation.h;
+                        if (iy < 0 || iy >= input_y) {
+                            continue;
+                        }
+                        for (int32_t kx = 0; kx < kernel_x; kx++) {
+                            const int32_t ix = ox * pdat->stride.w - pdat->padding.w + kx * pdat->dilation.w;
+                            if (ix < 0 || ix >= input_x) {
+                                continue;
+                            }
+                            const float32_t *px = input_data + ((b * input_y + iy) * input_x + ix) * input_ch + g * kernel_ch;
+                            const float32_t *pw = filter_data + ((oc * kernel_y + ky) * kernel_x + kx) * kernel_ch;
+                            for (int32_t ic = 0; ic < kernel_ch; ic++) {
+                                sum += px[ic] * pw[ic];
+                            }
+                        }
+                    }
+                    *output_data++ = sum;
+                }
+            }
+        }
+    }
+}
+
+void Conv_float16(struct onnx_node_t *n)
+{
+    const struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const struct onnx_tensor_t *input = n->inputs[0];
+    const struct onnx_tensor_t *filter = n->inputs[1];
+    const struct onnx_tensor_t *bias = conv_bias(n);
+    struct onnx_tensor_t *output = n->outputs[0];
+
+    const int32_t input_ch = input->dims[0];
+    const int32_t input_x = input->dims[1];
+    const int32_t input_y = input->dims[2];
+    const int32_t kernel_ch = filter->dims[0];
+    const int32_t kernel_x = filter->dims[1];
+    const int32_t kernel_y = filter->dims[2];
+    const int32_t output_ch = output->dims[0];
+    const int32_t output_x = output->dims[1];
+    const int32_t output_y = output->dims[2];
+    const int32_t output_ch_per_group = output_ch / pdat->groups;
+    const float16_t *input_data = (const float16_t *)input->datas;
+    const float16_t *filter_data = (const float16_t *)filter->datas;
+    const float16_t *bias_data = bias ? (const float16_t *)bias->datas : NULL;
+    float16_t *output_data = (float16_t *)output->datas;
+
+    for (int32_t b = 0; b < input->dims[3]; b++) {
+        for (int32_t oy = 0; oy < output_y; oy++) {
+            for (int32_t ox = 0; ox < output_x; ox++) {
+                for (int32_t oc = 0; oc < output_ch; oc++) {
+                    const int32_t g = oc / output_ch_per_group;
+                    float32_t sum = bias_data ? (float32_t)bias_data[oc] : 0.0f;
+                    for (int32_t ky = 0; ky < kernel_y; ky++) {
+                        const int32_t iy = oy * pdat->stride.h - pdat->padding.h + ky * pdat->dilation.h;
+                        if (iy < 0 || iy >= input_y) {
+                            continue;
+                        }
+                        for (int32_t kx = 0; kx < kernel_x; kx++) {
+                            const int32_t ix = ox * pdat->stride.w - pdat->padding.w + kx * pdat->dilation.w;
+                            if (ix < 0 || ix >= input_x) {
+                                continue;
+                            }
+                            const float16_t *px = input_data + ((b * input_y + iy) * input_x + ix) * input_ch + g * kernel_ch;
+                            const float16_t *pw = filter_data + ((oc * kernel_y + ky) * kernel_x + kx) * kernel_ch;
+                            for (int32_t ic = 0; ic < kernel_ch; ic++) {
+                                sum += (float32_t)px[ic] * (float32_t)pw[ic];
+                            }
+                        }
+                    }
+                    *output_data++ = (float16_t)sum;
+                }
+            }
+        }
+    }
+}
+
+#if defined(__riscv_vector)
+// filter [output_ch, kernel_h, kernel_w, kernel_ch] to [groups, rhs_cols, output_ch / groups], output channels are contiguous
+static void conv_pack_kernel(const struct onnx_tensor_t *filter, int32_t groups, void *kernel_packed)
+{
+    const size_t esize = onnx_tensor_type_sizeof(filter->type);
+    const int32_t rhs_cols = filter->dims[0] * filter->dims[1] * filter->dims[2];
+    const int32_t out_ch = filter->dims[3] / groups;
+    const char *src = (const char *)filter->datas;
+    char *dst = (char *)kernel_packed;
+
+    for (int32_t g = 0; g < groups; g++) {
+        for (int32_t k = 0; k < rhs_cols; k++) {
+            for (int32_t oc = 0; oc < out_ch; oc++) {
+                memcpy(dst + ((g * rhs_cols + k) * out_ch + oc) * esize, src + ((g * out_ch + oc) * rhs_cols + k) * esize, esize);
+            }
+        }
+    }
+}
+
+/*
+ * im2col row of output pixel (ox, oy) in group g, padding is zero. A 1x1
+ * filter without padding reads the input pixel directly.
+ */
+static const void *conv_im2col_row(const struct operator_pdata_t *pdat, const struct onnx_tensor_t *input, const struct onnx_tensor_t *filter,
+                                   const char *input_data, int32_t g, int32_t ox, int32_t oy, char *col)
+{
+    const size_t esize = onnx_tensor_type_sizeof(input->type);
+    const int32_t input_ch = input->dims[0];
+    const int32_t input_x = input->dims[1];
+    const int32_t input_y = input->dims[2];
+    const int32_t kernel_ch = filter->dims[0];
+    const int32_t kernel_x = filter->dims[1];
+    const int32_t kernel_y = filter->dims[2];
+
+    if (kernel_x == 1 && kernel_y == 1 && pdat->padding.w == 0 && pdat->padding.h == 0) {
+        return input_data + ((oy * pdat->stride.h * input_x + ox * pdat->stride.w) * input_ch + g * kernel_ch) * esize;
+    }
+    for (int32_t ky = 0; ky < kernel_y; ky++) {
+        const int32_t iy = oy * pdat->stride.h - pdat->padding.h + ky * pdat->dilation.h;
+        for (int32_t kx = 0; kx < kernel_x; kx++) {
+            const int32_t ix = ox * pdat->stride.w - pdat->padding.w + kx * pdat->dilation.w;
+            char *dst = col + (ky * kernel_x + kx) * kernel_ch * esize;
+            if (iy < 0 || iy >= input_y || ix < 0 || ix >= input_x) {
+                memset(dst, 0, kernel_ch * esize);
+            } else {
+                memcpy(dst, input_data + ((iy * input_x + ix) * input_ch + g * kernel_ch) * esize, kernel_ch * esize);
+            }
+        }
+    }
+    return col;
+}
+
+/*
+ * Any kernel size, stride, dilation and group count: CONV_ROWS output pixels
+ * are unrolled into rows, then multiplied with the packed filter along the
+ * output channels, every filter row loaded feeds CONV_ROWS accumulators.
+ */
+static void conv_float32_im2col_rvv(struct onnx_node_t *n)
+{
+    const struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const struct onnx_tensor_t *input = n->inputs[0];
+    const struct onnx_tensor_t *filter = n->inputs[1];
+    const struct onnx_tensor_t *bias = conv_bias(n);
+    struct onnx_tensor_t *output = n->outputs[0];
+
+    const int32_t groups = pdat->groups;
+    const int32_t rhs_cols = filter->dims[0] * filter->dims[1] * filter->dims[2];
+    const int32_t output_ch = output->dims[0];
+    const int32_t out_ch = output_ch / groups;
+    const int32_t output_x = output->dims[1];
+    const int32_t pixels = output_x * output->dims[2];
+    const float32_t *bias_data = bias ? (const float32_t *)bias->datas : NULL;
+    float32_t *col = (float32_t *)pdat->col;
+
+    for (int32_t batch_idx = 0; batch_idx < input->dims[3]; batch_idx++) {
+        const char *input_data = (const char *)input->datas + input->dims[2] * input->dims[1] * input->dims[0] * batch_idx * sizeof(float32_t);
+        float32_t *output_data = (float32_t *)output->datas + pixels * output_ch * batch_idx;
+
+        for (int32_t g = 0; g < groups; g++) {
+            const float32_t *kernel = (const float32_t *)pdat->kernel_packed + g * rhs_cols * out_ch;
+            for (int32_t p = 0; p < pixels; p += CONV_ROWS) {
+                const int32_t rows = MIN(CONV_ROWS, pixels - p);
+                // rows past the last pixel repeat row 0, their results are dropped
+                const float32_t *col0 = conv_im2col_row(pdat, input, filter, input_data, g, p % output_x, p / output_x, (char *)col);
+                const float32_t *col1 = col0;
+                const float32_t *col2 = col0;
+                const float32_t *col3 = col0;
+                if (rows > 1) {
+                    col1 = conv_im2col_row(pdat, input, filter, input_data, g, (p + 1) % output_x, (p + 1) / output_x, (char *)(col + rhs_cols));
+                }
+                if (rows > 2) {
+                    col2 = conv_im2col_row(pdat, input, filter, input_data, g, (p + 2) % output_x, (p + 2) / output_x, (char *)(col + 2 * rhs_cols));
+                }
+                if (rows > 3) {
+                    col3 = conv_im2col_row(pdat, input, filter, input_data, g, (p + 3) % output_x, (p + 3) / output_x, (char *)(col + 3 * rhs_cols));
+                }
+                float32_t *out = output_data + p * output_ch + g * out_ch;
+
+                size_t avl = out_ch, vl;
+                for (int32_t oc = 0; (vl = __riscv_vsetvl_e32m4(avl)) > 0; avl -= vl, oc += vl) {
+                    vfloat32m4_t acc0;
+                    if (bias_data) {
+                        acc0 = __riscv_vle32_v_f32m4(bias_data + g * out_ch + oc, vl);
+                    } else {
+                        acc0 = __riscv_vfmv_v_f_f32m4(0.0f, vl);
+                    }
+                    vfloat32m4_t acc1 = acc0;
+                    vfloat32m4_t acc2 = acc0;
+                    vfloat32m4_t acc3 = acc0;
+                    const float32_t *pk = kernel + oc;
+                    for (int32_t k = 0; k < rhs_cols; k++) {
+                        vfloat32m4_t w = __riscv_vle32_v_f32m4(pk, vl);
+                        pk += out_ch;
+                        acc0 = __riscv_vfmacc_vf_f32m4(acc0, col0[k], w, vl);
+                        acc1 = __riscv_vfmacc_vf_f32m4(acc1, col1[k], w, vl);
+                        acc2 = __riscv_vfmacc_vf_f32m4(acc2, col2[k], w, vl);
+                        acc3 = __riscv_vfmacc_vf_f32m4(acc3, col3[k], w, vl);
+                    }
+                    __riscv_vse32_v_f32m4(out + oc, acc0, vl);
+                    if (rows > 1) {
+                        __riscv_vse32_v_f32m4(out + output_ch + oc, acc1, vl);
+                    }
+                    if (rows > 2) {
+                        __riscv_vse32_v_f32m4(out + 2 * output_ch + oc, acc2, vl);
+                    }
+                    if (rows > 3) {
+                        __riscv_vse32_v_f32m4(out + 3 * output_ch + oc, acc3, vl);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// float16 im2col path, products are widened and accumulated in float32
+static void conv_float16_im2col_rvv(struct onnx_node_t *n)
+{
+    const struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const struct onnx_tensor_t *input = n->inputs[0];
+    const struct onnx_tensor_t *filter = n->inputs[1];
+    const struct onnx_tensor_t *bias = conv_bias(n);
+    struct onnx_tensor_t *output = n->outputs[0];
+
+    const int32_t groups = pdat->groups;
+    const int32_t rhs_cols = filter->dims[0] * filter->dims[1] * filter->dims[2];
+    const int32_t output_ch = output->dims[0];
+    const int32_t out_ch = output_ch / groups;
+    const int32_t output_x = output->dims[1];
+    const int32_t pixels = output_x * output->dims[2];
+    const float16_t *bias_data = bias ? (const float16_t *)bias->datas : NULL;
+    float16_t *col = (float16_t *)pdat->col;
+
+    for (int32_t batch_idx = 0; batch_idx < input->dims[3]; batch_idx++) {
+        const char *input_data = (const char *)input->datas + input->dims[2] * input->dims[1] * input->dims[0] * batch_idx * sizeof(float16_t);
+        float16_t *output_data = (float16_t *)output->datas + pixels * output_ch * batch_idx;
+
+        for (int32_t g = 0; g < groups; g++) {
+            const float16_t *kernel = (const float16_t *)pdat->kernel_packed + g * rhs_cols * out_ch;
+            for (int32_t p = 0; p < pixels; p += CONV_ROWS) {
+                const int32_t rows = MIN(CONV_ROWS, pixels - p);
+                // rows past the last pixel repeat row 0, their results are dropped
+                const float16_t *col0 = conv_im2col_row(pdat, input, filter, input_data, g, p % output_x, p / output_x, (char *)col);
+                const float16_t *col1 = col0;
+                const float16_t *col2 = col0;
+                const float16_t *col3 = col0;
+                if (rows > 1) {
+                    col1 = conv_im2col_row(pdat, input, filter, input_data, g, (p + 1) % output_x, (p + 1) / output_x, (char *)(col + rhs_cols));
+                }
+                if (rows > 2) {
+                    col2 = conv_im2col_row(pdat, input, filter, input_data, g, (p + 2) % output_x, (p + 2) / output_x, (char *)(col + 2 * rhs_cols));
+                }
+                if (rows > 3) {
+                    col3 = conv_im2col_row(pdat, input, filter, input_data, g, (p + 3) % output_x, (p + 3) / output_x, (char *)(col + 3 * rhs_cols));
+                }
+                float16_t *out = output_data + p * output_ch + g * out_ch;
+
+                size_t avl = out_ch, vl;
+                for (int32_t oc = 0; (vl = __riscv_vsetvl_e32m4(avl)) > 0; avl -= vl, oc += vl) {
+                    vfloat32m4_t acc0;
+                    if (bias_data) {
+                        acc0 = __riscv_vfwcvt_f_f_v_f32m4(__riscv_vle16_v_f16m2(bias_data + g * out_ch + oc, vl), vl);
+                    } else {
+                        acc0 = __riscv_vfmv_v_f_f32m4(0.0f, vl);
+                    }
+                    vfloat32m4_t acc1 = acc0;
+                    vfloat32m4_t acc2 = acc0;
+                    vfloat32m4_t acc3 = acc0;
+                    const float16_t *pk = kernel + oc;
+                    for (int32_t k = 0; k < rhs_cols; k++) {
+                        vfloat16m2_t w = __riscv_vle16_v_f16m2(pk, vl);
+                        pk += out_ch;
+                        acc0 = __riscv_vfwmacc_vf_f32m4(acc0, col0[k], w, vl);
+                        acc1 = __riscv_vfwmacc_vf_f32m4(acc1, col1[k], w, vl);
+                        acc2 = __riscv_vfwmacc_vf_f32m4(acc2, col2[k], w, vl);
+                        acc3 = __riscv_vfwmacc_vf_f32m4(acc3, col3[k], w, vl);
+                    }
+                    __riscv_vse16_v_f16m2(out + oc, __riscv_vfncvt_f_f_w_f16m2(acc0, vl), vl);
+                    if (rows > 1) {
+                        __riscv_vse16_v_f16m2(out + output_ch + oc, __riscv_vfncvt_f_f_w_f16m2(acc1, vl), vl);
+                    }
+                    if (rows > 2) {
+                        __riscv_vse16_v_f16m2(out + 2 * output_ch + oc, __riscv_vfncvt_f_f_w_f16m2(acc2, vl), vl);
+                    }
+                    if (rows > 3) {
+                        __riscv_vse16_v_f16m2(out + 3 * output_ch + oc, __riscv_vfncvt_f_f_w_f16m2(acc3, vl), vl);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Winograd F(4x4,3x3) for both types, computed in float32: 6x6 input tiles
+ * give 4x4 output tiles with 36 instead of 144 multiplies per input/output
+ * channel pair, the 36 positions of the transformed tiles are independent
+ * [tiles, in_ch] x [in_ch, out_ch] GEMMs.
+ */
+
+// G = [ 1/4,     0,   0]
+//     [-1/6,  -1/6, -1/6]
+//     [-1/6,   1/6, -1/6]
+//     [1/24,  1/12,  1/6]
+//     [1/24, -1/12,  1/6]
+//     [   0,     0,    1]
+static const float32_t wg43_ktm[6][3] = {
+    {1.0f / 4, 0.0f, 0.0f},           {-1.0f / 6, -1.0f / 6, -1.0f / 6}, {-1.0f / 6, 1.0f / 6, -1.0f / 6},
+    {1.0f / 24, 1.0f / 12, 1.0f / 6}, {1.0f / 24, -1.0f / 12, 1.0f / 6}, {0.0f, 0.0f, 1.0f},
+};
+
+// kernel_tm is [36, C_IN, C_OUT], G g G^T of every channel pair
+static void conv_wg43_trans_kernel(const struct onnx_tensor_t *filter, float32_t *kernel_tm)
+{
+    const int32_t out_ch = filter->dims[3];
+    const int32_t in_ch = filter->dims[0];
+
+    for (int32_t outch_idx = 0; outch_idx < out_ch; outch_idx++) {
+        for (int32_t inch_idx = 0; inch_idx < in_ch; inch_idx++) {
+            float32_t g[9];
+            for (int32_t k = 0; k < 9; k++) {
+                const int32_t idx = (outch_idx * 9 + k) * in_ch + inch_idx;
+                if (filter->type == ONNX_TENSOR_TYPE_FLOAT16) {
+                    g[k] = (float32_t)((const float16_t *)filter->datas)[idx];
+                } else {
+                    g[k] = ((const float32_t *)filter->datas)[idx];
+                }
+            }
+            float32_t tmp[6][3];
+            for (int32_t i = 0; i < 6; i++) {
+                for (int32_t kx = 0; kx < 3; kx++) {
+                    tmp[i][kx] = wg43_ktm[i][0] * g[kx] + wg43_ktm[i][1] * g[3 + kx] + wg43_ktm[i][2] * g[6 + kx];
+                }
+            }
+            for (int32_t i = 0; i < 6; i++) {
+                for (int32_t j = 0; j < 6; j++) {
+                    kernel_tm[((i * 6 + j) * in_ch + inch_idx) * out_ch + outch_idx] =
+                        tmp[i][0] * wg43_ktm[j][0] + tmp[i][1] * wg43_ktm[j][1] + tmp[i][2] * wg43_ktm[j][2];
+                }
+            }
+        }
+    }
+}
+
+// B^T = [4,  0, -5,  0, 1, 0]
+//       [0, -4, -4,  1, 1, 0]
+//       [0,  4, -4, -1, 1, 0]
+//       [0, -2, -1,  2, 1, 0]
+//       [0,  2, -1, -2, 1, 0]
+//       [0,  4,  0, -5, 0, 1]
+// applied to d0..d5, row k of the result is stored to out + k * stride
+__STATIC_FORCEINLINE void wg43_trans_input_op(vfloat32m2_t d0, vfloat32m2_t d1, vfloat32m2_t d2, vfloat32m2_t d3, vfloat32m2_t d4,
+                                              vfloat32m2_t d5, float32_t *out, ptrdiff_t stride, size_t vl)
+{
+    vfloat32m2_t d42 = __riscv_vfsub_vv_f32m2(d4, d2, vl);
+    vfloat32m2_t d13 = __riscv_vfmul_vf_f32m2(__riscv_vfsub_vv_f32m2(d1, d3, vl), 2.0f, vl);
+
+    __riscv_vse32_v_f32m2(out, __riscv_vfmacc_vf_f32m2(d42, 4.0f, __riscv_vfsub_vv_f32m2(d0, d2, vl), vl), vl);
+    __riscv_vse32_v_f32m2(out + stride, __riscv_vfmacc_vf_f32m2(__riscv_vfadd_vv_f32m2(d3, d4, vl), -4.0f, __riscv_vfadd_vv_f32m2(d1, d2, vl), vl),
+                          vl);
+    __riscv_vse32_v_f32m2(out + 2 * stride, __riscv_vfmacc_vf_f32m2(__riscv_vfsub_vv_f32m2(d4, d3, vl), 4.0f, __riscv_vfsub_vv_f32m2(d1, d2, vl), vl),
+                          vl);
+    __riscv_vse32_v_f32m2(out + 3 * stride, __riscv_vfsub_vv_f32m2(d42, d13, vl), vl);
+    __riscv_vse32_v_f32m2(out + 4 * stride, __riscv_vfadd_vv_f32m2(d42, d13, vl), vl);
+    // 4 * d1 - 5 * d3 + d5 = 2 * d13 - d3 + d5
+    __riscv_vse32_v_f32m2(out + 5 * stride, __riscv_vfsub_vv_f32m2(__riscv_vfmacc_vf_f32m2(d5, 2.0f, d13, vl), d3, vl), vl);
+}
+
+// input pixel (x, y) of channels [c, c + vl) as float32, zero outside of the input
+__STATIC_FORCEINLINE vfloat32m2_t conv_wg43_load(const struct onnx_tensor_t *input, const char *input_data, int32_t x, int32_t y, int32_t c,
+                                                 size_t vl)
+{
+    if (x < 0 || x >= input->dims[1] || y < 0 || y >= input->dims[2]) {
+        return __riscv_vfmv_v_f_f32m2(0.0f, vl);
+    }
+    const int32_t idx = (y * input->dims[1] + x) * input->dims[0] + c;
+    if (input->type == ONNX_TENSOR_TYPE_FLOAT16) {
+        return __riscv_vfwcvt_f_f_v_f32m2(__riscv_vle16_v_f16m1((const float16_t *)input_data + idx, vl), vl);
+    }
+    return __riscv_vle32_v_f32m2((const float32_t *)input_data + idx, vl);
+}
+
+// transform input [H, W, C_IN] to [36, tiles, C_IN], buffer holds [6, 6, C_IN]
+static void conv_wg43_trans_input(const struct operator_pdata_t *pdat, const struct onnx_tensor_t *input, const char *input_data, int32_t tile_w,
+                                  int32_t tile_h, float32_t *in_tm, float32_t *buffer)
+{
+    const int32_t tiles = tile_w * tile_h;
+    const int32_t c_in = input->dims[0];
+
+    for (int32_t h_idx = 0; h_idx < tile_h; ++h_idx) {
+        for (int32_t w_idx = 0; w_idx < tile_w; ++w_idx) {
+            const int32_t tile_idx = h_idx * tile_w + w_idx;
+            const int32_t x0 = w_idx * WG43_TILE - pdat->padding.w;
+            const int32_t y0 = h_idx * WG43_TILE - pdat->padding.h;
+
+            size_t avl = c_in, vl;
+            for (int32_t c = 0; (vl = __riscv_vsetvl_e32m2(avl)) > 0; avl -= vl, c += vl) {
+                // d B of the 6 rows
+                for (int32_t r = 0; r < 6; r++) {
+                    const int32_t y = y0 + r;
+                    wg43_trans_input_op(conv_wg43_load(input, input_data, x0, y, c, vl), conv_wg43_load(input, input_data, x0 + 1, y, c, vl),
+                                        conv_wg43_load(input, input_data, x0 + 2, y, c, vl), conv_wg43_load(input, input_data, x0 + 3, y, c, vl),
+                                        conv_wg43_load(input, input_data, x0 + 4, y, c, vl), conv_wg43_load(input, input_data, x0 + 5, y, c, vl),
+                                        buffer + r * 6 * c_in + c, c_in, vl);
+                }
+                // B^T (d B) of the 6 columns
+                for (int32_t j = 0; j < 6; j++) {
+                    const float32_t *col = buffer + j * c_in + c;
+                    wg43_trans_input_op(__riscv_vle32_v_f32m2(col, vl), __riscv_vle32_v_f32m2(col + 6 * c_in, vl),
+                                        __riscv_vle32_v_f32m2(col + 12 * c_in, vl), __riscv_vle32_v_f32m2(col + 18 * c_in, vl),
+                                        __riscv_vle32_v_f32m2(col + 24 * c_in, vl), __riscv_vle32_v_f32m2(col + 30 * c_in, vl),
+                                        in_tm + (j * tiles + tile_idx) * c_in + c, 6 * tiles * c_in, vl);
+                }
+            }
+        }
+    }
+}
+
+struct conv_wg43_dot_args_t {
+    const float32_t *in_tm;
+    const float32_t *kernel_tm;
+    float32_t *dot;
+    int32_t tiles;
+    int32_t in_ch;
+    int32_t out_ch;
+};
+
+// blocks [start, end) of WG43_DOT_ROWS tiles at one of the 36 positions, run on several harts by onnx_parallel_for
+static void conv_wg43_dot_blocks(void *arg, int start, int end)
+{
+    const struct conv_wg43_dot_args_t *args = (const struct conv_wg43_dot_args_t *)arg;
+    const int32_t tiles = args->tiles;
+    const int32_t in_ch = args->in_ch;
+    const int32_t out_ch = args->out_ch;
+    const int32_t blocks = (tiles + WG43_DOT_ROWS - 1) / WG43_DOT_ROWS;
+
+    for (int32_t b = start; b < end; b++) {
+        const int32_t pos = b / blocks;
+        const int32_t tile_idx = b % blocks * WG43_DOT_ROWS;
+        const int32_t rows = MIN(WG43_DOT_ROWS, tiles - tile_idx);
+        // rows past the last tile repeat row 0, their results are dropped
+        const float32_t *in0 = args->in_tm + (pos * tiles + tile_idx) * in_ch;
+        const float32_t *in1 = rows > 1 ? in0 + in_ch : in0;
+        const float32_t *in2 = rows > 2 ? in0 + 2 * in_ch : in0;
+        const float32_t *in3 = rows > 3 ? in0 + 3 * in_ch : in0;
+        const float32_t *kernel = args->kernel_tm + pos * in_ch * out_ch;
+        float32_t *dot = args->dot + (pos * tiles + tile_idx) * out_ch;
+
+        size_t avl = out_ch, vl;
+        for (int32_t oc = 0; (vl = __riscv_vsetvl_e32m4(avl)) > 0; avl -= vl, oc += vl) {
+            vfloat32m4_t sum0 = __riscv_vfmv_v_f_f32m4(0.0f, vl);
+            vfloat32m4_t sum1 = sum0;
+            vfloat32m4_t sum2 = sum0;
+            vfloat32m4_t sum3 = sum0;
+            const float32_t *pk = kernel + oc;
+            for (int32_t k = 0; k < in_ch; k++) {
+                vfloat32m4_t w = __riscv_vle32_v_f32m4(pk, vl);
+                pk += out_ch;
+                sum0 = __riscv_vfmacc_vf_f32m4(sum0, in0[k], w, vl);
+                sum1 = __riscv_vfmacc_vf_f32m4(sum1, in1[k], w, vl);
+                sum2 = __riscv_vfmacc_vf_f32m4(sum2, in2[k], w, vl);
+                sum3 = __riscv_vfmacc_vf_f32m4(sum3, in3[k], w, vl);
+            }
+            __riscv_vse32_v_f32m4(dot + oc, sum0, vl);
+            if (rows > 1) {
+                __riscv_vse32_v_f32m4(dot + out_ch + oc, sum1, vl);
+            }
+            if (rows > 2) {
+                __riscv_vse32_v_f32m4(dot + 2 * out_ch + oc, sum2, vl);
+            }
+            if (rows > 3) {
+                __riscv_vse32_v_f32m4(dot + 3 * out_ch + oc, sum3, vl);
+            }
+        }
+    }
+}
+
+// A^T = [1, 1,  1, 1,  1, 0]
+//       [0, 1, -1, 2, -2, 0]
+//       [0, 1,  1, 4,  4, 0]
+//       [0, 1, -1, 8, -8, 1]
+// applied to m0..m5, row k of the result is stored to out + k * stride
+__STATIC_FORCEINLINE void wg43_trans_output_op(vfloat32m4_t m0, vfloat32m4_t m1, vfloat32m4_t m2, vfloat32m4_t m3, vfloat32m4_t m4,
+                                               vfloat32m4_t m5, float32_t *out, ptrdiff_t stride, size_t vl)
+{
+    vfloat32m4_t a = __riscv_vfadd_vv_f32m4(m1, m2, vl);
+    vfloat32m4_t b = __riscv_vfsub_vv_f32m4(m1, m2, vl);
+    vfloat32m4_t c = __riscv_vfadd_vv_f32m4(m3, m4, vl);
+    vfloat32m4_t d = __riscv_vfsub_vv_f32m4(m3, m4, vl);
+
+    __riscv_vse32_v_f32m4(out, __riscv_vfadd_vv_f32m4(__riscv_vfadd_vv_f32m4(m0, a, vl), c, vl), vl);
+    __riscv_vse32_v_f32m4(out + stride, __riscv_vfmacc_vf_f32m4(b, 2.0f, d, vl), vl);
+    __riscv_vse32_v_f32m4(out + 2 * stride, __riscv_vfmacc_vf_f32m4(a, 4.0f, c, vl), vl);
+    __riscv_vse32_v_f32m4(out + 3 * stride, __riscv_vfadd_vv_f32m4(__riscv_vfmacc_vf_f32m4(b, 8.0f, d, vl), m5, vl), vl);
+}
+
+// transform dot [36, tiles, C_OUT] back to 4x4 output tiles, add bias and crop them to the output [H, W, C_OUT]
+static void conv_wg43_trans_output(const struct onnx_tensor_t *output, const struct onnx_tensor_t *bias, const float32_t *dot, int32_t tile_w,
+                                   int32_t tile_h, float32_t *buffer, char *output_data)
+{
+    const int32_t tiles = tile_w * tile_h;
+    const int32_t out_ch = output->dims[0];
+    const int32_t out_w = output->dims[1];
+    const int32_t out_h = output->dims[2];
+    const _Bool half = output->type == ONNX_TENSOR_TYPE_FLOAT16;
+
+    for (int32_t h_idx = 0; h_idx < tile_h; ++h_idx) {
+        for (int32_t w_idx = 0; w_idx < tile_w; ++w_idx) {
+            const int32_t tile_idx = h_idx * tile_w + w_idx;
+            const int32_t rows = MIN(WG43_TILE, out_h - h_idx * WG43_TILE);
+            const int32_t cols = MIN(WG43_TILE, out_w - w_idx * WG43_TILE);
+
+            size_t avl = out_ch, vl;
+            for (int32_t oc = 0; (vl = __riscv_vsetvl_e32m4(avl)) > 0; avl -= vl, oc += vl) {
+                // A^T dot of the 6 columns, buffer is [4, 6, C_OUT]
+                for (int32_t j = 0; j < 6; j++) {
+                    const float32_t *col = dot + (j * tiles + tile_idx) * out_ch + oc;
+                    const ptrdiff_t stride = 6 * tiles * out_ch;
+                    wg43_trans_output_op(__riscv_vle32_v_f32m4(col, vl), __riscv_vle32_v_f32m4(col + stride, vl),
+                                         __riscv_vle32_v_f32m4(col + 2 * stride, vl), __riscv_vle32_v_f32m4(col + 3 * stride, vl),
+                                         __riscv_vle32_v_f32m4(col + 4 * stride, vl), __riscv_vle32_v_f32m4(col + 5 * stride, vl),
+                                         buffer + j * out_ch + oc, 6 * out_ch, vl);
+                }
+                vfloat32m4_t vbias = __riscv_vfmv_v_f_f32m4(0.0f, vl);
+                if (bias && half) {
+                    vbias = __riscv_vfwcvt_f_f_v_f32m4(__riscv_vle16_v_f16m2((const float16_t *)bias->datas + oc, vl), vl);
+                } else if (bias) {
+                    vbias = __riscv_vle32_v_f32m4((const float32_t *)bias->datas + oc, vl);
+                }
+                // (A^T dot) A of the output rows, written over the first 4 columns of the row
+                for (int32_t i = 0; i < rows; i++) {
+                    float32_t *row = buffer + i * 6 * out_ch + oc;
+                    wg43_trans_output_op(__riscv_vle32_v_f32m4(row, vl), __riscv_vle32_v_f32m4(row + out_ch, vl),
+                                         __riscv_vle32_v_f32m4(row + 2 * out_ch, vl), __riscv_vle32_v_f32m4(row + 3 * out_ch, vl),
+                                         __riscv_vle32_v_f32m4(row + 4 * out_ch, vl), __riscv_vle32_v_f32m4(row + 5 * out_ch, vl), row, out_ch, vl);
+                    const int32_t pixel = (h_idx * WG43_TILE + i) * out_w + w_idx * WG43_TILE;
+                    for (int32_t c = 0; c < cols; c++) {
+                        vfloat32m4_t y = __riscv_vfadd_vv_f32m4(__riscv_vle32_v_f32m4(row + c * out_ch, vl), vbias, vl);
+                        if (half) {
+                            __riscv_vse16_v_f16m2((float16_t *)output_data + (pixel + c) * out_ch + oc, __riscv_vfncvt_f_f_w_f16m2(y, vl), vl);
+                        } else {
+                            __riscv_vse32_v_f32m4((float32_t *)output_data + (pixel + c) * out_ch + oc, y, vl);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void conv_wg43_rvv(struct onnx_node_t *n)
+{
+    const struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const struct onnx_tensor_t *input = n->inputs[0];
+    struct onnx_tensor_t *output = n->outputs[0];
+
+    const size_t esize = onnx_tensor_type_sizeof(input->type);
+    const int32_t in_ch = input->dims[0];
+    const int32_t out_ch = output->dims[0];
+    const int32_t tile_w = (output->dims[1] + WG43_TILE - 1) / WG43_TILE;
+    const int32_t tile_h = (output->dims[2] + WG43_TILE - 1) / WG43_TILE;
+    const int32_t tiles = tile_w * tile_h;
+
+    // split buffer, see GenerateConvParam
+    float32_t *in_tm = (float32_t *)pdat->buf;
+    float32_t *trans = in_tm + 36 * tiles * in_ch;
+    float32_t *dot = pdat->kernel_tm + 36 * in_ch * out_ch;
+
+    for (int32_t batch_idx = 0; batch_idx < input->dims[3]; ++batch_idx) {
+        const char *batch_in = (const char *)input->datas + input->dims[2] * input->dims[1] * in_ch * batch_idx * esize;
+        char *batch_out = (char *)output->datas + output->dims[2] * output->dims[1] * out_ch * batch_idx * esize;
+
+        conv_wg43_trans_input(pdat, input, batch_in, tile_w, tile_h, in_tm, trans);
+
+        struct conv_wg43_dot_args_t dot_args = {in_tm, pdat->kernel_tm, dot, tiles, in_ch, out_ch};
+        onnx_parallel_for(36 * ((tiles + WG43_DOT_ROWS - 1) / WG43_DOT_ROWS), 1, conv_wg43_dot_blocks, &dot_args);
+
+        conv_wg43_trans_output(output, conv_bias(n), dot, tile_w, tile_h, trans, batch_out);
+    }
+}
+
+static void conv_rvv(struct onnx_node_t *n)
+{
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    if (!pdat->kernel_ready) {
+        // weights bound after GenerateConvParam, transform them once
+        PrepareConvWeights(pdat, n->inputs[1]);
+    }
+    if (pdat->winograd) {
+        conv_wg43_rvv(n);
+    } else if (n->inputs[0]->type == ONNX_TENSOR_TYPE_FLOAT16) {
+        conv_float16_im2col_rvv(n);
+    } else {
+        conv_float32_im2col_rvv(n);
+    }
+}
+
+void Conv_float32_rvv(struct onnx_node_t *n)
+{
+    const struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    if (pdat->buf == NULL) {
+        // parameters generated for the scalar kernel
+        Conv_float32(n);
+        return;
+    }
+    conv_rvv(n);
+}
+
+void Conv_float16_rvv(struct onnx_node_t *n)
+{
+    const struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    if (pdat->buf == NULL) {
+        // parameters generated for the scalar kernel
+        Conv_float16(n);
+        return;
+    }
+    conv_rvv(n);
+}
+#endif /* defined(__riscv_vector) */
+
+void *GenerateConvParam(int32_t stride_w, int32_t stride_h, int32_t dilation_w, int32_t dilation_h, int32_t pad_w, int32_t pad_h,
+                        const struct onnx_tensor_t *input, const struct onnx_tensor_t *filter, const struct onnx_tensor_t *output, _Bool rvv)
+{
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)MALLOC_ASSERT(sizeof(struct operator_pdata_t));
+    pdat->stride.w = stride_w;
+    pdat->stride.h = stride_h;
+    pdat->dilation.w = dilation_w;
+    pdat->dilation.h = dilation_h;
+    pdat->padding.w = pad_w;
+    pdat->padding.h = pad_h;
+    pdat->groups = input->dims[0] / filter->dims[0];
+    pdat->winograd = 0;
+    pdat->buf = NULL;
+    pdat->buf_size = 0;
+    pdat->col = NULL;
+    pdat->kernel_packed = NULL;
+    pdat->kernel_tm = NULL;
+    pdat->kernel_ready = 0;
+
+#if !defined(__riscv_vector)
+    // Conv_*_rvv falls back to the scalar kernel, which needs no buffer
+    rvv = 0;
+#endif
+    if (!rvv) {
+        return pdat;
+    }
+
+    const int32_t in_ch = input->dims[0];
+    const int32_t out_ch = filter->dims[3];
+    pdat->winograd = filter->dims[1] == 3 && filter->dims[2] == 3 && stride_w == 1 && stride_h == 1 && dilation_w == 1 && dilation_h == 1 &&
+                     pdat->groups == 1 && in_ch >= WG43_MIN_CHANNELS && out_ch >= WG43_MIN_CHANNELS;
+    if (pdat->winograd) {
+        /* buffers of wg43 in float32, one after the other
+         * 1. in_tm, the transformed input [36, tiles, C_IN]
+         * 2. the transform buffer of one tile, [6, 6, C_IN] for the input or [4, 6, C_OUT] for the output
+         * 3. kernel_tm, the transformed filter [36, C_IN, C_OUT]
+         * 4. dot, the product of in_tm and kernel_tm [36, tiles, C_OUT]
+         */
+        const int32_t tiles = ((output->dims[1] + WG43_TILE - 1) / WG43_TILE) * ((output->dims[2] + WG43_TILE - 1) / WG43_TILE);
+        const int32_t in_tm_len = 36 * tiles * in_ch;
+        const int32_t trans_len = MAX(36 * in_ch, 24 * out_ch);
+        const int32_t kernel_tm_len = 36 * in_ch * out_ch;
+        const int32_t dot_len = 36 * tiles * out_ch;
+        pdat->buf_size = (in_tm_len + trans_len + kernel_tm_len + dot_len) * sizeof(float32_t);
+        pdat->buf = MALLOC_ASSERT(pdat->buf_size);
+        pdat->kernel_tm = (float32_t *)pdat->buf + in_tm_len + trans_len;
+    } else {
+        // CONV_ROWS im2col rows and the packed filter
+        const size_t esize = onnx_tensor_type_sizeof(input->type);
+        const int32_t rhs_cols = filter->dims[0] * filter->dims[1] * filter->dims[2];
+        pdat->buf_size = (CONV_ROWS * rhs_cols + rhs_cols * out_ch) * esize;
+        pdat->buf = MALLOC_ASSERT(pdat->buf_size);
+        pdat->col = pdat->buf;
+        pdat->kernel_packed = (char *)pdat->buf + CONV_ROWS * rhs_cols * esize;
+    }
+    if (filter->datas != NULL) {
+        PrepareConvWeights(pdat, filter);
+    }
+    return pdat;
+}
+
+int PrepareConvWeights(void *pdat, const struct onnx_tensor_t *filter)
+{
+    struct operator_pdata_t *_pdat = (struct operator_pdata_t *)pdat;
+#if defined(__riscv_vector)
+    if (_pdat->kernel_tm != NULL) {
+        conv_wg43_trans_kernel(filter, _pdat->kernel_tm);
+    } else if (_pdat->kernel_packed != NULL) {
+        conv_pack_kernel(filter, _pdat->groups, _pdat->kernel_packed);
+    }
+#else
+    (void)filter;
+#endif
+    // the scalar kernel reads the filter directly
+    _pdat->kernel_ready = 1;
+    return 0;
+}
+
+void FreeConvParam(void **pdat)
+{
+    struct operator_pdata_t *_pdat = (struct operator_pdata_t *)*pdat;
+    if (_pdat->buf != NULL) {
+        free(_pdat->buf);
+        _pdat->buf = NULL;
+        _pdat->buf_size = 0;
+    }
+    free(*pdat);
+    *pdat = NULL;
+}
@@ -3,6 +3,7 @@
  */
 
 #include "operators.h"
+#include "requantize.h"
 #include "utils.h"
 
 typedef struct {
@@ -20,16 +21,6 @@ typedef struct {
     int32_t max;
 } Activation;
 
-struct riscv_nn_double {
-    uint32_t low;
-    int32_t high;
-};
-
-union riscv_nn_long_long {
-    int64_t long_long;
-    struct riscv_nn_double word;
-};
-
 struct operator_pdata_t {
     Context ctx;
     int32_t input_offset;  /**< The negative of the zero value for the input tensor */
@@ -38,45 +29,36 @@ struct operator_pdata_t {
     Tile padding;
     Tile dilation;
     Activation activation;
+    Activation generate_activation; /**< activation bounds of GenerateConvIntegerParam, the epilogue narrows a copy of them */
+    int32_t groups;
+    _Bool depthwise;       /**< one input channel per output channel, groups == input_ch == output_ch > 1 */
+    _Bool pointwise;       /**< 1x1 filter, stride 1 and no padding, the input is the left hand matrix of the GEMM */
+    enum conv_integer_algo_t algo; /**< Winograd variant of kernel_tm, or CONV_INTEGER_ALGO_IM2COL */
+    int16_t *kernel_tm;    /**< Winograd transform of the 3x3 filter inside ctx.buf, NULL unless the rvv Winograd path is used */
+    int8_t *kernel_packed; /**< filter packed as [groups, rhs_cols, output_ch / groups] inside ctx.buf for the rvv im2col path */
+    _Bool kernel_ready;    /**< kernel_tm or kernel_packed holds the current filter */
+    _Bool fused;           /**< residual or silu epilogue, applied to every requantized output before the store */
+    _Bool silu;            /**< silu_lut maps the output of the epilogue */
+    Activation epilogue_clamp; /**< activation bounds of the epilogue after the residual */
+    const struct onnx_tensor_t *residual; /**< residual of the epilogue, NULL without */
+    int32_t residual_zero_point;
+    int32_t residual_mult;        /**< residual scale / output scale in Q16 */
+    int8_t silu_lut[256];  /**< silu of every int8 output value, indexed by the value + 128 */
 };
 
-#define LEFT_SHIFT(_shift) (_shift > 0 ? _shift : 0)
-#define RIGHT_SHIFT(_shift) (_shift > 0 ? 0 : -_shift)
+#define IM2COL_ROWS (4) // output pixels per block of the rvv im2col path
+#define WG43_ACC_MAX (1 << 25) // bound of the convolution F(4x4,3x3) recovers from the low 26 bits
 
-__STATIC_FORCEINLINE int32_t requantize(const int32_t val, const int32_t multiplier, const int32_t shift)
+// input channels of one chunk of F(4x4,3x3), the convolution of a chunk stays below WG43_ACC_MAX
+static int32_t convolve_3x3_s8_wg43_chunk(int32_t in_offset)
 {
-    int32_t result = 0;
-    union riscv_nn_long_long mult;
-
-    // Rounding offset to add for a right shift of 31
-    mult.word.low = 1 << 30;
-    mult.word.high = 0;
-
-    // Gets resolved as a SMLAL instruction
-    mult.long_long = mult.long_long + (int64_t)(val * (1 << LEFT_SHIFT(shift))) * multiplier;
-
-    // Utilize all of the upper 32 bits. This is the doubling step
-    // as well.
-    result = (int32_t)(mult.long_long >> 31);
-
-    const int32_t remainder_mask = (1 << RIGHT_SHIFT(shift)) - 1;
-    int32_t remainder = remainder_mask & result;
-
-    // Basic division
-    result >>= RIGHT_SHIFT(shift);
-
-    // Adjust 'result' for rounding (mid point away from zero)
-    int32_t threshold = remainder_mask >> 1;
-    if (result < 0) {
-        threshold++;
-    }
-    if (remainder > threshold) {
-        result++;
-    }
-
-    return result;
+    const int32_t in_max = MAX(128 - in_offset, 127 + in_offset);
+    return (WG43_ACC_MAX - 1) / (9 * in_max * 128);
 }
 
+#define EPILOGUE_RESIDUAL_SHIFT (16) // fraction bits of residual_mult
+#define EPILOGUE_RESIDUAL_MAX (64)   // largest residual scale / output scale
+
 static int8_t *mat_mult_kernel_row_offset_s8_s16(const int8_t *input_a, const int16_t *input_b, const uint16_t output_ch, const int32_t *out_shift,
                                                  const int32_t *out_mult, const int32_t out_offset, const int16_t activation_min,
                                                  const int16_t activation_max, const int32_t num_col_a, const int32_t aligned_num_col_a,
@@ -330,7 +312,68 @@ static int8_t *mat_mult_kernel_s8_s16(const int8_t *input_a, const int16_t *inpu
     return out_0;
 }
 
-int ConvInteger(struct onnx_node_t *n)
+/*
+ * Depthwise convolution, each output channel filters its own input channel.
+ * Taps outside of the input read the padding value like the im2col of ConvInteger.
+ */
+static int convolve_s8_depthwise(struct onnx_node_t *n)
+{
+    const struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const struct onnx_tensor_t *input = n->inputs[0];    // shape [batch, input_h, input_w, ch]
+    const struct onnx_tensor_t *filter = n->inputs[1];   // shape [ch, kernel_h, kernel_w, 1]
+    const struct onnx_tensor_t *bias = n->inputs[2];     // shape [ch]
+    const struct onnx_tensor_t *multiply = n->inputs[3]; // shape [ch]
+    const struct onnx_tensor_t *shift = n->inputs[4];    // shape [ch]
+    struct onnx_tensor_t *output = n->outputs[0];        // shape [batch, output_h, output_w, ch]
+
+    const int32_t input_x = input->dims[1];
+    const int32_t input_y = input->dims[2];
+    const int32_t ch = input->dims[0];
+    const int32_t kernel_x = filter->dims[1];
+    const int32_t kernel_y = filter->dims[2];
+    const int32_t output_x = output->dims[1];
+    const int32_t output_y = output->dims[2];
+    const int32_t *bias_data = (const int32_t *)bias->datas;
+    const int32_t *output_mult = (const int32_t *)multiply->datas;
+    const int32_t *output_shift = (const int32_t *)shift->datas;
+    const int8_t *filter_data = (const int8_t *)filter->datas;
+    const int32_t pad_value = (int16_t)(int8_t)-pdat->input_offset + pdat->input_offset;
+
+    for (int32_t batch_idx = 0; batch_idx < input->dims[3]; batch_idx++) {
+        const int8_t *input_data = (const int8_t *)input->datas + input_y * input_x * ch * batch_idx;
+        int8_t *out = (int8_t *)output->datas + output_y * output_x * ch * batch_idx;
+
+        for (int32_t out_y = 0; out_y < output_y; out_y++) {
+            for (int32_t out_x = 0; out_x < output_x; out_x++) {
+                const int32_t base_x = pdat->stride.w * out_x - pdat->padding.w;
+                const int32_t base_y = pdat->stride.h * out_y - pdat->padding.h;
+                for (int32_t c = 0; c < ch; c++) {
+                    const int8_t *ker = filter_data + c * kernel_y * kernel_x;
+                    int32_t sum = bias_data ? bias_data[c] : 0;
+                    for (int32_t ky = 0; ky < kernel_y; ky++) {
+                        const int32_t y = base_y + pdat->dilation.h * ky;
+                        for (int32_t kx = 0; kx < kernel_x; kx++) {
+                            const int32_t x = base_x + pdat->dilation.w * kx;
+                            int32_t in = pad_value;
+                            if (y >= 0 && y < input_y && x >= 0 && x < input_x) {
+                                in = input_data[(y * input_x + x) * ch + c] + pdat->input_offset;
+                            }
+                            sum += in * *ker++;
+                        }
+                    }
+                    sum = requantize(sum, output_mult[c], output_shift[c]);
+                    sum += pdat->output_offset;
+                    sum = MAX(sum, pdat->activation.min);
+                    sum = MIN(sum, pdat->activation.max);
+                    *out++ = (int8_t)sum;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+static int convolve_s8(struct onnx_node_t *n)
 {
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
     struct onnx_tensor_t *input = n->inputs[0];    // shape [batch, input_h, input_w, input_ch]
@@ -380,6 +423,9 @@ int ConvInteger(struct onnx_node_t *n)
     if (input_ch % groups != 0 || output_ch % groups != 0) {
         return -1;
     }
+    if (kernel_ch == 1 && output_ch == input_ch) {
+        return convolve_s8_depthwise(n);
+    }
 
     const int32_t remainder = rhs_cols % 4;
     const int32_t aligned_rhs_cols = remainder != 0 ? rhs_cols + 4 - remainder : rhs_cols;
@@ -499,6 +545,88 @@ int ConvInteger(struct onnx_node_t *n)
     return 0;
 }
 
+// epilogue of the running call, on its stack as the parameters are shared by the calls
+struct convolve_s8_epilogue_t {
+    const struct operator_pdata_t *pdat;
+    const int8_t *residual_data; // output_data[i] gets residual_data[i], NULL without residual
+    const int8_t *output_data;
+};
+
+// bind the residual of the epilogue to the output of the running call
+static int convolve_s8_bind_epilogue(const struct operator_pdata_t *pdat, const struct onnx_tensor_t *output, struct convolve_s8_epilogue_t *ep)
+{
+    ep->pdat = pdat;
+    ep->output_data = (const int8_t *)output->datas;
+    ep->residual_data = NULL;
+    if (pdat->residual != NULL) {
+        if (pdat->residual->type != ONNX_TENSOR_TYPE_INT8 || pdat->residual->ndata != output->ndata) {
+            return -1;
+        }
+        ep->residual_data = (const int8_t *)pdat->residual->datas;
+    }
+    return 0;
+}
+
+// residual, activation bounds and silu table of the epilogue on the requantized output
+static void convolve_s8_epilogue(const struct convolve_s8_epilogue_t *ep, int8_t *out, int32_t len)
+{
+    const struct operator_pdata_t *pdat = ep->pdat;
+    for (int32_t i = 0; i < len; i++) {
+        int32_t val = out[i];
+        if (ep->residual_data != NULL) {
+            const int32_t res = (ep->residual_data[i] - pdat->residual_zero_point) * pdat->residual_mult;
+            val += (res + (1 << (EPILOGUE_RESIDUAL_SHIFT - 1))) >> EPILOGUE_RESIDUAL_SHIFT;
+        }
+        val = MAX(val, pdat->epilogue_clamp.min);
+        val = MIN(val, pdat->epilogue_clamp.max);
+        out[i] = pdat->silu ? pdat->silu_lut[val + 128] : (int8_t)val;
+    }
+}
+
+int ConvInteger(struct onnx_node_t *n)
+{
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    struct onnx_tensor_t *output = n->outputs[0];
+    struct convolve_s8_epilogue_t ep;
+    int status = convolve_s8_bind_epilogue(pdat, output, &ep);
+    if (status == 0) {
+        status = convolve_s8(n);
+    }
+    if (status == 0 && pdat->fused) {
+        // the scalar kernels are the reference, the epilogue runs over their output
+        convolve_s8_epilogue(&ep, (int8_t *)output->datas, output->ndata);
+    }
+    return status;
+}
+
+#if defined(__riscv_vector)
+// same as convolve_s8_epilogue on out[0, vl) while it is still in registers, then store it
+__STATIC_FORCEINLINE void convolve_s8_store_i8m1(const struct convolve_s8_epilogue_t *ep, int8_t *out, vint8m1_t val, size_t vl)
+{
+    const struct operator_pdata_t *pdat = ep->pdat;
+    if (pdat->fused) {
+        if (ep->residual_data != NULL) {
+            const int8_t *residual = ep->residual_data + (out - ep->output_data);
+            vint16m2_t res16 = __riscv_vwsub_vx_i16m2(__riscv_vle8_v_i8m1(residual, vl), pdat->residual_zero_point, vl);
+            vint32m4_t res = __riscv_vmul_vx_i32m4(__riscv_vsext_vf2_i32m4(res16, vl), pdat->residual_mult, vl);
+            // vssra rounds half up like the scalar epilogue
+            res = __riscv_vssra_vx_i32m4(res, EPILOGUE_RESIDUAL_SHIFT, __RISCV_VXRM_RNU, vl);
+            res = __riscv_vadd_vv_i32m4(res, __riscv_vsext_vf4_i32m4(val, vl), vl);
+            res = __riscv_vmax_vx_i32m4(res, pdat->epilogue_clamp.min, vl);
+            res = __riscv_vmin_vx_i32m4(res, pdat->epilogue_clamp.max, vl);
+            val = __riscv_vncvt_x_x_w_i8m1(__riscv_vncvt_x_x_w_i16m2(res, vl), vl);
+        } else {
+            val = __riscv_vmax_vx_i8m1(val, pdat->epilogue_clamp.min, vl);
+            val = __riscv_vmin_vx_i8m1(val, pdat->epilogue_clamp.max, vl);
+        }
+        if (pdat->silu) {
+            vuint8m1_t idx = __riscv_vxor_vx_u8m1(__riscv_vreinterpret_v_i8m1_u8m1(val), 0x80, vl);
+            val = __riscv_vluxei8_v_i8m1(pdat->silu_lut, idx, vl);
+        }
+    }
+    __riscv_vse8_v_i8m1(out, val, vl);
+}
+
 static int convolve_3x3_s8_wg23_pad_input(const int *input_dims, int32_t pad_w, int32_t pad_h, int8_t input_offset, const int8_t *input_data,
                                           const Tile *output_shape, int8_t *in_pad)
 {
@@ -740,7 +868,7 @@ static void trans_input_col_op(const int16_t *buffer, int32_t c_in, int16_t *res
     }
 }
 
-static int32_t convolve_3x3_s8_wg23_trans_input(const int32_t *input_dims, const int8_t *input_data, int16_t *in_tm)
+static int32_t convolve_3x3_s8_wg23_trans_input(const int32_t *input_dims, const int8_t *input_data, int32_t input_offset, int16_t *in_tm)
 {
     // transform input [1, H, W, C_IN] to [1, tiles, C_IN, 16]
     // input_dims->n is not used and assumed to be 1
@@ -770,18 +898,45 @@ static int32_t convolve_3x3_s8_wg23_trans_input(const int32_t *input_dims, const
 
             int16_t *result = in_tm + tile_idx * c_in * 16;
             trans_input_col_op(buffer, c_in, result);
+
+            // B^T d B of a tile of input_offset is 4 * input_offset at (1, 1), zero elsewhere
+            if (input_offset != 0) {
+                int16_t *d11 = result + 5;
+                size_t avl = c_in, vl;
+                for (; (vl = __riscv_vsetvl_e16m2(avl)) > 0; avl -= vl, d11 += 16 * vl) {
+                    vint16m2_t v = __riscv_vlse16_v_i16m2(d11, 16 * sizeof(int16_t), vl);
+                    __riscv_vsse16_v_i16m2(d11, 16 * sizeof(int16_t), __riscv_vadd_vx_i16m2(v, 4 * input_offset, vl), vl);
+                }
+            }
         }
     }
 
     return 0;
 }
 
+// -1 when the shapes of riscv_convolve_3x3_s8_wg23_dot don't agree
+static int32_t convolve_3x3_s8_wg23_dot_check(const int32_t *in_tm_dims, const int16_t *in_tm, const int32_t *kernel_tm_dims,
+                                              const int16_t *kernel_tm, const int *dot_dims, const int32_t *dot)
+{
+    if (in_tm == NULL || kernel_tm == NULL || dot == NULL) {
+        return -1;
+    }
+    if (in_tm_dims[0] != 16 || kernel_tm_dims[0] != 16 || dot_dims[0] != 16 || in_tm_dims[1] != kernel_tm_dims[1] ||
+        dot_dims[1] != kernel_tm_dims[2] || dot_dims[2] != in_tm_dims[2] || in_tm_dims[1] <= 0 || in_tm_dims[2] < 0) {
+        return -1;
+    }
+    return 0;
+}
+
 static int32_t riscv_convolve_3x3_s8_wg23_dot(const int32_t *in_tm_dims, const int16_t *in_tm, const int32_t *kernel_tm_dims,
                                               const int16_t *kernel_tm, const int *dot_dims, int32_t *dot)
 {
     // shape of in_tm is [N, H, W, C] = [1, tiles, C_IN, 16]
     // shape of kernel_tm is [N, H, W, C] = [1, C_OUT, C_IN, 16]
     // shape of dot is [N, H, W, C] = [1, tiles, C_OUT, 16]
+    if (convolve_3x3_s8_wg23_dot_check(in_tm_dims, in_tm, kernel_tm_dims, kernel_tm, dot_dims, dot) != 0) {
+        return -1;
+    }
     const int32_t in_ch = in_tm_dims[1];
     const int32_t out_ch = kernel_tm_dims[2];
     const int32_t tiles = in_tm_dims[2];
@@ -902,6 +1057,28 @@ static int32_t riscv_convolve_3x3_s8_wg23_dot(const int32_t *in_tm_dims, const i
     return 0;
 }
 
+struct wg23_dot_args_t {
+    const int32_t *in_tm_dims;
+    const int16_t *in_tm;
+    const int32_t *kernel_tm_dims;
+    const int16_t *kernel_tm;
+    const int *dot_dims;
+    int32_t *dot;
+};
+
+// dot product of tiles [start, end), run on several harts by onnx_parallel_for after convolve_3x3_s8_wg23_dot_check
+static void convolve_3x3_s8_wg23_dot_tiles(void *arg, int start, int end)
+{
+    const struct wg23_dot_args_t *args = (const struct wg23_dot_args_t *)arg;
+    const int32_t in_ch = args->in_tm_dims[1];
+    const int32_t out_ch = args->dot_dims[1];
+    const int32_t in_tm_dims[4] = {16, in_ch, end - start, 1};
+    const int dot_dims[4] = {16, out_ch, end - start, 1};
+
+    riscv_convolve_3x3_s8_wg23_dot(in_tm_dims, args->in_tm + start * in_ch * 16, args->kernel_tm_dims, args->kernel_tm, dot_dims,
+                                   args->dot + start * out_ch * 16);
+}
+
 // input is [1, tiles, C_OUT, 16]
 // output is [1, tiles×C_OUT, 8, 1]
 // multiply with left hand matrix
@@ -1058,10 +1235,11 @@ static void trans_output_col_op(int32_t tiles, int32_t out_ch, const int32_t *bu
     }
 }
 
-static int32_t convolve_3x3_s8_wg23_trans_output(const Tile *output_shape, const int32_t out_offset, const int32_t out_activation_min,
-                                                 const int32_t out_activation_max, const int *dot_dims, const int32_t *dot,
-                                                 const int32_t *output_mult_ptr, const int32_t *output_shift_ptr, const int *bias_dims,
-                                                 const int32_t *bias_data, const int *output_dims, int32_t *buffer, int8_t *output_data)
+static int32_t convolve_3x3_s8_wg23_trans_output(const struct convolve_s8_epilogue_t *ep, const Tile *output_shape, const int32_t out_offset,
+                                                 const int32_t out_activation_min, const int32_t out_activation_max, const int *dot_dims,
+                                                 const int32_t *dot, const int32_t *output_mult_ptr, const int32_t *output_shift_ptr,
+                                                 const int *bias_dims, const int32_t *bias_data, const int *output_dims, int32_t *buffer,
+                                                 int8_t *output_data)
 {
     // output_dims->n is not used and assumed to be 1
     // shape of dot is [N, H, W, C] = [1, tiles, C_OUT, 16]
@@ -1096,76 +1274,48 @@ static int32_t convolve_3x3_s8_wg23_trans_output(const Tile *output_shape, const
             int8_t *out11 = output_data + ((h_idx * 2 + 1) * output_dims[1] + w_idx * 2 + 1) * out_ch;
 
             size_t avl = out_ch, vl;
-            const int32_t *bias_ptr = bias_data_ptr;
-            for (; (vl = __riscv_vsetvl_e32m4(avl)) > 0; avl -= vl) {
+            for (int32_t oc = 0; (vl = __riscv_vsetvl_e32m4(avl)) > 0; avl -= vl, oc += vl) {
                 vint32m4_t d00 = __riscv_vlse32_v_i32m4(tile_base, bstride, vl);
                 vint32m4_t d01 = __riscv_vlse32_v_i32m4(tile_base + 1, bstride, vl);
                 vint32m4_t d10 = __riscv_vlse32_v_i32m4(tile_base + 2, bstride, vl);
                 vint32m4_t d11 = __riscv_vlse32_v_i32m4(tile_base + 3, bstride, vl);
                 tile_base += 4 * vl;
 
+                // the transforms scale the dot product by exactly 4, divide it back before the bias like wg43
+                d00 = __riscv_vsra_vx_i32m4(d00, 2, vl);
+                d01 = __riscv_vsra_vx_i32m4(d01, 2, vl);
+                d10 = __riscv_vsra_vx_i32m4(d10, 2, vl);
+                d11 = __riscv_vsra_vx_i32m4(d11, 2, vl);
+
                 // add bias
-                {
-                    vint32m4_t v_bias = __riscv_vle32_v_i32m4(bias_ptr, vl);
-                    bias_ptr += vl;
+                if (bias_data_ptr) {
+                    vint32m4_t v_bias = __riscv_vle32_v_i32m4(bias_data_ptr + oc, vl);
                     d00 = __riscv_vadd_vv_i32m4(d00, v_bias, vl);
                     d01 = __riscv_vadd_vv_i32m4(d01, v_bias, vl);
                     d10 = __riscv_vadd_vv_i32m4(d10, v_bias, vl);
                     d11 = __riscv_vadd_vv_i32m4(d11, v_bias, vl);
                 }
 
-                vint32m4_t shift = __riscv_vsub_vx_i32m4(__riscv_vle32_v_i32m4(output_shift_ptr, vl), 2, vl);
-                {
-                    // left shift
-                    vuint32m4_t left_shift = __riscv_vreinterpret_v_i32m4_u32m4(__riscv_vmax_vx_i32m4(shift, 0, vl));
-                    d00 = __riscv_vsll_vv_i32m4(d00, left_shift, vl);
-                    d01 = __riscv_vsll_vv_i32m4(d01, left_shift, vl);
-                    d10 = __riscv_vsll_vv_i32m4(d10, left_shift, vl);
-                    d11 = __riscv_vsll_vv_i32m4(d11, left_shift, vl);
-                }
-
-                // requantize multiply
-                {
-                    vint32m4_t mult = __riscv_vle32_v_i32m4(output_mult_ptr, vl);
-                    d00 = __riscv_vsmul_vv_i32m4(d00, mult, __RISCV_VXRM_RNU, vl);
-                    d01 = __riscv_vsmul_vv_i32m4(d01, mult, __RISCV_VXRM_RNU, vl);
-                    d10 = __riscv_vsmul_vv_i32m4(d10, mult, __RISCV_VXRM_RNU, vl);
-                    d11 = __riscv_vsmul_vv_i32m4(d11, mult, __RISCV_VXRM_RNU, vl);
-                }
-
-                {
-                    // right shift
-                    vuint32m4_t right_shift = __riscv_vreinterpret_v_i32m4_u32m4(__riscv_vneg_v_i32m4(__riscv_vmin_vx_i32m4(shift, 0, vl), vl));
-                    d00 = __riscv_vssra_vv_i32m4(d00, right_shift, __RISCV_VXRM_RNU, vl);
-                    d01 = __riscv_vssra_vv_i32m4(d01, right_shift, __RISCV_VXRM_RNU, vl);
-                    d10 = __riscv_vssra_vv_i32m4(d10, right_shift, __RISCV_VXRM_RNU, vl);
-                    d11 = __riscv_vssra_vv_i32m4(d11, right_shift, __RISCV_VXRM_RNU, vl);
-                }
-
-                d00 = __riscv_vadd_vx_i32m4(d00, out_offset, vl);
-                d01 = __riscv_vadd_vx_i32m4(d01, out_offset, vl);
-                d10 = __riscv_vadd_vx_i32m4(d10, out_offset, vl);
-                d11 = __riscv_vadd_vx_i32m4(d11, out_offset, vl);
-
-                // clip result
-                vint8m1_t d00_i8 = __riscv_vnclip_wx_i8m1(__riscv_vnclip_wx_i16m2(d00, 0, __RISCV_VXRM_RNU, vl), 0, __RISCV_VXRM_RNU, vl);
-                vint8m1_t d01_i8 = __riscv_vnclip_wx_i8m1(__riscv_vnclip_wx_i16m2(d01, 0, __RISCV_VXRM_RNU, vl), 0, __RISCV_VXRM_RNU, vl);
-                vint8m1_t d10_i8 = __riscv_vnclip_wx_i8m1(__riscv_vnclip_wx_i16m2(d10, 0, __RISCV_VXRM_RNU, vl), 0, __RISCV_VXRM_RNU, vl);
-                vint8m1_t d11_i8 = __riscv_vnclip_wx_i8m1(__riscv_vnclip_wx_i16m2(d11, 0, __RISCV_VXRM_RNU, vl), 0, __RISCV_VXRM_RNU, vl);
+                vint32m4_t mult = __riscv_vle32_v_i32m4(output_mult_ptr + oc, vl);
+                vint32m4_t shift = __riscv_vle32_v_i32m4(output_shift_ptr + oc, vl);
+                vint8m1_t d00_i8 = requantize_i32m4(d00, mult, shift, out_offset, out_activation_min, out_activation_max, vl);
+                vint8m1_t d01_i8 = requantize_i32m4(d01, mult, shift, out_offset, out_activation_min, out_activation_max, vl);
+                vint8m1_t d10_i8 = requantize_i32m4(d10, mult, shift, out_offset, out_activation_min, out_activation_max, vl);
+                vint8m1_t d11_i8 = requantize_i32m4(d11, mult, shift, out_offset, out_activation_min, out_activation_max, vl);
 
                 // store result
-                __riscv_vse8_v_i8m1(out00, d00_i8, vl);
+                convolve_s8_store_i8m1(ep, out00, d00_i8, vl);
                 out00 += vl;
                 if (w_valid) {
-                    __riscv_vse8_v_i8m1(out01, d01_i8, vl);
+                    convolve_s8_store_i8m1(ep, out01, d01_i8, vl);
                     out01 += vl;
                 }
                 if (h_valid) {
-                    __riscv_vse8_v_i8m1(out10, d10_i8, vl);
+                    convolve_s8_store_i8m1(ep, out10, d10_i8, vl);
                     out10 += vl;
                 }
                 if (w_valid && h_valid) {
-                    __riscv_vse8_v_i8m1(out11, d11_i8, vl);
+                    convolve_s8_store_i8m1(ep, out11, d11_i8, vl);
                     out11 += vl;
                 }
             }
@@ -1174,13 +1324,699 @@ static int32_t convolve_3x3_s8_wg23_trans_output(const Tile *output_shape, const
     return 0;
 }
 
-int ConvInteger_rvv(struct onnx_node_t *n)
+// filter [output_ch, kernel_h, kernel_w, kernel_ch] to [groups, rhs_cols, output_ch / groups], output channels are contiguous
+static void convolve_s8_pack_kernel(const int *kernel_dims, int32_t groups, const int8_t *kernel_data, int8_t *kernel_packed)
+{
+    const int32_t rhs_cols = kernel_dims[0] * kernel_dims[1] * kernel_dims[2];
+    const int32_t out_ch = kernel_dims[3] / groups;
+
+    for (int32_t g = 0; g < groups; g++) {
+        const int8_t *kernel = kernel_data + g * out_ch * rhs_cols;
+        for (int32_t k = 0; k < rhs_cols; k++) {
+            size_t avl = out_ch, vl;
+            const int8_t *src = kernel + k;
+            for (; (vl = __riscv_vsetvl_e8m1(avl)) > 0; avl -= vl) {
+                __riscv_vse8_v_i8m1(kernel_packed, __riscv_vlse8_v_i8m1(src, rhs_cols * sizeof(int8_t), vl), vl);
+                src += vl * rhs_cols;
+                kernel_packed += vl;
+            }
+        }
+    }
+}
+
+// one im2col row of output pixel (out_x, out_y) with input_offset added, out of bounds taps read as padding
+static void convolve_s8_im2col_row(const int8_t *input_data, const int *input_dims, const int *kernel_dims, int32_t group,
+                                   const struct operator_pdata_t *pdat, int32_t out_x, int32_t out_y, int16_t *col)
+{
+    const int32_t input_x = input_dims[1];
+    const int32_t input_y = input_dims[2];
+    const int32_t input_ch = input_dims[0];
+    const int32_t kernel_ch = kernel_dims[0];
+    const int32_t base_x = pdat->stride.w * out_x - pdat->padding.w;
+    const int32_t base_y = pdat->stride.h * out_y - pdat->padding.h;
+    const int16_t pad_value = (int16_t)(int8_t)-pdat->input_offset + pdat->input_offset;
+    size_t avl, vl;
+
+    for (int32_t ky = 0; ky < kernel_dims[2]; ky++) {
+        for (int32_t kx = 0; kx < kernel_dims[1]; kx++) {
+            const int32_t y = base_y + pdat->dilation.h * ky;
+            const int32_t x = base_x + pdat->dilation.w * kx;
+            if (y < 0 || y >= input_y || x < 0 || x >= input_x) {
+                avl = kernel_ch;
+                for (int16_t *dst = col; (vl = __riscv_vsetvl_e16m2(avl)) > 0; avl -= vl) {
+                    __riscv_vse16_v_i16m2(dst, __riscv_vmv_v_x_i16m2(pad_value, vl), vl);
+                    dst += vl;
+                }
+            } else {
+                const int8_t *src = input_data + (y * input_x + x) * input_ch + group * kernel_ch;
+                avl = kernel_ch;
+                for (int16_t *dst = col; (vl = __riscv_vsetvl_e8m1(avl)) > 0; avl -= vl) {
+                    vint16m2_t v = __riscv_vsext_vf2_i16m2(__riscv_vle8_v_i8m1(src, vl), vl);
+                    __riscv_vse16_v_i16m2(dst, __riscv_vadd_vx_i16m2(v, pdat->input_offset, vl), vl);
+                    src += vl;
+                    dst += vl;
+                }
+            }
+            col += kernel_ch;
+        }
+    }
+}
+
+struct pointwise_args_t {
+    const struct onnx_node_t *n;
+    const struct convolve_s8_epilogue_t *ep;
+};
+
+// pixel blocks [start, end) of the pointwise GEMM, run on several harts by onnx_parallel_for
+static void convolve_s8_pointwise_blocks(void *arg, int start, int end)
+{
+    const struct pointwise_args_t *args = (const struct pointwise_args_t *)arg;
+    const struct onnx_node_t *n = args->n;
+    const struct convolve_s8_epilogue_t *ep = args->ep;
+    const struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const struct onnx_tensor_t *input = n->inputs[0];
+    const struct onnx_tensor_t *bias = n->inputs[2];
+    const struct onnx_tensor_t *multiply = n->inputs[3];
+    const struct onnx_tensor_t *shift = n->inputs[4];
+    struct onnx_tensor_t *output = n->outputs[0];
+
+    const int32_t in_ch = input->dims[0];
+    const int32_t out_ch = output->dims[0];
+    const int32_t pixels = output->ndata / out_ch;
+    const int32_t *bias_data = (const int32_t *)bias->datas;
+    const int16_t in_offset = pdat->input_offset;
+    const int32_t out_offset = pdat->output_offset;
+    const int32_t act_min = pdat->activation.min;
+    const int32_t act_max = pdat->activation.max;
+
+    for (int32_t p = start * IM2COL_ROWS; p < MIN(end * IM2COL_ROWS, pixels); p += IM2COL_ROWS) {
+        const int32_t rows = MIN(IM2COL_ROWS, pixels - p);
+        // rows past the last pixel repeat row 0, their results are dropped
+        const int8_t *in0 = (const int8_t *)input->datas + p * in_ch;
+        const int8_t *in1 = rows > 1 ? in0 + in_ch : in0;
+        const int8_t *in2 = rows > 2 ? in0 + 2 * in_ch : in0;
+        const int8_t *in3 = rows > 3 ? in0 + 3 * in_ch : in0;
+        int8_t *out = (int8_t *)output->datas + p * out_ch;
+
+        size_t avl = out_ch, vl;
+        for (int32_t oc = 0; (vl = __riscv_vsetvl_e32m4(avl)) > 0; avl -= vl, oc += vl) {
+            vint32m4_t acc0;
+            if (bias_data) {
+                acc0 = __riscv_vle32_v_i32m4(bias_data + oc, vl);
+            } else {
+                acc0 = __riscv_vmv_v_x_i32m4(0, vl);
+            }
+            vint32m4_t acc1 = acc0;
+            vint32m4_t acc2 = acc0;
+            vint32m4_t acc3 = acc0;
+            const int8_t *pk = pdat->kernel_packed + oc;
+            for (int32_t k = 0; k < in_ch; k++) {
+                vint16m2_t w = __riscv_vsext_vf2_i16m2(__riscv_vle8_v_i8m1(pk, vl), vl);
+                pk += out_ch;
+                acc0 = __riscv_vwmacc_vx_i32m4(acc0, in0[k] + in_offset, w, vl);
+                acc1 = __riscv_vwmacc_vx_i32m4(acc1, in1[k] + in_offset, w, vl);
+                acc2 = __riscv_vwmacc_vx_i32m4(acc2, in2[k] + in_offset, w, vl);
+                acc3 = __riscv_vwmacc_vx_i32m4(acc3, in3[k] + in_offset, w, vl);
+            }
+
+            vint32m4_t mult = __riscv_vle32_v_i32m4((const int32_t *)multiply->datas + oc, vl);
+            vint32m4_t sft = __riscv_vle32_v_i32m4((const int32_t *)shift->datas + oc, vl);
+            convolve_s8_store_i8m1(ep, out + oc, requantize_i32m4(acc0, mult, sft, out_offset, act_min, act_max, vl), vl);
+            if (rows > 1) {
+                convolve_s8_store_i8m1(ep, out + out_ch + oc, requantize_i32m4(acc1, mult, sft, out_offset, act_min, act_max, vl), vl);
+            }
+            if (rows > 2) {
+                convolve_s8_store_i8m1(ep, out + 2 * out_ch + oc, requantize_i32m4(acc2, mult, sft, out_offset, act_min, act_max, vl), vl);
+            }
+            if (rows > 3) {
+                convolve_s8_store_i8m1(ep, out + 3 * out_ch + oc, requantize_i32m4(acc3, mult, sft, out_offset, act_min, act_max, vl), vl);
+            }
+        }
+    }
+}
+
+/*
+ * 1x1 filter with stride 1 and no padding: the NHWC input of all batches is
+ * already the [pixels, input_ch] left hand matrix, it is multiplied with the
+ * packed filter without im2col copy.
+ */
+static int convolve_s8_pointwise_rvv(struct onnx_node_t *n, const struct convolve_s8_epilogue_t *ep)
+{
+    const struct onnx_tensor_t *input = n->inputs[0];
+    const struct onnx_tensor_t *filter = n->inputs[1];
+    const struct onnx_tensor_t *output = n->outputs[0];
+    const int32_t pixels = output->ndata / output->dims[0];
+
+    if (input->dims[0] != filter->dims[0] || input->ndata / input->dims[0] != (size_t)pixels) {
+        return -1;
+    }
+    struct pointwise_args_t args = {n, ep};
+    onnx_parallel_for((pixels + IM2COL_ROWS - 1) / IM2COL_ROWS, 1, convolve_s8_pointwise_blocks, &args);
+    return 0;
+}
+
+/*
+ * Depthwise convolution vectorized across the channels of the NHWC layout,
+ * the filter is packed to [kernel_h, kernel_w, ch] so every tap loads a
+ * contiguous weight vector.
+ */
+static int convolve_s8_depthwise_rvv(struct onnx_node_t *n, const struct convolve_s8_epilogue_t *ep)
+{
+    const struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const struct onnx_tensor_t *input = n->inputs[0];    // shape [batch, input_h, input_w, ch]
+    const struct onnx_tensor_t *filter = n->inputs[1];   // shape [ch, kernel_h, kernel_w, 1]
+    const struct onnx_tensor_t *bias = n->inputs[2];     // shape [ch]
+    const struct onnx_tensor_t *multiply = n->inputs[3]; // shape [ch]
+    const struct onnx_tensor_t *shift = n->inputs[4];    // shape [ch]
+    struct onnx_tensor_t *output = n->outputs[0];        // shape [batch, output_h, output_w, ch]
+
+    const int32_t input_x = input->dims[1];
+    const int32_t input_y = input->dims[2];
+    const int32_t ch = input->dims[0];
+    const int32_t kernel_x = filter->dims[1];
+    const int32_t kernel_y = filter->dims[2];
+    const int32_t output_x = output->dims[1];
+    const int32_t output_y = output->dims[2];
+    const int32_t *bias_data = (const int32_t *)bias->datas;
+    const int32_t out_offset = pdat->output_offset;
+    const int32_t act_min = pdat->activation.min;
+    const int32_t act_max = pdat->activation.max;
+    const int16_t pad_value = (int16_t)(int8_t)-pdat->input_offset + pdat->input_offset;
+
+    for (int32_t batch_idx = 0; batch_idx < input->dims[3]; batch_idx++) {
+        const int8_t *input_data = (const int8_t *)input->datas + input_y * input_x * ch * batch_idx;
+        int8_t *output_data = (int8_t *)output->datas + output_y * output_x * ch * batch_idx;
+
+        for (int32_t out_y = 0; out_y < output_y; out_y++) {
+            for (int32_t out_x = 0; out_x < output_x; out_x++) {
+                const int32_t base_x = pdat->stride.w * out_x - pdat->padding.w;
+                const int32_t base_y = pdat->stride.h * out_y - pdat->padding.h;
+                int8_t *out = output_data + (out_y * output_x + out_x) * ch;
+
+                size_t avl = ch, vl;
+                for (int32_t c = 0; (vl = __riscv_vsetvl_e32m4(avl)) > 0; avl -= vl, c += vl) {
+                    vint32m4_t acc;
+                    if (bias_data) {
+                        acc = __riscv_vle32_v_i32m4(bias_data + c, vl);
+                    } else {
+                        acc = __riscv_vmv_v_x_i32m4(0, vl);
+                    }
+                    const int8_t *pk = pdat->kernel_packed + c;
+                    for (int32_t ky = 0; ky < kernel_y; ky++) {
+                        const int32_t y = base_y + pdat->dilation.h * ky;
+                        for (int32_t kx = 0; kx < kernel_x; kx++, pk += ch) {
+                            const int32_t x = base_x + pdat->dilation.w * kx;
+                            vint16m2_t w = __riscv_vsext_vf2_i16m2(__riscv_vle8_v_i8m1(pk, vl), vl);
+                            if (y < 0 || y >= input_y || x < 0 || x >= input_x) {
+                                if (pad_value != 0) {
+                                    acc = __riscv_vwmacc_vx_i32m4(acc, pad_value, w, vl);
+                                }
+                                continue;
+                            }
+                            vint16m2_t in = __riscv_vsext_vf2_i16m2(__riscv_vle8_v_i8m1(input_data + (y * input_x + x) * ch + c, vl), vl);
+                            in = __riscv_vadd_vx_i16m2(in, pdat->input_offset, vl);
+                            acc = __riscv_vwmacc_vv_i32m4(acc, in, w, vl);
+                        }
+                    }
+                    vint32m4_t mult = __riscv_vle32_v_i32m4((const int32_t *)multiply->datas + c, vl);
+                    vint32m4_t sft = __riscv_vle32_v_i32m4((const int32_t *)shift->datas + c, vl);
+                    convolve_s8_store_i8m1(ep, out + c, requantize_i32m4(acc, mult, sft, out_offset, act_min, act_max, vl), vl);
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * Any kernel size, stride, dilation and group count: IM2COL_ROWS output pixels
+ * are unrolled into int16 rows, then multiplied with the packed filter along the
+ * output channels, every filter row loaded feeds IM2COL_ROWS accumulators.
+ */
+static int convolve_s8_im2col_rvv(struct onnx_node_t *n, const struct convolve_s8_epilogue_t *ep)
 {
     const struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
-    if (pdat->stride.w != 1 || pdat->stride.h != 1 || pdat->ctx.buf == NULL || pdat->dilation.h != 1 || pdat->dilation.w != 1) {
+    const struct onnx_tensor_t *input = n->inputs[0];    // shape [batch, input_h, input_w, input_ch]
+    const struct onnx_tensor_t *filter = n->inputs[1];   // shape [output_ch, kernel_h, kernel_w, input_ch / groups]
+    const struct onnx_tensor_t *bias = n->inputs[2];     // shape [output_ch]
+    const struct onnx_tensor_t *multiply = n->inputs[3]; // shape [output_ch]
+    const struct onnx_tensor_t *shift = n->inputs[4];    // shape [output_ch]
+    struct onnx_tensor_t *output = n->outputs[0];        // shape [batch, output_h, output_w, output_ch]
+
+    const int32_t groups = pdat->groups;
+    const int32_t rhs_cols = filter->dims[0] * filter->dims[1] * filter->dims[2];
+    const int32_t output_x = output->dims[1];
+    const int32_t output_y = output->dims[2];
+    const int32_t output_ch = output->dims[0];
+    const int32_t out_ch = output_ch / groups;
+    const int32_t pixels = output_x * output_y;
+    const int32_t *bias_data = (const int32_t *)bias->datas;
+    const int32_t out_offset = pdat->output_offset;
+    const int32_t act_min = pdat->activation.min;
+    const int32_t act_max = pdat->activation.max;
+    int16_t *col = (int16_t *)pdat->ctx.buf;
+
+    if (input->dims[0] != filter->dims[0] * groups || output_ch % groups != 0) {
         return -1;
     }
+
+    for (int32_t batch_idx = 0; batch_idx < input->dims[3]; batch_idx++) {
+        const int8_t *input_data = (const int8_t *)input->datas + input->dims[2] * input->dims[1] * input->dims[0] * batch_idx;
+        int8_t *output_data = (int8_t *)output->datas + pixels * output_ch * batch_idx;
+
+        for (int32_t g = 0; g < groups; g++) {
+            const int8_t *kernel = pdat->kernel_packed + g * rhs_cols * out_ch;
+            for (int32_t p = 0; p < pixels; p += IM2COL_ROWS) {
+                const int32_t rows = MIN(IM2COL_ROWS, pixels - p);
+                for (int32_t r = 0; r < rows; r++) {
+                    convolve_s8_im2col_row(input_data, input->dims, filter->dims, g, pdat, (p + r) % output_x, (p + r) / output_x,
+                                           col + r * rhs_cols);
+                }
+                // rows past the last pixel repeat row 0, their results are dropped
+                const int16_t *col0 = col;
+                const int16_t *col1 = rows > 1 ? col + rhs_cols : col;
+                const int16_t *col2 = rows > 2 ? col + 2 * rhs_cols : col;
+                const int16_t *col3 = rows > 3 ? col + 3 * rhs_cols : col;
+                int8_t *out = output_data + p * output_ch + g * out_ch;
+
+                size_t avl = out_ch, vl;
+                for (int32_t oc = 0; (vl = __riscv_vsetvl_e32m4(avl)) > 0; avl -= vl, oc += vl) {
+                    const int32_t ch = g * out_ch + oc;
+                    vint32m4_t acc0;
+                    if (bias_data) {
+                        acc0 = __riscv_vle32_v_i32m4(bias_data + ch, vl);
+                    } else {
+                        acc0 = __riscv_vmv_v_x_i32m4(0, vl);
+                    }
+                    vint32m4_t acc1 = acc0;
+                    vint32m4_t acc2 = acc0;
+                    vint32m4_t acc3 = acc0;
+                    const int8_t *pk = kernel + oc;
+                    for (int32_t k = 0; k < rhs_cols; k++) {
+                        vint16m2_t w = __riscv_vsext_vf2_i16m2(__riscv_vle8_v_i8m1(pk, vl), vl);
+                        pk += out_ch;
+                        acc0 = __riscv_vwmacc_vx_i32m4(acc0, col0[k], w, vl);
+                        acc1 = __riscv_vwmacc_vx_i32m4(acc1, col1[k], w, vl);
+                        acc2 = __riscv_vwmacc_vx_i32m4(acc2, col2[k], w, vl);
+                        acc3 = __riscv_vwmacc_vx_i32m4(acc3, col3[k], w, vl);
+                    }
+
+                    vint32m4_t mult = __riscv_vle32_v_i32m4((const int32_t *)multiply->datas + ch, vl);
+                    vint32m4_t sft = __riscv_vle32_v_i32m4((const int32_t *)shift->datas + ch, vl);
+                    convolve_s8_store_i8m1(ep, out + oc, requantize_i32m4(acc0, mult, sft, out_offset, act_min, act_max, vl), vl);
+                    if (rows > 1) {
+                        convolve_s8_store_i8m1(ep, out + output_ch + oc, requantize_i32m4(acc1, mult, sft, out_offset, act_min, act_max, vl), vl);
+                    }
+                    if (rows > 2) {
+                        convolve_s8_store_i8m1(ep, out + 2 * output_ch + oc, requantize_i32m4(acc2, mult, sft, out_offset, act_min, act_max, vl),
+                                               vl);
+                    }
+                    if (rows > 3) {
+                        convolve_s8_store_i8m1(ep, out + 3 * output_ch + oc, requantize_i32m4(acc3, mult, sft, out_offset, act_min, act_max, vl),
+                                               vl);
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * Winograd F(4x4,3x3): 6x6 input tiles give 4x4 output tiles with 36 instead
+ * of 144 multiplies per input/output channel pair, the 36 positions of the
+ * transformed tiles are independent [tiles, in_ch] x [in_ch, out_ch] GEMMs.
+ * The filter transform is scaled by 24 per side, its last row by 6 only to
+ * stay in int16, and the output transform scales the last row back, so the
+ * result is exactly 576 times the convolution modulo 2^32, all sums wrap in
+ * int32. 576 = 64 * 9, so the low 26 bits of the convolution are recovered
+ * with a shift and the inverse of 9, which is exact while its magnitude stays
+ * below 2^25. Wider layers sum the recovered results of chunks of input
+ * channels that each stay below it.
+ */
+#define WG43_TILE (4)
+#define WG43_DOT_ROWS (4)        // tiles per block of the dot product
+#define WG43_INV9 (0x38e38e39)   // inverse of 9 modulo 2^32
+
+// the convolution from 576 times it modulo 2^32
+__STATIC_FORCEINLINE vint32m4_t wg43_recover_i32m4(vint32m4_t acc, size_t vl)
+{
+    acc = __riscv_vmul_vx_i32m4(__riscv_vsra_vx_i32m4(acc, 6, vl), WG43_INV9, vl);
+    return __riscv_vsra_vx_i32m4(__riscv_vsll_vx_i32m4(acc, 6, vl), 6, vl);
+}
+
+// G' = [ 6,  0,  0]
+//      [-4, -4, -4]
+//      [-4,  4, -4]
+//      [ 1,  2,  4]
+//      [ 1, -2,  4]
+//      [ 0,  0,  6]
+static const int16_t wg43_ktm[6][3] = {{6, 0, 0}, {-4, -4, -4}, {-4, 4, -4}, {1, 2, 4}, {1, -2, 4}, {0, 0, 6}};
+
+// kernel_tm is [36, C_IN, C_OUT], G' g G'^T of every channel pair, at most 18432 in magnitude
+static int convolve_3x3_s8_wg43_trans_kernel(const int *kernel_dims, const int8_t *kernel_data, int16_t *kernel_tm)
+{
+    if (kernel_dims[2] != 3 || kernel_dims[1] != 3) {
+        return -1;
+    }
+
+    const int32_t out_ch = kernel_dims[3];
+    const int32_t in_ch = kernel_dims[0];
+
+    for (int32_t outch_idx = 0; outch_idx < out_ch; outch_idx++) {
+        for (int32_t inch_idx = 0; inch_idx < in_ch; inch_idx++) {
+            // g[ky][kx] is kernel[(ky * 3 + kx) * in_ch]
+            const int8_t *kernel = kernel_data + outch_idx * 9 * in_ch + inch_idx;
+            int32_t tmp[6][3];
+            for (int32_t i = 0; i < 6; i++) {
+                for (int32_t kx = 0; kx < 3; kx++) {
+                    tmp[i][kx] = wg43_ktm[i][0] * kernel[kx * in_ch] + wg43_ktm[i][1] * kernel[(3 + kx) * in_ch] +
+                                 wg43_ktm[i][2] * kernel[(6 + kx) * in_ch];
+                }
+            }
+            for (int32_t i = 0; i < 6; i++) {
+                for (int32_t j = 0; j < 6; j++) {
+                    const int32_t v = tmp[i][0] * wg43_ktm[j][0] + tmp[i][1] * wg43_ktm[j][1] + tmp[i][2] * wg43_ktm[j][2];
+                    kernel_tm[((i * 6 + j) * in_ch + inch_idx) * out_ch + outch_idx] = (int16_t)v;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+// B^T = [4,  0, -5,  0, 1, 0]
+//       [0, -4, -4,  1, 1, 0]
+//       [0,  4, -4, -1, 1, 0]
+//       [0, -2, -1,  2, 1, 0]
+//       [0,  2, -1, -2, 1, 0]
+//       [0,  4,  0, -5, 0, 1]
+// applied to d0..d5, row k of the result is stored to out + k * stride
+__STATIC_FORCEINLINE void wg43_trans_input_op(vint16m2_t d0, vint16m2_t d1, vint16m2_t d2, vint16m2_t d3, vint16m2_t d4, vint16m2_t d5,
+                                              int16_t *out, ptrdiff_t stride, size_t vl)
+{
+    vint16m2_t d42 = __riscv_vsub_vv_i16m2(d4, d2, vl);
+    vint16m2_t d13 = __riscv_vsll_vx_i16m2(__riscv_vsub_vv_i16m2(d1, d3, vl), 1, vl);
+    vint16m2_t d12_sum = __riscv_vsll_vx_i16m2(__riscv_vadd_vv_i16m2(d1, d2, vl), 2, vl);
+    vint16m2_t d12_diff = __riscv_vsll_vx_i16m2(__riscv_vsub_vv_i16m2(d1, d2, vl), 2, vl);
+
+    __riscv_vse16_v_i16m2(out, __riscv_vadd_vv_i16m2(__riscv_vsll_vx_i16m2(__riscv_vsub_vv_i16m2(d0, d2, vl), 2, vl), d42, vl), vl);
+    __riscv_vse16_v_i16m2(out + stride, __riscv_vsub_vv_i16m2(__riscv_vadd_vv_i16m2(d3, d4, vl), d12_sum, vl), vl);
+    __riscv_vse16_v_i16m2(out + 2 * stride, __riscv_vadd_vv_i16m2(__riscv_vsub_vv_i16m2(d4, d3, vl), d12_diff, vl), vl);
+    __riscv_vse16_v_i16m2(out + 3 * stride, __riscv_vsub_vv_i16m2(d42, d13, vl), vl);
+    __riscv_vse16_v_i16m2(out + 4 * stride, __riscv_vadd_vv_i16m2(d42, d13, vl), vl);
+    // 4 * d1 - 5 * d3 + d5 = 2 * d13 - d3 + d5
+    __riscv_vse16_v_i16m2(out + 5 * stride, __riscv_vadd_vv_i16m2(__riscv_vsub_vv_i16m2(__riscv_vsll_vx_i16m2(d13, 1, vl), d3, vl), d5, vl), vl);
+}
+
+// transform input [H, W, C_IN] to [36, tiles, C_IN], the input offset is added before the transform
+static void convolve_3x3_s8_wg43_trans_input(const int32_t *input_dims, const int8_t *input_data, int32_t input_offset, int16_t *in_tm,
+                                             int16_t *buffer)
+{
+    const int32_t tile_w = (input_dims[1] - 2) / WG43_TILE;
+    const int32_t tile_h = (input_dims[2] - 2) / WG43_TILE;
+    const int32_t tiles = tile_w * tile_h;
+    const int32_t c_in = input_dims[0];
+    const int32_t w_step = input_dims[1] * c_in;
+
+    for (int32_t h_idx = 0; h_idx < tile_h; ++h_idx) {
+        for (int32_t w_idx = 0; w_idx < tile_w; ++w_idx) {
+            const int32_t tile_idx = h_idx * tile_w + w_idx;
+            const int8_t *tile_start = input_data + WG43_TILE * h_idx * w_step + WG43_TILE * w_idx * c_in;
+
+            size_t avl = c_in, vl;
+            for (int32_t c = 0; (vl = __riscv_vsetvl_e16m2(avl)) > 0; avl -= vl, c += vl) {
+                // d B of the 6 rows, buffer is [6, 6, C_IN]
+                for (int32_t r = 0; r < 6; r++) {
+                    const int8_t *row = tile_start + r * w_step + c;
+                    vint16m2_t d0 = __riscv_vadd_vx_i16m2(__riscv_vsext_vf2_i16m2(__riscv_vle8_v_i8m1(row, vl), vl), input_offset, vl);
+                    vint16m2_t d1 = __riscv_vadd_vx_i16m2(__riscv_vsext_vf2_i16m2(__riscv_vle8_v_i8m1(row + c_in, vl), vl), input_offset, vl);
+                    vint16m2_t d2 = __riscv_vadd_vx_i16m2(__riscv_vsext_vf2_i16m2(__riscv_vle8_v_i8m1(row + 2 * c_in, vl), vl), input_offset, vl);
+                    vint16m2_t d3 = __riscv_vadd_vx_i16m2(__riscv_vsext_vf2_i16m2(__riscv_vle8_v_i8m1(row + 3 * c_in, vl), vl), input_offset, vl);
+                    vint16m2_t d4 = __riscv_vadd_vx_i16m2(__riscv_vsext_vf2_i16m2(__riscv_vle8_v_i8m1(row + 4 * c_in, vl), vl), input_offset, vl);
+                    vint16m2_t d5 = __riscv_vadd_vx_i16m2(__riscv_vsext_vf2_i16m2(__riscv_vle8_v_i8m1(row + 5 * c_in, vl), vl), input_offset, vl);
+                    wg43_trans_input_op(d0, d1, d2, d3, d4, d5, buffer + r * 6 * c_in + c, c_in, vl);
+                }
+                // B^T (d B) of the 6 columns
+                for (int32_t j = 0; j < 6; j++) {
+                    const int16_t *col = buffer + j * c_in + c;
+                    vint16m2_t s0 = __riscv_vle16_v_i16m2(col, vl);
+                    vint16m2_t s1 = __riscv_vle16_v_i16m2(col + 6 * c_in, vl);
+                    vint16m2_t s2 = __riscv_vle16_v_i16m2(col + 12 * c_in, vl);
+                    vint16m2_t s3 = __riscv_vle16_v_i16m2(col + 18 * c_in, vl);
+                    vint16m2_t s4 = __riscv_vle16_v_i16m2(col + 24 * c_in, vl);
+                    vint16m2_t s5 = __riscv_vle16_v_i16m2(col + 30 * c_in, vl);
+                    wg43_trans_input_op(s0, s1, s2, s3, s4, s5, in_tm + (j * tiles + tile_idx) * c_in + c, 6 * tiles * c_in, vl);
+                }
+            }
+        }
+    }
+}
+
+struct wg43_dot_args_t {
+    const int16_t *in_tm;
+    const int16_t *kernel_tm;
+    int32_t *dot;
+    int32_t tiles;
+    int32_t in_ch;
+    int32_t out_ch;
+    int32_t k0; // input channels [k0, k0 + kc) of the chunk
+    int32_t kc;
+};
+
+// blocks [start, end) of WG43_DOT_ROWS tiles at one of the 36 positions, run on several harts by onnx_parallel_for
+static void convolve_3x3_s8_wg43_dot_blocks(void *arg, int start, int end)
+{
+    const struct wg43_dot_args_t *args = (const struct wg43_dot_args_t *)arg;
+    const int32_t tiles = args->tiles;
+    const int32_t in_ch = args->in_ch;
+    const int32_t out_ch = args->out_ch;
+    const int32_t blocks = (tiles + WG43_DOT_ROWS - 1) / WG43_DOT_ROWS;
+
+    for (int32_t b = start; b < end; b++) {
+        const int32_t pos = b / blocks;
+        const int32_t tile_idx = b % blocks * WG43_DOT_ROWS;
+        const int32_t rows = MIN(WG43_DOT_ROWS, tiles - tile_idx);
+        // rows past the last tile repeat row 0, their results are dropped
+        const int16_t *in0 = args->in_tm + (pos * tiles + tile_idx) * in_ch + args->k0;
+        const int16_t *in1 = rows > 1 ? in0 + in_ch : in0;
+        const int16_t *in2 = rows > 2 ? in0 + 2 * in_ch : in0;
+        const int16_t *in3 = rows > 3 ? in0 + 3 * in_ch : in0;
+        const int16_t *kernel = args->kernel_tm + (pos * in_ch + args->k0) * out_ch;
+        int32_t *dot = args->dot + (pos * tiles + tile_idx) * out_ch;
+
+        size_t avl = out_ch, vl;
+        for (int32_t oc = 0; (vl = __riscv_vsetvl_e32m4(avl)) > 0; avl -= vl, oc += vl) {
+            vint32m4_t sum0 = __riscv_vmv_v_x_i32m4(0, vl);
+            vint32m4_t sum1 = sum0;
+            vint32m4_t sum2 = sum0;
+            vint32m4_t sum3 = sum0;
+            const int16_t *pk = kernel + oc;
+            for (int32_t k = 0; k < args->kc; k++) {
+                vint16m2_t w = __riscv_vle16_v_i16m2(pk, vl);
+                pk += out_ch;
+                sum0 = __riscv_vwmacc_vx_i32m4(sum0, in0[k], w, vl);
+                sum1 = __riscv_vwmacc_vx_i32m4(sum1, in1[k], w, vl);
+                sum2 = __riscv_vwmacc_vx_i32m4(sum2, in2[k], w, vl);
+                sum3 = __riscv_vwmacc_vx_i32m4(sum3, in3[k], w, vl);
+            }
+            __riscv_vse32_v_i32m4(dot + oc, sum0, vl);
+            if (rows > 1) {
+                __riscv_vse32_v_i32m4(dot + out_ch + oc, sum1, vl);
+            }
+            if (rows > 2) {
+                __riscv_vse32_v_i32m4(dot + 2 * out_ch + oc, sum2, vl);
+            }
+            if (rows > 3) {
+                __riscv_vse32_v_i32m4(dot + 3 * out_ch + oc, sum3, vl);
+            }
+        }
+    }
+}
+
+// A'^T = [1, 1,  1, 1,  1, 0]
+//        [0, 1, -1, 2, -2, 0]
+//        [0, 1,  1, 4,  4, 0]
+//        [0, 1, -1, 8, -8, 4]
+// A^T of F(4x4,3x3) with the last column scaled by 4 for the last row of G',
+// applied to m0..m5, row k of the result is stored to out + k * stride
+__STATIC_FORCEINLINE void wg43_trans_output_op(vint32m4_t m0, vint32m4_t m1, vint32m4_t m2, vint32m4_t m3, vint32m4_t m4, vint32m4_t m5,
+                                               int32_t *out, ptrdiff_t stride, size_t vl)
+{
+    vint32m4_t a = __riscv_vadd_vv_i32m4(m1, m2, vl);
+    vint32m4_t b = __riscv_vsub_vv_i32m4(m1, m2, vl);
+    vint32m4_t c = __riscv_vadd_vv_i32m4(m3, m4, vl);
+    vint32m4_t d = __riscv_vsub_vv_i32m4(m3, m4, vl);
+
+    __riscv_vse32_v_i32m4(out, __riscv_vadd_vv_i32m4(__riscv_vadd_vv_i32m4(m0, a, vl), c, vl), vl);
+    __riscv_vse32_v_i32m4(out + stride, __riscv_vadd_vv_i32m4(b, __riscv_vsll_vx_i32m4(d, 1, vl), vl), vl);
+    __riscv_vse32_v_i32m4(out + 2 * stride, __riscv_vadd_vv_i32m4(a, __riscv_vsll_vx_i32m4(c, 2, vl), vl), vl);
+    __riscv_vse32_v_i32m4(out + 3 * stride,
+                          __riscv_vadd_vv_i32m4(__riscv_vadd_vv_i32m4(b, __riscv_vsll_vx_i32m4(d, 3, vl), vl), __riscv_vsll_vx_i32m4(m5, 2, vl), vl),
+                          vl);
+}
+
+// transform dot [36, tiles, C_OUT] back to 4x4 output tiles, requantize and crop them to the output [H, W, C_OUT]. With
+// chunks the tiles of every chunk but the last are added up in sum [tiles, 16, C_OUT], the last requantizes the total
+static void convolve_3x3_s8_wg43_trans_output(const struct convolve_s8_epilogue_t *ep, const int32_t *dot, int32_t tile_w, int32_t tile_h,
+                                              const int32_t *bias_data, const int32_t *output_mult, const int32_t *output_shift,
+                                              const int *output_dims, int32_t *buffer, int32_t *sum, _Bool first, _Bool last,
+                                              int8_t *output_data)
+{
+    const struct operator_pdata_t *pdat = ep->pdat;
+    const int32_t tiles = tile_w * tile_h;
+    const int32_t out_ch = output_dims[0];
+    const int32_t out_w = output_dims[1];
+    const int32_t out_h = output_dims[2];
+
+    for (int32_t h_idx = 0; h_idx < tile_h; ++h_idx) {
+        for (int32_t w_idx = 0; w_idx < tile_w; ++w_idx) {
+            const int32_t tile_idx = h_idx * tile_w + w_idx;
+            const int32_t rows = MIN(WG43_TILE, out_h - h_idx * WG43_TILE);
+            const int32_t cols = MIN(WG43_TILE, out_w - w_idx * WG43_TILE);
+
+            size_t avl = out_ch, vl;
+            for (int32_t oc = 0; (vl = __riscv_vsetvl_e32m4(avl)) > 0; avl -= vl, oc += vl) {
+                // A'^T dot of the 6 columns, buffer is [4, 6, C_OUT]
+                for (int32_t j = 0; j < 6; j++) {
+                    const int32_t *col = dot + (j * tiles + tile_idx) * out_ch + oc;
+                    const ptrdiff_t stride = 6 * tiles * out_ch;
+                    wg43_trans_output_op(__riscv_vle32_v_i32m4(col, vl), __riscv_vle32_v_i32m4(col + stride, vl),
+                                         __riscv_vle32_v_i32m4(col + 2 * stride, vl), __riscv_vle32_v_i32m4(col + 3 * stride, vl),
+                                         __riscv_vle32_v_i32m4(col + 4 * stride, vl), __riscv_vle32_v_i32m4(col + 5 * stride, vl),
+                                         buffer + j * out_ch + oc, 6 * out_ch, vl);
+                }
+                // (A'^T dot) A' of the output rows, written over the first 4 columns of the row
+                for (int32_t i = 0; i < rows; i++) {
+                    int32_t *row = buffer + i * 6 * out_ch + oc;
+                    wg43_trans_output_op(__riscv_vle32_v_i32m4(row, vl), __riscv_vle32_v_i32m4(row + out_ch, vl),
+                                         __riscv_vle32_v_i32m4(row + 2 * out_ch, vl), __riscv_vle32_v_i32m4(row + 3 * out_ch, vl),
+                                         __riscv_vle32_v_i32m4(row + 4 * out_ch, vl), __riscv_vle32_v_i32m4(row + 5 * out_ch, vl), row, out_ch,
+                                         vl);
+                    int8_t *out = output_data + ((h_idx * WG43_TILE + i) * out_w + w_idx * WG43_TILE) * out_ch + oc;
+                    for (int32_t c = 0; c < cols; c++) {
+                        vint32m4_t acc = wg43_recover_i32m4(__riscv_vle32_v_i32m4(row + c * out_ch, vl), vl);
+                        if (sum != NULL) {
+                            int32_t *s = sum + ((tile_idx * 16 + i * WG43_TILE + c) * out_ch + oc);
+                            if (!first) {
+                                acc = __riscv_vadd_vv_i32m4(acc, __riscv_vle32_v_i32m4(s, vl), vl);
+                            }
+                            if (!last) {
+                                __riscv_vse32_v_i32m4(s, acc, vl);
+                                continue;
+                            }
+                        }
+                        if (bias_data) {
+                            acc = __riscv_vadd_vv_i32m4(acc, __riscv_vle32_v_i32m4(bias_data + oc, vl), vl);
+                        }
+                        vint32m4_t mult = __riscv_vle32_v_i32m4(output_mult + oc, vl);
+                        vint32m4_t sft = __riscv_vle32_v_i32m4(output_shift + oc, vl);
+                        vint8m1_t res = requantize_i32m4(acc, mult, sft, pdat->output_offset, pdat->activation.min, pdat->activation.max, vl);
+                        convolve_s8_store_i8m1(ep, out + c * out_ch, res, vl);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static int convolve_3x3_s8_wg43_rvv(struct onnx_node_t *n, const struct convolve_s8_epilogue_t *ep)
+{
+    const struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const struct onnx_tensor_t *input = n->inputs[0];    // shape [batch, input_h, input_w, input_ch]
+    const struct onnx_tensor_t *bias = n->inputs[2];     // shape [output_ch]
+    const struct onnx_tensor_t *multiply = n->inputs[3]; // shape [output_ch]
+    const struct onnx_tensor_t *shift = n->inputs[4];    // shape [output_ch]
+    struct onnx_tensor_t *output = n->outputs[0];        // shape [batch, output_h, output_w, output_ch]
+
+    const int *input_dims = input->dims;
+    const int *output_dims = output->dims;
+    const int32_t in_ch = input_dims[0];
+    const int32_t out_ch = output_dims[0];
+    const int32_t tile_w = (output_dims[1] + WG43_TILE - 1) / WG43_TILE;
+    const int32_t tile_h = (output_dims[2] + WG43_TILE - 1) / WG43_TILE;
+    const int32_t tiles = tile_w * tile_h;
+    const int32_t in_preprocess_dims[4] = {in_ch, tile_w * WG43_TILE + 2, tile_h * WG43_TILE + 2, 1};
+    const Tile output_shape = {tile_w * WG43_TILE, tile_h * WG43_TILE};
+
+    // split buffer, see GenerateConvIntegerParam
+    const int32_t chunk = convolve_3x3_s8_wg43_chunk(pdat->input_offset);
+    const int32_t in_tm_sz = 36 * tiles * in_ch * sizeof(int16_t);
+    const int32_t trans_sz = MAX(36 * in_ch * sizeof(int16_t), 24 * out_ch * sizeof(int32_t));
+    const int32_t kernel_tm_sz = 36 * in_ch * out_ch * sizeof(int16_t);
+    const int32_t dot_sz = 36 * tiles * out_ch * sizeof(int32_t);
+    const int32_t sum_sz = in_ch > chunk ? 16 * tiles * out_ch * sizeof(int32_t) : 0;
+    int16_t *in_tm = (int16_t *)pdat->ctx.buf;
+    void *trans = (char *)pdat->ctx.buf + in_tm_sz;
+    int32_t *dot = (int32_t *)((char *)pdat->ctx.buf + in_tm_sz + trans_sz + kernel_tm_sz);
+    int32_t *sum = sum_sz != 0 ? (int32_t *)((char *)pdat->ctx.buf + in_tm_sz + trans_sz + kernel_tm_sz + dot_sz) : NULL;
+    int8_t *in_pad = (int8_t *)pdat->ctx.buf + in_tm_sz + trans_sz + kernel_tm_sz + dot_sz + sum_sz;
+    const _Bool need_pad = pdat->padding.w != 0 || pdat->padding.h != 0 || output_dims[1] % WG43_TILE || output_dims[2] % WG43_TILE ||
+                           input_dims[1] != output_dims[1] + 2 || input_dims[2] != output_dims[2] + 2;
+
+    for (int32_t batch_idx = 0; batch_idx < input_dims[3]; ++batch_idx) {
+        const int8_t *batch_in = (const int8_t *)input->datas + input_dims[2] * input_dims[1] * in_ch * batch_idx;
+        int8_t *batch_out = (int8_t *)output->datas + output_dims[2] * output_dims[1] * out_ch * batch_idx;
+        if (need_pad) {
+            int status =
+                convolve_3x3_s8_wg23_pad_input(input_dims, pdat->padding.w, pdat->padding.h, pdat->input_offset, batch_in, &output_shape, in_pad);
+            if (status != 0) {
+                return status;
+            }
+            batch_in = in_pad;
+        }
+
+        convolve_3x3_s8_wg43_trans_input(in_preprocess_dims, batch_in, pdat->input_offset, in_tm, (int16_t *)trans);
+
+        // every chunk of input channels is recovered exactly, their sum is requantized with the last one
+        for (int32_t k0 = 0; k0 < in_ch; k0 += chunk) {
+            struct wg43_dot_args_t dot_args = {in_tm, pdat->kernel_tm, dot, tiles, in_ch, out_ch, k0, MIN(chunk, in_ch - k0)};
+            onnx_parallel_for(36 * ((tiles + WG43_DOT_ROWS - 1) / WG43_DOT_ROWS), 1, convolve_3x3_s8_wg43_dot_blocks, &dot_args);
+
+            convolve_3x3_s8_wg43_trans_output(ep, dot, tile_w, tile_h, bias->datas, multiply->datas, shift->datas, output_dims,
+                                              (int32_t *)trans, sum, k0 == 0, k0 + chunk >= in_ch, batch_out);
+        }
+    }
+    return 0;
+}
+
+int ConvInteger_rvv(struct onnx_node_t *n)
+{
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
     const struct onnx_tensor_t *filter = n->inputs[1]; // shape [output_ch, kernel_h, kernel_w, input_ch]
+    struct convolve_s8_epilogue_t ep;
+    int status;
+    if (pdat->kernel_tm == NULL && pdat->kernel_packed == NULL) {
+        // parameters generated for the scalar kernel
+        return ConvInteger(n);
+    }
+    status = convolve_s8_bind_epilogue(pdat, n->outputs[0], &ep);
+    if (status != 0) {
+        return status;
+    }
+    if (!pdat->kernel_ready) {
+        // weights bound after GenerateConvIntegerParam, transform them once
+        status = PrepareConvIntegerWeights(pdat, filter);
+        if (status != 0) {
+            return status;
+        }
+    }
+    if (pdat->pointwise) {
+        return convolve_s8_pointwise_rvv(n, &ep);
+    }
+    if (pdat->depthwise) {
+        return convolve_s8_depthwise_rvv(n, &ep);
+    }
+    if (pdat->kernel_packed != NULL) {
+        return convolve_s8_im2col_rvv(n, &ep);
+    }
+    if (pdat->algo == CONV_INTEGER_ALGO_WINOGRAD43) {
+        return convolve_3x3_s8_wg43_rvv(n, &ep);
+    }
+    if (pdat->stride.w != 1 || pdat->stride.h != 1 || pdat->dilation.h != 1 || pdat->dilation.w != 1) {
+        return -1;
+    }
     if (filter->dims[1] != 3 || filter->dims[2] != 3) {
         return -1;
     }
@@ -1212,7 +2048,7 @@ int ConvInteger_rvv(struct onnx_node_t *n)
     const int32_t kernel_tm_sz = 16 * out_ch * in_ch * sizeof(int16_t);
     const int32_t dot_sz = tiles * 16 * out_ch * sizeof(int32_t);
     int16_t *in_tm = (int16_t *)pdat->ctx.buf;
-    int16_t *kernel_tm = (int16_t *)((char *)pdat->ctx.buf + in_tm_sz);
+    int16_t *kernel_tm = pdat->kernel_tm;
     int32_t *dot = (int32_t *)((char *)pdat->ctx.buf + in_tm_sz + kernel_tm_sz);
 
     // transform kernel shape of kernel_tm is [N, H, W, C] = [1, C_OUT, C_IN, 16]
@@ -1222,10 +2058,6 @@ int ConvInteger_rvv(struct onnx_node_t *n)
     // kernel_tm_dims.w = in_ch;
     // kernel_tm_dims.c = 16;
     const int32_t kernel_tm_dims[4] = {16, in_ch, out_ch, 1};
-    int status = convolve_3x3_s8_wg23_trans_kernel(filter->dims, filter->datas, kernel_tm);
-    if (status != 0) {
-        return status;
-    }
 
     for (int32_t batch_idx = 0; batch_idx < batch; ++batch_idx) {
         const int8_t *in_preprocess;
@@ -1251,7 +2083,7 @@ int ConvInteger_rvv(struct onnx_node_t *n)
         // in_tm_dims.w = in_ch;
         // in_tm_dims.c = 16;
         const int32_t in_tm_dims[4] = {16, in_ch, tiles, 1};
-        status = convolve_3x3_s8_wg23_trans_input(in_preprocess_dims, in_preprocess, in_tm);
+        status = convolve_3x3_s8_wg23_trans_input(in_preprocess_dims, in_preprocess, pdat->input_offset, in_tm);
         if (status != 0) {
             return status;
         }
@@ -1263,15 +2095,18 @@ int ConvInteger_rvv(struct onnx_node_t *n)
         // dot_dims.w = out_ch;
         // dot_dims.c = 16;
         const int dot_dims[4] = {16, out_ch, tiles, 1};
-        status = riscv_convolve_3x3_s8_wg23_dot(in_tm_dims, in_tm, kernel_tm_dims, kernel_tm, dot_dims, dot);
+        // the tiles can't report an error, the shapes are checked once for all of them
+        status = convolve_3x3_s8_wg23_dot_check(in_tm_dims, in_tm, kernel_tm_dims, kernel_tm, dot_dims, dot);
         if (status != 0) {
             return status;
         }
+        struct wg23_dot_args_t dot_args = {in_tm_dims, in_tm, kernel_tm_dims, kernel_tm, dot_dims, dot};
+        onnx_parallel_for(tiles, 1, convolve_3x3_s8_wg23_dot_tiles, &dot_args);
 
         // transform output and crop padding
         int8_t *perbatch_out = output_data + output_dims[2] * output_dims[1] * output_dims[0] * batch_idx;
         status =
-            convolve_3x3_s8_wg23_trans_output(&output_shape, pdat->output_offset, pdat->activation.min, pdat->activation.max, dot_dims, dot,
+            convolve_3x3_s8_wg23_trans_output(&ep, &output_shape, pdat->output_offset, pdat->activation.min, pdat->activation.max, dot_dims, dot,
                                               multiply->datas, shift->datas, bias->dims, bias->datas, output_dims, (int32_t *)buffer, perbatch_out);
         if (status != 0) {
             return status;
@@ -1281,12 +2116,42 @@ int ConvInteger_rvv(struct onnx_node_t *n)
     /* Return to application */
     return 0;
 }
+#endif /* defined(__riscv_vector) */
+
+/*
+ * Multiplies per input/output channel pair of both tilings, F(4x4,3x3) rounds
+ * the output up to multiples of 4 and wins on larger outputs. It is exact for
+ * any number of input channels, see convolve_3x3_s8_wg43_chunk.
+ */
+static enum conv_integer_algo_t convolve_3x3_s8_winograd_select(const int *output_dims)
+{
+    const int32_t wg23 = (output_dims[1] + 1) / 2 * ((output_dims[2] + 1) / 2) * 16;
+    const int32_t wg43 = (output_dims[1] + 3) / 4 * ((output_dims[2] + 3) / 4) * 36;
+    return wg43 < wg23 ? CONV_INTEGER_ALGO_WINOGRAD43 : CONV_INTEGER_ALGO_WINOGRAD23;
+}
 
 void *GenerateConvIntegerParam(int32_t in_offset, int32_t out_offset, int32_t stride_w, int32_t stride_h, int32_t dilation_w, int32_t dilation_h,
                                int32_t pad_w, int32_t pad_h, int32_t activation_min, int32_t activation_max, const struct onnx_tensor_t *input,
                                const struct onnx_tensor_t *filter, const struct onnx_tensor_t *output, _Bool rvv)
+{
+    return GenerateConvIntegerParamAlgo(in_offset, out_offset, stride_w, stride_h, dilation_w, dilation_h, pad_w, pad_h, activation_min,
+                                        activation_max, input, filter, output, rvv, CONV_INTEGER_ALGO_AUTO);
+}
+
+void *GenerateConvIntegerParamAlgo(int32_t in_offset, int32_t out_offset, int32_t stride_w, int32_t stride_h, int32_t dilation_w,
+                                   int32_t dilation_h, int32_t pad_w, int32_t pad_h, int32_t activation_min, int32_t activation_max,
+                                   const struct onnx_tensor_t *input, const struct onnx_tensor_t *filter, const struct onnx_tensor_t *output,
+                                   _Bool rvv, enum conv_integer_algo_t algo)
 {
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)MALLOC_ASSERT(sizeof(struct operator_pdata_t));
+    pdat->groups = input->dims[0] / filter->dims[0];
+    // a single channel conv is not depthwise, its 3x3 filter takes the Winograd path
+    pdat->depthwise = pdat->groups > 1 && filter->dims[0] == 1 && filter->dims[3] == input->dims[0];
+    pdat->pointwise =
+        filter->dims[1] == 1 && filter->dims[2] == 1 && stride_w == 1 && stride_h == 1 && pad_w == 0 && pad_h == 0 && pdat->groups == 1;
+    pdat->kernel_tm = NULL;
+    pdat->kernel_packed = NULL;
+    pdat->kernel_ready = 0;
     pdat->input_offset = in_offset;
     pdat->output_offset = out_offset;
     pdat->stride.w = stride_w;
@@ -1297,9 +2162,59 @@ void *GenerateConvIntegerParam(int32_t in_offset, int32_t out_offset, int32_t st
     pdat->padding.h = pad_h;
     pdat->activation.min = activation_min;
     pdat->activation.max = activation_max;
+    pdat->generate_activation = pdat->activation;
+    pdat->fused = 0;
+    pdat->silu = 0;
+    pdat->residual = NULL;
+
+#if !defined(__riscv_vector)
+    // ConvInteger_rvv falls back to ConvInteger, which needs the im2col buffer
+    rvv = 0;
+#endif
+    const _Bool winograd = rvv && filter->dims[1] == 3 && filter->dims[2] == 3 && stride_w == 1 && stride_h == 1 && dilation_w == 1 &&
+                           dilation_h == 1 && pdat->groups == 1 && algo != CONV_INTEGER_ALGO_IM2COL;
+    if (winograd && algo == CONV_INTEGER_ALGO_AUTO) {
+        algo = convolve_3x3_s8_winograd_select(output->dims);
+    }
+#if defined(__riscv_vector)
+    if (algo == CONV_INTEGER_ALGO_WINOGRAD23 && __riscv_vsetvlmax_e32m4() < 16) {
+        // wg23 works on fixed 4x4 tiles: vl = 16 for e16m2 and e32m4, VLEN >= 128
+        algo = CONV_INTEGER_ALGO_IM2COL;
+    }
+#endif
+    pdat->algo = winograd ? algo : CONV_INTEGER_ALGO_IM2COL;
+    if (pdat->algo == CONV_INTEGER_ALGO_WINOGRAD43) {
+        // allocate buffer for rvv winograd F(4x4,3x3)
+        const int32_t tile_w = (output->dims[1] + 3) / 4;
+        const int32_t tile_h = (output->dims[2] + 3) / 4;
+        const int32_t tiles = tile_w * tile_h;
+        const int32_t in_ch = input->dims[0];
+        const int32_t out_ch = filter->dims[3];
+        int32_t in_pad = 0;
+
+        if (pad_h != 0 || pad_w != 0 || output->dims[2] % 4 || output->dims[1] % 4 || input->dims[2] != output->dims[2] + 2 ||
+            input->dims[1] != output->dims[1] + 2) {
+            in_pad = (tile_w * 4 + 2) * (tile_h * 4 + 2) * in_ch * sizeof(int8_t);
+        }
 
-    if (rvv && filter->dims[1] == 3 && filter->dims[2] == 3) {
-        // allocate buffer for rvv
+        /* buffers of wg43, one after the other
+         * 1. in_tm, the transformed input [36, tiles, C_IN]
+         * 2. the transform buffer of one tile, [6, 6, C_IN] for the input or [4, 6, C_OUT] for the output
+         * 3. kernel_tm, the transformed filter [36, C_IN, C_OUT]
+         * 4. dot, the product of in_tm and kernel_tm [36, tiles, C_OUT]
+         * 5. the output tiles summed over the chunks of input channels [tiles, 16, C_OUT], only with more than one chunk
+         * 6. the padded input
+         */
+        const int32_t in_tm_sz = 36 * tiles * in_ch * sizeof(int16_t);
+        const int32_t trans_sz = MAX(36 * in_ch * sizeof(int16_t), 24 * out_ch * sizeof(int32_t));
+        const int32_t kernel_tm_sz = 36 * in_ch * out_ch * sizeof(int16_t);
+        const int32_t dot_sz = 36 * tiles * out_ch * sizeof(int32_t);
+        const int32_t sum_sz = in_ch > convolve_3x3_s8_wg43_chunk(in_offset) ? 16 * tiles * out_ch * sizeof(int32_t) : 0;
+        pdat->ctx.buf_size = in_tm_sz + trans_sz + kernel_tm_sz + dot_sz + sum_sz + in_pad;
+        pdat->ctx.buf = MALLOC_ASSERT(pdat->ctx.buf_size);
+        pdat->kernel_tm = (int16_t *)((char *)pdat->ctx.buf + in_tm_sz + trans_sz);
+    } else if (pdat->algo == CONV_INTEGER_ALGO_WINOGRAD23) {
+        // allocate buffer for rvv winograd F(2x2,3x3)
         int32_t in_pad = 0;
         const int32_t out_inner_w = (output->dims[1] + 1) / 2 * 2;
         const int32_t out_inner_h = (output->dims[2] + 1) / 2 * 2;
@@ -1309,17 +2224,17 @@ void *GenerateConvIntegerParam(int32_t in_offset, int32_t out_offset, int32_t st
         const int32_t in_ch = input->dims[0];
         const int32_t out_ch = filter->dims[3];
 
+        // the output transform always needs its buffer, the padded input shares it
         // whether copy to padding
         // 1. when padding is not zero
         // 2. when output dim is not multiple of 2
         // 3. when input dim is not match to output dim
+        in_pad = tiles * out_ch * sizeof(int32_t) * 8;
         if (pad_h != 0 || pad_w != 0 || output->dims[2] % 2 || output->dims[1] % 2 || input->dims[2] < output->dims[2] + 3 - 1 ||
             input->dims[1] < output->dims[1] + 3 - 1) {
             // need padding
             int32_t in_sz = (out_inner_w + 2) * (out_inner_h + 2) * in_ch * sizeof(int8_t);
-            int32_t out_sz = tiles * out_ch * sizeof(int32_t) * 8;
-            // the same memory is also used to store output transform result
-            in_pad = in_sz > out_sz ? in_sz : out_sz;
+            in_pad = MAX(in_pad, in_sz);
         }
 
         /* there are three buffers needed for wg23
@@ -1334,6 +2249,19 @@ void *GenerateConvIntegerParam(int32_t in_offset, int32_t out_offset, int32_t st
         const int32_t dot_sz = tiles * 16 * out_ch * sizeof(int32_t);
         pdat->ctx.buf_size = in_tm_sz + kernel_tm_sz + dot_sz + in_pad;
         pdat->ctx.buf = MALLOC_ASSERT(pdat->ctx.buf_size);
+        pdat->kernel_tm = (int16_t *)((char *)pdat->ctx.buf + in_tm_sz);
+    } else if (rvv && (pdat->pointwise || pdat->depthwise)) {
+        // allocate buffer for rvv pointwise or depthwise, the packed filter only
+        pdat->ctx.buf_size = filter->dims[0] * filter->dims[1] * filter->dims[2] * filter->dims[3] * sizeof(int8_t);
+        pdat->ctx.buf = MALLOC_ASSERT(pdat->ctx.buf_size);
+        pdat->kernel_packed = (int8_t *)pdat->ctx.buf;
+    } else if (rvv) {
+        // allocate buffer for rvv im2col, IM2COL_ROWS int16 rows and the packed filter
+        const int32_t rhs_cols = filter->dims[1] * filter->dims[2] * filter->dims[0];
+        const int32_t col_sz = IM2COL_ROWS * rhs_cols * sizeof(int16_t);
+        pdat->ctx.buf_size = col_sz + rhs_cols * filter->dims[3] * sizeof(int8_t);
+        pdat->ctx.buf = MALLOC_ASSERT(pdat->ctx.buf_size);
+        pdat->kernel_packed = (int8_t *)pdat->ctx.buf + col_sz;
     } else {
         // allocate buffer for non-rvv
         const int32_t rhs_cols = filter->dims[1] * filter->dims[2] * filter->dims[0];
@@ -1342,9 +2270,97 @@ void *GenerateConvIntegerParam(int32_t in_offset, int32_t out_offset, int32_t st
         pdat->ctx.buf_size = (2 * aligned_rhs_cols) * (int32_t)sizeof(int16_t);
         pdat->ctx.buf = MALLOC_ASSERT(pdat->ctx.buf_size);
     }
+    if (filter->datas != NULL) {
+        PrepareConvIntegerWeights(pdat, filter);
+    }
     return pdat;
 }
 
+int PrepareConvIntegerWeights(void *pdat, const struct onnx_tensor_t *filter)
+{
+    struct operator_pdata_t *_pdat = (struct operator_pdata_t *)pdat;
+#if defined(__riscv_vector)
+    if (_pdat->kernel_tm != NULL) {
+        int status = _pdat->algo == CONV_INTEGER_ALGO_WINOGRAD43 ? convolve_3x3_s8_wg43_trans_kernel(filter->dims, filter->datas, _pdat->kernel_tm)
+                                                                 : convolve_3x3_s8_wg23_trans_kernel(filter->dims, filter->datas, _pdat->kernel_tm);
+        if (status != 0) {
+            return status;
+        }
+    } else if (_pdat->kernel_packed != NULL) {
+        // depthwise filters are packed as one group of [kernel_h, kernel_w, ch]
+        convolve_s8_pack_kernel(filter->dims, _pdat->depthwise ? 1 : _pdat->groups, filter->datas, _pdat->kernel_packed);
+    }
+#else
+    (void)filter;
+#endif
+    // the scalar kernel reads the filter directly
+    _pdat->kernel_ready = 1;
+    return 0;
+}
+
+// real value v as int8 of the output quantization, saturated
+static int32_t convolve_s8_quantize(float32_t v, float32_t scale, int32_t zero_point)
+{
+    const float32_t q = roundf(v / scale) + zero_point;
+    return q < -128.0f ? -128 : q > 127.0f ? 127 : (int32_t)q;
+}
+
+int SetConvIntegerEpilogue(void *pdat, const struct onnx_epilogue_t *epilogue)
+{
+    struct operator_pdata_t *_pdat = (struct operator_pdata_t *)pdat;
+    const int32_t zero_point = _pdat->output_offset;
+    const float32_t scale = epilogue->scale;
+    Activation clamp = {-128, 127};
+
+    if (epilogue->activation != ONNX_ACTIVATION_NONE && epilogue->activation != ONNX_ACTIVATION_RELU && !(scale > 0.0f)) {
+        return -1;
+    }
+    switch (epilogue->activation) {
+        case ONNX_ACTIVATION_RELU:
+            clamp.min = MAX(zero_point, -128);
+            break;
+        case ONNX_ACTIVATION_RELU6:
+            clamp.min = MAX(zero_point, -128);
+            clamp.max = convolve_s8_quantize(6.0f, scale, zero_point);
+            break;
+        case ONNX_ACTIVATION_CLAMP:
+            clamp.min = convolve_s8_quantize(epilogue->min, scale, zero_point);
+            clamp.max = convolve_s8_quantize(epilogue->max, scale, zero_point);
+            break;
+        case ONNX_ACTIVATION_SILU:
+            for (int32_t q = -128; q < 128; q++) {
+                const float32_t x = scale * (q - zero_point);
+                _pdat->silu_lut[q + 128] = (int8_t)convolve_s8_quantize(x / (1.0f + expf(-x)), scale, zero_point);
+            }
+            break;
+        default:
+            break;
+    }
+
+    _pdat->residual = epilogue->residual;
+    if (epilogue->residual != NULL) {
+        const float32_t ratio = epilogue->residual_scale / scale;
+        if (epilogue->residual->type != ONNX_TENSOR_TYPE_INT8 || !(ratio > 0.0f && ratio <= EPILOGUE_RESIDUAL_MAX) ||
+            epilogue->residual_zero_point < -128 || epilogue->residual_zero_point > 127) {
+            _pdat->residual = NULL;
+            return -1;
+        }
+        _pdat->residual_zero_point = epilogue->residual_zero_point;
+        _pdat->residual_mult = (int32_t)roundf(ratio * (1 << EPILOGUE_RESIDUAL_SHIFT));
+    }
+    _pdat->silu = epilogue->activation == ONNX_ACTIVATION_SILU;
+    _pdat->fused = _pdat->residual != NULL || _pdat->silu;
+    _pdat->activation = _pdat->generate_activation;
+    if (_pdat->fused) {
+        _pdat->epilogue_clamp = clamp;
+    } else {
+        // without residual the activation is a tighter bound of the requantization
+        _pdat->activation.min = MAX(_pdat->activation.min, clamp.min);
+        _pdat->activation.max = MIN(_pdat->activation.max, clamp.max);
+    }
+    return 0;
+}
+
 void FreeConvIntegerParam(void **pdat)
 {
     struct operator_pdata_t *_pdat = (struct operator_pdata_t *)*pdat;
@@ -1355,4 +2371,153 @@ void FreeConvIntegerParam(void **pdat)
     }
     free(*pdat);
     *pdat = NULL;
-}
\ No newline at end of file
+}
+
+/* streaming ConvInteger of one image, see GenerateConvIntegerStreamParam */
+struct conv_integer_stream_t {
+    void *band;         /**< ConvInteger parameters of one output row over one window, the vertical padding is left to the stream */
+    int8_t *ring;       /**< the last window input rows, each stored at slot and slot + window so that every window is contiguous */
+    int32_t window;     /**< input rows of one output row, dilation_h * (kernel_h - 1) + 1 */
+    int32_t row_size;   /**< input_w * input_ch */
+    int32_t input_h;
+    int32_t output_h;
+    int32_t pad_h;
+    int32_t stride_h;
+    int8_t pad_value;   /**< input zero point, the value of the padding rows */
+    int32_t rows;       /**< rows of the padded image in the ring so far, top padding included */
+    int32_t received;   /**< rows of the image received so far */
+    int32_t emitted;    /**< output rows written so far */
+    int window_dims[4];
+    int row_dims[4];
+    struct onnx_tensor_t window_tensor; /**< input of band, datas points into ring */
+    struct onnx_tensor_t row_tensor;    /**< output of band, datas points into the output of the running call */
+};
+
+// output rows whose window is complete once the first rows of the padded image arrived
+static int32_t conv_integer_stream_ready(const struct conv_integer_stream_t *s, int32_t rows)
+{
+    return rows < s->window ? 0 : MIN((rows - s->window) / s->stride_h + 1, s->output_h);
+}
+
+// append a row of the padded image to the ring, NULL for a padding row
+static void conv_integer_stream_push(struct conv_integer_stream_t *s, const int8_t *row)
+{
+    int8_t *slot = s->ring + (s->rows % s->window) * s->row_size;
+    if (row != NULL) {
+        memcpy(slot, row, s->row_size);
+    } else {
+        memset(slot, s->pad_value, s->row_size);
+    }
+    memcpy(slot + s->window * s->row_size, slot, s->row_size);
+    s->rows++;
+}
+
+// compute the output rows completed by the last push, *out advances past them
+static int conv_integer_stream_emit(struct conv_integer_stream_t *s, struct onnx_node_t *band, int8_t **out)
+{
+    const int32_t ready = conv_integer_stream_ready(s, s->rows);
+    for (; s->emitted < ready; s->emitted++) {
+        // emitted right when complete, so the window is the last window rows of the ring
+        s->window_tensor.datas = s->ring + (s->emitted * s->stride_h % s->window) * s->row_size;
+        s->row_tensor.datas = *out;
+#if defined(__riscv_vector)
+        int status = ConvInteger_rvv(band);
+#else
+        int status = ConvInteger(band);
+#endif
+        if (status != 0) {
+            return status;
+        }
+        *out += s->row_tensor.ndata;
+    }
+    return 0;
+}
+
+int ConvIntegerStream(struct onnx_node_t *n, int32_t *written)
+{
+    struct conv_integer_stream_t *s = (struct conv_integer_stream_t *)n->priv;
+    const struct onnx_tensor_t *input = n->inputs[0]; // shape [band_h, input_w, input_ch]
+    struct onnx_tensor_t *output = n->outputs[0];     // shape [rows, output_w, output_ch]
+    const int32_t band_h = input->ndata / s->row_size;
+    const int32_t received = s->received;
+    int status = 0;
+
+    *written = 0;
+    if (input->ndata % s->row_size != 0 || received + band_h > s->input_h) {
+        return -1;
+    }
+    // the bottom padding follows the last row of the image
+    const _Bool last = received + band_h == s->input_h;
+    const int32_t rows = s->pad_h + received + band_h + (last ? s->pad_h : 0);
+    const int32_t count = conv_integer_stream_ready(s, rows) - s->emitted;
+    if (count * s->row_tensor.ndata > output->ndata) {
+        return -1;
+    }
+
+    struct onnx_tensor_t *inputs[5] = {&s->window_tensor, n->inputs[1], n->inputs[2], n->inputs[3], n->inputs[4]};
+    struct onnx_tensor_t *outputs[1] = {&s->row_tensor};
+    struct onnx_node_t band = {inputs, 5, outputs, 1, s->band};
+    const int8_t *input_data = (const int8_t *)input->datas;
+    int8_t *out = (int8_t *)output->datas;
+    while (s->rows < rows && status == 0) {
+        const int32_t y = s->rows - s->pad_h; // row of the image
+        conv_integer_stream_push(s, y >= 0 && y < s->input_h ? input_data + (y - received) * s->row_size : NULL);
+        status = conv_integer_stream_emit(s, &band, &out);
+    }
+    if (status != 0) {
+        return status;
+    }
+    s->received += band_h;
+    if (last) {
+        // the next call starts a new image
+        s->rows = 0;
+        s->received = 0;
+        s->emitted = 0;
+    }
+    *written = count;
+    return 0;
+}
+
+void *GenerateConvIntegerStreamParam(int32_t in_offset, int32_t out_offset, int32_t stride_w, int32_t stride_h, int32_t dilation_w,
+                                     int32_t dilation_h, int32_t pad_w, int32_t pad_h, int32_t activation_min, int32_t activation_max,
+                                     const struct onnx_tensor_t *input, const struct onnx_tensor_t *filter, const struct onnx_tensor_t *output,
+                                     _Bool rvv)
+{
+    struct conv_integer_stream_t *s = (struct conv_integer_stream_t *)MALLOC_ASSERT(sizeof(struct conv_integer_stream_t));
+    s->window = dilation_h * (filter->dims[2] - 1) + 1;
+    s->row_size = input->dims[1] * input->dims[0];
+    s->input_h = input->dims[2];
+    s->output_h = output->dims[2];
+    s->pad_h = pad_h;
+    s->stride_h = stride_h;
+    s->pad_value = (int8_t)-in_offset;
+    s->rows = 0;
+    s->received = 0;
+    s->emitted = 0;
+
+    s->window_dims[0] = input->dims[0];
+    s->window_dims[1] = input->dims[1];
+    s->window_dims[2] = s->window;
+    s->window_dims[3] = 1;
+    s->row_dims[0] = output->dims[0];
+    s->row_dims[1] = output->dims[1];
+    s->row_dims[2] = 1;
+    s->row_dims[3] = 1;
+    s->window_tensor = (struct onnx_tensor_t){NULL, ONNX_TENSOR_TYPE_INT8, NULL, s->window_dims, 4, NULL, s->window * s->row_size};
+    s->row_tensor = (struct onnx_tensor_t){NULL, ONNX_TENSOR_TYPE_INT8, NULL, s->row_dims, 4, NULL, output->dims[1] * output->dims[0]};
+    s->ring = (int8_t *)MALLOC_ASSERT(2 * s->window * s->row_size * sizeof(int8_t));
+
+    // a single output row per call, im2col has no tiles to round up like Winograd
+    s->band = GenerateConvIntegerParamAlgo(in_offset, out_offset, stride_w, 1, dilation_w, dilation_h, pad_w, 0, activation_min, activation_max,
+                                           &s->window_tensor, filter, &s->row_tensor, rvv, CONV_INTEGER_ALGO_IM2COL);
+    return s;
+}
+
+void FreeConvIntegerStreamParam(void **pdat)
+{
+    struct conv_integer_stream_t *s = (struct conv_integer_stream_t *)*pdat;
+    FreeConvIntegerParam(&s->band);
+    free(s->ring);
+    free(*pdat);
+    *pdat = NULL;
+}
@@ -0,0 +1,669 @@
+/*
+ * https://onnx.ai/onnx/operators/onnx__ConvTranspose.html
+ *
+ * NHWC like Conv: input [batch, input_h, input_w, input_ch], filter
+ * [input_ch, kernel_h, kernel_w, output_ch / groups] and output
+ * [batch, output_h, output_w, output_ch], where
+ * output_h = (input_h - 1) * stride_h - 2 * pad_h + dilation_h * (kernel_h - 1) + output_padding_h + 1.
+ *
+ * Output pixel o gets tap k from input pixel (o + pad - k * dilation) / stride
+ * when the division is exact. The pixels with the same (o + pad) % stride, a
+ * phase, share their taps, so every phase is a stride 1 convolution with a
+ * sub-filter: the rvv kernels gather im2col rows of the phase and multiply
+ * them with the packed sub-filter instead of scattering every input pixel.
+ */
+
+#include "operators.h"
+#include "requantize.h"
+#include "utils.h"
+
+typedef struct {
+    int32_t w;
+    int32_t h;
+} Tile;
+
+typedef struct {
+    int32_t min;
+    int32_t max;
+} Activation;
+
+struct operator_pdata_t {
+    void *buf;
+    size_t buf_size;
+    int32_t input_offset;  /**< The negative of the zero value for the input tensor, int8 only */
+    int32_t output_offset; /**< The negative of the zero value for the output tensor, int8 only */
+    Tile stride;
+    Tile padding;
+    Tile dilation;
+    Tile output_padding;
+    Activation activation;
+    int32_t groups;
+    void *col;           /**< CONV_TRANSPOSE_ROWS im2col rows inside buf, int16 for int8 inputs */
+    void *kernel_packed; /**< filter packed as [groups, stride_h, stride_w, phase_cols, output_ch / groups] inside buf */
+    _Bool kernel_ready;  /**< kernel_packed holds the current filter */
+};
+
+#define CONV_TRANSPOSE_ROWS (4) // output pixels per block of the rvv kernels
+
+static int32_t conv_transpose_output_size(int32_t input, int32_t kernel, int32_t stride, int32_t dilation, int32_t pad, int32_t output_padding)
+{
+    return (input - 1) * stride - 2 * pad + dilation * (kernel - 1) + output_padding + 1;
+}
+
+// shapes of input, filter and output agree with the parameters
+static int conv_transpose_check(const struct operator_pdata_t *pdat, const struct onnx_tensor_t *input, const struct onnx_tensor_t *filter,
+                                const struct onnx_tensor_t *output)
+{
+    const int32_t groups = pdat->groups;
+    if (groups <= 0 || input->dims[0] != filter->dims[3] || input->dims[0] % groups != 0 || output->dims[0] != filter->dims[0] * groups ||
+        output->dims[3] != input->dims[3]) {
+        return -1;
+    }
+    if (output->dims[1] != conv_transpose_output_size(input->dims[1], filter->dims[1], pdat->stride.w, pdat->dilation.w, pdat->padding.w,
+                                                      pdat->output_padding.w) ||
+        output->dims[2] != conv_transpose_output_size(input->dims[2], filter->dims[2], pdat->stride.h, pdat->dilation.h, pdat->padding.h,
+                                                      pdat->output_padding.h)) {
+        return -1;
+    }
+    return 0;
+}
+
+// input coordinate of output o and tap k, -1 when the tap doesn't reach o
+static int32_t conv_transpose_source(int32_t o, int32_t k, int32_t stride, int32_t dilation, int32_t pad, int32_t input)
+{
+    const int32_t t = o + pad - k * dilation;
+    if (t < 0 || t % stride != 0 || t / stride >= input) {
+        return -1;
+    }
+    return t / stride;
+}
+
+int ConvTransposeInteger(struct onnx_node_t *n)
+{
+    const struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const struct onnx_tensor_t *input = n->inputs[0];    // shape [batch, input_h, input_w, input_ch]
+    const struct onnx_tensor_t *filter = n->inputs[1];   // shape [input_ch, kernel_h, kernel_w, output_ch / groups]
+    const struct onnx_tensor_t *bias = n->inputs[2];     // shape [output_ch]
+    const struct onnx_tensor_t *multiply = n->inputs[3]; // shape [output_ch]
+    const struct onnx_tensor_t *shift = n->inputs[4];    // shape [output_ch]
+    struct onnx_tensor_t *output = n->outputs[0];        // shape [batch, output_h, output_w, output_ch]
+
+    if (conv_transpose_check(pdat, input, filter, output) != 0) {
+        return -1;
+    }
+
+    const int32_t input_ch = input->dims[0];
+    const int32_t input_x = input->dims[1];
+    const int32_t input_y = input->dims[2];
+    const int32_t kernel_x = filter->dims[1];
+    const int32_t kernel_y = filter->dims[2];
+    const int32_t output_ch = output->dims[0];
+    const int32_t output_x = output->dims[1];
+    const int32_t output_y = output->dims[2];
+    const int32_t in_ch = input_ch / pdat->groups;
+    const int32_t out_ch = filter->dims[0];
+    const int32_t *bias_data = (const int32_t *)bias->datas;
+    const int32_t *mult_data = (const int32_t *)multiply->datas;
+    const int32_t *shift_data = (const int32_t *)shift->datas;
+    const int8_t *input_data = (const int8_t *)input->datas;
+    const int8_t *filter_data = (const int8_t *)filter->datas;
+    int8_t *output_data = (int8_t *)output->datas;
+
+    for (int32_t b = 0; b < input->dims[3]; b++) {
+        for (int32_t oy = 0; oy < output_y; oy++) {
+            for (int32_t ox = 0; ox < output_x; ox++) {
+                for (int32_t oc = 0; oc < output_ch; oc++) {
+                    const int32_t g = oc / out_ch;
+                    int32_t sum = bias_data ? bias_data[oc] : 0;
+                    for (int32_t ky = 0; ky < kernel_y; ky++) {
+                        const int32_t iy = conv_transpose_source(oy, ky, pdat->stride.h, pdat->dilation.h, pdat->padding.h, input_y);
+                        if (iy < 0) {
+                            continue;
+                        }
+                        for (int32_t kx = 0; kx < kernel_x; kx++) {
+                            const int32_t ix = conv_transpose_source(ox, kx, pdat->stride.w, pdat->dilation.w, pdat->padding.w, input_x);
+                            if (ix < 0) {
+                                continue;
+                            }
+                            const int8_t *px = input_data + ((b * input_y + iy) * input_x + ix) * input_ch + g * in_ch;
+                            const int8_t *pw = filter_data + ((g * in_ch * kernel_y + ky) * kernel_x + kx) * out_ch + oc % out_ch;
+                            for (int32_t ic = 0; ic < in_ch; ic++) {
+                                sum += (px[ic] + pdat->input_offset) * pw[ic * kernel_y * kernel_x * out_ch];
+                            }
+                        }
+                    }
+                    sum = requantize(sum, mult_data[oc], shift_data[oc]) + pdat->output_offset;
+                    sum = MAX(sum, pdat->activation.min);
+                    sum = MIN(sum, pdat->activation.max);
+                    *output_data++ = (int8_t)sum;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+static const struct onnx_tensor_t *conv_transpose_bias(const struct onnx_node_t *n)
+{
+    return n->ninput > 2 && n->inputs[2] != NULL && n->inputs[2]->datas != NULL ? n->inputs[2] : NULL;
+}
+
+int ConvTranspose_float16(struct onnx_node_t *n)
+{
+    const struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const struct onnx_tensor_t *input = n->inputs[0];
+    const struct onnx_tensor_t *filter = n->inputs[1];
+    const struct onnx_tensor_t *bias = conv_transpose_bias(n);
+    struct onnx_tensor_t *output = n->outputs[0];
+
+    if (conv_transpose_check(pdat, input, filter, output) != 0) {
+        return -1;
+    }
+
+    const int32_t input_ch = input->dims[0];
+    const int32_t input_x = input->dims[1];
+    const int32_t input_y = input->dims[2];
+    const int32_t kernel_x = filter->dims[1];
+    const int32_t kernel_y = filter->dims[2];
+    const int32_t output_ch = output->dims[0];
+    const int32_t output_x = output->dims[1];
+    const int32_t output_y = output->dims[2];
+    const int32_t in_ch = input_ch / pdat->groups;
+    const int32_t out_ch = filter->dims[0];
+    const float16_t *input_data = (const float16_t *)input->datas;
+    const float16_t *filter_data = (const float16_t *)filter->datas;
+    const float16_t *bias_data = bias ? (const float16_t *)bias->datas : NULL;
+    float16_t *output_data = (float16_t *)output->datas;
+
+    for (int32_t b = 0; b < input->dims[3]; b++) {
+        for (int32_t oy = 0; oy < output_y; oy++) {
+            for (int32_t ox = 0; ox < output_x; ox++) {
+                for (int32_t oc = 0; oc < output_ch; oc++) {
+                    const int32_t g = oc / out_ch;
+                    float32_t sum = bias_data ? (float32_t)bias_data[oc] : 0.0f;
+                    for (int32_t ky = 0; ky < kernel_y; ky++) {
+                        const int32_t iy = conv_transpose_source(oy, ky, pdat->stride.h, pdat->dilation.h, pdat->padding.h, input_y);
+                        if (iy < 0) {
+                            continue;
+                        }
+                        for (int32_t kx = 0; kx < kernel_x; kx++) {
+                            const int32_t ix = conv_transpose_source(ox, kx, pdat->stride.w, pdat->dilation.w, pdat->padding.w, input_x);
+                            if (ix < 0) {
+                                continue;
+                            }
+                            const float16_t *px = input_data + ((b * input_y + iy) * input_x + ix) * input_ch + g * in_ch;
+                            const float16_t *pw = filter_data + ((g * in_ch * kernel_y + ky) * kernel_x + kx) * out_ch + oc % out_ch;
+                            for (int32_t ic = 0; ic < in_ch; ic++) {
+                                sum += (float32_t)px[ic] * (float32_t)pw[ic * kernel_y * kernel_x * out_ch];
+                            }
+                        }
+                    }
+                    *output_data++ = (float16_t)sum;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// taps k of a kernel with k * dilation % stride == phase
+static int32_t conv_transpose_taps(int32_t kernel, int32_t stride, int32_t dilation, int32_t phase)
+{
+    int32_t taps = 0;
+    for (int32_t k = 0; k < kernel; k++) {
+        taps += k * dilation % stride == phase;
+    }
+    return taps;
+}
+
+#if defined(__riscv_vector)
+// first output o with (o + pad) % stride == phase
+static int32_t conv_transpose_first(int32_t phase, int32_t stride, int32_t pad)
+{
+    return ((phase - pad) % stride + stride) % stride;
+}
+
+// outputs o < size from first on, one every stride
+static int32_t conv_transpose_count(int32_t first, int32_t stride, int32_t size)
+{
+    return first < size ? (size - first + stride - 1) / stride : 0;
+}
+
+/*
+ * filter [input_ch, kernel_h, kernel_w, output_ch / groups] to one
+ * [phase_cols, output_ch / groups] block per group and phase, phase_cols are
+ * the taps of the phase times input_ch / groups in im2col order.
+ */
+static void conv_transpose_pack_kernel(const struct operator_pdata_t *pdat, const struct onnx_tensor_t *filter, void *kernel_packed)
+{
+    const size_t esize = onnx_tensor_type_sizeof(filter->type);
+    const int32_t out_ch = filter->dims[0];
+    const int32_t kernel_x = filter->dims[1];
+    const int32_t kernel_y = filter->dims[2];
+    const int32_t in_ch = filter->dims[3] / pdat->groups;
+    const char *src = (const char *)filter->datas;
+    char *dst = (char *)kernel_packed;
+
+    for (int32_t g = 0; g < pdat->groups; g++) {
+        for (int32_t ry = 0; ry < pdat->stride.h; ry++) {
+            for (int32_t rx = 0; rx < pdat->stride.w; rx++) {
+                for (int32_t ky = 0; ky < kernel_y; ky++) {
+                    if (ky * pdat->dilation.h % pdat->stride.h != ry) {
+                        continue;
+                    }
+                    for (int32_t kx = 0; kx < kernel_x; kx++) {
+                        if (kx * pdat->dilation.w % pdat->stride.w != rx) {
+                            continue;
+                        }
+                        for (int32_t ic = 0; ic < in_ch; ic++) {
+                            memcpy(dst, src + (((g * in_ch + ic) * kernel_y + ky) * kernel_x + kx) * out_ch * esize, out_ch * esize);
+                            dst += out_ch * esize;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// im2col row of output pixel (ox, oy) in group g with input_offset added, taps outside of the input add nothing
+static void conv_transpose_s8_im2col_row(const struct operator_pdata_t *pdat, const struct onnx_tensor_t *input, const struct onnx_tensor_t *filter,
+                                         const int8_t *input_data, int32_t g, int32_t ox, int32_t oy, int16_t *col)
+{
+    const int32_t input_ch = input->dims[0];
+    const int32_t input_x = input->dims[1];
+    const int32_t input_y = input->dims[2];
+    const int32_t in_ch = input_ch / pdat->groups;
+    size_t avl, vl;
+
+    for (int32_t ky = 0; ky < filter->dims[2]; ky++) {
+        const int32_t t = oy + pdat->padding.h - ky * pdat->dilation.h;
+        if (t % pdat->stride.h != 0) {
+            continue;
+        }
+        for (int32_t kx = 0; kx < filter->dims[1]; kx++) {
+            const int32_t s = ox + pdat->padding.w - kx * pdat->dilation.w;
+            if (s % pdat->stride.w != 0) {
+                continue;
+            }
+            const int32_t iy = t / pdat->stride.h;
+            const int32_t ix = s / pdat->stride.w;
+            if (t < 0 || iy >= input_y || s < 0 || ix >= input_x) {
+                avl = in_ch;
+                for (int16_t *dst = col; (vl = __riscv_vsetvl_e16m2(avl)) > 0; avl -= vl) {
+                    __riscv_vse16_v_i16m2(dst, __riscv_vmv_v_x_i16m2(0, vl), vl);
+                    dst += vl;
+                }
+            } else {
+                const int8_t *src = input_data + (iy * input_x + ix) * input_ch + g * in_ch;
+                avl = in_ch;
+                for (int16_t *dst = col; (vl = __riscv_vsetvl_e8m1(avl)) > 0; avl -= vl) {
+                    vint16m2_t v = __riscv_vsext_vf2_i16m2(__riscv_vle8_v_i8m1(src, vl), vl);
+                    __riscv_vse16_v_i16m2(dst, __riscv_vadd_vx_i16m2(v, pdat->input_offset, vl), vl);
+                    src += vl;
+                    dst += vl;
+                }
+            }
+            col += in_ch;
+        }
+    }
+}
+
+// im2col row of output pixel (ox, oy) in group g, taps outside of the input are zero
+static void conv_transpose_im2col_row(const struct operator_pdata_t *pdat, const struct onnx_tensor_t *input, const struct onnx_tensor_t *filter,
+                                      const char *input_data, int32_t g, int32_t ox, int32_t oy, char *col)
+{
+    const size_t esize = onnx_tensor_type_sizeof(input->type);
+    const int32_t input_ch = input->dims[0];
+    const int32_t input_x = input->dims[1];
+    const int32_t input_y = input->dims[2];
+    const int32_t in_ch = input_ch / pdat->groups;
+
+    for (int32_t ky = 0; ky < filter->dims[2]; ky++) {
+        const int32_t t = oy + pdat->padding.h - ky * pdat->dilation.h;
+        if (t % pdat->stride.h != 0) {
+            continue;
+        }
+        for (int32_t kx = 0; kx < filter->dims[1]; kx++) {
+            const int32_t s = ox + pdat->padding.w - kx * pdat->dilation.w;
+            if (s % pdat->stride.w != 0) {
+                continue;
+            }
+            const int32_t iy = t / pdat->stride.h;
+            const int32_t ix = s / pdat->stride.w;
+            if (t < 0 || iy >= input_y || s < 0 || ix >= input_x) {
+                memset(col, 0, in_ch * esize);
+            } else {
+                memcpy(col, input_data + ((iy * input_x + ix) * input_ch + g * in_ch) * esize, in_ch * esize);
+            }
+            col += in_ch * esize;
+        }
+    }
+}
+
+/*
+ * Every group and phase: CONV_TRANSPOSE_ROWS output pixels of the phase are
+ * unrolled into int16 rows, then multiplied with the packed sub-filter along
+ * the output channels, every filter row loaded feeds CONV_TRANSPOSE_ROWS
+ * accumulators. The phases partition the output, every pixel is stored once.
+ */
+static void conv_transpose_s8_rvv(struct onnx_node_t *n)
+{
+    const struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const struct onnx_tensor_t *input = n->inputs[0];
+    const struct onnx_tensor_t *filter = n->inputs[1];
+    const struct onnx_tensor_t *bias = n->inputs[2];
+    const struct onnx_tensor_t *multiply = n->inputs[3];
+    const struct onnx_tensor_t *shift = n->inputs[4];
+    struct onnx_tensor_t *output = n->outputs[0];
+
+    const int32_t in_ch = input->dims[0] / pdat->groups;
+    const int32_t output_ch = output->dims[0];
+    const int32_t out_ch = filter->dims[0];
+    const int32_t output_x = output->dims[1];
+    const int32_t output_y = output->dims[2];
+    const int32_t *bias_data = (const int32_t *)bias->datas;
+    const int32_t out_offset = pdat->output_offset;
+    const int32_t act_min = pdat->activation.min;
+    const int32_t act_max = pdat->activation.max;
+    int16_t *col = (int16_t *)pdat->col;
+
+    for (int32_t batch_idx = 0; batch_idx < input->dims[3]; batch_idx++) {
+        const int8_t *input_data = (const int8_t *)input->datas + input->dims[2] * input->dims[1] * input->dims[0] * batch_idx;
+        int8_t *output_data = (int8_t *)output->datas + output_y * output_x * output_ch * batch_idx;
+        const int8_t *kernel = (const int8_t *)pdat->kernel_packed;
+
+        for (int32_t g = 0; g < pdat->groups; g++) {
+            for (int32_t ry = 0; ry < pdat->stride.h; ry++) {
+                const int32_t first_y = conv_transpose_first(ry, pdat->stride.h, pdat->padding.h);
+                const int32_t count_y = conv_transpose_count(first_y, pdat->stride.h, output_y);
+                const int32_t taps_y = conv_transpose_taps(filter->dims[2], pdat->stride.h, pdat->dilation.h, ry);
+                for (int32_t rx = 0; rx < pdat->stride.w; rx++) {
+                    const int32_t first_x = conv_transpose_first(rx, pdat->stride.w, pdat->padding.w);
+                    const int32_t count_x = conv_transpose_count(first_x, pdat->stride.w, output_x);
+                    const int32_t rhs_cols = taps_y * conv_transpose_taps(filter->dims[1], pdat->stride.w, pdat->dilation.w, rx) * in_ch;
+                    const int32_t pixels = count_x * count_y;
+
+                    for (int32_t p = 0; p < pixels; p += CONV_TRANSPOSE_ROWS) {
+                        const int32_t rows = MIN(CONV_TRANSPOSE_ROWS, pixels - p);
+                        int8_t *out[CONV_TRANSPOSE_ROWS];
+                        for (int32_t r = 0; r < rows; r++) {
+                            const int32_t ox = first_x + (p + r) % count_x * pdat->stride.w;
+                            const int32_t oy = first_y + (p + r) / count_x * pdat->stride.h;
+                            conv_transpose_s8_im2col_row(pdat, input, filter, input_data, g, ox, oy, col + r * rhs_cols);
+                            out[r] = output_data + (oy * output_x + ox) * output_ch + g * out_ch;
+                        }
+                        // rows past the last pixel repeat row 0, their results are dropped
+                        const int16_t *col0 = col;
+                        const int16_t *col1 = rows > 1 ? col + rhs_cols : col;
+                        const int16_t *col2 = rows > 2 ? col + 2 * rhs_cols : col;
+                        const int16_t *col3 = rows > 3 ? col + 3 * rhs_cols : col;
+
+                        size_t avl = out_ch, vl;
+                        for (int32_t oc = 0; (vl = __riscv_vsetvl_e32m4(avl)) > 0; avl -= vl, oc += vl) {
+                            const int32_t ch = g * out_ch + oc;
+                            vint32m4_t acc0;
+                            if (bias_data) {
+                                acc0 = __riscv_vle32_v_i32m4(bias_data + ch, vl);
+                            } else {
+                                acc0 = __riscv_vmv_v_x_i32m4(0, vl);
+                            }
+                            vint32m4_t acc1 = acc0;
+                            vint32m4_t acc2 = acc0;
+                            vint32m4_t acc3 = acc0;
+                            const int8_t *pk = kernel + oc;
+                            for (int32_t k = 0; k < rhs_cols; k++) {
+                                vint16m2_t w = __riscv_vsext_vf2_i16m2(__riscv_vle8_v_i8m1(pk, vl), vl);
+                                pk += out_ch;
+                                acc0 = __riscv_vwmacc_vx_i32m4(acc0, col0[k], w, vl);
+                                acc1 = __riscv_vwmacc_vx_i32m4(acc1, col1[k], w, vl);
+                                acc2 = __riscv_vwmacc_vx_i32m4(acc2, col2[k], w, vl);
+                                acc3 = __riscv_vwmacc_vx_i32m4(acc3, col3[k], w, vl);
+                            }
+
+                            vint32m4_t mult = __riscv_vle32_v_i32m4((const int32_t *)multiply->datas + ch, vl);
+                            vint32m4_t sft = __riscv_vle32_v_i32m4((const int32_t *)shift->datas + ch, vl);
+                            __riscv_vse8_v_i8m1(out[0] + oc, requantize_i32m4(acc0, mult, sft, out_offset, act_min, act_max, vl), vl);
+                            if (rows > 1) {
+                                __riscv_vse8_v_i8m1(out[1] + oc, requantize_i32m4(acc1, mult, sft, out_offset, act_min, act_max, vl), vl);
+                            }
+                            if (rows > 2) {
+                                __riscv_vse8_v_i8m1(out[2] + oc, requantize_i32m4(acc2, mult, sft, out_offset, act_min, act_max, vl), vl);
+                            }
+                            if (rows > 3) {
+                                __riscv_vse8_v_i8m1(out[3] + oc, requantize_i32m4(acc3, mult, sft, out_offset, act_min, act_max, vl), vl);
+                            }
+                        }
+                    }
+                    kernel += rhs_cols * out_ch;
+                }
+            }
+        }
+    }
+}
+
+// float16 phases, products are widened and accumulated in float32
+static void conv_transpose_float16_rvv(struct onnx_node_t *n)
+{
+    const struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const struct onnx_tensor_t *input = n->inputs[0];
+    const struct onnx_tensor_t *filter = n->inputs[1];
+    const struct onnx_tensor_t *bias = conv_transpose_bias(n);
+    struct onnx_tensor_t *output = n->outputs[0];
+
+    const int32_t in_ch = input->dims[0] / pdat->groups;
+    const int32_t output_ch = output->dims[0];
+    const int32_t out_ch = filter->dims[0];
+    const int32_t output_x = output->dims[1];
+    const int32_t output_y = output->dims[2];
+    const float16_t *bias_data = bias ? (const float16_t *)bias->datas : NULL;
+    float16_t *col = (float16_t *)pdat->col;
+
+    for (int32_t batch_idx = 0; batch_idx < input->dims[3]; batch_idx++) {
+        const char *input_data = (const char *)input->datas + input->dims[2] * input->dims[1] * input->dims[0] * batch_idx * sizeof(float16_t);
+        float16_t *output_data = (float16_t *)output->datas + output_y * output_x * output_ch * batch_idx;
+        const float16_t *kernel = (const float16_t *)pdat->kernel_packed;
+
+        for (int32_t g = 0; g < pdat->groups; g++) {
+            for (int32_t ry = 0; ry < pdat->stride.h; ry++) {
+                const int32_t first_y = conv_transpose_first(ry, pdat->stride.h, pdat->padding.h);
+                const int32_t count_y = conv_transpose_count(first_y, pdat->stride.h, output_y);
+                const int32_t taps_y = conv_transpose_taps(filter->dims[2], pdat->stride.h, pdat->dilation.h, ry);
+                for (int32_t rx = 0; rx < pdat->stride.w; rx++) {
+                    const int32_t first_x = conv_transpose_first(rx, pdat->stride.w, pdat->padding.w);
+                    const int32_t count_x = conv_transpose_count(first_x, pdat->stride.w, output_x);
+                    const int32_t rhs_cols = taps_y * conv_transpose_taps(filter->dims[1], pdat->stride.w, pdat->dilation.w, rx) * in_ch;
+                    const int32_t pixels = count_x * count_y;
+
+                    for (int32_t p = 0; p < pixels; p += CONV_TRANSPOSE_ROWS) {
+                        const int32_t rows = MIN(CONV_TRANSPOSE_ROWS, pixels - p);
+                        float16_t *out[CONV_TRANSPOSE_ROWS];
+                        for (int32_t r = 0; r < rows; r++) {
+                            const int32_t ox = first_x + (p + r) % count_x * pdat->stride.w;
+                            const int32_t oy = first_y + (p + r) / count_x * pdat->stride.h;
+                            conv_transpose_im2col_row(pdat, input, filter, input_data, g, ox, oy, (char *)(col + r * rhs_cols));
+                            out[r] = output_data + (oy * output_x + ox) * output_ch + g * out_ch;
+                        }
+                        // rows past the last pixel repeat row 0, their results are dropped
+                        const float16_t *col0 = col;
+                        const float16_t *col1 = rows > 1 ? col + rhs_cols : col;
+                        const float16_t *col2 = rows > 2 ? col + 2 * rhs_cols : col;
+                        const float16_t *col3 = rows > 3 ? col + 3 * rhs_cols : col;
+
+                        size_t avl = out_ch, vl;
+                        for (int32_t oc = 0; (vl = __riscv_vsetvl_e32m4(avl)) > 0; avl -= vl, oc += vl) {
+                            vfloat32m4_t acc0;
+                            if (bias_data) {
+                                acc0 = __riscv_vfwcvt_f_f_v_f32m4(__riscv_vle16_v_f16m2(bias_data + g * out_ch + oc, vl), vl);
+                            } else {
+                                acc0 = __riscv_vfmv_v_f_f32m4(0.0f, vl);
+                            }
+                            vfloat32m4_t acc1 = acc0;
+                            vfloat32m4_t acc2 = acc0;
+                            vfloat32m4_t acc3 = acc0;
+                            const float16_t *pk = kernel + oc;
+                            for (int32_t k = 0; k < rhs_cols; k++) {
+                                vfloat16m2_t w = __riscv_vle16_v_f16m2(pk, vl);
+                                pk += out_ch;
+                                acc0 = __riscv_vfwmacc_vf_f32m4(acc0, col0[k], w, vl);
+                                acc1 = __riscv_vfwmacc_vf_f32m4(acc1, col1[k], w, vl);
+                                acc2 = __riscv_vfwmacc_vf_f32m4(acc2, col2[k], w, vl);
+                                acc3 = __riscv_vfwmacc_vf_f32m4(acc3, col3[k], w, vl);
+                            }
+                            __riscv_vse16_v_f16m2(out[0] + oc, __riscv_vfncvt_f_f_w_f16m2(acc0, vl), vl);
+                            if (rows > 1) {
+                                __riscv_vse16_v_f16m2(out[1] + oc, __riscv_vfncvt_f_f_w_f16m2(acc1, vl), vl);
+                            }
+                            if (rows > 2) {
+                                __riscv_vse16_v_f16m2(out[2] + oc, __riscv_vfncvt_f_f_w_f16m2(acc2, vl), vl);
+                            }
+                            if (rows > 3) {
+                                __riscv_vse16_v_f16m2(out[3] + oc, __riscv_vfncvt_f_f_w_f16m2(acc3, vl), vl);
+                            }
+                        }
+                    }
+                    kernel += rhs_cols * out_ch;
+                }
+            }
+        }
+    }
+}
+
+int ConvTransposeInteger_rvv(struct onnx_node_t *n)
+{
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    if (pdat->buf == NULL) {
+        // parameters generated for the scalar kernel
+        return ConvTransposeInteger(n);
+    }
+    if (conv_transpose_check(pdat, n->inputs[0], n->inputs[1], n->outputs[0]) != 0) {
+        return -1;
+    }
+    if (!pdat->kernel_ready) {
+        // weights bound after GenerateConvTransposeIntegerParam, pack them once
+        PrepareConvTransposeWeights(pdat, n->inputs[1]);
+    }
+    conv_transpose_s8_rvv(n);
+    return 0;
+}
+
+int ConvTranspose_float16_rvv(struct onnx_node_t *n)
+{
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    if (pdat->buf == NULL) {
+        // parameters generated for the scalar kernel
+        return ConvTranspose_float16(n);
+    }
+    if (conv_transpose_check(pdat, n->inputs[0], n->inputs[1], n->outputs[0]) != 0) {
+        return -1;
+    }
+    if (!pdat->kernel_ready) {
+        // weights bound after GenerateConvTransposeParam, pack them once
+        PrepareConvTransposeWeights(pdat, n->inputs[1]);
+    }
+    conv_transpose_float16_rvv(n);
+    return 0;
+}
+#endif /* defined(__riscv_vector) */
+
+static void *conv_transpose_generate(int32_t stride_w, int32_t stride_h, int32_t dilation_w, int32_t dilation_h, int32_t pad_w, int32_t pad_h,
+                                     int32_t output_padding_w, int32_t output_padding_h, const struct onnx_tensor_t *input,
+                                     const struct onnx_tensor_t *filter, const struct onnx_tensor_t *output, _Bool rvv)
+{
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)MALLOC_ASSERT(sizeof(struct operator_pdata_t));
+    pdat->stride.w = stride_w;
+    pdat->stride.h = stride_h;
+    pdat->dilation.w = dilation_w;
+    pdat->dilation.h = dilation_h;
+    pdat->padding.w = pad_w;
+    pdat->padding.h = pad_h;
+    pdat->output_padding.w = output_padding_w;
+    pdat->output_padding.h = output_padding_h;
+    pdat->groups = output->dims[0] / filter->dims[0];
+    pdat->input_offset = 0;
+    pdat->output_offset = 0;
+    pdat->activation.min = -128;
+    pdat->activation.max = 127;
+    pdat->buf = NULL;
+    pdat->buf_size = 0;
+    pdat->col = NULL;
+    pdat->kernel_packed = NULL;
+    pdat->kernel_ready = 0;
+
+#if !defined(__riscv_vector)
+    // ConvTranspose*_rvv falls back to the scalar kernel, which needs no buffer
+    rvv = 0;
+#endif
+    if (!rvv) {
+        return pdat;
+    }
+
+    // CONV_TRANSPOSE_ROWS im2col rows of the phase with the most taps, and the packed filter of the same size as the filter
+    const size_t esize = onnx_tensor_type_sizeof(filter->type);
+    const size_t col_esize = input->type == ONNX_TENSOR_TYPE_INT8 ? sizeof(int16_t) : esize;
+    int32_t taps_x = 0, taps_y = 0;
+    for (int32_t r = 0; r < stride_w; r++) {
+        taps_x = MAX(taps_x, conv_transpose_taps(filter->dims[1], stride_w, dilation_w, r));
+    }
+    for (int32_t r = 0; r < stride_h; r++) {
+        taps_y = MAX(taps_y, conv_transpose_taps(filter->dims[2], stride_h, dilation_h, r));
+    }
+    const size_t col_sz = CONV_TRANSPOSE_ROWS * taps_x * taps_y * (input->dims[0] / pdat->groups) * col_esize;
+    pdat->buf_size = col_sz + filter->ndata * esize;
+    pdat->buf = MALLOC_ASSERT(pdat->buf_size);
+    pdat->col = pdat->buf;
+    pdat->kernel_packed = (char *)pdat->buf + col_sz;
+    if (filter->datas != NULL) {
+        PrepareConvTransposeWeights(pdat, filter);
+    }
+    return pdat;
+}
+
+void *GenerateConvTransposeIntegerParam(int32_t in_offset, int32_t out_offset, int32_t stride_w, int32_t stride_h, int32_t dilation_w,
+                                        int32_t dilation_h, int32_t pad_w, int32_t pad_h, int32_t output_padding_w, int32_t output_padding_h,
+                                        int32_t activation_min, int32_t activation_max, const struct onnx_tensor_t *input,
+                                        const struct onnx_tensor_t *filter, const struct onnx_tensor_t *output, _Bool rvv)
+{
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)conv_transpose_generate(
+        stride_w, stride_h, dilation_w, dilation_h, pad_w, pad_h, output_padding_w, output_padding_h, input, filter, output, rvv);
+    pdat->input_offset = in_offset;
+    pdat->output_offset = out_offset;
+    pdat->activation.min = activation_min;
+    pdat->activation.max = activation_max;
+    return pdat;
+}
+
+void *GenerateConvTransposeParam(int32_t stride_w, int32_t stride_h, int32_t dilation_w, int32_t dilation_h, int32_t pad_w, int32_t pad_h,
+                                 int32_t output_padding_w, int32_t output_padding_h, const struct onnx_tensor_t *input,
+                                 const struct onnx_tensor_t *filter, const struct onnx_tensor_t *output, _Bool rvv)
+{
+    return conv_transpose_generate(stride_w, stride_h, dilation_w, dilation_h, pad_w, pad_h, output_padding_w, output_padding_h, input, filter,
+                                   output, rvv);
+}
+
+int PrepareConvTransposeWeights(void *pdat, const struct onnx_tensor_t *filter)
+{
+    struct operator_pdata_t *_pdat = (struct operator_pdata_t *)pdat;
+#if defined(__riscv_vector)
+    if (_pdat->kernel_packed != NULL) {
+        conv_transpose_pack_kernel(_pdat, filter, _pdat->kernel_packed);
+    }
+#else
+    (void)filter;
+#endif
+    // the scalar kernel reads the filter directly
+    _pdat->kernel_ready = 1;
+    return 0;
+}
+
+void FreeConvTransposeParam(void **pdat)
+{
+    struct operator_pdata_t *_pdat = (struct operator_pdata_t *)*pdat;
+    if (_pdat->buf != NULL) {
+        free(_pdat->buf);
+        _pdat->buf = NULL;
+        _pdat->buf_size = 0;
+    }
+    free(*pdat);
+    *pdat = NULL;
+}
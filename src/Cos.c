@@ -18,6 +18,7 @@ void Cos_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Cos_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -59,6 +60,7 @@ void Cos_float16_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Cos_float32(struct onnx_node_t *n)
 {
@@ -73,6 +75,7 @@ void Cos_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Cos_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -113,3 +116,4 @@ void Cos_float32_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
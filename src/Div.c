@@ -19,6 +19,7 @@ void Div_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Div_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *y = n->outputs[0];
@@ -40,6 +41,7 @@ void Div_float16_rvv(struct onnx_node_t *n)
         py += l;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Div_float32(struct onnx_node_t *n)
 {
@@ -55,6 +57,7 @@ void Div_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Div_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *y = n->outputs[0];
@@ -77,3 +80,4 @@ void Div_float32_rvv(struct onnx_node_t *n)
         py += l;
     }
 }
+#endif /* defined(__riscv_vector) */
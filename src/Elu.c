@@ -23,6 +23,7 @@ void Elu_float16(struct onnx_node_t *n)
         py[i] = (px[i] < 0) ? (expf(px[i]) - 1.) * alpha : px[i];
 }
 
+#if defined(__riscv_vector)
 void Elu_float16_rvv(struct onnx_node_t *n)
 {
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
@@ -71,6 +72,7 @@ void Elu_float16_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Elu_float32(struct onnx_node_t *n)
 {
@@ -85,6 +87,7 @@ void Elu_float32(struct onnx_node_t *n)
         py[i] = (px[i] < 0) ? (expf(px[i]) - 1.) * alpha : px[i];
 }
 
+#if defined(__riscv_vector)
 void Elu_float32_rvv(struct onnx_node_t *n)
 {
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
@@ -133,6 +136,7 @@ void Elu_float32_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void *GenerateEluParam(float32_t alpha)
 {
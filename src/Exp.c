@@ -17,6 +17,7 @@ void Exp_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Exp_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -54,6 +55,7 @@ void Exp_float16_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Exp_float32(struct onnx_node_t *n)
 {
@@ -66,6 +68,7 @@ void Exp_float32(struct onnx_node_t *n)
         py[i] = expf(px[i]);
 }
 
+#if defined(__riscv_vector)
 void Exp_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -103,3 +106,4 @@ void Exp_float32_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
@@ -70,6 +70,7 @@ void Flip_int8(struct onnx_node_t *node)
     }
 }
 
+#if defined(__riscv_vector)
 void Flip_int8_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -127,6 +128,7 @@ void Flip_int8_rvv(struct onnx_node_t *node)
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Flip_int32(struct onnx_node_t *node)
 {
@@ -168,6 +170,7 @@ void Flip_int32(struct onnx_node_t *node)
     }
 }
 
+#if defined(__riscv_vector)
 void Flip_int32_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -225,6 +228,7 @@ void Flip_int32_rvv(struct onnx_node_t *node)
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Flip_float16(struct onnx_node_t *node)
 {
@@ -266,6 +270,7 @@ void Flip_float16(struct onnx_node_t *node)
     }
 }
 
+#if defined(__riscv_vector)
 void Flip_float16_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -323,6 +328,7 @@ void Flip_float16_rvv(struct onnx_node_t *node)
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Flip_float32(struct onnx_node_t *node)
 {
@@ -364,6 +370,7 @@ void Flip_float32(struct onnx_node_t *node)
     }
 }
 
+#if defined(__riscv_vector)
 void Flip_float32_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -421,6 +428,7 @@ void Flip_float32_rvv(struct onnx_node_t *node)
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void *GenerateFlipParam(int flip_axis0, int flip_axis1)
 {
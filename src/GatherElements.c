@@ -62,6 +62,7 @@ void GatherElements_int8(struct onnx_node_t *node)
     }
 }
 
+#if defined(__riscv_vector)
 void GatherElements_int8_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -123,6 +124,7 @@ void GatherElements_int8_rvv(struct onnx_node_t *node)
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void GatherElements_int32(struct onnx_node_t *node)
 {
@@ -156,6 +158,7 @@ void GatherElements_int32(struct onnx_node_t *node)
     }
 }
 
+#if defined(__riscv_vector)
 void GatherElements_int32_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -218,6 +221,7 @@ void GatherElements_int32_rvv(struct onnx_node_t *node)
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void GatherElements_float16(struct onnx_node_t *node)
 {
@@ -251,6 +255,7 @@ void GatherElements_float16(struct onnx_node_t *node)
     }
 }
 
+#if defined(__riscv_vector)
 void GatherElements_float16_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -313,6 +318,7 @@ void GatherElements_float16_rvv(struct onnx_node_t *node)
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void GatherElements_float32(struct onnx_node_t *node)
 {
@@ -346,6 +352,7 @@ void GatherElements_float32(struct onnx_node_t *node)
     }
 }
 
+#if defined(__riscv_vector)
 void GatherElements_float32_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -407,4 +414,5 @@ void GatherElements_float32_rvv(struct onnx_node_t *node)
             }
         }
     }
-}
\ No newline at end of file
+}
+#endif /* defined(__riscv_vector) */
\ No newline at end of file
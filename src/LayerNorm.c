@@ -42,17 +42,19 @@ void LayerNormalization_float16(struct onnx_node_t *n)
     }
 }
 
-void LayerNormalization_float16_rvv(struct onnx_node_t *n)
+#if defined(__riscv_vector)
+// rows [start, end) of y
+static void layernorm_float16_rvv(void *arg, int start, int end)
 {
+    struct onnx_node_t *n = (struct onnx_node_t *)arg;
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
     struct onnx_tensor_t *x = n->inputs[0];
     struct onnx_tensor_t *y = n->outputs[0];
     float16_t *px = (float16_t *)x->datas;
     float16_t *py = (float16_t *)y->datas;
-    int N = x->dims[0];
     int D = x->dims[1];
 
-    for (int i = 0; i < N; i++) {
+    for (int i = start; i < end; i++) {
         float16_t mean = 0;
         float16_t variance = 0;
 
@@ -97,6 +99,12 @@ void LayerNormalization_float16_rvv(struct onnx_node_t *n)
     }
 }
 
+void LayerNormalization_float16_rvv(struct onnx_node_t *n)
+{
+    onnx_parallel_for(n->inputs[0]->dims[0], 1, layernorm_float16_rvv, n);
+}
+#endif /* defined(__riscv_vector) */
+
 void LayerNormalization_float32(struct onnx_node_t *n)
 {
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
@@ -128,17 +136,19 @@ void LayerNormalization_float32(struct onnx_node_t *n)
     }
 }
 
-void LayerNormalization_float32_rvv(struct onnx_node_t *n)
+#if defined(__riscv_vector)
+// rows [start, end) of y
+static void layernorm_float32_rvv(void *arg, int start, int end)
 {
+    struct onnx_node_t *n = (struct onnx_node_t *)arg;
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
     struct onnx_tensor_t *x = n->inputs[0];
     struct onnx_tensor_t *y = n->outputs[0];
     float32_t *px = (float32_t *)x->datas;
     float32_t *py = (float32_t *)y->datas;
-    int N = x->dims[0];
     int D = x->dims[1];
 
-    for (int i = 0; i < N; i++) {
+    for (int i = start; i < end; i++) {
         float32_t mean = 0.0f;
         float32_t variance = 0.0f;
 
@@ -183,6 +193,12 @@ void LayerNormalization_float32_rvv(struct onnx_node_t *n)
     }
 }
 
+void LayerNormalization_float32_rvv(struct onnx_node_t *n)
+{
+    onnx_parallel_for(n->inputs[0]->dims[0], 1, layernorm_float32_rvv, n);
+}
+#endif /* defined(__riscv_vector) */
+
 void *GenerateLayerNormParam(float epsilon, float momentum)
 {
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)MALLOC_ASSERT(sizeof(struct operator_pdata_t));
@@ -18,6 +18,7 @@ void Log_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Log_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -57,6 +58,7 @@ void Log_float16_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Log_float32(struct onnx_node_t *n)
 {
@@ -71,6 +73,7 @@ void Log_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Log_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -110,3 +113,4 @@ void Log_float32_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
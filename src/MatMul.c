@@ -4,45 +4,489 @@
  */
 
 #include "operators.h"
+#include "utils.h"
 
 // Following numpy.matmul for shape inference:
 // https://docs.scipy.org/doc/numpy/reference/generated/numpy.matmul.html
 // TODO(jdqiu): implement MatMul as onnxruntime
-// assert(a->ndim == 2 && b->ndim == 2 && a->dims[1] == b->dims[0]);
 
-void MatMul_int8(struct onnx_node_t *n)
+struct operator_pdata_t {
+    struct onnx_epilogue_t epilogue;
+    _Bool has_epilogue;
+    int32_t k;          /**< rows of B */
+    int32_t n;          /**< columns of B */
+    size_t esize;
+    size_t ndata;       /**< elements of B, all matrices of its batch */
+    enum matmul_accumulate_t accumulate;
+    size_t nr;          /**< columns of a panel of the rvv micro-kernel */
+    size_t kc;          /**< rows of a block of packed, all k with float32 sums */
+    void *packed;       /**< B as the blocks of the blocked GEMM one after the other, NULL without rvv */
+    _Bool kernel_ready; /**< packed holds the current B */
+};
+
+// one product y [m, n] = a [m, k] x b [k, n] of the batch
+struct matmul_t {
+    const void *a;
+    const void *b;
+    void *y;
+    const void *y0;                  // the output of the node, the epilogue indexes the residual from it
+    size_t m, k, n;
+    const struct onnx_epilogue_t *e; // NULL, or the epilogue of the parameters
+    _Bool acc32;                     // float32 sums of the float16 MatMul
+    const void *packed;              // NULL, or b packed by matmul_pack_b_all
+    void *pack;                      // NULL, or room for one block of b of matmul_gemm, owned by the thread of the batch
+};
+
+// NULL or the epilogue of GenerateMatMulParam
+static const struct onnx_epilogue_t *matmul_epilogue_param(const struct onnx_node_t *n)
+{
+    const struct operator_pdata_t *pdat = (const struct operator_pdata_t *)n->priv;
+    return pdat != NULL && pdat->has_epilogue ? &pdat->epilogue : NULL;
+}
+
+// float32 sums of the float16 MatMul
+static _Bool matmul_accumulate_float32(const struct onnx_node_t *n)
+{
+    const struct operator_pdata_t *pdat = (const struct operator_pdata_t *)n->priv;
+    return pdat != NULL && pdat->accumulate == MATMUL_ACCUMULATE_FLOAT32 && n->inputs[1]->type == ONNX_TENSOR_TYPE_FLOAT16;
+}
+
+// epilogue of the float MatMul on y[i], see struct onnx_epilogue_t
+static float32_t matmul_epilogue(const struct onnx_epilogue_t *e, float32_t val, size_t i)
+{
+    if (e->residual != NULL) {
+        if (e->residual->type == ONNX_TENSOR_TYPE_FLOAT16) {
+            val += e->residual_scale * (float32_t)((const float16_t *)e->residual->datas)[i];
+        } else {
+            val += e->residual_scale * ((const float32_t *)e->residual->datas)[i];
+        }
+    }
+    switch (e->activation) {
+        case ONNX_ACTIVATION_RELU:
+            return MAX(val, 0.0f);
+        case ONNX_ACTIVATION_RELU6:
+            return MIN(MAX(val, 0.0f), 6.0f);
+        case ONNX_ACTIVATION_CLAMP:
+            return MIN(MAX(val, e->min), e->max);
+        case ONNX_ACTIVATION_SILU:
+            return val / (1.0f + expf(-val));
+        default:
+            return val;
+    }
+}
+
+#if defined(__riscv_vector)
+// x / (1 + exp(-x)) with the exp of Silu_float32_rvv, the exponent is clamped to stay a normal float
+__STATIC_FORCEINLINE vfloat32m8_t matmul_silu_f32m8(vfloat32m8_t val, size_t vl)
+{
+    vfloat32m8_t vx = __riscv_vfmul_vf_f32m8(val, -1.4426950408889634f, vl); // -log2(e)
+    vx = __riscv_vfmin_vf_f32m8(__riscv_vfmax_vf_f32m8(vx, -126.0f, vl), 126.0f, vl);
+    vint32m8_t vx_int = __riscv_vfcvt_rtz_x_f_v_i32m8(vx, vl);
+    vx = __riscv_vfsub_vv_f32m8(vx, __riscv_vfcvt_f_x_v_f32m8(vx_int, vl), vl);
+    vfloat32m8_t vy = __riscv_vreinterpret_v_i32m8_f32m8(__riscv_vmul_vx_i32m8(__riscv_vadd_vx_i32m8(vx_int, 127, vl), (1 << 23), vl));
+
+    vx = __riscv_vfmul_vf_f32m8(vx, 0.693147180559945f, vl);                                    // ln2
+    vfloat32m8_t vz = __riscv_vfmul_vf_f32m8(vx, 1.0 / 5040, vl);                               // 1/7!
+    vz = __riscv_vfmul_vv_f32m8(vx, __riscv_vfadd_vf_f32m8(vz, 1.0 / 720, vl), vl);             // 1/6!
+    vz = __riscv_vfmul_vv_f32m8(vx, __riscv_vfadd_vf_f32m8(vz, 1.0 / 120, vl), vl);             // 1/5!
+    vz = __riscv_vfmul_vv_f32m8(vx, __riscv_vfadd_vf_f32m8(vz, 1.0 / 24, vl), vl);              // 1/4!
+    vz = __riscv_vfmul_vv_f32m8(vx, __riscv_vfadd_vf_f32m8(vz, 1.0 / 6, vl), vl);               // 1/3!
+    vz = __riscv_vfmul_vv_f32m8(vx, __riscv_vfadd_vf_f32m8(vz, 1.0 / 2, vl), vl);               // 1/2!
+    vz = __riscv_vfmul_vv_f32m8(vx, __riscv_vfadd_vf_f32m8(vz, 1.0, vl), vl);                   // 1/1!
+    vy = __riscv_vfmul_vv_f32m8(vy, __riscv_vfadd_vf_f32m8(vz, 1.0f, vl), vl);
+    return __riscv_vfdiv_vv_f32m8(val, __riscv_vfadd_vf_f32m8(vy, 1.0f, vl), vl);
+}
+
+// float16 version with the exp of Silu_float16_rvv
+__STATIC_FORCEINLINE vfloat16m8_t matmul_silu_f16m8(vfloat16m8_t val, size_t vl)
+{
+    vfloat16m8_t vx = __riscv_vfmul_vf_f16m8(val, -1.4426950408889634f, vl); // -log2(e)
+    vx = __riscv_vfmin_vf_f16m8(__riscv_vfmax_vf_f16m8(vx, -14.0f, vl), 15.0f, vl);
+    vint16m8_t vx_int = __riscv_vfcvt_rtz_x_f_v_i16m8(vx, vl);
+    vx = __riscv_vfsub_vv_f16m8(vx, __riscv_vfcvt_f_x_v_f16m8(vx_int, vl), vl);
+    vfloat16m8_t vy = __riscv_vreinterpret_v_i16m8_f16m8(__riscv_vmul_vx_i16m8(__riscv_vadd_vx_i16m8(vx_int, 15, vl), (1 << 10), vl));
+
+    vx = __riscv_vfmul_vf_f16m8(vx, 0.693147180559945f, vl);                                    // ln2
+    vfloat16m8_t vz = __riscv_vfmul_vf_f16m8(vx, 1.0 / 5040, vl);                               // 1/7!
+    vz = __riscv_vfmul_vv_f16m8(vx, __riscv_vfadd_vf_f16m8(vz, 1.0 / 720, vl), vl);             // 1/6!
+    vz = __riscv_vfmul_vv_f16m8(vx, __riscv_vfadd_vf_f16m8(vz, 1.0 / 120, vl), vl);             // 1/5!
+    vz = __riscv_vfmul_vv_f16m8(vx, __riscv_vfadd_vf_f16m8(vz, 1.0 / 24, vl), vl);              // 1/4!
+    vz = __riscv_vfmul_vv_f16m8(vx, __riscv_vfadd_vf_f16m8(vz, 1.0 / 6, vl), vl);               // 1/3!
+    vz = __riscv_vfmul_vv_f16m8(vx, __riscv_vfadd_vf_f16m8(vz, 1.0 / 2, vl), vl);               // 1/2!
+    vz = __riscv_vfmul_vv_f16m8(vx, __riscv_vfadd_vf_f16m8(vz, 1.0, vl), vl);                   // 1/1!
+    vy = __riscv_vfmul_vv_f16m8(vy, __riscv_vfadd_vf_f16m8(vz, 1.0f, vl), vl);
+    return __riscv_vfdiv_vv_f16m8(val, __riscv_vfadd_vf_f16m8(vy, 1.0f, vl), vl);
+}
+
+// matmul_epilogue on y[i, i + vl) before it is stored
+__STATIC_FORCEINLINE vfloat32m8_t matmul_epilogue_f32m8(const struct onnx_epilogue_t *e, vfloat32m8_t val, size_t i, size_t vl)
+{
+    if (e->residual != NULL && e->residual->type == ONNX_TENSOR_TYPE_FLOAT16) {
+        // float32 sums of the float16 MatMul
+        vfloat32m8_t residual = __riscv_vfwcvt_f_f_v_f32m8(__riscv_vle16_v_f16m4((const float16_t *)e->residual->datas + i, vl), vl);
+        val = __riscv_vfmacc_vf_f32m8(val, e->residual_scale, residual, vl);
+    } else if (e->residual != NULL) {
+        val = __riscv_vfmacc_vf_f32m8(val, e->residual_scale, __riscv_vle32_v_f32m8((const float32_t *)e->residual->datas + i, vl), vl);
+    }
+    switch (e->activation) {
+        case ONNX_ACTIVATION_RELU:
+            return __riscv_vfmax_vf_f32m8(val, 0.0f, vl);
+        case ONNX_ACTIVATION_RELU6:
+            return __riscv_vfmin_vf_f32m8(__riscv_vfmax_vf_f32m8(val, 0.0f, vl), 6.0f, vl);
+        case ONNX_ACTIVATION_CLAMP:
+            return __riscv_vfmin_vf_f32m8(__riscv_vfmax_vf_f32m8(val, e->min, vl), e->max, vl);
+        case ONNX_ACTIVATION_SILU:
+            return matmul_silu_f32m8(val, vl);
+        default:
+            return val;
+    }
+}
+
+__STATIC_FORCEINLINE vfloat16m8_t matmul_epilogue_f16m8(const struct onnx_epilogue_t *e, vfloat16m8_t val, size_t i, size_t vl)
+{
+    if (e->residual != NULL) {
+        val = __riscv_vfmacc_vf_f16m8(val, e->residual_scale, __riscv_vle16_v_f16m8((const float16_t *)e->residual->datas + i, vl), vl);
+    }
+    switch (e->activation) {
+        case ONNX_ACTIVATION_RELU:
+            return __riscv_vfmax_vf_f16m8(val, 0.0f, vl);
+        case ONNX_ACTIVATION_RELU6:
+            return __riscv_vfmin_vf_f16m8(__riscv_vfmax_vf_f16m8(val, 0.0f, vl), 6.0f, vl);
+        case ONNX_ACTIVATION_CLAMP:
+            return __riscv_vfmin_vf_f16m8(__riscv_vfmax_vf_f16m8(val, e->min, vl), e->max, vl);
+        case ONNX_ACTIVATION_SILU:
+            return matmul_silu_f16m8(val, vl);
+        default:
+            return val;
+    }
+}
+
+// the m4 accumulators of the 4 rows blocks run the m8 epilogue on their lower half
+__STATIC_FORCEINLINE vfloat32m4_t matmul_epilogue_f32m4(const struct onnx_epilogue_t *e, vfloat32m4_t val, size_t i, size_t vl)
+{
+    return __riscv_vlmul_trunc_v_f32m8_f32m4(matmul_epilogue_f32m8(e, __riscv_vlmul_ext_v_f32m4_f32m8(val), i, vl));
+}
+
+__STATIC_FORCEINLINE vfloat16m4_t matmul_epilogue_f16m4(const struct onnx_epilogue_t *e, vfloat16m4_t val, size_t i, size_t vl)
+{
+    return __riscv_vlmul_trunc_v_f16m8_f16m4(matmul_epilogue_f16m8(e, __riscv_vlmul_ext_v_f16m4_f16m8(val), i, vl));
+}
+
+// the m2 accumulators of the micro-kernels of the blocked GEMM
+__STATIC_FORCEINLINE vfloat32m2_t matmul_epilogue_f32m2(const struct onnx_epilogue_t *e, vfloat32m2_t val, size_t i, size_t vl)
+{
+    return __riscv_vlmul_trunc_v_f32m8_f32m2(matmul_epilogue_f32m8(e, __riscv_vlmul_ext_v_f32m2_f32m8(val), i, vl));
+}
+
+__STATIC_FORCEINLINE vfloat16m2_t matmul_epilogue_f16m2(const struct onnx_epilogue_t *e, vfloat16m2_t val, size_t i, size_t vl)
+{
+    return __riscv_vlmul_trunc_v_f16m8_f16m2(matmul_epilogue_f16m8(e, __riscv_vlmul_ext_v_f16m2_f16m8(val), i, vl));
+}
+
+/*
+ * Blocked GEMM of the float MatMul once B outgrows the data cache. B is
+ * packed one block of GEMM_KC rows by GEMM_NC columns at a time into panels
+ * of nr columns, kc rows of nr contiguous values each, so the micro-kernel
+ * reads a panel sequentially and keeps it in L1 while it sweeps up to GEMM_MC
+ * rows of A, which stay in L2 across the panels of the block. The micro-kernel
+ * holds GEMM_MR rows by nr columns of y in LMUL 2 accumulators: 8 rows x m2
+ * use 16 vector registers like the 4 rows x m4 of the unblocked kernel, but
+ * load B half as often per FMA. Blocks of K after the first accumulate on y,
+ * the epilogue runs with the last one. The float16 MatMul with float32
+ * accumulators takes 4 rows of m4 sums over all of K in one block instead, so
+ * y is rounded to float16 only once.
+ */
+#define GEMM_MR (8)
+#define GEMM_MC (64)
+#define GEMM_KC (256)
+#define GEMM_NC (256)
+// B up to this size stays in the data cache, the unblocked kernel streams it as is
+#define GEMM_MIN_BYTES (32 * 1024)
+
+struct matmul_gemm_t {
+    const void *a;                   // [m, k]
+    void *y;                         // [m, n]
+    const void *y0;                  // element 0 of the epilogue
+    const struct onnx_epilogue_t *e; // NULL, or applied on the last block of K
+    size_t m, k, n;
+    size_t nr;                       // columns of a panel, the vlmax of the micro-kernel
+    size_t kcb;                      // rows of a block of B, GEMM_KC or k
+    const void *prepacked;           // NULL, or all blocks of B packed by PrepareMatMulWeights
+    void *pack;                      // room for one block of B, NULL with prepacked
+    const void *packed;              // panels of the current block of B
+    size_t pc, kc;                   // rows of the block
+    size_t jc, nc;                   // columns of the block
+};
+
+// rows [pc, pc + kc) and columns [jc, jc + nc) of b [k, n] into panels of nr columns
+static void matmul_pack_b(const void *b, size_t n, size_t esize, size_t pc, size_t kc, size_t jc, size_t nc, size_t nr, void *packed)
+{
+    const char *pb = (const char *)b + (pc * n + jc) * esize;
+    char *pp = (char *)packed;
+
+    for (size_t j = 0; j < nc; j += nr) {
+        const size_t w = MIN(nr, nc - j) * esize;
+        for (size_t kk = 0; kk < kc; kk++) {
+            memcpy(pp, pb + (kk * n + j) * esize, w);
+            pp += w;
+        }
+    }
+}
+
+// all blocks of kcb rows of b [k, n] in the order of matmul_gemm, the block at (pc, jc) starts at jc * k + pc * nc
+static void matmul_pack_b_all(const void *b, size_t k, size_t n, size_t esize, size_t nr, size_t kcb, void *packed)
+{
+    for (size_t jc = 0; jc < n; jc += GEMM_NC) {
+        const size_t nc = MIN(GEMM_NC, n - jc);
+        for (size_t pc = 0; pc < k; pc += kcb) {
+            matmul_pack_b(b, n, esize, pc, MIN(kcb, k - pc), jc, nc, nr, (char *)packed + (jc * k + pc * nc) * esize);
+        }
+    }
+}
+
+// bytes of one block of B of matmul_gemm
+static size_t matmul_pack_size(size_t k, size_t n, size_t esize, size_t kcb)
+{
+    return MIN(k, kcb) * MIN(n, GEMM_NC) * esize;
+}
+
+// y = a * b, blocks runs the micro-kernels on rows [start, end) of y for the current block of B
+static void matmul_gemm(struct matmul_gemm_t *g, const void *b, size_t esize, onnx_parallel_fn_t blocks)
 {
-    struct onnx_tensor_t *y = n->outputs[0];
-    struct onnx_tensor_t *a = n->inputs[0];
-    struct onnx_tensor_t *b = n->inputs[1];
-    int8_t *py = (int8_t *)y->datas;
-    int8_t *pa = (int8_t *)a->datas;
-    int8_t *pb = (int8_t *)b->datas;
+    for (g->jc = 0; g->jc < g->n; g->jc += GEMM_NC) {
+        g->nc = MIN(GEMM_NC, g->n - g->jc);
+        for (g->pc = 0; g->pc < g->k; g->pc += g->kcb) {
+            g->kc = MIN(g->kcb, g->k - g->pc);
+            if (g->prepacked != NULL) {
+                g->packed = (const char *)g->prepacked + (g->jc * g->k + g->pc * g->nc) * esize;
+            } else {
+                matmul_pack_b(b, g->n, esize, g->pc, g->kc, g->jc, g->nc, g->nr, g->pack);
+                g->packed = g->pack;
+            }
+            // keep the GEMM_MR rows of the micro-kernel inside one chunk
+            onnx_parallel_for(g->m, GEMM_MR, blocks, g);
+        }
+    }
+}
+
+// matmul_pack_b_all of every matrix of b [batch, k, n], each at the offset of its matrix in b
+static void matmul_pack_b_batch(const void *b, size_t ndata, size_t k, size_t n, size_t esize, size_t nr, size_t kcb, void *packed)
+{
+    for (size_t i = 0; k * n > 0 && i < ndata; i += k * n) {
+        matmul_pack_b_all((const char *)b + i * esize, k, n, esize, nr, kcb, (char *)packed + i * esize);
+    }
+}
+
+// packed B of GenerateMatMulParam for a [m, k] x b [batch..., k, n], NULL when it doesn't match or isn't ready
+static const void *matmul_prepacked(const struct onnx_node_t *n)
+{
+    const struct operator_pdata_t *pdat = (const struct operator_pdata_t *)n->priv;
+    const struct onnx_tensor_t *b = n->inputs[1];
+    if (pdat == NULL || pdat->packed == NULL || !pdat->kernel_ready || pdat->k != b->dims[1] || pdat->n != b->dims[0] ||
+        pdat->ndata != b->ndata || pdat->esize != (size_t)onnx_tensor_type_sizeof(b->type)) {
+        return NULL;
+    }
+    return pdat->packed;
+}
+#endif /* defined(__riscv_vector) */
+
+/*
+ * Batched MatMul following numpy.matmul: a [batch..., m, k] and b [batch...,
+ * k, n], dims [k, m, batch...] and [n, k, batch...] here, broadcast over the
+ * batch dims, a missing dim or a dim of 1 repeats the matrix for every index
+ * of the other input (stride 0). y is [batch..., m, n] of the broadcast dims.
+ * A b shared by all batches of a is one product of all rows of a. Otherwise
+ * the blocked GEMM packs every matrix of b once for all batches sharing it,
+ * and the parallel kernels take whole batches per thread when there are
+ * enough of them for all threads, the kernels of a batch run on one thread.
+ * The blocks of B a thread packs go to its own buffer, allocated up front as
+ * the threads of bare metal can't call malloc.
+ */
+
+// dim d of x, 1 past its ndim
+static int matmul_dim(const struct onnx_tensor_t *x, int d)
+{
+    return d < x->ndim ? x->dims[d] : 1;
+}
+
+// matrices of x, or batches of y with x NULL
+static size_t matmul_batches(const struct onnx_node_t *n, const struct onnx_tensor_t *x)
+{
+    const struct onnx_tensor_t *a = n->inputs[0];
+    const struct onnx_tensor_t *b = n->inputs[1];
+    size_t batches = 1;
+
+    for (int d = 2; d < MAX(a->ndim, b->ndim); d++) {
+        batches *= x != NULL ? matmul_dim(x, d) : MAX(matmul_dim(a, d), matmul_dim(b, d));
+    }
+    return batches;
+}
+
+// elements of x before its matrix of batch t of y
+static size_t matmul_batch_offset(const struct onnx_node_t *n, const struct onnx_tensor_t *x, size_t t)
+{
+    const struct onnx_tensor_t *a = n->inputs[0];
+    const struct onnx_tensor_t *b = n->inputs[1];
+    size_t offset = 0;
+    size_t stride = (size_t)x->dims[0] * x->dims[1];
+
+    for (int d = 2; d < MAX(a->ndim, b->ndim); d++) {
+        const size_t dim = MAX(matmul_dim(a, d), matmul_dim(b, d));
+        if (matmul_dim(x, d) != 1) {
+            offset += t % dim * stride;
+        }
+        stride *= matmul_dim(x, d);
+        t /= dim;
+    }
+    return offset;
+}
+
+struct matmul_batch_t {
+    const struct onnx_node_t *n;
+    struct matmul_t mm; // a, b, y and packed of batch 0
+    size_t esize;
+    void (*fn)(const struct matmul_t *mm);
+    size_t batches;
+    int slots;          // ranges of batches, one per thread
+    void *pack;         // NULL, or a block of B for matmul_gemm per slot
+    size_t pack_size;
+};
+
+// batches [start, end) of y, the blocks of B are packed into pack
+static void matmul_batch(const struct matmul_batch_t *batch, void *pack, size_t start, size_t end)
+{
+    struct matmul_t mm = batch->mm;
+
+    mm.pack = pack;
+
+    for (size_t t = start; t < end; t++) {
+        const size_t offset = matmul_batch_offset(batch->n, batch->n->inputs[1], t) * batch->esize;
+        mm.a = (const char *)batch->mm.a + matmul_batch_offset(batch->n, batch->n->inputs[0], t) * batch->esize;
+        mm.b = (const char *)batch->mm.b + offset;
+        mm.y = (char *)batch->mm.y + t * mm.m * mm.n * batch->esize;
+        mm.packed = batch->mm.packed != NULL ? (const char *)batch->mm.packed + offset : NULL;
+        batch->fn(&mm);
+    }
+}
+
+// slots [start, end) of the batches, each with its own block of B
+static void matmul_batch_slots(void *arg, int start, int end)
+{
+    const struct matmul_batch_t *batch = (const struct matmul_batch_t *)arg;
+
+    for (int s = start; s < end; s++) {
+        void *pack = batch->pack != NULL ? (char *)batch->pack + s * batch->pack_size : NULL;
+        matmul_batch(batch, pack, batch->batches * s / batch->slots, batch->batches * (s + 1) / batch->slots);
+    }
+}
+
+// fn on every batch, b packed into panels of nr columns and blocks of kcb rows for the blocked GEMM, nr 0 reads b as is
+static void matmul_run(struct onnx_node_t *n, void (*fn)(const struct matmul_t *mm), size_t nr, size_t kcb, _Bool parallel)
+{
+    const struct onnx_tensor_t *a = n->inputs[0];
+    const struct onnx_tensor_t *b = n->inputs[1];
+    const size_t batches = matmul_batches(n, NULL);
+    struct matmul_batch_t batch;
+    void *packed = NULL;
+
+    batch.n = n;
+    batch.esize = onnx_tensor_type_sizeof(b->type);
+    batch.fn = fn;
+    batch.mm.a = a->datas;
+    batch.mm.b = b->datas;
+    batch.mm.y = n->outputs[0]->datas;
+    batch.mm.y0 = n->outputs[0]->datas;
+    batch.mm.m = a->dims[1];
+    batch.mm.k = a->dims[0];
+    batch.mm.n = b->dims[0];
+    batch.mm.e = matmul_epilogue_param(n);
+    batch.mm.acc32 = matmul_accumulate_float32(n);
+    batch.mm.packed = NULL;
+    batch.mm.pack = NULL;
+    batch.batches = batches;
+    batch.slots = 1;
+    batch.pack = NULL;
+    batch.pack_size = 0;
+#if defined(__riscv_vector)
+    if (nr != 0) {
+        batch.mm.packed = matmul_prepacked(n);
+    }
+#endif
+
+    if (matmul_batches(n, b) == 1 && matmul_batches(n, a) == batches) {
+        // the rows of a of all batches are contiguous, so are those of y
+        batch.mm.m *= batches;
+        batch.batches = 1;
+    } else if (parallel && batches >= (size_t)onnx_parallel_nthreads()) {
+        // the kernels of a batch call onnx_parallel_for from a slot and run on its thread
+        batch.slots = onnx_parallel_nthreads();
+    }
+#if defined(__riscv_vector)
+    if (nr != 0 && batch.mm.packed == NULL && matmul_batches(n, b) < batch.batches &&
+        (batch.mm.acc32 || batch.mm.k * batch.mm.n * batch.esize > GEMM_MIN_BYTES)) {
+        // batches sharing a matrix of b don't pack it again
+        const size_t ndata = batch.mm.k * batch.mm.n * matmul_batches(n, b);
+        packed = MALLOC_ASSERT(ndata * batch.esize);
+        matmul_pack_b_batch(b->datas, ndata, batch.mm.k, batch.mm.n, batch.esize, nr, kcb, packed);
+        batch.mm.packed = packed;
+    }
+    if (nr != 0 && batch.mm.packed == NULL) {
+        batch.pack_size = matmul_pack_size(batch.mm.k, batch.mm.n, batch.esize, kcb);
+        batch.pack = batch.pack_size > 0 ? MALLOC_ASSERT(batch.slots * batch.pack_size) : NULL;
+    }
+#else
+    (void)nr;
+    (void)kcb;
+#endif
+    if (batch.slots > 1) {
+        onnx_parallel_for(batch.slots, 1, matmul_batch_slots, &batch);
+    } else {
+        matmul_batch_slots(&batch, 0, 1);
+    }
+    if (packed != NULL) {
+        free(packed);
+    }
+    if (batch.pack != NULL) {
+        free(batch.pack);
+    }
+}
+
+// y = a x b of one batch
+static void matmul_int8(const struct matmul_t *mm)
+{
+    const int8_t *pa = (const int8_t *)mm->a;
+    const int8_t *pb = (const int8_t *)mm->b;
+    int8_t *py = (int8_t *)mm->y;
     int32_t sum;
 
-    for (int i = 0; i < a->dims[1]; ++i) {
-        for (int j = 0; j < b->dims[0]; ++j) {
+    for (size_t i = 0; i < mm->m; ++i) {
+        for (size_t j = 0; j < mm->n; ++j) {
             sum = 0;
-            for (int k = 0; k < a->dims[0]; ++k) {
-                sum += pa[i * a->dims[0] + k] * pb[k * b->dims[0] + j];
+            for (size_t k = 0; k < mm->k; ++k) {
+                sum += pa[i * mm->k + k] * pb[k * mm->n + j];
             }
-            py[i * b->dims[0] + j] = sum;
+            py[i * mm->n + j] = sum;
         }
     }
 }
 
-void MatMul_int8_rvv(struct onnx_node_t *n)
+void MatMul_int8(struct onnx_node_t *n)
+{
+    matmul_run(n, matmul_int8, 0, 0, 0);
+}
+
+#if defined(__riscv_vector)
+// rows [start, end) of y
+static void matmul_int8_rvv(void *arg, int start, int end)
 {
-    struct onnx_tensor_t *y = n->outputs[0];
-    struct onnx_tensor_t *a = n->inputs[0];
-    struct onnx_tensor_t *b = n->inputs[1];
-    int8_t *py = (int8_t *)y->datas;
-    int8_t *pa = (int8_t *)a->datas;
-    int8_t *pb = (int8_t *)b->datas;
-    uint32_t numColsB = b->dims[0]; /* number of columns of input matrix B */
-    uint32_t numColsA = a->dims[0]; /* number of columns of input matrix A */
-    uint32_t numRowsA = a->dims[1]; /* number of rows of input matrix A    */
-    uint32_t numRowsB = b->dims[1]; /* Number of rows of input matrix B */
+    const struct matmul_t *mm = (const struct matmul_t *)arg;
+    uint32_t numColsB = mm->n;       /* number of columns of input matrix B */
+    uint32_t numColsA = mm->k;       /* number of columns of input matrix A */
+    uint32_t numRowsA = end - start; /* number of rows of input matrix A    */
+    int8_t *py = (int8_t *)mm->y + start * numColsB;
+    int8_t *pa = (int8_t *)mm->a + start * numColsA;
+    int8_t *pb = (int8_t *)mm->b;
+    uint32_t numRowsB = mm->k;       /* Number of rows of input matrix B */
     uint32_t colCnt;
 
     size_t ii, jj, kk;
@@ -140,39 +584,262 @@ void MatMul_int8_rvv(struct onnx_node_t *n)
     }
 }
 
-void MatMul_float16(struct onnx_node_t *n)
+// y = a x b of one batch
+static void matmul_int8_batch_rvv(const struct matmul_t *mm)
 {
-    struct onnx_tensor_t *y = n->outputs[0];
-    struct onnx_tensor_t *a = n->inputs[0];
-    struct onnx_tensor_t *b = n->inputs[1];
-    float16_t *py = (float16_t *)y->datas;
-    float16_t *pa = (float16_t *)a->datas;
-    float16_t *pb = (float16_t *)b->datas;
+    // keep 4 rows blocks of the kernel inside one chunk
+    onnx_parallel_for(mm->m, 4, matmul_int8_rvv, (void *)mm);
+}
+
+void MatMul_int8_rvv(struct onnx_node_t *n)
+{
+    matmul_run(n, matmul_int8_batch_rvv, 0, 0, 1);
+}
+#endif /* defined(__riscv_vector) */
+
+// y = a x b of one batch
+static void matmul_float16(const struct matmul_t *mm)
+{
+    const float16_t *pa = (const float16_t *)mm->a;
+    const float16_t *pb = (const float16_t *)mm->b;
+    float16_t *py = (float16_t *)mm->y;
+    const struct onnx_epilogue_t *e = mm->e;
+    // index of y[0] in the output for the epilogue
+    const size_t y0 = py - (const float16_t *)mm->y0;
+    const _Bool acc32 = mm->acc32;
     float16_t sum;
+    float32_t sum32;
 
-    for (int i = 0; i < a->dims[1]; ++i) {
-        for (int j = 0; j < b->dims[0]; ++j) {
+    for (size_t i = 0; i < mm->m; ++i) {
+        for (size_t j = 0; j < mm->n; ++j) {
             sum = 0;
-            for (int k = 0; k < a->dims[0]; ++k) {
-                sum += pa[i * a->dims[0] + k] * pb[k * b->dims[0] + j];
+            sum32 = 0.0f;
+            for (size_t k = 0; k < mm->k; ++k) {
+                if (acc32) {
+                    sum32 += (float32_t)pa[i * mm->k + k] * (float32_t)pb[k * mm->n + j];
+                } else {
+                    sum += pa[i * mm->k + k] * pb[k * mm->n + j];
+                }
+            }
+            if (!acc32) {
+                sum32 = sum;
             }
-            py[i * b->dims[0] + j] = sum;
+            py[i * mm->n + j] = e ? matmul_epilogue(e, sum32, y0 + i * mm->n + j) : sum32;
         }
     }
 }
 
-void MatMul_float16_rvv(struct onnx_node_t *n)
+void MatMul_float16(struct onnx_node_t *n)
+{
+    matmul_run(n, matmul_float16, 0, 0, 0);
+}
+
+#if defined(__riscv_vector)
+// GEMM_MR rows of y += a * b over one packed panel of vl columns and kc rows
+static void matmul_float16_kernel(const float16_t *pa, size_t lda, const float16_t *pb, size_t kc, float16_t *py, size_t ldy, size_t vl, _Bool first,
+                                  const struct onnx_epilogue_t *e, const float16_t *py0)
+{
+    const float16_t *pa0 = pa;
+    const float16_t *pa1 = pa + lda;
+    const float16_t *pa2 = pa + 2 * lda;
+    const float16_t *pa3 = pa + 3 * lda;
+    const float16_t *pa4 = pa + 4 * lda;
+    const float16_t *pa5 = pa + 5 * lda;
+    const float16_t *pa6 = pa + 6 * lda;
+    const float16_t *pa7 = pa + 7 * lda;
+    float16_t *py1 = py + ldy;
+    float16_t *py2 = py + 2 * ldy;
+    float16_t *py3 = py + 3 * ldy;
+    float16_t *py4 = py + 4 * ldy;
+    float16_t *py5 = py + 5 * ldy;
+    float16_t *py6 = py + 6 * ldy;
+    float16_t *py7 = py + 7 * ldy;
+    vfloat16m2_t vb, vres0, vres1, vres2, vres3, vres4, vres5, vres6, vres7;
+
+    if (first) {
+        vres0 = __riscv_vfmv_v_f_f16m2(0.0f, vl);
+        vres1 = __riscv_vmv_v_v_f16m2(vres0, vl);
+        vres2 = __riscv_vmv_v_v_f16m2(vres0, vl);
+        vres3 = __riscv_vmv_v_v_f16m2(vres0, vl);
+        vres4 = __riscv_vmv_v_v_f16m2(vres0, vl);
+        vres5 = __riscv_vmv_v_v_f16m2(vres0, vl);
+        vres6 = __riscv_vmv_v_v_f16m2(vres0, vl);
+        vres7 = __riscv_vmv_v_v_f16m2(vres0, vl);
+    } else {
+        vres0 = __riscv_vle16_v_f16m2(py, vl);
+        vres1 = __riscv_vle16_v_f16m2(py1, vl);
+        vres2 = __riscv_vle16_v_f16m2(py2, vl);
+        vres3 = __riscv_vle16_v_f16m2(py3, vl);
+        vres4 = __riscv_vle16_v_f16m2(py4, vl);
+        vres5 = __riscv_vle16_v_f16m2(py5, vl);
+        vres6 = __riscv_vle16_v_f16m2(py6, vl);
+        vres7 = __riscv_vle16_v_f16m2(py7, vl);
+    }
+    for (size_t kk = 0; kk < kc; kk++) {
+        vb = __riscv_vle16_v_f16m2(pb, vl);
+        vres0 = __riscv_vfmacc_vf_f16m2(vres0, pa0[kk], vb, vl);
+        vres1 = __riscv_vfmacc_vf_f16m2(vres1, pa1[kk], vb, vl);
+        vres2 = __riscv_vfmacc_vf_f16m2(vres2, pa2[kk], vb, vl);
+        vres3 = __riscv_vfmacc_vf_f16m2(vres3, pa3[kk], vb, vl);
+        vres4 = __riscv_vfmacc_vf_f16m2(vres4, pa4[kk], vb, vl);
+        vres5 = __riscv_vfmacc_vf_f16m2(vres5, pa5[kk], vb, vl);
+        vres6 = __riscv_vfmacc_vf_f16m2(vres6, pa6[kk], vb, vl);
+        vres7 = __riscv_vfmacc_vf_f16m2(vres7, pa7[kk], vb, vl);
+        pb += vl;
+    }
+    if (e) {
+        vres0 = matmul_epilogue_f16m2(e, vres0, py - py0, vl);
+        vres1 = matmul_epilogue_f16m2(e, vres1, py1 - py0, vl);
+        vres2 = matmul_epilogue_f16m2(e, vres2, py2 - py0, vl);
+        vres3 = matmul_epilogue_f16m2(e, vres3, py3 - py0, vl);
+        vres4 = matmul_epilogue_f16m2(e, vres4, py4 - py0, vl);
+        vres5 = matmul_epilogue_f16m2(e, vres5, py5 - py0, vl);
+        vres6 = matmul_epilogue_f16m2(e, vres6, py6 - py0, vl);
+        vres7 = matmul_epilogue_f16m2(e, vres7, py7 - py0, vl);
+    }
+    __riscv_vse16_v_f16m2(py, vres0, vl);
+    __riscv_vse16_v_f16m2(py1, vres1, vl);
+    __riscv_vse16_v_f16m2(py2, vres2, vl);
+    __riscv_vse16_v_f16m2(py3, vres3, vl);
+    __riscv_vse16_v_f16m2(py4, vres4, vl);
+    __riscv_vse16_v_f16m2(py5, vres5, vl);
+    __riscv_vse16_v_f16m2(py6, vres6, vl);
+    __riscv_vse16_v_f16m2(py7, vres7, vl);
+}
+
+// one row of matmul_float16_kernel, for the rows past the last GEMM_MR rows
+static void matmul_float16_kernel_row(const float16_t *pa, const float16_t *pb, size_t kc, float16_t *py, size_t vl, _Bool first,
+                                      const struct onnx_epilogue_t *e, const float16_t *py0)
+{
+    vfloat16m2_t vres = first ? __riscv_vfmv_v_f_f16m2(0.0f, vl) : __riscv_vle16_v_f16m2(py, vl);
+
+    for (size_t kk = 0; kk < kc; kk++) {
+        vres = __riscv_vfmacc_vf_f16m2(vres, pa[kk], __riscv_vle16_v_f16m2(pb, vl), vl);
+        pb += vl;
+    }
+    if (e) {
+        vres = matmul_epilogue_f16m2(e, vres, py - py0, vl);
+    }
+    __riscv_vse16_v_f16m2(py, vres, vl);
+}
+
+// rows [start, end) of y for the current block of B, see matmul_gemm
+static void matmul_float16_gemm(void *arg, int start, int end)
+{
+    const struct matmul_gemm_t *g = (const struct matmul_gemm_t *)arg;
+    const float16_t *pa = (const float16_t *)g->a + g->pc;
+    const float16_t *pb = (const float16_t *)g->packed;
+    float16_t *py = (float16_t *)g->y + g->jc;
+    const float16_t *py0 = (const float16_t *)g->y0;
+    // y holds the whole sum with the last block of K
+    const struct onnx_epilogue_t *e = g->pc + g->kc == g->k ? g->e : NULL;
+
+    for (size_t ic = start; ic < (size_t)end; ic += GEMM_MC) {
+        const size_t mc = MIN(GEMM_MC, end - ic);
+        for (size_t jr = 0; jr < g->nc; jr += g->nr) {
+            const size_t vl = MIN(g->nr, g->nc - jr);
+            size_t ir = ic;
+            for (; ir + GEMM_MR <= ic + mc; ir += GEMM_MR) {
+                matmul_float16_kernel(pa + ir * g->k, g->k, pb + jr * g->kc, g->kc, py + ir * g->n + jr, g->n, vl, g->pc == 0, e, py0);
+            }
+            for (; ir < ic + mc; ir++) {
+                matmul_float16_kernel_row(pa + ir * g->k, pb + jr * g->kc, g->kc, py + ir * g->n + jr, vl, g->pc == 0, e, py0);
+            }
+        }
+    }
+}
+
+// 4 rows of y = a * b over one packed panel of vl columns and all k rows, summed in float32
+static void matmul_float16_acc32_kernel(const float16_t *pa, size_t lda, const float16_t *pb, size_t kc, float16_t *py, size_t ldy, size_t vl,
+                                        const struct onnx_epilogue_t *e, const float16_t *py0)
 {
-    struct onnx_tensor_t *y = n->outputs[0];
-    struct onnx_tensor_t *a = n->inputs[0];
-    struct onnx_tensor_t *b = n->inputs[1];
-    float16_t *py = (float16_t *)y->datas;
-    float16_t *pa = (float16_t *)a->datas;
-    float16_t *pb = (float16_t *)b->datas;
-    uint32_t numColsB = b->dims[0]; /* number of columns of input matrix B */
-    uint32_t numColsA = a->dims[0]; /* number of columns of input matrix A */
-    uint32_t numRowsA = a->dims[1]; /* number of rows of input matrix A    */
-    uint32_t numRowsB = b->dims[1]; /* Number of rows of input matrix B */
+    const float16_t *pa0 = pa;
+    const float16_t *pa1 = pa + lda;
+    const float16_t *pa2 = pa + 2 * lda;
+    const float16_t *pa3 = pa + 3 * lda;
+    float16_t *py1 = py + ldy;
+    float16_t *py2 = py + 2 * ldy;
+    float16_t *py3 = py + 3 * ldy;
+    vfloat16m2_t vb;
+    vfloat32m4_t vres0, vres1, vres2, vres3;
+
+    vres0 = __riscv_vfmv_v_f_f32m4(0.0f, vl);
+    vres1 = __riscv_vmv_v_v_f32m4(vres0, vl);
+    vres2 = __riscv_vmv_v_v_f32m4(vres0, vl);
+    vres3 = __riscv_vmv_v_v_f32m4(vres0, vl);
+    for (size_t kk = 0; kk < kc; kk++) {
+        vb = __riscv_vle16_v_f16m2(pb, vl);
+        vres0 = __riscv_vfwmacc_vf_f32m4(vres0, pa0[kk], vb, vl);
+        vres1 = __riscv_vfwmacc_vf_f32m4(vres1, pa1[kk], vb, vl);
+        vres2 = __riscv_vfwmacc_vf_f32m4(vres2, pa2[kk], vb, vl);
+        vres3 = __riscv_vfwmacc_vf_f32m4(vres3, pa3[kk], vb, vl);
+        pb += vl;
+    }
+    if (e) {
+        vres0 = matmul_epilogue_f32m4(e, vres0, py - py0, vl);
+        vres1 = matmul_epilogue_f32m4(e, vres1, py1 - py0, vl);
+        vres2 = matmul_epilogue_f32m4(e, vres2, py2 - py0, vl);
+        vres3 = matmul_epilogue_f32m4(e, vres3, py3 - py0, vl);
+    }
+    __riscv_vse16_v_f16m2(py, __riscv_vfncvt_f_f_w_f16m2(vres0, vl), vl);
+    __riscv_vse16_v_f16m2(py1, __riscv_vfncvt_f_f_w_f16m2(vres1, vl), vl);
+    __riscv_vse16_v_f16m2(py2, __riscv_vfncvt_f_f_w_f16m2(vres2, vl), vl);
+    __riscv_vse16_v_f16m2(py3, __riscv_vfncvt_f_f_w_f16m2(vres3, vl), vl);
+}
+
+// one row of matmul_float16_acc32_kernel
+static void matmul_float16_acc32_kernel_row(const float16_t *pa, const float16_t *pb, size_t kc, float16_t *py, size_t vl,
+                                            const struct onnx_epilogue_t *e, const float16_t *py0)
+{
+    vfloat32m4_t vres = __riscv_vfmv_v_f_f32m4(0.0f, vl);
+
+    for (size_t kk = 0; kk < kc; kk++) {
+        vres = __riscv_vfwmacc_vf_f32m4(vres, pa[kk], __riscv_vle16_v_f16m2(pb, vl), vl);
+        pb += vl;
+    }
+    if (e) {
+        vres = matmul_epilogue_f32m4(e, vres, py - py0, vl);
+    }
+    __riscv_vse16_v_f16m2(py, __riscv_vfncvt_f_f_w_f16m2(vres, vl), vl);
+}
+
+// rows [start, end) of y with float32 sums, B is packed in one block of all k rows
+static void matmul_float16_acc32_gemm(void *arg, int start, int end)
+{
+    const struct matmul_gemm_t *g = (const struct matmul_gemm_t *)arg;
+    const float16_t *pa = (const float16_t *)g->a;
+    const float16_t *pb = (const float16_t *)g->packed;
+    float16_t *py = (float16_t *)g->y + g->jc;
+    const float16_t *py0 = (const float16_t *)g->y0;
+
+    for (size_t ic = start; ic < (size_t)end; ic += GEMM_MC) {
+        const size_t mc = MIN(GEMM_MC, end - ic);
+        for (size_t jr = 0; jr < g->nc; jr += g->nr) {
+            const size_t vl = MIN(g->nr, g->nc - jr);
+            size_t ir = ic;
+            for (; ir + 4 <= ic + mc; ir += 4) {
+                matmul_float16_acc32_kernel(pa + ir * g->k, g->k, pb + jr * g->kc, g->kc, py + ir * g->n + jr, g->n, vl, g->e, py0);
+            }
+            for (; ir < ic + mc; ir++) {
+                matmul_float16_acc32_kernel_row(pa + ir * g->k, pb + jr * g->kc, g->kc, py + ir * g->n + jr, vl, g->e, py0);
+            }
+        }
+    }
+}
+
+// rows [start, end) of y
+static void matmul_float16_rvv(void *arg, int start, int end)
+{
+    const struct matmul_t *mm = (const struct matmul_t *)arg;
+    uint32_t numColsB = mm->n;       /* number of columns of input matrix B */
+    uint32_t numColsA = mm->k;       /* number of columns of input matrix A */
+    uint32_t numRowsA = end - start; /* number of rows of input matrix A    */
+    float16_t *py = (float16_t *)mm->y + start * numColsB;
+    float16_t *pa = (float16_t *)mm->a + start * numColsA;
+    float16_t *pb = (float16_t *)mm->b;
+    const float16_t *py0 = (const float16_t *)mm->y0;
+    const struct onnx_epilogue_t *e = mm->e;
+    uint32_t numRowsB = mm->k;       /* Number of rows of input matrix B */
     uint32_t colCnt;
 
     size_t ii, jj, kk;
@@ -205,6 +872,12 @@ void MatMul_float16_rvv(struct onnx_node_t *n)
                 vres3m4 = __riscv_vfmacc_vf_f16m4(vres3m4, *(pInA + 3 * numColsA), va0m4, l);
                 pInA++;
             }
+            if (e) {
+                vres0m4 = matmul_epilogue_f16m4(e, vres0m4, px - py0, l);
+                vres1m4 = matmul_epilogue_f16m4(e, vres1m4, px + numColsB - py0, l);
+                vres2m4 = matmul_epilogue_f16m4(e, vres2m4, px + 2 * numColsB - py0, l);
+                vres3m4 = matmul_epilogue_f16m4(e, vres3m4, px + 3 * numColsB - py0, l);
+            }
             __riscv_vse16_v_f16m4(px, vres0m4, l);
             __riscv_vse16_v_f16m4(px + numColsB, vres1m4, l);
             __riscv_vse16_v_f16m4(px + 2 * numColsB, vres2m4, l);
@@ -231,6 +904,10 @@ void MatMul_float16_rvv(struct onnx_node_t *n)
                 vres1m8 = __riscv_vfmacc_vf_f16m8(vres1m8, *(pInA + numColsA), va0m8, l);
                 pInA++;
             }
+            if (e) {
+                vres0m8 = matmul_epilogue_f16m8(e, vres0m8, px - py0, l);
+                vres1m8 = matmul_epilogue_f16m8(e, vres1m8, px + numColsB - py0, l);
+            }
             __riscv_vse16_v_f16m8(px, vres0m8, l);
             __riscv_vse16_v_f16m8(px + numColsB, vres1m8, l);
             px += l;
@@ -252,6 +929,9 @@ void MatMul_float16_rvv(struct onnx_node_t *n)
                 va0m8 = __riscv_vle16_v_f16m8(pInB + kk * numColsB, l);
                 vres0m8 = __riscv_vfmacc_vf_f16m8(vres0m8, *(pInA++), va0m8, l);
             }
+            if (e) {
+                vres0m8 = matmul_epilogue_f16m8(e, vres0m8, px - py0, l);
+            }
             __riscv_vse16_v_f16m8(px, vres0m8, l);
             px += l;
             pInB += l;
@@ -261,39 +941,193 @@ void MatMul_float16_rvv(struct onnx_node_t *n)
     }
 }
 
-void MatMul_float32(struct onnx_node_t *n)
+// y = a x b of one batch
+static void matmul_float16_batch_rvv(const struct matmul_t *mm)
 {
-    struct onnx_tensor_t *y = n->outputs[0];
-    struct onnx_tensor_t *a = n->inputs[0];
-    struct onnx_tensor_t *b = n->inputs[1];
-    float32_t *py = (float32_t *)y->datas;
-    float32_t *pa = (float32_t *)a->datas;
-    float32_t *pb = (float32_t *)b->datas;
+    // prepacked B costs no packing, any number of rows goes through the blocked GEMM, so do float32 sums
+    if (mm->acc32 || mm->packed != NULL || (mm->m >= GEMM_MR && mm->k * mm->n * sizeof(float16_t) > GEMM_MIN_BYTES)) {
+        struct matmul_gemm_t g;
+        g.a = mm->a;
+        g.y = mm->y;
+        g.y0 = mm->y0;
+        g.e = mm->e;
+        g.prepacked = mm->packed;
+        g.pack = mm->pack;
+        g.m = mm->m;
+        g.k = mm->k;
+        g.n = mm->n;
+        g.nr = __riscv_vsetvlmax_e16m2();
+        g.kcb = mm->acc32 ? g.k : GEMM_KC;
+        matmul_gemm(&g, mm->b, sizeof(float16_t), mm->acc32 ? matmul_float16_acc32_gemm : matmul_float16_gemm);
+        return;
+    }
+    // keep 4 rows blocks of the kernel inside one chunk
+    onnx_parallel_for(mm->m, 4, matmul_float16_rvv, (void *)mm);
+}
+
+void MatMul_float16_rvv(struct onnx_node_t *n)
+{
+    // the panels of matmul_float16_batch_rvv
+    const size_t kcb = matmul_accumulate_float32(n) ? n->inputs[0]->dims[0] : GEMM_KC;
+    matmul_run(n, matmul_float16_batch_rvv, __riscv_vsetvlmax_e16m2(), kcb, 1);
+}
+#endif /* defined(__riscv_vector) */
+
+// y = a x b of one batch
+static void matmul_float32(const struct matmul_t *mm)
+{
+    const float32_t *pa = (const float32_t *)mm->a;
+    const float32_t *pb = (const float32_t *)mm->b;
+    float32_t *py = (float32_t *)mm->y;
+    const struct onnx_epilogue_t *e = mm->e;
+    // index of y[0] in the output for the epilogue
+    const size_t y0 = py - (const float32_t *)mm->y0;
     float32_t sum;
 
-    for (int i = 0; i < a->dims[1]; ++i) {
-        for (int j = 0; j < b->dims[0]; ++j) {
+    for (size_t i = 0; i < mm->m; ++i) {
+        for (size_t j = 0; j < mm->n; ++j) {
             sum = 0;
-            for (int k = 0; k < a->dims[0]; ++k) {
-                sum += pa[i * a->dims[0] + k] * pb[k * b->dims[0] + j];
+            for (size_t k = 0; k < mm->k; ++k) {
+                sum += pa[i * mm->k + k] * pb[k * mm->n + j];
             }
-            py[i * b->dims[0] + j] = sum;
+            py[i * mm->n + j] = e ? matmul_epilogue(e, sum, y0 + i * mm->n + j) : sum;
         }
     }
 }
 
-void MatMul_float32_rvv(struct onnx_node_t *n)
+void MatMul_float32(struct onnx_node_t *n)
+{
+    matmul_run(n, matmul_float32, 0, 0, 0);
+}
+
+#if defined(__riscv_vector)
+// GEMM_MR rows of y += a * b over one packed panel of vl columns and kc rows
+static void matmul_float32_kernel(const float32_t *pa, size_t lda, const float32_t *pb, size_t kc, float32_t *py, size_t ldy, size_t vl, _Bool first,
+                                  const struct onnx_epilogue_t *e, const float32_t *py0)
+{
+    const float32_t *pa0 = pa;
+    const float32_t *pa1 = pa + lda;
+    const float32_t *pa2 = pa + 2 * lda;
+    const float32_t *pa3 = pa + 3 * lda;
+    const float32_t *pa4 = pa + 4 * lda;
+    const float32_t *pa5 = pa + 5 * lda;
+    const float32_t *pa6 = pa + 6 * lda;
+    const float32_t *pa7 = pa + 7 * lda;
+    float32_t *py1 = py + ldy;
+    float32_t *py2 = py + 2 * ldy;
+    float32_t *py3 = py + 3 * ldy;
+    float32_t *py4 = py + 4 * ldy;
+    float32_t *py5 = py + 5 * ldy;
+    float32_t *py6 = py + 6 * ldy;
+    float32_t *py7 = py + 7 * ldy;
+    vfloat32m2_t vb, vres0, vres1, vres2, vres3, vres4, vres5, vres6, vres7;
+
+    if (first) {
+        vres0 = __riscv_vfmv_v_f_f32m2(0.0f, vl);
+        vres1 = __riscv_vmv_v_v_f32m2(vres0, vl);
+        vres2 = __riscv_vmv_v_v_f32m2(vres0, vl);
+        vres3 = __riscv_vmv_v_v_f32m2(vres0, vl);
+        vres4 = __riscv_vmv_v_v_f32m2(vres0, vl);
+        vres5 = __riscv_vmv_v_v_f32m2(vres0, vl);
+        vres6 = __riscv_vmv_v_v_f32m2(vres0, vl);
+        vres7 = __riscv_vmv_v_v_f32m2(vres0, vl);
+    } else {
+        vres0 = __riscv_vle32_v_f32m2(py, vl);
+        vres1 = __riscv_vle32_v_f32m2(py1, vl);
+        vres2 = __riscv_vle32_v_f32m2(py2, vl);
+        vres3 = __riscv_vle32_v_f32m2(py3, vl);
+        vres4 = __riscv_vle32_v_f32m2(py4, vl);
+        vres5 = __riscv_vle32_v_f32m2(py5, vl);
+        vres6 = __riscv_vle32_v_f32m2(py6, vl);
+        vres7 = __riscv_vle32_v_f32m2(py7, vl);
+    }
+    for (size_t kk = 0; kk < kc; kk++) {
+        vb = __riscv_vle32_v_f32m2(pb, vl);
+        vres0 = __riscv_vfmacc_vf_f32m2(vres0, pa0[kk], vb, vl);
+        vres1 = __riscv_vfmacc_vf_f32m2(vres1, pa1[kk], vb, vl);
+        vres2 = __riscv_vfmacc_vf_f32m2(vres2, pa2[kk], vb, vl);
+        vres3 = __riscv_vfmacc_vf_f32m2(vres3, pa3[kk], vb, vl);
+        vres4 = __riscv_vfmacc_vf_f32m2(vres4, pa4[kk], vb, vl);
+        vres5 = __riscv_vfmacc_vf_f32m2(vres5, pa5[kk], vb, vl);
+        vres6 = __riscv_vfmacc_vf_f32m2(vres6, pa6[kk], vb, vl);
+        vres7 = __riscv_vfmacc_vf_f32m2(vres7, pa7[kk], vb, vl);
+        pb += vl;
+    }
+    if (e) {
+        vres0 = matmul_epilogue_f32m2(e, vres0, py - py0, vl);
+        vres1 = matmul_epilogue_f32m2(e, vres1, py1 - py0, vl);
+        vres2 = matmul_epilogue_f32m2(e, vres2, py2 - py0, vl);
+        vres3 = matmul_epilogue_f32m2(e, vres3, py3 - py0, vl);
+        vres4 = matmul_epilogue_f32m2(e, vres4, py4 - py0, vl);
+        vres5 = matmul_epilogue_f32m2(e, vres5, py5 - py0, vl);
+        vres6 = matmul_epilogue_f32m2(e, vres6, py6 - py0, vl);
+        vres7 = matmul_epilogue_f32m2(e, vres7, py7 - py0, vl);
+    }
+    __riscv_vse32_v_f32m2(py, vres0, vl);
+    __riscv_vse32_v_f32m2(py1, vres1, vl);
+    __riscv_vse32_v_f32m2(py2, vres2, vl);
+    __riscv_vse32_v_f32m2(py3, vres3, vl);
+    __riscv_vse32_v_f32m2(py4, vres4, vl);
+    __riscv_vse32_v_f32m2(py5, vres5, vl);
+    __riscv_vse32_v_f32m2(py6, vres6, vl);
+    __riscv_vse32_v_f32m2(py7, vres7, vl);
+}
+
+// one row of matmul_float32_kernel, for the rows past the last GEMM_MR rows
+static void matmul_float32_kernel_row(const float32_t *pa, const float32_t *pb, size_t kc, float32_t *py, size_t vl, _Bool first,
+                                      const struct onnx_epilogue_t *e, const float32_t *py0)
 {
-    struct onnx_tensor_t *y = n->outputs[0];
-    struct onnx_tensor_t *a = n->inputs[0];
-    struct onnx_tensor_t *b = n->inputs[1];
-    float32_t *py = (float32_t *)y->datas;
-    float32_t *pa = (float32_t *)a->datas;
-    float32_t *pb = (float32_t *)b->datas;
-    uint32_t numColsB = b->dims[0]; /* number of columns of input matrix B */
-    uint32_t numColsA = a->dims[0]; /* number of columns of input matrix A */
-    uint32_t numRowsA = a->dims[1]; /* number of rows of input matrix A    */
-    uint32_t numRowsB = b->dims[1]; /* Number of rows of input matrix B */
+    vfloat32m2_t vres = first ? __riscv_vfmv_v_f_f32m2(0.0f, vl) : __riscv_vle32_v_f32m2(py, vl);
+
+    for (size_t kk = 0; kk < kc; kk++) {
+        vres = __riscv_vfmacc_vf_f32m2(vres, pa[kk], __riscv_vle32_v_f32m2(pb, vl), vl);
+        pb += vl;
+    }
+    if (e) {
+        vres = matmul_epilogue_f32m2(e, vres, py - py0, vl);
+    }
+    __riscv_vse32_v_f32m2(py, vres, vl);
+}
+
+// rows [start, end) of y for the current block of B, see matmul_gemm
+static void matmul_float32_gemm(void *arg, int start, int end)
+{
+    const struct matmul_gemm_t *g = (const struct matmul_gemm_t *)arg;
+    const float32_t *pa = (const float32_t *)g->a + g->pc;
+    const float32_t *pb = (const float32_t *)g->packed;
+    float32_t *py = (float32_t *)g->y + g->jc;
+    const float32_t *py0 = (const float32_t *)g->y0;
+    // y holds the whole sum with the last block of K
+    const struct onnx_epilogue_t *e = g->pc + g->kc == g->k ? g->e : NULL;
+
+    for (size_t ic = start; ic < (size_t)end; ic += GEMM_MC) {
+        const size_t mc = MIN(GEMM_MC, end - ic);
+        for (size_t jr = 0; jr < g->nc; jr += g->nr) {
+            const size_t vl = MIN(g->nr, g->nc - jr);
+            size_t ir = ic;
+            for (; ir + GEMM_MR <= ic + mc; ir += GEMM_MR) {
+                matmul_float32_kernel(pa + ir * g->k, g->k, pb + jr * g->kc, g->kc, py + ir * g->n + jr, g->n, vl, g->pc == 0, e, py0);
+            }
+            for (; ir < ic + mc; ir++) {
+                matmul_float32_kernel_row(pa + ir * g->k, pb + jr * g->kc, g->kc, py + ir * g->n + jr, vl, g->pc == 0, e, py0);
+            }
+        }
+    }
+}
+
+// rows [start, end) of y
+static void matmul_float32_rvv(void *arg, int start, int end)
+{
+    const struct matmul_t *mm = (const struct matmul_t *)arg;
+    uint32_t numColsB = mm->n;       /* number of columns of input matrix B */
+    uint32_t numColsA = mm->k;       /* number of columns of input matrix A */
+    uint32_t numRowsA = end - start; /* number of rows of input matrix A    */
+    float32_t *py = (float32_t *)mm->y + start * numColsB;
+    float32_t *pa = (float32_t *)mm->a + start * numColsA;
+    float32_t *pb = (float32_t *)mm->b;
+    const float32_t *py0 = (const float32_t *)mm->y0;
+    const struct onnx_epilogue_t *e = mm->e;
+    uint32_t numRowsB = mm->k;       /* Number of rows of input matrix B */
     uint32_t colCnt;
 
     size_t ii, jj, kk;
@@ -324,6 +1158,12 @@ void MatMul_float32_rvv(struct onnx_node_t *n)
                 vres3m4 = __riscv_vfmacc_vf_f32m4(vres3m4, *(pInA + 3 * numColsA), va0m4, l);
                 pInA++;
             }
+            if (e) {
+                vres0m4 = matmul_epilogue_f32m4(e, vres0m4, px - py0, l);
+                vres1m4 = matmul_epilogue_f32m4(e, vres1m4, px + numColsB - py0, l);
+                vres2m4 = matmul_epilogue_f32m4(e, vres2m4, px + 2 * numColsB - py0, l);
+                vres3m4 = matmul_epilogue_f32m4(e, vres3m4, px + 3 * numColsB - py0, l);
+            }
             __riscv_vse32_v_f32m4(px, vres0m4, l);
             __riscv_vse32_v_f32m4(px + numColsB, vres1m4, l);
             __riscv_vse32_v_f32m4(px + 2 * numColsB, vres2m4, l);
@@ -350,6 +1190,10 @@ void MatMul_float32_rvv(struct onnx_node_t *n)
                 vres1m8 = __riscv_vfmacc_vf_f32m8(vres1m8, *(pInA + numColsA), va0m8, l);
                 pInA++;
             }
+            if (e) {
+                vres0m8 = matmul_epilogue_f32m8(e, vres0m8, px - py0, l);
+                vres1m8 = matmul_epilogue_f32m8(e, vres1m8, px + numColsB - py0, l);
+            }
             __riscv_vse32_v_f32m8(px, vres0m8, l);
             __riscv_vse32_v_f32m8(px + numColsB, vres1m8, l);
             px += l;
@@ -371,6 +1215,9 @@ void MatMul_float32_rvv(struct onnx_node_t *n)
                 va0m8 = __riscv_vle32_v_f32m8(pInB + kk * numColsB, l);
                 vres0m8 = __riscv_vfmacc_vf_f32m8(vres0m8, *(pInA++), va0m8, l);
             }
+            if (e) {
+                vres0m8 = matmul_epilogue_f32m8(e, vres0m8, px - py0, l);
+            }
             __riscv_vse32_v_f32m8(px, vres0m8, l);
             px += l;
             pInB += l;
@@ -378,4 +1225,113 @@ void MatMul_float32_rvv(struct onnx_node_t *n)
         pa += numColsA;
         py += numColsB;
     }
-}
\ No newline at end of file
+}
+
+// y = a x b of one batch
+static void matmul_float32_batch_rvv(const struct matmul_t *mm)
+{
+    // prepacked B costs no packing, any number of rows goes through the blocked GEMM
+    if (mm->packed != NULL || (mm->m >= GEMM_MR && mm->k * mm->n * sizeof(float32_t) > GEMM_MIN_BYTES)) {
+        struct matmul_gemm_t g;
+        g.a = mm->a;
+        g.y = mm->y;
+        g.y0 = mm->y0;
+        g.e = mm->e;
+        g.prepacked = mm->packed;
+        g.pack = mm->pack;
+        g.m = mm->m;
+        g.k = mm->k;
+        g.n = mm->n;
+        g.nr = __riscv_vsetvlmax_e32m2();
+        g.kcb = GEMM_KC;
+        matmul_gemm(&g, mm->b, sizeof(float32_t), matmul_float32_gemm);
+        return;
+    }
+    // keep 4 rows blocks of the kernel inside one chunk
+    onnx_parallel_for(mm->m, 4, matmul_float32_rvv, (void *)mm);
+}
+
+void MatMul_float32_rvv(struct onnx_node_t *n)
+{
+    matmul_run(n, matmul_float32_batch_rvv, __riscv_vsetvlmax_e32m2(), GEMM_KC, 1);
+}
+#endif /* defined(__riscv_vector) */
+
+void *GenerateMatMulParam(const struct onnx_tensor_t *b, _Bool rvv)
+{
+    return GenerateMatMulParamAccumulate(b, rvv, MATMUL_ACCUMULATE_NATIVE);
+}
+
+void *GenerateMatMulParamAccumulate(const struct onnx_tensor_t *b, _Bool rvv, enum matmul_accumulate_t accumulate)
+{
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)MALLOC_ASSERT(sizeof(struct operator_pdata_t));
+    memset(&pdat->epilogue, 0, sizeof(pdat->epilogue));
+    pdat->has_epilogue = 0;
+    pdat->k = b->dims[1];
+    pdat->n = b->dims[0];
+    pdat->esize = onnx_tensor_type_sizeof(b->type);
+    pdat->ndata = b->ndata;
+    pdat->accumulate = accumulate;
+    pdat->nr = 0;
+    pdat->kc = 0;
+    pdat->packed = NULL;
+    pdat->kernel_ready = 0;
+
+#if defined(__riscv_vector)
+    // the int8 kernel reads B directly
+    if (rvv && (b->type == ONNX_TENSOR_TYPE_FLOAT32 || b->type == ONNX_TENSOR_TYPE_FLOAT16)) {
+        pdat->nr = b->type == ONNX_TENSOR_TYPE_FLOAT32 ? __riscv_vsetvlmax_e32m2() : __riscv_vsetvlmax_e16m2();
+        // the float32 sums take all of K in one block
+        pdat->kc = accumulate == MATMUL_ACCUMULATE_FLOAT32 && b->type == ONNX_TENSOR_TYPE_FLOAT16 ? pdat->k : GEMM_KC;
+        pdat->packed = MALLOC_ASSERT(b->ndata * pdat->esize);
+    }
+#else
+    (void)rvv;
+#endif
+    if (b->datas != NULL) {
+        PrepareMatMulWeights(pdat, b);
+    }
+    return pdat;
+}
+
+int PrepareMatMulWeights(void *pdat, const struct onnx_tensor_t *b)
+{
+    struct operator_pdata_t *_pdat = (struct operator_pdata_t *)pdat;
+    if (b->dims[1] != _pdat->k || b->dims[0] != _pdat->n || b->ndata != _pdat->ndata) {
+        return -1;
+    }
+#if defined(__riscv_vector)
+    if (_pdat->packed != NULL) {
+        matmul_pack_b_batch(b->datas, _pdat->ndata, _pdat->k, _pdat->n, _pdat->esize, _pdat->nr, _pdat->kc, _pdat->packed);
+    }
+#endif
+    // the scalar kernels read B directly
+    _pdat->kernel_ready = 1;
+    return 0;
+}
+
+int SetMatMulEpilogue(void *pdat, const struct onnx_epilogue_t *epilogue)
+{
+    struct operator_pdata_t *_pdat = (struct operator_pdata_t *)pdat;
+    // the residual has the type of the output, float16 for a float16 B and float32 for a float32 B
+    const enum onnx_tensor_type_t type = _pdat->esize == sizeof(float16_t) ? ONNX_TENSOR_TYPE_FLOAT16 : ONNX_TENSOR_TYPE_FLOAT32;
+    if (epilogue != NULL && epilogue->residual != NULL && epilogue->residual->type != type) {
+        return -1;
+    }
+    _pdat->has_epilogue = epilogue != NULL;
+    if (epilogue != NULL) {
+        _pdat->epilogue = *epilogue;
+    }
+    return 0;
+}
+
+void FreeMatMulParam(void **pdat)
+{
+    struct operator_pdata_t *_pdat = (struct operator_pdata_t *)*pdat;
+    if (_pdat->packed != NULL) {
+        free(_pdat->packed);
+        _pdat->packed = NULL;
+    }
+    free(*pdat);
+    *pdat = NULL;
+}
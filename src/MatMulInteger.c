@@ -0,0 +1,311 @@
+/*
+ * https://onnx.ai/onnx/operators/onnx__MatMulInteger.html
+ * https://onnx.ai/onnx/operators/onnx__QLinearMatMul.html
+ *
+ * y [m, n] = (a [m, k] + a_offset) * (b [k, n] + b_offset) + bias, in int32.
+ * An int32 output takes the sum as is like MatMulInteger, an int8 output is
+ * requantized per tensor or per column of b like ConvInteger, plus out_offset
+ * and clamped to the activation bounds, which covers QLinearMatMul.
+ *
+ * The rvv kernel multiplies the int8 values as they are and adds the offsets
+ * afterwards: a_offset * colsum(b) + k * a_offset * b_offset per column, kept
+ * in the parameters with the packed b, and b_offset * rowsum(a) per row.
+ */
+
+#include "operators.h"
+#include "requantize.h"
+#include "utils.h"
+
+typedef struct {
+    int32_t min;
+    int32_t max;
+} Activation;
+
+struct operator_pdata_t {
+    void *buf;
+    size_t buf_size;
+    int32_t a_offset;      /**< The negative of the zero value for a */
+    int32_t b_offset;      /**< The negative of the zero value for b */
+    int32_t output_offset; /**< The negative of the zero value for the int8 output */
+    Activation activation;
+    int32_t k;             /**< rows of b */
+    int32_t n;             /**< columns of b */
+    int32_t nr;            /**< columns of a panel of kernel_packed, the vlmax of e32m4 */
+    int8_t *kernel_packed; /**< b as panels of nr columns, [n / nr][k][nr] inside buf */
+    int32_t *col_offset;   /**< a_offset * colsum(b) + k * a_offset * b_offset [n] inside buf */
+    _Bool kernel_ready;    /**< kernel_packed and col_offset hold the current b */
+};
+
+#define MATMUL_INTEGER_ROWS (4) // rows of a per block of the rvv kernel
+
+static const struct onnx_tensor_t *matmul_integer_bias(const struct onnx_node_t *n)
+{
+    return n->ninput > 2 && n->inputs[2] != NULL && n->inputs[2]->datas != NULL ? n->inputs[2] : NULL;
+}
+
+// shapes of a, b and y, and one or n requantization parameters for an int8 y
+static int matmul_integer_check(const struct operator_pdata_t *pdat, const struct onnx_node_t *n)
+{
+    const struct onnx_tensor_t *a = n->inputs[0];
+    const struct onnx_tensor_t *b = n->inputs[1];
+    const struct onnx_tensor_t *bias = matmul_integer_bias(n);
+    const struct onnx_tensor_t *y = n->outputs[0];
+    const size_t cols = b->dims[0];
+
+    if (pdat == NULL || a->dims[0] != b->dims[1] || y->dims[0] != b->dims[0] || y->dims[1] != a->dims[1]) {
+        return -1;
+    }
+    if (bias != NULL && bias->ndata != cols) {
+        return -1;
+    }
+    if (y->type == ONNX_TENSOR_TYPE_INT32) {
+        return 0;
+    }
+    if (y->type != ONNX_TENSOR_TYPE_INT8 || n->ninput < 5 || n->inputs[3] == NULL || n->inputs[4] == NULL) {
+        return -1;
+    }
+    const int per_tensor = n->inputs[3]->ndata == 1 && n->inputs[4]->ndata == 1;
+    const int per_channel = n->inputs[3]->ndata == cols && n->inputs[4]->ndata == cols;
+    return per_tensor || per_channel ? 0 : -1;
+}
+
+int MatMulInteger(struct onnx_node_t *n)
+{
+    const struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const struct onnx_tensor_t *a = n->inputs[0]; // shape [m, k]
+    const struct onnx_tensor_t *b = n->inputs[1]; // shape [k, n]
+    const struct onnx_tensor_t *bias = matmul_integer_bias(n);
+    struct onnx_tensor_t *y = n->outputs[0];      // shape [m, n]
+
+    if (matmul_integer_check(pdat, n) != 0) {
+        return -1;
+    }
+
+    const int32_t rows = a->dims[1];
+    const int32_t depth = a->dims[0];
+    const int32_t cols = b->dims[0];
+    const int8_t *pa = (const int8_t *)a->datas;
+    const int8_t *pb = (const int8_t *)b->datas;
+    const int32_t *bias_data = bias ? (const int32_t *)bias->datas : NULL;
+    const _Bool quantized = y->type == ONNX_TENSOR_TYPE_INT8;
+    const int32_t *mult_data = quantized ? (const int32_t *)n->inputs[3]->datas : NULL;
+    const int32_t *shift_data = quantized ? (const int32_t *)n->inputs[4]->datas : NULL;
+    const _Bool per_channel = quantized && n->inputs[3]->ndata == (size_t)cols;
+
+    for (int32_t i = 0; i < rows; i++) {
+        for (int32_t j = 0; j < cols; j++) {
+            int32_t sum = bias_data ? bias_data[j] : 0;
+            for (int32_t kk = 0; kk < depth; kk++) {
+                sum += (pa[i * depth + kk] + pdat->a_offset) * (pb[kk * cols + j] + pdat->b_offset);
+            }
+            if (!quantized) {
+                ((int32_t *)y->datas)[i * cols + j] = sum;
+                continue;
+            }
+            const int32_t c = per_channel ? j : 0;
+            sum = requantize(sum, mult_data[c], shift_data[c]) + pdat->output_offset;
+            sum = MAX(sum, pdat->activation.min);
+            sum = MIN(sum, pdat->activation.max);
+            ((int8_t *)y->datas)[i * cols + j] = (int8_t)sum;
+        }
+    }
+    return 0;
+}
+
+#if defined(__riscv_vector)
+// b [k, n] as panels of nr columns, and the column offsets
+static void matmul_integer_pack_kernel(struct operator_pdata_t *pdat, const int8_t *b)
+{
+    const int32_t depth = pdat->k;
+    const int32_t cols = pdat->n;
+    int8_t *packed = pdat->kernel_packed;
+    size_t vl;
+
+    for (int32_t j = 0; j < cols; j += vl) {
+        vl = MIN(pdat->nr, cols - j);
+        vint32m4_t vsum = __riscv_vmv_v_x_i32m4(0, vl);
+        for (int32_t kk = 0; kk < depth; kk++) {
+            vint8m1_t vb = __riscv_vle8_v_i8m1(b + kk * cols + j, vl);
+            __riscv_vse8_v_i8m1(packed, vb, vl);
+            vsum = __riscv_vwadd_wv_i32m4(vsum, __riscv_vwadd_vx_i16m2(vb, 0, vl), vl);
+            packed += vl;
+        }
+        vsum = __riscv_vadd_vx_i32m4(__riscv_vmul_vx_i32m4(vsum, pdat->a_offset, vl), depth * pdat->a_offset * pdat->b_offset, vl);
+        __riscv_vse32_v_i32m4(pdat->col_offset + j, vsum, vl);
+    }
+}
+
+// b_offset * rowsum(a) of one row
+static int32_t matmul_integer_row_offset(const int8_t *pa, int32_t depth, int32_t b_offset)
+{
+    size_t vl;
+    vint32m1_t vsum = __riscv_vmv_v_x_i32m1(0, 1);
+
+    if (b_offset == 0) {
+        return 0;
+    }
+    for (size_t avl = depth; (vl = __riscv_vsetvl_e8m1(avl)) > 0; avl -= vl, pa += vl) {
+        vsum = __riscv_vwredsum_vs_i16m2_i32m1(__riscv_vwadd_vx_i16m2(__riscv_vle8_v_i8m1(pa, vl), 0, vl), vsum, vl);
+    }
+    return b_offset * __riscv_vmv_x_s_i32m1_i32(vsum);
+}
+
+// rows [start, end) of y, in blocks of MATMUL_INTEGER_ROWS, the rows past the last repeat row 0 and store the same values over it
+static void matmul_integer_rvv(void *arg, int start, int end)
+{
+    const struct onnx_node_t *n = (const struct onnx_node_t *)arg;
+    const struct operator_pdata_t *pdat = (const struct operator_pdata_t *)n->priv;
+    const struct onnx_tensor_t *a = n->inputs[0];
+    const struct onnx_tensor_t *bias = matmul_integer_bias(n);
+    struct onnx_tensor_t *y = n->outputs[0];
+    const int32_t depth = pdat->k;
+    const int32_t cols = pdat->n;
+    const int32_t *bias_data = bias ? (const int32_t *)bias->datas : NULL;
+    const _Bool quantized = y->type == ONNX_TENSOR_TYPE_INT8;
+    const int32_t *mult_data = quantized ? (const int32_t *)n->inputs[3]->datas : NULL;
+    const int32_t *shift_data = quantized ? (const int32_t *)n->inputs[4]->datas : NULL;
+    const _Bool per_channel = quantized && n->inputs[3]->ndata == (size_t)cols;
+    size_t vl;
+
+    for (int32_t i = start; i < end; i += MATMUL_INTEGER_ROWS) {
+        const int32_t rows = MIN(MATMUL_INTEGER_ROWS, end - i);
+        const int8_t *pa0 = (const int8_t *)a->datas + i * depth;
+        const int8_t *pa1 = rows > 1 ? pa0 + depth : pa0;
+        const int8_t *pa2 = rows > 2 ? pa0 + 2 * depth : pa0;
+        const int8_t *pa3 = rows > 3 ? pa0 + 3 * depth : pa0;
+        const size_t y0 = i * cols;
+        const size_t y1 = rows > 1 ? y0 + cols : y0;
+        const size_t y2 = rows > 2 ? y0 + 2 * cols : y0;
+        const size_t y3 = rows > 3 ? y0 + 3 * cols : y0;
+        const int32_t row0 = matmul_integer_row_offset(pa0, depth, pdat->b_offset);
+        const int32_t row1 = matmul_integer_row_offset(pa1, depth, pdat->b_offset);
+        const int32_t row2 = matmul_integer_row_offset(pa2, depth, pdat->b_offset);
+        const int32_t row3 = matmul_integer_row_offset(pa3, depth, pdat->b_offset);
+        const int8_t *pb = pdat->kernel_packed;
+
+        for (int32_t j = 0; j < cols; j += vl) {
+            vl = MIN(pdat->nr, cols - j);
+            vint32m4_t vres0 = __riscv_vmv_v_x_i32m4(0, vl);
+            vint32m4_t vres1 = __riscv_vmv_v_v_i32m4(vres0, vl);
+            vint32m4_t vres2 = __riscv_vmv_v_v_i32m4(vres0, vl);
+            vint32m4_t vres3 = __riscv_vmv_v_v_i32m4(vres0, vl);
+            for (int32_t kk = 0; kk < depth; kk++) {
+                vint16m2_t vb = __riscv_vwadd_vx_i16m2(__riscv_vle8_v_i8m1(pb, vl), 0, vl);
+                vres0 = __riscv_vwmacc_vx_i32m4(vres0, pa0[kk], vb, vl);
+                vres1 = __riscv_vwmacc_vx_i32m4(vres1, pa1[kk], vb, vl);
+                vres2 = __riscv_vwmacc_vx_i32m4(vres2, pa2[kk], vb, vl);
+                vres3 = __riscv_vwmacc_vx_i32m4(vres3, pa3[kk], vb, vl);
+                pb += vl;
+            }
+
+            vint32m4_t vcol = __riscv_vle32_v_i32m4(pdat->col_offset + j, vl);
+            if (bias_data) {
+                vcol = __riscv_vadd_vv_i32m4(vcol, __riscv_vle32_v_i32m4(bias_data + j, vl), vl);
+            }
+            vres0 = __riscv_vadd_vx_i32m4(__riscv_vadd_vv_i32m4(vres0, vcol, vl), row0, vl);
+            vres1 = __riscv_vadd_vx_i32m4(__riscv_vadd_vv_i32m4(vres1, vcol, vl), row1, vl);
+            vres2 = __riscv_vadd_vx_i32m4(__riscv_vadd_vv_i32m4(vres2, vcol, vl), row2, vl);
+            vres3 = __riscv_vadd_vx_i32m4(__riscv_vadd_vv_i32m4(vres3, vcol, vl), row3, vl);
+
+            if (!quantized) {
+                int32_t *py = (int32_t *)y->datas + j;
+                __riscv_vse32_v_i32m4(py + y3, vres3, vl);
+                __riscv_vse32_v_i32m4(py + y2, vres2, vl);
+                __riscv_vse32_v_i32m4(py + y1, vres1, vl);
+                __riscv_vse32_v_i32m4(py + y0, vres0, vl);
+                continue;
+            }
+            vint32m4_t vmult = per_channel ? __riscv_vle32_v_i32m4(mult_data + j, vl) : __riscv_vmv_v_x_i32m4(mult_data[0], vl);
+            vint32m4_t vshift = per_channel ? __riscv_vle32_v_i32m4(shift_data + j, vl) : __riscv_vmv_v_x_i32m4(shift_data[0], vl);
+            const int32_t out_offset = pdat->output_offset;
+            int8_t *py = (int8_t *)y->datas + j;
+            __riscv_vse8_v_i8m1(py + y3, requantize_i32m4(vres3, vmult, vshift, out_offset, pdat->activation.min, pdat->activation.max, vl), vl);
+            __riscv_vse8_v_i8m1(py + y2, requantize_i32m4(vres2, vmult, vshift, out_offset, pdat->activation.min, pdat->activation.max, vl), vl);
+            __riscv_vse8_v_i8m1(py + y1, requantize_i32m4(vres1, vmult, vshift, out_offset, pdat->activation.min, pdat->activation.max, vl), vl);
+            __riscv_vse8_v_i8m1(py + y0, requantize_i32m4(vres0, vmult, vshift, out_offset, pdat->activation.min, pdat->activation.max, vl), vl);
+        }
+    }
+}
+
+int MatMulInteger_rvv(struct onnx_node_t *n)
+{
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    if (pdat == NULL || pdat->buf == NULL) {
+        // parameters generated for the scalar kernel
+        return MatMulInteger(n);
+    }
+    if (matmul_integer_check(pdat, n) != 0 || n->inputs[1]->dims[1] != pdat->k || n->inputs[1]->dims[0] != pdat->n) {
+        return -1;
+    }
+    if (!pdat->kernel_ready) {
+        PrepareMatMulIntegerWeights(pdat, n->inputs[1]);
+    }
+    // keep the MATMUL_INTEGER_ROWS rows blocks inside one chunk
+    onnx_parallel_for(n->inputs[0]->dims[1], MATMUL_INTEGER_ROWS, matmul_integer_rvv, n);
+    return 0;
+}
+#endif /* defined(__riscv_vector) */
+
+void *GenerateMatMulIntegerParam(int32_t a_offset, int32_t b_offset, int32_t out_offset, int32_t activation_min, int32_t activation_max,
+                                 const struct onnx_tensor_t *b, _Bool rvv)
+{
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)MALLOC_ASSERT(sizeof(struct operator_pdata_t));
+    pdat->buf = NULL;
+    pdat->buf_size = 0;
+    pdat->a_offset = a_offset;
+    pdat->b_offset = b_offset;
+    pdat->output_offset = out_offset;
+    pdat->activation.min = activation_min;
+    pdat->activation.max = activation_max;
+    pdat->k = b->dims[1];
+    pdat->n = b->dims[0];
+    pdat->nr = 0;
+    pdat->kernel_packed = NULL;
+    pdat->col_offset = NULL;
+    pdat->kernel_ready = 0;
+
+#if defined(__riscv_vector)
+    if (rvv) {
+        // the packed b and the column offsets
+        pdat->nr = __riscv_vsetvlmax_e32m4();
+        pdat->buf_size = pdat->n * sizeof(int32_t) + b->ndata;
+        pdat->buf = MALLOC_ASSERT(pdat->buf_size);
+        pdat->col_offset = (int32_t *)pdat->buf;
+        pdat->kernel_packed = (int8_t *)pdat->buf + pdat->n * sizeof(int32_t);
+    }
+#else
+    (void)rvv;
+#endif
+    if (b->datas != NULL) {
+        PrepareMatMulIntegerWeights(pdat, b);
+    }
+    return pdat;
+}
+
+int PrepareMatMulIntegerWeights(void *pdat, const struct onnx_tensor_t *b)
+{
+    struct operator_pdata_t *_pdat = (struct operator_pdata_t *)pdat;
+    if (b->dims[1] != _pdat->k || b->dims[0] != _pdat->n) {
+        return -1;
+    }
+#if defined(__riscv_vector)
+    if (_pdat->kernel_packed != NULL) {
+        matmul_integer_pack_kernel(_pdat, (const int8_t *)b->datas);
+    }
+#endif
+    // the scalar kernel reads b directly
+    _pdat->kernel_ready = 1;
+    return 0;
+}
+
+void FreeMatMulIntegerParam(void **pdat)
+{
+    struct operator_pdata_t *_pdat = (struct operator_pdata_t *)*pdat;
+    if (_pdat->buf != NULL) {
+        free(_pdat->buf);
+        _pdat->buf = NULL;
+        _pdat->buf_size = 0;
+    }
+    free(*pdat);
+    *pdat = NULL;
+}
@@ -19,6 +19,7 @@ void Mul_int8(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Mul_int8_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *y = n->outputs[0];
@@ -40,6 +41,7 @@ void Mul_int8_rvv(struct onnx_node_t *n)
         py += l;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Mul_float16(struct onnx_node_t *n)
 {
@@ -55,6 +57,7 @@ void Mul_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Mul_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *y = n->outputs[0];
@@ -76,6 +79,7 @@ void Mul_float16_rvv(struct onnx_node_t *n)
         py += l;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Mul_float32(struct onnx_node_t *n)
 {
@@ -91,6 +95,7 @@ void Mul_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Mul_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *y = n->outputs[0];
@@ -113,3 +118,4 @@ void Mul_float32_rvv(struct onnx_node_t *n)
         py += l;
     }
 }
+#endif /* defined(__riscv_vector) */
@@ -17,6 +17,7 @@ void Negate_int8(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Negate_int8_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -35,6 +36,7 @@ void Negate_int8_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Negate_int32(struct onnx_node_t *n)
 {
@@ -48,6 +50,7 @@ void Negate_int32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Negate_int32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -66,6 +69,7 @@ void Negate_int32_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Negate_float16(struct onnx_node_t *n)
 {
@@ -79,6 +83,7 @@ void Negate_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Negate_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -97,6 +102,7 @@ void Negate_float16_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Negate_float32(struct onnx_node_t *n)
 {
@@ -110,6 +116,7 @@ void Negate_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Negate_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -128,3 +135,4 @@ void Negate_float32_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
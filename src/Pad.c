@@ -75,6 +75,7 @@ void Pad_int8(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Pad_int8_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -131,6 +132,7 @@ void Pad_int8_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Pad_int32(struct onnx_node_t *n)
 {
@@ -174,6 +176,7 @@ void Pad_int32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Pad_int32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -230,6 +233,7 @@ void Pad_int32_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Pad_float16(struct onnx_node_t *n)
 {
@@ -273,6 +277,7 @@ void Pad_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Pad_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -329,6 +334,7 @@ void Pad_float16_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Pad_float32(struct onnx_node_t *n)
 {
@@ -372,6 +378,7 @@ void Pad_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Pad_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -428,6 +435,7 @@ void Pad_float32_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void *GeneratePadParam(OnnxScalar value, int top, int bottom, int left, int right)
 {
@@ -0,0 +1,571 @@
+/*
+ * https://onnx.ai/onnx/operators/onnx__MaxPool.html
+ * https://onnx.ai/onnx/operators/onnx__AveragePool.html
+ * https://onnx.ai/onnx/operators/onnx__GlobalAveragePool.html
+ */
+
+#include "operators.h"
+#include "utils.h"
+
+struct operator_pdata_t {
+    int kernel_w;
+    int kernel_h;
+    int stride_w;
+    int stride_h;
+    int pad_w;
+    int pad_h;
+    _Bool count_include_pad; /**< AveragePool divides by the whole window, padding included */
+    int32_t zero_point;      /**< int8 AveragePool, value of the padding counted by count_include_pad */
+};
+
+/**
+ * NOTE: y->dims is managed by the caller
+ * x is [batch, in_h, in_w, ch] and y is [batch, out_h, out_w, ch] as in ConvInteger,
+ * out_w = (in_w + 2 * pad_w - kernel_w) / stride_w + 1, the same for h.
+ * GlobalAveragePool has y [batch, 1, 1, ch] and no parameters.
+ */
+
+// window of the output pixel (oy, ox) clipped to the input, empty when it lies in the padding, returns the divisor of
+// AveragePool. An empty window without count_include_pad divides by one padding value, so it averages to 0, the zero
+// point for int8
+static int pool_window(const struct operator_pdata_t *pdat, const struct onnx_tensor_t *x, int oy, int ox, int *y0, int *y1, int *x0, int *x1)
+{
+    const int hy = oy * pdat->stride_h - pdat->pad_h;
+    const int wx = ox * pdat->stride_w - pdat->pad_w;
+    *y0 = MAX(hy, 0);
+    *y1 = MAX(MIN(hy + pdat->kernel_h, x->dims[2]), *y0);
+    *x0 = MAX(wx, 0);
+    *x1 = MAX(MIN(wx + pdat->kernel_w, x->dims[1]), *x0);
+    if (pdat->count_include_pad) {
+        return (MIN(hy + pdat->kernel_h, x->dims[2] + pdat->pad_h) - hy) * (MIN(wx + pdat->kernel_w, x->dims[1] + pdat->pad_w) - wx);
+    }
+    return MAX((*y1 - *y0) * (*x1 - *x0), 1);
+}
+
+// sum / count rounded half away from zero, the average of int8 values fits int8
+static int8_t pool_average_s8(int32_t sum, int32_t count)
+{
+    sum = sum >= 0 ? sum + count / 2 : sum - count / 2;
+    return (int8_t)(sum / count);
+}
+
+void MaxPool_int8(struct onnx_node_t *n)
+{
+    struct onnx_tensor_t *x = n->inputs[0];
+    struct onnx_tensor_t *y = n->outputs[0];
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const int ch = x->dims[0], in_w = x->dims[1], in_h = x->dims[2];
+    int8_t *py = (int8_t *)y->datas;
+    int y0, y1, x0, x1;
+
+    for (int b = 0; b < x->dims[3]; b++) {
+        const int8_t *px = (const int8_t *)x->datas + b * in_h * in_w * ch;
+        for (int oy = 0; oy < y->dims[2]; oy++) {
+            for (int ox = 0; ox < y->dims[1]; ox++) {
+                pool_window(pdat, x, oy, ox, &y0, &y1, &x0, &x1);
+                for (int c = 0; c < ch; c++) {
+                    int8_t max = INT8_MIN;
+                    for (int iy = y0; iy < y1; iy++) {
+                        for (int ix = x0; ix < x1; ix++) {
+                            max = MAX(max, px[(iy * in_w + ix) * ch + c]);
+                        }
+                    }
+                    *py++ = max;
+                }
+            }
+        }
+    }
+}
+
+void MaxPool_float16(struct onnx_node_t *n)
+{
+    struct onnx_tensor_t *x = n->inputs[0];
+    struct onnx_tensor_t *y = n->outputs[0];
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const int ch = x->dims[0], in_w = x->dims[1], in_h = x->dims[2];
+    float16_t *py = (float16_t *)y->datas;
+    int y0, y1, x0, x1;
+
+    for (int b = 0; b < x->dims[3]; b++) {
+        const float16_t *px = (const float16_t *)x->datas + b * in_h * in_w * ch;
+        for (int oy = 0; oy < y->dims[2]; oy++) {
+            for (int ox = 0; ox < y->dims[1]; ox++) {
+                pool_window(pdat, x, oy, ox, &y0, &y1, &x0, &x1);
+                for (int c = 0; c < ch; c++) {
+                    float16_t max = (float16_t)-INFINITY;
+                    for (int iy = y0; iy < y1; iy++) {
+                        for (int ix = x0; ix < x1; ix++) {
+                            max = MAX(max, px[(iy * in_w + ix) * ch + c]);
+                        }
+                    }
+                    *py++ = max;
+                }
+            }
+        }
+    }
+}
+
+void MaxPool_float32(struct onnx_node_t *n)
+{
+    struct onnx_tensor_t *x = n->inputs[0];
+    struct onnx_tensor_t *y = n->outputs[0];
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const int ch = x->dims[0], in_w = x->dims[1], in_h = x->dims[2];
+    float32_t *py = (float32_t *)y->datas;
+    int y0, y1, x0, x1;
+
+    for (int b = 0; b < x->dims[3]; b++) {
+        const float32_t *px = (const float32_t *)x->datas + b * in_h * in_w * ch;
+        for (int oy = 0; oy < y->dims[2]; oy++) {
+            for (int ox = 0; ox < y->dims[1]; ox++) {
+                pool_window(pdat, x, oy, ox, &y0, &y1, &x0, &x1);
+                for (int c = 0; c < ch; c++) {
+                    float32_t max = -INFINITY;
+                    for (int iy = y0; iy < y1; iy++) {
+                        for (int ix = x0; ix < x1; ix++) {
+                            max = MAX(max, px[(iy * in_w + ix) * ch + c]);
+                        }
+                    }
+                    *py++ = max;
+                }
+            }
+        }
+    }
+}
+
+void AveragePool_int8(struct onnx_node_t *n)
+{
+    struct onnx_tensor_t *x = n->inputs[0];
+    struct onnx_tensor_t *y = n->outputs[0];
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const int ch = x->dims[0], in_w = x->dims[1], in_h = x->dims[2];
+    int8_t *py = (int8_t *)y->datas;
+    int y0, y1, x0, x1;
+
+    for (int b = 0; b < x->dims[3]; b++) {
+        const int8_t *px = (const int8_t *)x->datas + b * in_h * in_w * ch;
+        for (int oy = 0; oy < y->dims[2]; oy++) {
+            for (int ox = 0; ox < y->dims[1]; ox++) {
+                const int count = pool_window(pdat, x, oy, ox, &y0, &y1, &x0, &x1);
+                // padding counted by count_include_pad holds the zero point
+                const int32_t pad_sum = (count - (y1 - y0) * (x1 - x0)) * pdat->zero_point;
+                for (int c = 0; c < ch; c++) {
+                    int32_t sum = pad_sum;
+                    for (int iy = y0; iy < y1; iy++) {
+                        for (int ix = x0; ix < x1; ix++) {
+                            sum += px[(iy * in_w + ix) * ch + c];
+                        }
+                    }
+                    *py++ = pool_average_s8(sum, count);
+                }
+            }
+        }
+    }
+}
+
+void AveragePool_float16(struct onnx_node_t *n)
+{
+    struct onnx_tensor_t *x = n->inputs[0];
+    struct onnx_tensor_t *y = n->outputs[0];
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const int ch = x->dims[0], in_w = x->dims[1], in_h = x->dims[2];
+    float16_t *py = (float16_t *)y->datas;
+    int y0, y1, x0, x1;
+
+    for (int b = 0; b < x->dims[3]; b++) {
+        const float16_t *px = (const float16_t *)x->datas + b * in_h * in_w * ch;
+        for (int oy = 0; oy < y->dims[2]; oy++) {
+            for (int ox = 0; ox < y->dims[1]; ox++) {
+                const int count = pool_window(pdat, x, oy, ox, &y0, &y1, &x0, &x1);
+                for (int c = 0; c < ch; c++) {
+                    // float16 accumulates in float32
+                    float32_t sum = 0.0f;
+                    for (int iy = y0; iy < y1; iy++) {
+                        for (int ix = x0; ix < x1; ix++) {
+                            sum += (float32_t)px[(iy * in_w + ix) * ch + c];
+                        }
+                    }
+                    *py++ = (float16_t)(sum / count);
+                }
+            }
+        }
+    }
+}
+
+void AveragePool_float32(struct onnx_node_t *n)
+{
+    struct onnx_tensor_t *x = n->inputs[0];
+    struct onnx_tensor_t *y = n->outputs[0];
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const int ch = x->dims[0], in_w = x->dims[1], in_h = x->dims[2];
+    float32_t *py = (float32_t *)y->datas;
+    int y0, y1, x0, x1;
+
+    for (int b = 0; b < x->dims[3]; b++) {
+        const float32_t *px = (const float32_t *)x->datas + b * in_h * in_w * ch;
+        for (int oy = 0; oy < y->dims[2]; oy++) {
+            for (int ox = 0; ox < y->dims[1]; ox++) {
+                const int count = pool_window(pdat, x, oy, ox, &y0, &y1, &x0, &x1);
+                for (int c = 0; c < ch; c++) {
+                    float32_t sum = 0.0f;
+                    for (int iy = y0; iy < y1; iy++) {
+                        for (int ix = x0; ix < x1; ix++) {
+                            sum += px[(iy * in_w + ix) * ch + c];
+                        }
+                    }
+                    *py++ = sum / count;
+                }
+            }
+        }
+    }
+}
+
+void GlobalAveragePool_int8(struct onnx_node_t *n)
+{
+    struct onnx_tensor_t *x = n->inputs[0];
+    struct onnx_tensor_t *y = n->outputs[0];
+    const int ch = x->dims[0], pixels = x->dims[1] * x->dims[2];
+    const int8_t *px = (const int8_t *)x->datas;
+    int8_t *py = (int8_t *)y->datas;
+
+    for (int b = 0; b < x->dims[3]; b++) {
+        for (int c = 0; c < ch; c++) {
+            int32_t sum = 0;
+            for (int i = 0; i < pixels; i++) {
+                sum += px[i * ch + c];
+            }
+            *py++ = pool_average_s8(sum, pixels);
+        }
+        px += pixels * ch;
+    }
+}
+
+void GlobalAveragePool_float16(struct onnx_node_t *n)
+{
+    struct onnx_tensor_t *x = n->inputs[0];
+    struct onnx_tensor_t *y = n->outputs[0];
+    const int ch = x->dims[0], pixels = x->dims[1] * x->dims[2];
+    const float16_t *px = (const float16_t *)x->datas;
+    float16_t *py = (float16_t *)y->datas;
+
+    for (int b = 0; b < x->dims[3]; b++) {
+        for (int c = 0; c < ch; c++) {
+            float32_t sum = 0.0f;
+            for (int i = 0; i < pixels; i++) {
+                sum += (float32_t)px[i * ch + c];
+            }
+            *py++ = (float16_t)(sum / pixels);
+        }
+        px += pixels * ch;
+    }
+}
+
+void GlobalAveragePool_float32(struct onnx_node_t *n)
+{
+    struct onnx_tensor_t *x = n->inputs[0];
+    struct onnx_tensor_t *y = n->outputs[0];
+    const int ch = x->dims[0], pixels = x->dims[1] * x->dims[2];
+    const float32_t *px = (const float32_t *)x->datas;
+    float32_t *py = (float32_t *)y->datas;
+
+    for (int b = 0; b < x->dims[3]; b++) {
+        for (int c = 0; c < ch; c++) {
+            float32_t sum = 0.0f;
+            for (int i = 0; i < pixels; i++) {
+                sum += px[i * ch + c];
+            }
+            *py++ = sum / pixels;
+        }
+        px += pixels * ch;
+    }
+}
+
+#if defined(__riscv_vector)
+// pool_average_s8 of every lane
+__STATIC_FORCEINLINE vint8m2_t pool_average_i32m8(vint32m8_t sum, int32_t count, size_t vl)
+{
+    // sign is 0 or -1, (count / 2 ^ sign) - sign is count / 2 or -(count / 2)
+    const vint32m8_t sign = __riscv_vsra_vx_i32m8(sum, 31, vl);
+    const vint32m8_t half = __riscv_vsub_vv_i32m8(__riscv_vxor_vx_i32m8(sign, count / 2, vl), sign, vl);
+    sum = __riscv_vdiv_vx_i32m8(__riscv_vadd_vv_i32m8(sum, half, vl), count, vl);
+    return __riscv_vncvt_x_x_w_i8m2(__riscv_vncvt_x_x_w_i16m4(sum, vl), vl);
+}
+
+void MaxPool_int8_rvv(struct onnx_node_t *n)
+{
+    struct onnx_tensor_t *x = n->inputs[0];
+    struct onnx_tensor_t *y = n->outputs[0];
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const int ch = x->dims[0], in_w = x->dims[1], in_h = x->dims[2];
+    int8_t *py = (int8_t *)y->datas;
+    int y0, y1, x0, x1;
+    size_t vl;
+
+    for (int b = 0; b < x->dims[3]; b++) {
+        const int8_t *px = (const int8_t *)x->datas + b * in_h * in_w * ch;
+        for (int oy = 0; oy < y->dims[2]; oy++) {
+            for (int ox = 0; ox < y->dims[1]; ox++) {
+                pool_window(pdat, x, oy, ox, &y0, &y1, &x0, &x1);
+                for (int c = 0; c < ch; c += vl) {
+                    vl = __riscv_vsetvl_e8m8(ch - c);
+                    vint8m8_t vmax = __riscv_vmv_v_x_i8m8(INT8_MIN, vl);
+                    for (int iy = y0; iy < y1; iy++) {
+                        for (int ix = x0; ix < x1; ix++) {
+                            vmax = __riscv_vmax_vv_i8m8(vmax, __riscv_vle8_v_i8m8(px + (iy * in_w + ix) * ch + c, vl), vl);
+                        }
+                    }
+                    __riscv_vse8_v_i8m8(py + c, vmax, vl);
+                }
+                py += ch;
+            }
+        }
+    }
+}
+
+void MaxPool_float16_rvv(struct onnx_node_t *n)
+{
+    struct onnx_tensor_t *x = n->inputs[0];
+    struct onnx_tensor_t *y = n->outputs[0];
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const int ch = x->dims[0], in_w = x->dims[1], in_h = x->dims[2];
+    float16_t *py = (float16_t *)y->datas;
+    int y0, y1, x0, x1;
+    size_t vl;
+
+    for (int b = 0; b < x->dims[3]; b++) {
+        const float16_t *px = (const float16_t *)x->datas + b * in_h * in_w * ch;
+        for (int oy = 0; oy < y->dims[2]; oy++) {
+            for (int ox = 0; ox < y->dims[1]; ox++) {
+                pool_window(pdat, x, oy, ox, &y0, &y1, &x0, &x1);
+                for (int c = 0; c < ch; c += vl) {
+                    vl = __riscv_vsetvl_e16m8(ch - c);
+                    vfloat16m8_t vmax = __riscv_vfmv_v_f_f16m8((float16_t)-INFINITY, vl);
+                    for (int iy = y0; iy < y1; iy++) {
+                        for (int ix = x0; ix < x1; ix++) {
+                            vmax = __riscv_vfmax_vv_f16m8(vmax, __riscv_vle16_v_f16m8(px + (iy * in_w + ix) * ch + c, vl), vl);
+                        }
+                    }
+                    __riscv_vse16_v_f16m8(py + c, vmax, vl);
+                }
+                py += ch;
+            }
+        }
+    }
+}
+
+void MaxPool_float32_rvv(struct onnx_node_t *n)
+{
+    struct onnx_tensor_t *x = n->inputs[0];
+    struct onnx_tensor_t *y = n->outputs[0];
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const int ch = x->dims[0], in_w = x->dims[1], in_h = x->dims[2];
+    float32_t *py = (float32_t *)y->datas;
+    int y0, y1, x0, x1;
+    size_t vl;
+
+    for (int b = 0; b < x->dims[3]; b++) {
+        const float32_t *px = (const float32_t *)x->datas + b * in_h * in_w * ch;
+        for (int oy = 0; oy < y->dims[2]; oy++) {
+            for (int ox = 0; ox < y->dims[1]; ox++) {
+                pool_window(pdat, x, oy, ox, &y0, &y1, &x0, &x1);
+                for (int c = 0; c < ch; c += vl) {
+                    vl = __riscv_vsetvl_e32m8(ch - c);
+                    vfloat32m8_t vmax = __riscv_vfmv_v_f_f32m8(-INFINITY, vl);
+                    for (int iy = y0; iy < y1; iy++) {
+                        for (int ix = x0; ix < x1; ix++) {
+                            vmax = __riscv_vfmax_vv_f32m8(vmax, __riscv_vle32_v_f32m8(px + (iy * in_w + ix) * ch + c, vl), vl);
+                        }
+                    }
+                    __riscv_vse32_v_f32m8(py + c, vmax, vl);
+                }
+                py += ch;
+            }
+        }
+    }
+}
+
+void AveragePool_int8_rvv(struct onnx_node_t *n)
+{
+    struct onnx_tensor_t *x = n->inputs[0];
+    struct onnx_tensor_t *y = n->outputs[0];
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const int ch = x->dims[0], in_w = x->dims[1], in_h = x->dims[2];
+    int8_t *py = (int8_t *)y->datas;
+    int y0, y1, x0, x1;
+    size_t vl;
+
+    for (int b = 0; b < x->dims[3]; b++) {
+        const int8_t *px = (const int8_t *)x->datas + b * in_h * in_w * ch;
+        for (int oy = 0; oy < y->dims[2]; oy++) {
+            for (int ox = 0; ox < y->dims[1]; ox++) {
+                const int count = pool_window(pdat, x, oy, ox, &y0, &y1, &x0, &x1);
+                const int32_t pad_sum = (count - (y1 - y0) * (x1 - x0)) * pdat->zero_point;
+                for (int c = 0; c < ch; c += vl) {
+                    vl = __riscv_vsetvl_e8m2(ch - c);
+                    vint32m8_t vsum = __riscv_vmv_v_x_i32m8(pad_sum, vl);
+                    for (int iy = y0; iy < y1; iy++) {
+                        for (int ix = x0; ix < x1; ix++) {
+                            vint8m2_t vx = __riscv_vle8_v_i8m2(px + (iy * in_w + ix) * ch + c, vl);
+                            vsum = __riscv_vadd_vv_i32m8(vsum, __riscv_vsext_vf4_i32m8(vx, vl), vl);
+                        }
+                    }
+                    __riscv_vse8_v_i8m2(py + c, pool_average_i32m8(vsum, count, vl), vl);
+                }
+                py += ch;
+            }
+        }
+    }
+}
+
+void AveragePool_float16_rvv(struct onnx_node_t *n)
+{
+    struct onnx_tensor_t *x = n->inputs[0];
+    struct onnx_tensor_t *y = n->outputs[0];
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const int ch = x->dims[0], in_w = x->dims[1], in_h = x->dims[2];
+    float16_t *py = (float16_t *)y->datas;
+    int y0, y1, x0, x1;
+    size_t vl;
+
+    for (int b = 0; b < x->dims[3]; b++) {
+        const float16_t *px = (const float16_t *)x->datas + b * in_h * in_w * ch;
+        for (int oy = 0; oy < y->dims[2]; oy++) {
+            for (int ox = 0; ox < y->dims[1]; ox++) {
+                const int count = pool_window(pdat, x, oy, ox, &y0, &y1, &x0, &x1);
+                for (int c = 0; c < ch; c += vl) {
+                    vl = __riscv_vsetvl_e16m4(ch - c);
+                    vfloat32m8_t vsum = __riscv_vfmv_v_f_f32m8(0.0f, vl);
+                    for (int iy = y0; iy < y1; iy++) {
+                        for (int ix = x0; ix < x1; ix++) {
+                            vsum = __riscv_vfwadd_wv_f32m8(vsum, __riscv_vle16_v_f16m4(px + (iy * in_w + ix) * ch + c, vl), vl);
+                        }
+                    }
+                    __riscv_vse16_v_f16m4(py + c, __riscv_vfncvt_f_f_w_f16m4(__riscv_vfdiv_vf_f32m8(vsum, (float32_t)count, vl), vl), vl);
+                }
+                py += ch;
+            }
+        }
+    }
+}
+
+void AveragePool_float32_rvv(struct onnx_node_t *n)
+{
+    struct onnx_tensor_t *x = n->inputs[0];
+    struct onnx_tensor_t *y = n->outputs[0];
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
+    const int ch = x->dims[0], in_w = x->dims[1], in_h = x->dims[2];
+    float32_t *py = (float32_t *)y->datas;
+    int y0, y1, x0, x1;
+    size_t vl;
+
+    for (int b = 0; b < x->dims[3]; b++) {
+        const float32_t *px = (const float32_t *)x->datas + b * in_h * in_w * ch;
+        for (int oy = 0; oy < y->dims[2]; oy++) {
+            for (int ox = 0; ox < y->dims[1]; ox++) {
+                const int count = pool_window(pdat, x, oy, ox, &y0, &y1, &x0, &x1);
+                for (int c = 0; c < ch; c += vl) {
+                    vl = __riscv_vsetvl_e32m8(ch - c);
+                    vfloat32m8_t vsum = __riscv_vfmv_v_f_f32m8(0.0f, vl);
+                    for (int iy = y0; iy < y1; iy++) {
+                        for (int ix = x0; ix < x1; ix++) {
+                            vsum = __riscv_vfadd_vv_f32m8(vsum, __riscv_vle32_v_f32m8(px + (iy * in_w + ix) * ch + c, vl), vl);
+                        }
+                    }
+                    __riscv_vse32_v_f32m8(py + c, __riscv_vfdiv_vf_f32m8(vsum, (float32_t)count, vl), vl);
+                }
+                py += ch;
+            }
+        }
+    }
+}
+
+void GlobalAveragePool_int8_rvv(struct onnx_node_t *n)
+{
+    struct onnx_tensor_t *x = n->inputs[0];
+    struct onnx_tensor_t *y = n->outputs[0];
+    const int ch = x->dims[0], pixels = x->dims[1] * x->dims[2];
+    const int8_t *px = (const int8_t *)x->datas;
+    int8_t *py = (int8_t *)y->datas;
+    size_t vl;
+
+    for (int b = 0; b < x->dims[3]; b++) {
+        for (int c = 0; c < ch; c += vl) {
+            vl = __riscv_vsetvl_e8m2(ch - c);
+            vint32m8_t vsum = __riscv_vmv_v_x_i32m8(0, vl);
+            for (int i = 0; i < pixels; i++) {
+                vsum = __riscv_vadd_vv_i32m8(vsum, __riscv_vsext_vf4_i32m8(__riscv_vle8_v_i8m2(px + i * ch + c, vl), vl), vl);
+            }
+            __riscv_vse8_v_i8m2(py + c, pool_average_i32m8(vsum, pixels, vl), vl);
+        }
+        px += pixels * ch;
+        py += ch;
+    }
+}
+
+void GlobalAveragePool_float16_rvv(struct onnx_node_t *n)
+{
+    struct onnx_tensor_t *x = n->inputs[0];
+    struct onnx_tensor_t *y = n->outputs[0];
+    const int ch = x->dims[0], pixels = x->dims[1] * x->dims[2];
+    const float16_t *px = (const float16_t *)x->datas;
+    float16_t *py = (float16_t *)y->datas;
+    size_t vl;
+
+    for (int b = 0; b < x->dims[3]; b++) {
+        for (int c = 0; c < ch; c += vl) {
+            vl = __riscv_vsetvl_e16m4(ch - c);
+            vfloat32m8_t vsum = __riscv_vfmv_v_f_f32m8(0.0f, vl);
+            for (int i = 0; i < pixels; i++) {
+                vsum = __riscv_vfwadd_wv_f32m8(vsum, __riscv_vle16_v_f16m4(px + i * ch + c, vl), vl);
+            }
+            __riscv_vse16_v_f16m4(py + c, __riscv_vfncvt_f_f_w_f16m4(__riscv_vfdiv_vf_f32m8(vsum, (float32_t)pixels, vl), vl), vl);
+        }
+        px += pixels * ch;
+        py += ch;
+    }
+}
+
+void GlobalAveragePool_float32_rvv(struct onnx_node_t *n)
+{
+    struct onnx_tensor_t *x = n->inputs[0];
+    struct onnx_tensor_t *y = n->outputs[0];
+    const int ch = x->dims[0], pixels = x->dims[1] * x->dims[2];
+    const float32_t *px = (const float32_t *)x->datas;
+    float32_t *py = (float32_t *)y->datas;
+    size_t vl;
+
+    for (int b = 0; b < x->dims[3]; b++) {
+        for (int c = 0; c < ch; c += vl) {
+            vl = __riscv_vsetvl_e32m8(ch - c);
+            vfloat32m8_t vsum = __riscv_vfmv_v_f_f32m8(0.0f, vl);
+            for (int i = 0; i < pixels; i++) {
+                vsum = __riscv_vfadd_vv_f32m8(vsum, __riscv_vle32_v_f32m8(px + i * ch + c, vl), vl);
+            }
+            __riscv_vse32_v_f32m8(py + c, __riscv_vfdiv_vf_f32m8(vsum, (float32_t)pixels, vl), vl);
+        }
+        px += pixels * ch;
+        py += ch;
+    }
+}
+#endif /* defined(__riscv_vector) */
+
+void *GeneratePoolParam(int kernel_w, int kernel_h, int stride_w, int stride_h, int pad_w, int pad_h, _Bool count_include_pad,
+                        int32_t zero_point)
+{
+    struct operator_pdata_t *pdat = (struct operator_pdata_t *)MALLOC_ASSERT(sizeof(struct operator_pdata_t));
+    pdat->kernel_w = kernel_w;
+    pdat->kernel_h = kernel_h;
+    pdat->stride_w = stride_w;
+    pdat->stride_h = stride_h;
+    pdat->pad_w = pad_w;
+    pdat->pad_h = pad_h;
+    pdat->count_include_pad = count_include_pad;
+    pdat->zero_point = zero_point;
+    return pdat;
+}
+
+void FreePoolParam(void **pdat)
+{
+    free(*pdat);
+    *pdat = NULL;
+}
@@ -25,6 +25,7 @@ void Pow_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Pow_float16_rvv(struct onnx_node_t *n)
 {
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
@@ -85,6 +86,7 @@ void Pow_float16_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Pow_float32(struct onnx_node_t *n)
 {
@@ -99,6 +101,7 @@ void Pow_float32(struct onnx_node_t *n)
         py[i] = pow(px[i], exponent);
 }
 
+#if defined(__riscv_vector)
 // x^a = e ^ (alnx)
 void Pow_float32_rvv(struct onnx_node_t *n)
 {
@@ -160,6 +163,7 @@ void Pow_float32_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void *GeneratePowParam(OnnxScalar exponent)
 {
@@ -31,6 +31,7 @@ void RMSNormalization_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void RMSNormalization_float16_rvv(struct onnx_node_t *n)
 {
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
@@ -71,6 +72,7 @@ void RMSNormalization_float16_rvv(struct onnx_node_t *n)
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void RMSNormalization_float32(struct onnx_node_t *n)
 {
@@ -97,6 +99,7 @@ void RMSNormalization_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void RMSNormalization_float32_rvv(struct onnx_node_t *n)
 {
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
@@ -137,6 +140,7 @@ void RMSNormalization_float32_rvv(struct onnx_node_t *n)
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void *GenerateRMSNormParam(float epsilon, float momentum)
 {
@@ -65,6 +65,7 @@ void ReduceAll(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void ReduceAll_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -130,6 +131,7 @@ void ReduceAll_rvv(struct onnx_node_t *n)
         y->ndata = y->strides[y->ndim - 1] * y->dims[y->ndim - 1];
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void ReduceAny(struct onnx_node_t *n)
 {
@@ -188,6 +190,7 @@ void ReduceAny(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void ReduceAny_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -253,6 +256,7 @@ void ReduceAny_rvv(struct onnx_node_t *n)
         y->ndata = y->strides[y->ndim - 1] * y->dims[y->ndim - 1];
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void ReduceMax_int8(struct onnx_node_t *n)
 {
@@ -312,6 +316,7 @@ void ReduceMax_int8(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void ReduceMax_int8_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -377,6 +382,7 @@ void ReduceMax_int8_rvv(struct onnx_node_t *n)
         y->ndata = y->strides[y->ndim - 1] * y->dims[y->ndim - 1];
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void ReduceMax_float16(struct onnx_node_t *n)
 {
@@ -436,6 +442,7 @@ void ReduceMax_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void ReduceMax_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -501,6 +508,7 @@ void ReduceMax_float16_rvv(struct onnx_node_t *n)
         y->ndata = y->strides[y->ndim - 1] * y->dims[y->ndim - 1];
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void ReduceMax_int32(struct onnx_node_t *n)
 {
@@ -560,6 +568,7 @@ void ReduceMax_int32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void ReduceMax_int32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -625,6 +634,7 @@ void ReduceMax_int32_rvv(struct onnx_node_t *n)
         y->ndata = y->strides[y->ndim - 1] * y->dims[y->ndim - 1];
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void ReduceMax_float32(struct onnx_node_t *n)
 {
@@ -684,6 +694,7 @@ void ReduceMax_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void ReduceMax_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -749,6 +760,7 @@ void ReduceMax_float32_rvv(struct onnx_node_t *n)
         y->ndata = y->strides[y->ndim - 1] * y->dims[y->ndim - 1];
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void ReduceMin_int8(struct onnx_node_t *n)
 {
@@ -808,6 +820,7 @@ void ReduceMin_int8(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void ReduceMin_int8_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -873,6 +886,7 @@ void ReduceMin_int8_rvv(struct onnx_node_t *n)
         y->ndata = y->strides[y->ndim - 1] * y->dims[y->ndim - 1];
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void ReduceMin_float16(struct onnx_node_t *n)
 {
@@ -932,6 +946,7 @@ void ReduceMin_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void ReduceMin_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -997,6 +1012,7 @@ void ReduceMin_float16_rvv(struct onnx_node_t *n)
         y->ndata = y->strides[y->ndim - 1] * y->dims[y->ndim - 1];
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void ReduceMin_int32(struct onnx_node_t *n)
 {
@@ -1056,6 +1072,7 @@ void ReduceMin_int32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void ReduceMin_int32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -1121,6 +1138,7 @@ void ReduceMin_int32_rvv(struct onnx_node_t *n)
         y->ndata = y->strides[y->ndim - 1] * y->dims[y->ndim - 1];
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void ReduceMin_float32(struct onnx_node_t *n)
 {
@@ -1180,6 +1198,7 @@ void ReduceMin_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void ReduceMin_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -1245,6 +1264,7 @@ void ReduceMin_float32_rvv(struct onnx_node_t *n)
         y->ndata = y->strides[y->ndim - 1] * y->dims[y->ndim - 1];
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void ReduceProd_float16(struct onnx_node_t *n)
 {
@@ -1303,6 +1323,7 @@ void ReduceProd_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void ReduceProd_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -1442,6 +1463,7 @@ void ReduceProd_float16_rvv(struct onnx_node_t *n)
         y->ndata = y->strides[y->ndim - 1] * y->dims[y->ndim - 1];
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void ReduceProd_float32(struct onnx_node_t *n)
 {
@@ -1500,6 +1522,7 @@ void ReduceProd_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void ReduceProd_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -1639,6 +1662,7 @@ void ReduceProd_float32_rvv(struct onnx_node_t *n)
         y->ndata = y->strides[y->ndim - 1] * y->dims[y->ndim - 1];
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void ReduceSum_float16(struct onnx_node_t *n)
 {
@@ -1697,6 +1721,7 @@ void ReduceSum_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void ReduceSum_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -1762,6 +1787,7 @@ void ReduceSum_float16_rvv(struct onnx_node_t *n)
         y->ndata = y->strides[y->ndim - 1] * y->dims[y->ndim - 1];
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void ReduceSum_float32(struct onnx_node_t *n)
 {
@@ -1820,6 +1846,7 @@ void ReduceSum_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void ReduceSum_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -1884,4 +1911,5 @@ void ReduceSum_float32_rvv(struct onnx_node_t *n)
         }
         y->ndata = y->strides[y->ndim - 1] * y->dims[y->ndim - 1];
     }
-}
\ No newline at end of file
+}
+#endif /* defined(__riscv_vector) */
\ No newline at end of file
@@ -16,6 +16,7 @@ void Relu_float16(struct onnx_node_t *n)
         py[i] = (px[i] < 0) ? 0 : px[i];
 }
 
+#if defined(__riscv_vector)
 void Relu_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -34,6 +35,7 @@ void Relu_float16_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Relu_float32(struct onnx_node_t *n)
 {
@@ -46,6 +48,7 @@ void Relu_float32(struct onnx_node_t *n)
         py[i] = (px[i] < 0) ? 0 : px[i];
 }
 
+#if defined(__riscv_vector)
 void Relu_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -64,3 +67,4 @@ void Relu_float32_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
@@ -17,6 +17,7 @@ void Rsqrt_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Rsqrt_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -38,6 +39,7 @@ void Rsqrt_float16_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Rsqrt_float32(struct onnx_node_t *n)
 {
@@ -52,6 +54,7 @@ void Rsqrt_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Rsqrt_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -73,3 +76,4 @@ void Rsqrt_float32_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
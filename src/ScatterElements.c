@@ -66,6 +66,7 @@ void ScatterElements_int8(struct onnx_node_t *node)
     }
 }
 
+#if defined(__riscv_vector)
 void ScatterElements_int8_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -128,6 +129,7 @@ void ScatterElements_int8_rvv(struct onnx_node_t *node)
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void ScatterElements_int32(struct onnx_node_t *node)
 {
@@ -160,6 +162,7 @@ void ScatterElements_int32(struct onnx_node_t *node)
     }
 }
 
+#if defined(__riscv_vector)
 void ScatterElements_int32_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -223,6 +226,7 @@ void ScatterElements_int32_rvv(struct onnx_node_t *node)
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void ScatterElements_float16(struct onnx_node_t *node)
 {
@@ -255,6 +259,7 @@ void ScatterElements_float16(struct onnx_node_t *node)
     }
 }
 
+#if defined(__riscv_vector)
 void ScatterElements_float16_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -318,6 +323,7 @@ void ScatterElements_float16_rvv(struct onnx_node_t *node)
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void ScatterElements_float32(struct onnx_node_t *node)
 {
@@ -350,6 +356,7 @@ void ScatterElements_float32(struct onnx_node_t *node)
     }
 }
 
+#if defined(__riscv_vector)
 void ScatterElements_float32_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -412,4 +419,5 @@ void ScatterElements_float32_rvv(struct onnx_node_t *node)
             }
         }
     }
-}
\ No newline at end of file
+}
+#endif /* defined(__riscv_vector) */
\ No newline at end of file
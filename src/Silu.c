@@ -16,6 +16,7 @@ void Silu_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Silu_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -58,6 +59,7 @@ void Silu_float16_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Silu_float32(struct onnx_node_t *n)
 {
@@ -71,6 +73,7 @@ void Silu_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Silu_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -112,4 +115,5 @@ void Silu_float32_rvv(struct onnx_node_t *n)
         __riscv_vse32_v_f32m8(py, vy, vl);
         py += vl;
     }
-}
\ No newline at end of file
+}
+#endif /* defined(__riscv_vector) */
\ No newline at end of file
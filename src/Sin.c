@@ -18,6 +18,7 @@ void Sin_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Sin_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -58,6 +59,7 @@ void Sin_float16_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Sin_float32(struct onnx_node_t *n)
 {
@@ -72,6 +74,7 @@ void Sin_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Sin_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -111,3 +114,4 @@ void Sin_float32_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
@@ -74,6 +74,7 @@ void Slice_int8(struct onnx_node_t *node)
     y->ndata = y->dims[0] * y->dims[1];
 }
 
+#if defined(__riscv_vector)
 void Slice_int8_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -110,12 +111,13 @@ void Slice_int8_rvv(struct onnx_node_t *node)
         for (; (vl = __riscv_vsetvl_e8m8(avl)) > 0; avl -= vl) {
             vx = __riscv_vlse8_v_i8m8(pxx, pdat->step[1] * sizeof(int8_t), vl);
             __riscv_vse8_v_i8m8(pyy, vx, vl);
-            pxx += vl;
+            pxx += vl * pdat->step[1];
             pyy += vl;
         }
         py += y->dims[0];
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Slice_int32(struct onnx_node_t *node)
 {
@@ -147,6 +149,7 @@ void Slice_int32(struct onnx_node_t *node)
     y->ndata = y->dims[0] * y->dims[1];
 }
 
+#if defined(__riscv_vector)
 void Slice_int32_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -189,6 +192,7 @@ void Slice_int32_rvv(struct onnx_node_t *node)
         py += y->dims[0];
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Slice_float16(struct onnx_node_t *node)
 {
@@ -220,6 +224,7 @@ void Slice_float16(struct onnx_node_t *node)
     y->ndata = y->dims[0] * y->dims[1];
 }
 
+#if defined(__riscv_vector)
 void Slice_float16_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -262,6 +267,7 @@ void Slice_float16_rvv(struct onnx_node_t *node)
         py += y->dims[0];
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Slice_float32(struct onnx_node_t *node)
 {
@@ -293,6 +299,7 @@ void Slice_float32(struct onnx_node_t *node)
     y->ndata = y->dims[0] * y->dims[1];
 }
 
+#if defined(__riscv_vector)
 void Slice_float32_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -335,6 +342,7 @@ void Slice_float32_rvv(struct onnx_node_t *node)
         py += y->dims[0];
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void *GenerateSliceParam(int naxes, int *axes, int *start, int *end, int *step)
 {
@@ -38,9 +38,11 @@ void Softmax_float16(struct onnx_node_t *n)
     }
 }
 
-void Softmax_float16_rvv(struct onnx_node_t *n)
+#if defined(__riscv_vector)
+// rows [start, end) of y
+static void softmax_float16_rvv(void *arg, int start, int end)
 {
-    struct operator_softmax_1_11_pdata_t *pdat = (struct operator_softmax_1_11_pdata_t *)n->priv;
+    struct onnx_node_t *n = (struct onnx_node_t *)arg;
     struct onnx_tensor_t *x = n->inputs[0];
     struct onnx_tensor_t *y = n->outputs[0];
     float16_t *px = (float16_t *)x->datas;
@@ -48,9 +50,8 @@ void Softmax_float16_rvv(struct onnx_node_t *n)
     float16_t maxv, sum, v;
     int i, j, o;
     const int D = x->dims[0];
-    const int N = x->dims[1];
 
-    for (i = 0, o = 0; i < N; i++, o += D) {
+    for (i = start, o = start * D; i < end; i++, o += D) {
         size_t blkCnt = D; /* Loop counter */
         size_t l;
         float16_t maxValue = px[o];
@@ -105,7 +106,7 @@ void Softmax_float16_rvv(struct onnx_node_t *n)
         sum = __riscv_vfmv_f_s_f16m1_f16(vsum);
 
         if (sum == 0)
-            return;
+            continue;
 
         float16_t inv = 1.0 / sum;
         blkCnt = D;
@@ -119,6 +120,12 @@ void Softmax_float16_rvv(struct onnx_node_t *n)
     }
 }
 
+void Softmax_float16_rvv(struct onnx_node_t *n)
+{
+    onnx_parallel_for(n->inputs[0]->dims[1], 1, softmax_float16_rvv, n);
+}
+#endif /* defined(__riscv_vector) */
+
 void Softmax_float32(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -149,8 +156,11 @@ void Softmax_float32(struct onnx_node_t *n)
     }
 }
 
-void Softmax_float32_rvv(struct onnx_node_t *n)
+#if defined(__riscv_vector)
+// rows [start, end) of y
+static void softmax_float32_rvv(void *arg, int start, int end)
 {
+    struct onnx_node_t *n = (struct onnx_node_t *)arg;
     struct onnx_tensor_t *x = n->inputs[0];
     struct onnx_tensor_t *y = n->outputs[0];
     float32_t *px = (float32_t *)x->datas;
@@ -159,9 +169,8 @@ void Softmax_float32_rvv(struct onnx_node_t *n)
     int i, j, o;
 
     const int D = x->dims[0];
-    const int N = x->dims[1];
 
-    for (i = 0, o = 0; i < N; i++, o += D) {
+    for (i = start, o = start * D; i < end; i++, o += D) {
         size_t blkCnt = D; /* Loop counter */
         size_t vl;
         float32_t maxValue = px[o];
@@ -216,7 +225,7 @@ void Softmax_float32_rvv(struct onnx_node_t *n)
         sum = __riscv_vfmv_f_s_f32m1_f32(vsum);
 
         if (sum == 0)
-            return;
+            continue;
 
         float32_t inv = 1.0 / sum;
         blkCnt = D;
@@ -229,3 +238,9 @@ void Softmax_float32_rvv(struct onnx_node_t *n)
         }
     }
 }
+
+void Softmax_float32_rvv(struct onnx_node_t *n)
+{
+    onnx_parallel_for(n->inputs[0]->dims[1], 1, softmax_float32_rvv, n);
+}
+#endif /* defined(__riscv_vector) */
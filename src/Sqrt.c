@@ -18,6 +18,7 @@ void Sqrt_float16(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Sqrt_float16_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -37,6 +38,7 @@ void Sqrt_float16_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Sqrt_float32(struct onnx_node_t *n)
 {
@@ -51,6 +53,7 @@ void Sqrt_float32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Sqrt_float32_rvv(struct onnx_node_t *n)
 {
     struct onnx_tensor_t *x = n->inputs[0];
@@ -70,3 +73,4 @@ void Sqrt_float32_rvv(struct onnx_node_t *n)
         py += vl;
     }
 }
+#endif /* defined(__riscv_vector) */
@@ -77,6 +77,7 @@ void Tile_int8(struct onnx_node_t *node)
     }
 }
 
+#if defined(__riscv_vector)
 void Tile_int8_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -87,6 +88,7 @@ void Tile_int8_rvv(struct onnx_node_t *node)
     int8_t *pxx, *pyy;
     int *pt = (int *)t->datas;
     size_t avl, vl;
+    int stride;
     vint8m8_t vx;
 
     // only support x->ndim == 2
@@ -118,19 +120,21 @@ void Tile_int8_rvv(struct onnx_node_t *node)
 
     if (pt[0] > 1) {
         px = y->datas;
-        avl = y->strides[1] * x->dims[1];
+        stride = y->strides[1] * x->dims[1];
+        avl = stride;
         pxx = px;
         pyy = py;
         for (; (vl = __riscv_vsetvl_e8m8(avl)) > 0; avl -= vl) {
             vx = __riscv_vle8_v_i8m8(pxx, vl);
             for (int i = 0; i < (pt[0] - 1); ++i) {
-                __riscv_vse8_v_i8m8(pyy + i * avl, vx, vl);
+                __riscv_vse8_v_i8m8(pyy + i * stride, vx, vl);
             }
             pxx += vl;
             pyy += vl;
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Tile_int32(struct onnx_node_t *node)
 {
@@ -170,6 +174,7 @@ void Tile_int32(struct onnx_node_t *node)
     }
 }
 
+#if defined(__riscv_vector)
 void Tile_int32_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -180,6 +185,7 @@ void Tile_int32_rvv(struct onnx_node_t *node)
     int32_t *pxx, *pyy;
     int *pt = (int *)t->datas;
     size_t avl, vl;
+    int stride;
     vint32m8_t vx;
 
     // only support x->ndim == 2
@@ -211,19 +217,21 @@ void Tile_int32_rvv(struct onnx_node_t *node)
 
     if (pt[0] > 1) {
         px = y->datas;
-        avl = y->strides[1] * x->dims[1];
+        stride = y->strides[1] * x->dims[1];
+        avl = stride;
         pxx = px;
         pyy = py;
         for (; (vl = __riscv_vsetvl_e32m8(avl)) > 0; avl -= vl) {
             vx = __riscv_vle32_v_i32m8(pxx, vl);
             for (int i = 0; i < (pt[0] - 1); ++i) {
-                __riscv_vse32_v_i32m8(pyy + i * avl, vx, vl);
+                __riscv_vse32_v_i32m8(pyy + i * stride, vx, vl);
             }
             pxx += vl;
             pyy += vl;
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Tile_float16(struct onnx_node_t *node)
 {
@@ -263,6 +271,7 @@ void Tile_float16(struct onnx_node_t *node)
     }
 }
 
+#if defined(__riscv_vector)
 void Tile_float16_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -273,6 +282,7 @@ void Tile_float16_rvv(struct onnx_node_t *node)
     float16_t *pxx, *pyy;
     int *pt = (int *)t->datas;
     size_t avl, vl;
+    int stride;
     vfloat16m8_t vx;
 
     // only support x->ndim == 2
@@ -304,19 +314,21 @@ void Tile_float16_rvv(struct onnx_node_t *node)
 
     if (pt[0] > 1) {
         px = y->datas;
-        avl = y->strides[1] * x->dims[1];
+        stride = y->strides[1] * x->dims[1];
+        avl = stride;
         pxx = px;
         pyy = py;
         for (; (vl = __riscv_vsetvl_e16m8(avl)) > 0; avl -= vl) {
             vx = __riscv_vle16_v_f16m8(pxx, vl);
             for (int i = 0; i < (pt[0] - 1); ++i) {
-                __riscv_vse16_v_f16m8(pyy + i * avl, vx, vl);
+                __riscv_vse16_v_f16m8(pyy + i * stride, vx, vl);
             }
             pxx += vl;
             pyy += vl;
         }
     }
 }
+#endif /* defined(__riscv_vector) */
 
 void Tile_float32(struct onnx_node_t *node)
 {
@@ -356,6 +368,7 @@ void Tile_float32(struct onnx_node_t *node)
     }
 }
 
+#if defined(__riscv_vector)
 void Tile_float32_rvv(struct onnx_node_t *node)
 {
     struct onnx_tensor_t *x = node->inputs[0];
@@ -366,6 +379,7 @@ void Tile_float32_rvv(struct onnx_node_t *node)
     float32_t *pxx, *pyy;
     int *pt = (int *)t->datas;
     size_t avl, vl;
+    int stride;
     vfloat32m8_t vx;
 
     // only support x->ndim == 2
@@ -397,16 +411,18 @@ void Tile_float32_rvv(struct onnx_node_t *node)
 
     if (pt[0] > 1) {
         px = y->datas;
-        avl = y->strides[1] * x->dims[1];
+        stride = y->strides[1] * x->dims[1];
+        avl = stride;
         pxx = px;
         pyy = py;
         for (; (vl = __riscv_vsetvl_e32m8(avl)) > 0; avl -= vl) {
             vx = __riscv_vle32_v_f32m8(pxx, vl);
             for (int i = 0; i < (pt[0] - 1); ++i) {
-                __riscv_vse32_v_f32m8(pyy + i * avl, vx, vl);
+                __riscv_vse32_v_f32m8(pyy + i * stride, vx, vl);
             }
             pxx += vl;
             pyy += vl;
         }
     }
-}
\ No newline at end of file
+}
+#endif /* defined(__riscv_vector) */
\ No newline at end of file
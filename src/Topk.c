@@ -58,6 +58,7 @@ void Topk_int32(struct onnx_node_t *n)
     }
 }
 
+#if defined(__riscv_vector)
 void Topk_int32_rvv(struct onnx_node_t *n)
 {
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
@@ -92,6 +93,7 @@ void Topk_int32_rvv(struct onnx_node_t *n)
     }
     __riscv_vse32_v_i32m8(py, vx, vl);
 }
+#endif /* defined(__riscv_vector) */
 
 static void Swap_float16(float16_t *a, float16_t *b)
 {
@@ -119,6 +121,7 @@ static void Heapify_float16(float16_t arr[], int len, int idx)
     }
 }
 
+#if defined(__riscv_vector)
 void Topk_float16_rvv(struct onnx_node_t *n)
 {
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
@@ -153,6 +156,7 @@ void Topk_float16_rvv(struct onnx_node_t *n)
     }
     __riscv_vse16_v_f16m8(py, vx, vl);
 }
+#endif /* defined(__riscv_vector) */
 
 void Topk_float16(struct onnx_node_t *n)
 {
@@ -200,6 +204,7 @@ static void Heapify_float32(float32_t arr[], int len, int idx)
     }
 }
 
+#if defined(__riscv_vector)
 void Topk_float32_rvv(struct onnx_node_t *n)
 {
     struct operator_pdata_t *pdat = (struct operator_pdata_t *)n->priv;
@@ -234,6 +239,7 @@ void Topk_float32_rvv(struct onnx_node_t *n)
     }
     __riscv_vse32_v_f32m8(py, vx, vl);
 }
+#endif /* defined(__riscv_vector) */
 
 void Topk_float32(struct onnx_node_t *n)
 {
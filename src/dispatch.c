@@ -0,0 +1,264 @@
+/*
+ * Kernel dispatch table, maps operator name and tensor type to the scalar or
+ * rvv kernel. The choice is made once in onnx_dispatch_init() from the vector
+ * features and VLEN of the running core, callers keep the returned pointer.
+ * A binary built with V runs the scalar kernels on a core without V. Neither
+ * misa nor the hwcap report zve32f, a binary built for it assumes the core has it.
+ */
+
+#include <string.h>
+#if defined(__riscv_vector) && defined(__linux__)
+#include <sys/auxv.h>
+#endif
+
+#include "operators.h"
+#include "utils.h"
+
+struct onnx_kernel_t {
+    const char *op;
+    enum onnx_tensor_type_t type;
+    onnx_operator_t ref;
+    onnx_operator_t rvv;
+    onnx_operator_status_t ref_status;
+    onnx_operator_status_t rvv_status;
+    uint32_t isa; // features needed by the rvv kernel
+    int min_vlen; // minimal VLEN in bits needed by the rvv kernel, 0 means any
+    int use_rvv;
+};
+
+#define KERNEL(op, type, fn, isa, vlen) {#op, ONNX_TENSOR_TYPE_##type, fn, fn##_rvv, NULL, NULL, ONNX_ISA_V | (isa), vlen, 0}
+#define KERNEL_STATUS(op, type, fn, isa, vlen) {#op, ONNX_TENSOR_TYPE_##type, NULL, NULL, fn, fn##_rvv, ONNX_ISA_V | (isa), vlen, 0}
+
+static struct onnx_kernel_t kernels[] = {
+    KERNEL(BatchNormalization, FLOAT16, BatchNormalization_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(BatchNormalization, FLOAT32, BatchNormalization_float32, 0, 0),
+    KERNEL(LayerNormalization, FLOAT16, LayerNormalization_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(LayerNormalization, FLOAT32, LayerNormalization_float32, 0, 0),
+    KERNEL(RMSNormalization, FLOAT16, RMSNormalization_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(RMSNormalization, FLOAT32, RMSNormalization_float32, 0, 0),
+    KERNEL(Softmax, FLOAT16, Softmax_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Softmax, FLOAT32, Softmax_float32, 0, 0),
+    KERNEL(Topk, INT32, Topk_int32, ONNX_ISA_PERMUTE, 0),
+    KERNEL(Topk, FLOAT16, Topk_float16, ONNX_ISA_ZVFH | ONNX_ISA_PERMUTE, 0),
+    KERNEL(Topk, FLOAT32, Topk_float32, ONNX_ISA_PERMUTE, 0),
+    KERNEL(MatMul, INT8, MatMul_int8, 0, 0),
+    KERNEL(MatMul, FLOAT16, MatMul_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(MatMul, FLOAT32, MatMul_float32, 0, 0),
+    KERNEL_STATUS(MatMulInteger, INT8, MatMulInteger, 0, 0),
+    KERNEL(Add, INT8, Add_int8, 0, 0),
+    KERNEL(Add, FLOAT16, Add_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Add, FLOAT32, Add_float32, 0, 0),
+    KERNEL(Sub, INT8, Sub_int8, 0, 0),
+    KERNEL(Sub, FLOAT16, Sub_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Sub, FLOAT32, Sub_float32, 0, 0),
+    KERNEL(Mul, INT8, Mul_int8, 0, 0),
+    KERNEL(Mul, FLOAT16, Mul_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Mul, FLOAT32, Mul_float32, 0, 0),
+    KERNEL(Div, FLOAT16, Div_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Div, FLOAT32, Div_float32, 0, 0),
+    KERNEL(Pow, FLOAT16, Pow_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Pow, FLOAT32, Pow_float32, 0, 0),
+    KERNEL(Abs, INT8, Abs_int8, 0, 0),
+    KERNEL(Abs, INT32, Abs_int32, 0, 0),
+    KERNEL(Abs, FLOAT16, Abs_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Abs, FLOAT32, Abs_float32, 0, 0),
+    KERNEL(Negate, INT8, Negate_int8, 0, 0),
+    KERNEL(Negate, INT32, Negate_int32, 0, 0),
+    KERNEL(Negate, FLOAT16, Negate_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Negate, FLOAT32, Negate_float32, 0, 0),
+    KERNEL(Exp, FLOAT16, Exp_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Exp, FLOAT32, Exp_float32, 0, 0),
+    KERNEL(Log, FLOAT16, Log_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Log, FLOAT32, Log_float32, 0, 0),
+    KERNEL(Reciprocal, FLOAT16, Reciprocal_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Reciprocal, FLOAT32, Reciprocal_float32, 0, 0),
+    KERNEL(Sqrt, FLOAT16, Sqrt_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Sqrt, FLOAT32, Sqrt_float32, 0, 0),
+    KERNEL(Rsqrt, FLOAT16, Rsqrt_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Rsqrt, FLOAT32, Rsqrt_float32, 0, 0),
+    KERNEL(Sin, FLOAT16, Sin_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Sin, FLOAT32, Sin_float32, 0, 0),
+    KERNEL(Cos, FLOAT16, Cos_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Cos, FLOAT32, Cos_float32, 0, 0),
+    KERNEL(Concat, INT8, Concat_int8, 0, 0),
+    KERNEL(Concat, INT32, Concat_int32, 0, 0),
+    KERNEL(Concat, FLOAT16, Concat_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Concat, FLOAT32, Concat_float32, 0, 0),
+    KERNEL(Clamp, INT8, Clamp_int8, 0, 0),
+    KERNEL(Clamp, INT32, Clamp_int32, 0, 0),
+    KERNEL(Clamp, FLOAT16, Clamp_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Clamp, FLOAT32, Clamp_float32, 0, 0),
+    KERNEL(Elu, FLOAT16, Elu_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Elu, FLOAT32, Elu_float32, 0, 0),
+    KERNEL(Relu, FLOAT16, Relu_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Relu, FLOAT32, Relu_float32, 0, 0),
+    KERNEL(Silu, FLOAT16, Silu_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Silu, FLOAT32, Silu_float32, 0, 0),
+    KERNEL(Pad, INT8, Pad_int8, 0, 0),
+    KERNEL(Pad, INT32, Pad_int32, 0, 0),
+    KERNEL(Pad, FLOAT16, Pad_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Pad, FLOAT32, Pad_float32, 0, 0),
+    KERNEL(Flip, INT8, Flip_int8, 0, 0),
+    KERNEL(Flip, INT32, Flip_int32, 0, 0),
+    KERNEL(Flip, FLOAT16, Flip_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Flip, FLOAT32, Flip_float32, 0, 0),
+    KERNEL(Slice, INT8, Slice_int8, 0, 0),
+    KERNEL(Slice, INT32, Slice_int32, 0, 0),
+    KERNEL(Slice, FLOAT16, Slice_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Slice, FLOAT32, Slice_float32, 0, 0),
+    KERNEL(Tile, INT8, Tile_int8, 0, 0),
+    KERNEL(Tile, INT32, Tile_int32, 0, 0),
+    KERNEL(Tile, FLOAT16, Tile_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Tile, FLOAT32, Tile_float32, 0, 0),
+    KERNEL(GatherElements, INT8, GatherElements_int8, 0, 0),
+    KERNEL(GatherElements, INT32, GatherElements_int32, 0, 0),
+    KERNEL(GatherElements, FLOAT16, GatherElements_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(GatherElements, FLOAT32, GatherElements_float32, 0, 0),
+    KERNEL(ScatterElements, INT8, ScatterElements_int8, 0, 0),
+    KERNEL(ScatterElements, INT32, ScatterElements_int32, 0, 0),
+    KERNEL(ScatterElements, FLOAT16, ScatterElements_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(ScatterElements, FLOAT32, ScatterElements_float32, 0, 0),
+    KERNEL(ReduceAll, BOOL, ReduceAll, 0, 0),
+    KERNEL(ReduceAny, BOOL, ReduceAny, 0, 0),
+    KERNEL(ReduceMax, INT8, ReduceMax_int8, 0, 0),
+    KERNEL(ReduceMax, FLOAT16, ReduceMax_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(ReduceMax, INT32, ReduceMax_int32, 0, 0),
+    KERNEL(ReduceMax, FLOAT32, ReduceMax_float32, 0, 0),
+    KERNEL(ReduceMin, INT8, ReduceMin_int8, 0, 0),
+    KERNEL(ReduceMin, FLOAT16, ReduceMin_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(ReduceMin, INT32, ReduceMin_int32, 0, 0),
+    KERNEL(ReduceMin, FLOAT32, ReduceMin_float32, 0, 0),
+    KERNEL(ReduceProd, FLOAT16, ReduceProd_float16, ONNX_ISA_ZVFH | ONNX_ISA_PERMUTE, 0),
+    KERNEL(ReduceProd, FLOAT32, ReduceProd_float32, ONNX_ISA_PERMUTE, 0),
+    KERNEL(ReduceSum, FLOAT16, ReduceSum_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(ReduceSum, FLOAT32, ReduceSum_float32, 0, 0),
+    /* the Winograd F(2x2,3x3) kernel needs VLEN >= 128, GenerateConvIntegerParam only selects it then */
+    KERNEL_STATUS(ConvInteger, INT8, ConvInteger, ONNX_ISA_SEGMENT, 0),
+    KERNEL(Conv, FLOAT16, Conv_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(Conv, FLOAT32, Conv_float32, 0, 0),
+    KERNEL_STATUS(ConvTransposeInteger, INT8, ConvTransposeInteger, 0, 0),
+    KERNEL_STATUS(ConvTranspose, FLOAT16, ConvTranspose_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(MaxPool, INT8, MaxPool_int8, 0, 0),
+    KERNEL(MaxPool, FLOAT16, MaxPool_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(MaxPool, FLOAT32, MaxPool_float32, 0, 0),
+    KERNEL(AveragePool, INT8, AveragePool_int8, 0, 0),
+    KERNEL(AveragePool, FLOAT16, AveragePool_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(AveragePool, FLOAT32, AveragePool_float32, 0, 0),
+    KERNEL(GlobalAveragePool, INT8, GlobalAveragePool_int8, 0, 0),
+    KERNEL(GlobalAveragePool, FLOAT16, GlobalAveragePool_float16, ONNX_ISA_ZVFH, 0),
+    KERNEL(GlobalAveragePool, FLOAT32, GlobalAveragePool_float32, 0, 0),
+};
+
+#if defined(__riscv_vector)
+// V of the running core, from the hwcap on Linux, from misa on bare metal where the library runs in M mode
+static int dispatch_probe_v(void)
+{
+#if !defined(__riscv_v) && defined(__riscv_zve32f)
+    // misa and the hwcap only have a bit for the full V, a binary built for zve32f (e.g. n900) targets a core with it
+    return 1;
+#else
+    const unsigned long v = 1UL << ('V' - 'A');
+#if defined(__linux__)
+    return (getauxval(AT_HWCAP) & v) != 0;
+#else
+    unsigned long misa;
+    __asm__ volatile("csrr %0, misa" : "=r"(misa));
+    return (misa & v) != 0;
+#endif
+#endif
+}
+#endif
+
+static uint32_t dispatch_isa = 0;
+static int dispatch_vlen = 0;
+static int dispatch_ready = 0;
+
+void onnx_dispatch_init(uint32_t disable)
+{
+    uint32_t isa = 0;
+    int vlen = 0;
+
+#if defined(__riscv_vector)
+    // vlenb is only readable with V, the extensions of V are those the binary is built with
+    if (dispatch_probe_v()) {
+        isa |= ONNX_ISA_V | ONNX_ISA_SEGMENT | ONNX_ISA_PERMUTE;
+        vlen = csrr_vlenb() * 8;
+#if defined(__riscv_zvfh)
+        isa |= ONNX_ISA_ZVFH;
+#endif
+#if defined(__riscv_v_elen) && (__riscv_v_elen >= 64)
+        isa |= ONNX_ISA_ELEN64;
+#endif
+    }
+#endif
+    isa &= ~disable;
+
+    for (size_t i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++) {
+        kernels[i].use_rvv = (kernels[i].isa & isa) == kernels[i].isa && vlen >= kernels[i].min_vlen;
+    }
+    dispatch_isa = isa;
+    dispatch_vlen = vlen;
+    dispatch_ready = 1;
+}
+
+uint32_t onnx_dispatch_isa(void)
+{
+    return dispatch_isa;
+}
+
+int onnx_dispatch_vlen(void)
+{
+    return dispatch_vlen;
+}
+
+static struct onnx_kernel_t *onnx_dispatch_search(const char *op, enum onnx_tensor_type_t type)
+{
+    if (!dispatch_ready) {
+        onnx_dispatch_init(0);
+    }
+    for (size_t i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++) {
+        if (kernels[i].type == type && strcmp(kernels[i].op, op) == 0) {
+            return &kernels[i];
+        }
+    }
+    return NULL;
+}
+
+onnx_operator_t onnx_dispatch_find(const char *op, enum onnx_tensor_type_t type)
+{
+    struct onnx_kernel_t *k = onnx_dispatch_search(op, type);
+    if (k == NULL) {
+        return NULL;
+    }
+    return k->use_rvv ? k->rvv : k->ref;
+}
+
+onnx_operator_status_t onnx_dispatch_find_status(const char *op, enum onnx_tensor_type_t type)
+{
+    struct onnx_kernel_t *k = onnx_dispatch_search(op, type);
+    if (k == NULL) {
+        return NULL;
+    }
+    return k->use_rvv ? k->rvv_status : k->ref_status;
+}
+
+_Bool onnx_dispatch_rvv(const char *op, enum onnx_tensor_type_t type)
+{
+    struct onnx_kernel_t *k = onnx_dispatch_search(op, type);
+    return k != NULL && k->use_rvv;
+}
+
+const char *onnx_dispatch_name(const void *kernel)
+{
+    if (kernel == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++) {
+        struct onnx_kernel_t *k = &kernels[i];
+        if (kernel == (const void *)k->ref || kernel == (const void *)k->rvv || kernel == (const void *)k->ref_status ||
+            kernel == (const void *)k->rvv_status) {
+            return k->op;
+        }
+    }
+    return NULL;
+}
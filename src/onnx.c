@@ -0,0 +1,390 @@
+/*
+ * https://github.com/xboot/libonnx/blob/master/src/onnx.c
+ */
+
+#include "onnx.h"
+#include "utils.h"
+
+int onnx_tensor_type_sizeof(enum onnx_tensor_type_t type)
+{
+    switch (type) {
+        case ONNX_TENSOR_TYPE_BOOL:
+        case ONNX_TENSOR_TYPE_INT8:
+        case ONNX_TENSOR_TYPE_UINT8:
+            return 1;
+        case ONNX_TENSOR_TYPE_INT16:
+        case ONNX_TENSOR_TYPE_UINT16:
+        case ONNX_TENSOR_TYPE_BFLOAT16:
+        case ONNX_TENSOR_TYPE_FLOAT16:
+            return 2;
+        case ONNX_TENSOR_TYPE_INT32:
+        case ONNX_TENSOR_TYPE_UINT32:
+        case ONNX_TENSOR_TYPE_FLOAT32:
+            return 4;
+        case ONNX_TENSOR_TYPE_INT64:
+        case ONNX_TENSOR_TYPE_UINT64:
+        case ONNX_TENSOR_TYPE_FLOAT64:
+        case ONNX_TENSOR_TYPE_COMPLEX64:
+            return 8;
+        case ONNX_TENSOR_TYPE_COMPLEX128:
+            return 16;
+        case ONNX_TENSOR_TYPE_STRING:
+            return sizeof(char *);
+        default:
+            break;
+    }
+    return 0;
+}
+
+#define ALIGN_UP(x, a) (((x) + (a) - 1) & ~((size_t)(a) - 1))
+
+struct onnx_tensor_block_t {
+    struct onnx_tensor_t tensor; // must be the first member
+    void *raw;                   // malloc pointer, NULL when allocated from pool
+    size_t size;                 // bytes of the whole block
+    size_t capacity;             // bytes available for datas
+    int maxdim;                  // number of ints available for dims and strides
+};
+
+static struct {
+    char *base;
+    size_t size;
+    size_t used;
+} tensor_pool = {NULL, 0, 0};
+
+void onnx_tensor_pool_init(void *buf, size_t size)
+{
+    if (buf == NULL) {
+        tensor_pool.base = NULL;
+        tensor_pool.size = 0;
+        tensor_pool.used = 0;
+        return;
+    }
+    char *base = (char *)ALIGN_UP((uintptr_t)buf, ONNX_TENSOR_ALIGN);
+    size_t skip = base - (char *)buf;
+    tensor_pool.base = base;
+    tensor_pool.size = size > skip ? size - skip : 0;
+    tensor_pool.used = 0;
+}
+
+void onnx_tensor_pool_reset(void)
+{
+    tensor_pool.used = 0;
+}
+
+size_t onnx_tensor_pool_used(void)
+{
+    return tensor_pool.used;
+}
+
+static size_t onnx_tensor_ndata(int *dims, int ndim)
+{
+    size_t ndata = 1;
+    for (int i = 0; i < ndim; i++) {
+        ndata *= dims[i];
+    }
+    return ndata;
+}
+
+static void onnx_tensor_setup(struct onnx_tensor_block_t *blk, enum onnx_tensor_type_t type, int *dims, int ndim)
+{
+    struct onnx_tensor_t *t = &blk->tensor;
+    t->type = type;
+    t->ndim = ndim;
+    t->ndata = onnx_tensor_ndata(dims, ndim);
+    for (int i = 0; i < ndim; i++) {
+        t->dims[i] = dims[i];
+        t->strides[i] = i == 0 ? 1 : t->strides[i - 1] * dims[i - 1];
+    }
+}
+
+struct onnx_tensor_t *onnx_tensor_alloc(enum onnx_tensor_type_t type, int *dims, int ndim)
+{
+    struct onnx_tensor_block_t *blk;
+    void *raw = NULL;
+
+    if (dims == NULL || ndim < 0) {
+        ndim = 0;
+    }
+    const size_t hdr = ALIGN_UP(sizeof(struct onnx_tensor_block_t) + 2 * ndim * sizeof(int), ONNX_TENSOR_ALIGN);
+    const size_t capacity = ALIGN_UP(onnx_tensor_ndata(dims, ndim) * onnx_tensor_type_sizeof(type), ONNX_TENSOR_ALIGN);
+    const size_t size = hdr + capacity;
+
+    if (tensor_pool.base != NULL) {
+        if (tensor_pool.used + size > tensor_pool.size) {
+            // pool exhausted
+            return NULL;
+        }
+        blk = (struct onnx_tensor_block_t *)(tensor_pool.base + tensor_pool.used);
+        tensor_pool.used += size;
+    } else {
+        raw = MALLOC_ASSERT(size + ONNX_TENSOR_ALIGN);
+        blk = (struct onnx_tensor_block_t *)ALIGN_UP((uintptr_t)raw, ONNX_TENSOR_ALIGN);
+    }
+
+    blk->raw = raw;
+    blk->size = size;
+    blk->capacity = capacity;
+    blk->maxdim = ndim;
+    blk->tensor.name = NULL;
+    blk->tensor.dims = (int *)(blk + 1);
+    blk->tensor.strides = blk->tensor.dims + ndim;
+    blk->tensor.datas = (char *)blk + hdr;
+    onnx_tensor_setup(blk, type, dims, ndim);
+    return &blk->tensor;
+}
+
+void onnx_tensor_free(struct onnx_tensor_t *t)
+{
+    struct onnx_tensor_block_t *blk = (struct onnx_tensor_block_t *)t;
+    if (t == NULL) {
+        return;
+    }
+    if (blk->raw != NULL) {
+        free(blk->raw);
+    } else if ((char *)blk + blk->size == tensor_pool.base + tensor_pool.used) {
+        // only the last block can be given back to the pool
+        tensor_pool.used -= blk->size;
+    }
+}
+
+int onnx_tensor_reinit(struct onnx_tensor_t *t, enum onnx_tensor_type_t type, int *dims, int ndim)
+{
+    struct onnx_tensor_block_t *blk = (struct onnx_tensor_block_t *)t;
+    if (dims == NULL || ndim < 0) {
+        ndim = 0;
+    }
+    if (ndim > blk->maxdim || onnx_tensor_ndata(dims, ndim) * onnx_tensor_type_sizeof(type) > blk->capacity) {
+        return -1;
+    }
+    onnx_tensor_setup(blk, type, dims, ndim);
+    return 0;
+}
+
+struct onnx_graph_t *onnx_graph_alloc(int max_nodes)
+{
+    struct onnx_graph_t *g = (struct onnx_graph_t *)MALLOC_ASSERT(sizeof(struct onnx_graph_t));
+    g->nodes = (struct onnx_graph_node_t *)MALLOC_ASSERT(sizeof(struct onnx_graph_node_t) * max_nodes);
+    g->nlen = 0;
+    g->nmax = max_nodes;
+    g->tensors = NULL;
+    g->ntensor = 0;
+    g->arena = NULL;
+    g->arena_size = 0;
+    g->arena_owned = 0;
+    return g;
+}
+
+static void onnx_graph_release(struct onnx_graph_t *g)
+{
+    for (int i = 0; i < g->ntensor; i++) {
+        g->tensors[i].tensor->datas = NULL;
+    }
+    if (g->tensors) {
+        free(g->tensors);
+        g->tensors = NULL;
+    }
+    g->ntensor = 0;
+    if (g->arena_owned && g->arena) {
+        free(g->arena);
+    }
+    g->arena = NULL;
+    g->arena_size = 0;
+    g->arena_owned = 0;
+}
+
+void onnx_graph_free(struct onnx_graph_t *g)
+{
+    if (g == NULL) {
+        return;
+    }
+    onnx_graph_release(g);
+    free(g->nodes);
+    free(g);
+}
+
+static int onnx_graph_push(struct onnx_graph_t *g, struct onnx_node_t *node, onnx_operator_t op, onnx_operator_status_t op_status)
+{
+    if (g->nlen >= g->nmax || node == NULL) {
+        return -1;
+    }
+    g->nodes[g->nlen].node = node;
+    g->nodes[g->nlen].op = op;
+    g->nodes[g->nlen].op_status = op_status;
+    g->nlen++;
+    return 0;
+}
+
+int onnx_graph_add_node(struct onnx_graph_t *g, struct onnx_node_t *node, onnx_operator_t op)
+{
+    return onnx_graph_push(g, node, op, NULL);
+}
+
+int onnx_graph_add_node_status(struct onnx_graph_t *g, struct onnx_node_t *node, onnx_operator_status_t op)
+{
+    return onnx_graph_push(g, node, NULL, op);
+}
+
+static int onnx_graph_find_tensor(struct onnx_graph_t *g, struct onnx_tensor_t *t)
+{
+    for (int i = 0; i < g->ntensor; i++) {
+        if (g->tensors[i].tensor == t) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static size_t onnx_graph_tensor_bytes(struct onnx_tensor_t *t)
+{
+    size_t ndata = t->ndata;
+    if (ndata == 0 && t->dims != NULL) {
+        ndata = 1;
+        for (int i = 0; i < t->ndim; i++) {
+            ndata *= t->dims[i];
+        }
+    }
+    return ALIGN_UP(ndata * onnx_tensor_type_sizeof(t->type), ONNX_GRAPH_ALIGN);
+}
+
+static void onnx_graph_track(struct onnx_graph_t *g, struct onnx_tensor_t *t, int idx, int produced)
+{
+    if (t == NULL) {
+        return;
+    }
+    int k = onnx_graph_find_tensor(g, t);
+    if (k < 0) {
+        if (t->datas != NULL) {
+            return;
+        }
+        k = g->ntensor++;
+        g->tensors[k].tensor = t;
+        g->tensors[k].size = onnx_graph_tensor_bytes(t);
+        g->tensors[k].offset = 0;
+        // tensors read before written are graph inputs, keep them alive for the whole graph
+        g->tensors[k].first = produced ? idx : 0;
+        g->tensors[k].last = produced ? idx : g->nlen - 1;
+    } else if (g->tensors[k].last < idx) {
+        g->tensors[k].last = idx;
+    }
+}
+
+size_t onnx_graph_plan(struct onnx_graph_t *g)
+{
+    int cap = 0;
+
+    onnx_graph_release(g);
+    for (int i = 0; i < g->nlen; i++) {
+        cap += g->nodes[i].node->ninput + g->nodes[i].node->noutput;
+    }
+    if (cap == 0) {
+        return 0;
+    }
+    g->tensors = (struct onnx_graph_tensor_t *)MALLOC_ASSERT(sizeof(struct onnx_graph_tensor_t) * cap);
+
+    // lifetime of each intermediate tensor, [first, last] in node index
+    for (int i = 0; i < g->nlen; i++) {
+        struct onnx_node_t *n = g->nodes[i].node;
+        for (int j = 0; j < n->ninput; j++) {
+            onnx_graph_track(g, n->inputs[j], i, 0);
+        }
+        for (int j = 0; j < n->noutput; j++) {
+            onnx_graph_track(g, n->outputs[j], i, 1);
+        }
+    }
+    // tensors never consumed are graph outputs, keep them until the end
+    for (int i = 0; i < g->ntensor; i++) {
+        if (g->tensors[i].first == g->tensors[i].last) {
+            g->tensors[i].last = g->nlen - 1;
+        }
+    }
+
+    // greedy by size: place the largest tensor first at the lowest offset
+    // that does not overlap any placed tensor alive at the same time
+    int *order = (int *)MALLOC_ASSERT(sizeof(int) * g->ntensor * 2);
+    int *live = order + g->ntensor;
+    for (int i = 0; i < g->ntensor; i++) {
+        int k = i;
+        while (k > 0 && g->tensors[order[k - 1]].size < g->tensors[i].size) {
+            order[k] = order[k - 1];
+            k--;
+        }
+        order[k] = i;
+    }
+
+    size_t total = 0;
+    for (int i = 0; i < g->ntensor; i++) {
+        struct onnx_graph_tensor_t *cur = &g->tensors[order[i]];
+        int nlive = 0;
+        // collect placed tensors overlapping in time, sorted by offset
+        for (int j = 0; j < i; j++) {
+            struct onnx_graph_tensor_t *o = &g->tensors[order[j]];
+            if (o->first > cur->last || o->last < cur->first) {
+                continue;
+            }
+            int k = nlive++;
+            while (k > 0 && g->tensors[live[k - 1]].offset > o->offset) {
+                live[k] = live[k - 1];
+                k--;
+            }
+            live[k] = order[j];
+        }
+        size_t offset = 0;
+        for (int j = 0; j < nlive; j++) {
+            struct onnx_graph_tensor_t *o = &g->tensors[live[j]];
+            if (offset + cur->size <= o->offset) {
+                break;
+            }
+            offset = MAX(offset, o->offset + o->size);
+        }
+        cur->offset = offset;
+        total = MAX(total, offset + cur->size);
+    }
+    free(order);
+
+    g->arena_size = total;
+    return total;
+}
+
+int onnx_graph_prepare(struct onnx_graph_t *g, void *arena, size_t size)
+{
+    size_t need = onnx_graph_plan(g);
+    char *base;
+
+    if (arena == NULL) {
+        g->arena = MALLOC_ASSERT(need + ONNX_GRAPH_ALIGN);
+        g->arena_owned = 1;
+        base = (char *)ALIGN_UP((uintptr_t)g->arena, ONNX_GRAPH_ALIGN);
+    } else {
+        base = (char *)ALIGN_UP((uintptr_t)arena, ONNX_GRAPH_ALIGN);
+        if (need + (size_t)(base - (char *)arena) > size) {
+            return -1;
+        }
+        g->arena = arena;
+        g->arena_owned = 0;
+    }
+
+    for (int i = 0; i < g->ntensor; i++) {
+        g->tensors[i].tensor->datas = base + g->tensors[i].offset;
+    }
+    return 0;
+}
+
+int onnx_graph_run(struct onnx_graph_t *g)
+{
+    for (int i = 0; i < g->nlen; i++) {
+        struct onnx_graph_node_t *gn = &g->nodes[i];
+        ONNX_PROFILE_BEGIN(prof);
+        if (gn->op_status) {
+            int ret = gn->op_status(gn->node);
+            ONNX_PROFILE_END(prof, NULL, gn->op_status, i);
+            if (ret != 0) {
+                return ret;
+            }
+        } else {
+            gn->op(gn->node);
+            ONNX_PROFILE_END(prof, NULL, gn->op, i);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,261 @@
+/*
+ * Parallel-for over the harts of an SMP cluster.
+ *
+ * The iteration space is cut into chunks, every thread owns a contiguous range
+ * of chunks and takes them from the front, a thread running out of work steals
+ * chunks from the back of the other ranges. The caller of onnx_parallel_for()
+ * is thread 0 and returns when all chunks are done.
+ */
+
+#include "onnx.h"
+#include "utils.h"
+
+#if !defined(ONNX_PARALLEL_PTHREAD) && !defined(ONNX_PARALLEL_BAREMETAL)
+#if defined(__linux__)
+#define ONNX_PARALLEL_PTHREAD
+#else
+#define ONNX_PARALLEL_BAREMETAL
+#endif
+#endif
+
+#if defined(ONNX_PARALLEL_PTHREAD)
+#include <pthread.h>
+#endif
+
+#define PARALLEL_CHUNKS_PER_THREAD (4)
+#define PARALLEL_CACHELINE (64)
+
+// lo in bits [15:0], hi in bits [31:16], both chunk indexes
+struct parallel_range_t {
+    uint32_t range;
+    char pad[PARALLEL_CACHELINE - sizeof(uint32_t)];
+};
+
+static struct {
+    onnx_parallel_fn_t fn;
+    void *arg;
+    int n;
+    int chunk; // iterations per chunk
+    struct parallel_range_t ranges[ONNX_PARALLEL_MAX_THREADS];
+} job;
+
+static int nthreads = 1;
+static int busy = 0;
+
+static int range_pop_front(struct parallel_range_t *r)
+{
+    uint32_t v = __atomic_load_n(&r->range, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t lo = v & 0xffff, hi = v >> 16;
+        if (lo >= hi) {
+            return -1;
+        }
+        if (__atomic_compare_exchange_n(&r->range, &v, (lo + 1) | (hi << 16), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            return lo;
+        }
+    }
+}
+
+static int range_pop_back(struct parallel_range_t *r)
+{
+    uint32_t v = __atomic_load_n(&r->range, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t lo = v & 0xffff, hi = v >> 16;
+        if (lo >= hi) {
+            return -1;
+        }
+        if (__atomic_compare_exchange_n(&r->range, &v, lo | ((hi - 1) << 16), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            return hi - 1;
+        }
+    }
+}
+
+static void run_chunk(int c)
+{
+    int start = c * job.chunk;
+    int end = MIN(start + job.chunk, job.n);
+    job.fn(job.arg, start, end);
+}
+
+static void run_thread(int tid)
+{
+    int c;
+    while ((c = range_pop_front(&job.ranges[tid])) >= 0) {
+        run_chunk(c);
+    }
+    for (int i = 1; i < nthreads; i++) {
+        struct parallel_range_t *victim = &job.ranges[(tid + i) % nthreads];
+        while ((c = range_pop_back(victim)) >= 0) {
+            run_chunk(c);
+        }
+    }
+}
+
+#if defined(ONNX_PARALLEL_PTHREAD)
+
+static pthread_t threads[ONNX_PARALLEL_MAX_THREADS];
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t done = PTHREAD_COND_INITIALIZER;
+static unsigned generation = 0;
+static int active = 0;
+static int quit = 0;
+
+static void *worker_main(void *arg)
+{
+    int tid = (int)(intptr_t)arg;
+    unsigned seen = 0;
+
+    pthread_mutex_lock(&lock);
+    for (;;) {
+        while (generation == seen && !quit) {
+            pthread_cond_wait(&wake, &lock);
+        }
+        if (quit) {
+            break;
+        }
+        seen = generation;
+        pthread_mutex_unlock(&lock);
+        run_thread(tid);
+        pthread_mutex_lock(&lock);
+        if (--active == 0) {
+            pthread_cond_signal(&done);
+        }
+    }
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+int onnx_parallel_init(int n)
+{
+    onnx_parallel_deinit();
+    n = MAX(1, MIN(n, ONNX_PARALLEL_MAX_THREADS));
+    quit = 0;
+    generation = 0;
+    for (nthreads = 1; nthreads < n; nthreads++) {
+        if (pthread_create(&threads[nthreads], NULL, worker_main, (void *)(intptr_t)nthreads) != 0) {
+            break;
+        }
+    }
+    return nthreads;
+}
+
+void onnx_parallel_deinit(void)
+{
+    pthread_mutex_lock(&lock);
+    quit = 1;
+    pthread_cond_broadcast(&wake);
+    pthread_mutex_unlock(&lock);
+    for (int i = 1; i < nthreads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    nthreads = 1;
+}
+
+void onnx_parallel_worker(int hart)
+{
+    (void)hart;
+}
+
+static void parallel_run(void)
+{
+    pthread_mutex_lock(&lock);
+    active = nthreads - 1;
+    generation++;
+    pthread_cond_broadcast(&wake);
+    pthread_mutex_unlock(&lock);
+
+    run_thread(0);
+
+    pthread_mutex_lock(&lock);
+    while (active != 0) {
+        pthread_cond_wait(&done, &lock);
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+#else /* ONNX_PARALLEL_BAREMETAL */
+
+static volatile unsigned generation = 0;
+static volatile int active = 0;
+static volatile int online = 0;
+
+int onnx_parallel_init(int n)
+{
+    onnx_parallel_deinit();
+    n = MAX(1, MIN(n, ONNX_PARALLEL_MAX_THREADS));
+    nthreads = MIN(n, __atomic_load_n(&online, __ATOMIC_ACQUIRE) + 1);
+    return nthreads;
+}
+
+void onnx_parallel_deinit(void)
+{
+    nthreads = 1;
+}
+
+void onnx_parallel_worker(int hart)
+{
+    int tid = __atomic_add_fetch(&online, 1, __ATOMIC_ACQ_REL);
+    unsigned seen = __atomic_load_n(&generation, __ATOMIC_ACQUIRE);
+    (void)hart;
+
+    for (;;) {
+        unsigned gen = __atomic_load_n(&generation, __ATOMIC_ACQUIRE);
+        if (gen == seen) {
+            continue;
+        }
+        seen = gen;
+        if (tid < nthreads) {
+            run_thread(tid);
+            __atomic_sub_fetch(&active, 1, __ATOMIC_ACQ_REL);
+        }
+    }
+}
+
+static void parallel_run(void)
+{
+    __atomic_store_n(&active, nthreads - 1, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&generation, 1, __ATOMIC_ACQ_REL);
+
+    run_thread(0);
+
+    while (__atomic_load_n(&active, __ATOMIC_ACQUIRE) != 0) {
+    }
+}
+
+#endif /* ONNX_PARALLEL_PTHREAD */
+
+int onnx_parallel_nthreads(void)
+{
+    return nthreads;
+}
+
+void onnx_parallel_for(int n, int grain, onnx_parallel_fn_t fn, void *arg)
+{
+    if (n <= 0) {
+        return;
+    }
+    grain = MAX(grain, 1);
+    // nested call from a running chunk, or not worth to split
+    if (nthreads <= 1 || n <= grain || __atomic_exchange_n(&busy, 1, __ATOMIC_ACQUIRE) != 0) {
+        fn(arg, 0, n);
+        return;
+    }
+
+    int chunks = (n + grain - 1) / grain;
+    int maxchunks = nthreads * PARALLEL_CHUNKS_PER_THREAD;
+    job.chunk = grain * ((chunks + maxchunks - 1) / maxchunks);
+    chunks = (n + job.chunk - 1) / job.chunk;
+    job.fn = fn;
+    job.arg = arg;
+    job.n = n;
+    for (int t = 0; t < nthreads; t++) {
+        uint32_t lo = chunks * t / nthreads;
+        uint32_t hi = chunks * (t + 1) / nthreads;
+        __atomic_store_n(&job.ranges[t].range, lo | (hi << 16), __ATOMIC_RELAXED);
+    }
+
+    parallel_run();
+
+    __atomic_store_n(&busy, 0, __ATOMIC_RELEASE);
+}
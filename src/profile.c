@@ -0,0 +1,189 @@
+/*
+ * Per node profiling with the hardware performance counters, see onnx.h.
+ */
+
+#include "onnx.h"
+#include "utils.h"
+
+#if defined(ONNX_PROFILE)
+
+#if defined(__riscv)
+#if defined(__linux__)
+// user mode counters, mcycle and minstret are not accessible
+#define PROFILE_CSR(m, u) u
+#else
+#define PROFILE_CSR(m, u) m
+#endif
+
+#if __riscv_xlen == 32
+#define PROFILE_READ_CSR(csr, v)                                                                                                                     \
+    do {                                                                                                                                             \
+        uint32_t hi, lo, hi2;                                                                                                                        \
+        do {                                                                                                                                         \
+            __asm__ volatile("csrr %0, " csr "h" : "=r"(hi));                                                                                        \
+            __asm__ volatile("csrr %0, " csr : "=r"(lo));                                                                                            \
+            __asm__ volatile("csrr %0, " csr "h" : "=r"(hi2));                                                                                       \
+        } while (hi != hi2);                                                                                                                         \
+        (v) = ((uint64_t)hi << 32) | lo;                                                                                                             \
+    } while (0)
+#else
+#define PROFILE_READ_CSR(csr, v) __asm__ volatile("csrr %0, " csr : "=r"(v))
+#endif
+#endif /* defined(__riscv) */
+
+#define PROFILE_MAX_OPS (64)
+
+struct profile_event_t {
+    const char *op;
+    const void *kernel;
+    int node;
+    uint64_t start;
+    struct onnx_profile_counter_t delta;
+};
+
+static struct profile_event_t events[ONNX_PROFILE_MAX_EVENTS];
+static int nevent = 0;
+static int dropped = 0;
+static uint64_t origin = 0;
+
+void onnx_profile_read(struct onnx_profile_counter_t *c)
+{
+#if defined(__riscv)
+    PROFILE_READ_CSR(PROFILE_CSR("minstret", "instret"), c->instret);
+#if ONNX_PROFILE_NHPM > 0
+    PROFILE_READ_CSR(PROFILE_CSR("mhpmcounter3", "hpmcounter3"), c->hpm[0]);
+#endif
+#if ONNX_PROFILE_NHPM > 1
+    PROFILE_READ_CSR(PROFILE_CSR("mhpmcounter4", "hpmcounter4"), c->hpm[1]);
+#endif
+#if ONNX_PROFILE_NHPM > 2
+    PROFILE_READ_CSR(PROFILE_CSR("mhpmcounter5", "hpmcounter5"), c->hpm[2]);
+#endif
+#if ONNX_PROFILE_NHPM > 3
+    PROFILE_READ_CSR(PROFILE_CSR("mhpmcounter6", "hpmcounter6"), c->hpm[3]);
+#endif
+    PROFILE_READ_CSR(PROFILE_CSR("mcycle", "cycle"), c->cycle);
+#else
+    // host build without riscv counters
+    c->instret = 0;
+    for (int i = 0; i < ONNX_PROFILE_NHPM; i++) {
+        c->hpm[i] = 0;
+    }
+    c->cycle = host_read_cycle();
+#endif
+}
+
+void onnx_profile_record(const char *op, const void *kernel, int node, const struct onnx_profile_counter_t *start)
+{
+    struct onnx_profile_counter_t end;
+    onnx_profile_read(&end);
+
+    if (nevent >= ONNX_PROFILE_MAX_EVENTS) {
+        dropped++;
+        return;
+    }
+    if (nevent == 0) {
+        origin = start->cycle;
+    }
+    struct profile_event_t *e = &events[nevent++];
+    e->op = op;
+    e->kernel = kernel;
+    e->node = node;
+    e->start = start->cycle - origin;
+    e->delta.cycle = end.cycle - start->cycle;
+    e->delta.instret = end.instret - start->instret;
+    for (int i = 0; i < ONNX_PROFILE_NHPM; i++) {
+        e->delta.hpm[i] = end.hpm[i] - start->hpm[i];
+    }
+}
+
+void onnx_profile_reset(void)
+{
+    nevent = 0;
+    dropped = 0;
+}
+
+int onnx_profile_count(void)
+{
+    return nevent;
+}
+
+static const char *profile_name(const struct profile_event_t *e)
+{
+    const char *name = e->op ? e->op : onnx_dispatch_name(e->kernel);
+    return name ? name : "unknown";
+}
+
+void onnx_profile_summary(void)
+{
+    struct {
+        const char *op;
+        int calls;
+        struct onnx_profile_counter_t sum;
+    } ops[PROFILE_MAX_OPS];
+    int nops = 0;
+    uint64_t total = 0;
+
+    for (int i = 0; i < nevent; i++) {
+        const char *name = profile_name(&events[i]);
+        int k;
+        for (k = 0; k < nops; k++) {
+            if (strcmp(ops[k].op, name) == 0) {
+                break;
+            }
+        }
+        if (k == nops) {
+            if (nops == PROFILE_MAX_OPS) {
+                continue;
+            }
+            memset(&ops[k], 0, sizeof(ops[k]));
+            ops[k].op = name;
+            nops++;
+        }
+        ops[k].calls++;
+        ops[k].sum.cycle += events[i].delta.cycle;
+        ops[k].sum.instret += events[i].delta.instret;
+        for (int j = 0; j < ONNX_PROFILE_NHPM; j++) {
+            ops[k].sum.hpm[j] += events[i].delta.hpm[j];
+        }
+        total += events[i].delta.cycle;
+    }
+
+    printf("PROFILE, op, calls, cycles, percent, instret, ipc");
+    for (int j = 0; j < ONNX_PROFILE_NHPM; j++) {
+        printf(", hpm%d", j + 3);
+    }
+    printf("\r\n");
+    for (int k = 0; k < nops; k++) {
+        printf("PROFILE, %s, %d, %lu, %.2f, %lu, %.3f", ops[k].op, ops[k].calls, (unsigned long)ops[k].sum.cycle,
+               total ? 100.0 * ops[k].sum.cycle / total : 0.0, (unsigned long)ops[k].sum.instret,
+               ops[k].sum.cycle ? (double)ops[k].sum.instret / ops[k].sum.cycle : 0.0);
+        for (int j = 0; j < ONNX_PROFILE_NHPM; j++) {
+            printf(", %lu", (unsigned long)ops[k].sum.hpm[j]);
+        }
+        printf("\r\n");
+    }
+    printf("PROFILE, total, %d, %lu, 100.00\r\n", nevent, (unsigned long)total);
+    if (dropped) {
+        printf("PROFILE, %d events not recorded, raise ONNX_PROFILE_MAX_EVENTS\r\n", dropped);
+    }
+}
+
+void onnx_profile_trace(void)
+{
+    printf("{\"traceEvents\": [\n");
+    for (int i = 0; i < nevent; i++) {
+        const struct profile_event_t *e = &events[i];
+        printf("%s{\"name\": \"%s\", \"cat\": \"onnx\", \"ph\": \"X\", \"pid\": 0, \"tid\": 0, \"ts\": %.3f, \"dur\": %.3f, "
+               "\"args\": {\"node\": %d, \"cycles\": %lu, \"instret\": %lu",
+               i ? "," : "", profile_name(e), (double)e->start / ONNX_PROFILE_CYCLES_PER_US, (double)e->delta.cycle / ONNX_PROFILE_CYCLES_PER_US,
+               e->node, (unsigned long)e->delta.cycle, (unsigned long)e->delta.instret);
+        for (int j = 0; j < ONNX_PROFILE_NHPM; j++) {
+            printf(", \"hpm%d\": %lu", j + 3, (unsigned long)e->delta.hpm[j]);
+        }
+        printf("}}\n");
+    }
+    printf("]}\n");
+}
+
+#endif /* defined(ONNX_PROFILE) */
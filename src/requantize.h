@@ -0,0 +1,87 @@
+#ifndef __REQUANTIZE_H__
+#define __REQUANTIZE_H__
+
+/*
+ * Requantization of the int32 accumulators of the int8 kernels: a rounding
+ * doubling high multiply by multiplier, i.e. val * multiplier / 2^31, then
+ * shift, to the left when positive, to the right rounding half away from zero
+ * when negative. The rvv versions are bit-exact with requantize().
+ */
+
+#include "utils.h"
+
+struct riscv_nn_double {
+    uint32_t low;
+    int32_t high;
+};
+
+union riscv_nn_long_long {
+    int64_t long_long;
+    struct riscv_nn_double word;
+};
+
+#define LEFT_SHIFT(_shift) (_shift > 0 ? _shift : 0)
+#define RIGHT_SHIFT(_shift) (_shift > 0 ? 0 : -_shift)
+
+__STATIC_FORCEINLINE int32_t requantize(const int32_t val, const int32_t multiplier, const int32_t shift)
+{
+    int32_t result = 0;
+    union riscv_nn_long_long mult;
+
+    // Rounding offset to add for a right shift of 31
+    mult.word.low = 1 << 30;
+    mult.word.high = 0;
+
+    // Gets resolved as a SMLAL instruction
+    mult.long_long = mult.long_long + (int64_t)(val * (1 << LEFT_SHIFT(shift))) * multiplier;
+
+    // Utilize all of the upper 32 bits. This is the doubling step
+    // as well.
+    result = (int32_t)(mult.long_long >> 31);
+
+    const int32_t remainder_mask = (1 << RIGHT_SHIFT(shift)) - 1;
+    int32_t remainder = remainder_mask & result;
+
+    // Basic division
+    result >>= RIGHT_SHIFT(shift);
+
+    // Adjust 'result' for rounding (mid point away from zero)
+    int32_t threshold = remainder_mask >> 1;
+    if (result < 0) {
+        threshold++;
+    }
+    if (remainder > threshold) {
+        result++;
+    }
+
+    return result;
+}
+
+#if defined(__riscv_vector)
+// requantize() of vl values, multiplier and shift per element, e.g. per output channel
+__STATIC_FORCEINLINE vint32m4_t requantize_vv_i32m4(vint32m4_t val, vint32m4_t mult, vint32m4_t shift, size_t vl)
+{
+    vuint32m4_t left_shift = __riscv_vreinterpret_v_i32m4_u32m4(__riscv_vmax_vx_i32m4(shift, 0, vl));
+    vuint32m4_t right_shift = __riscv_vreinterpret_v_i32m4_u32m4(__riscv_vneg_v_i32m4(__riscv_vmin_vx_i32m4(shift, 0, vl), vl));
+
+    val = __riscv_vsll_vv_i32m4(val, left_shift, vl);
+    // vsmul rounds (val * mult) >> 31 half up, the same as the rounding offset of the 64-bit product
+    val = __riscv_vsmul_vv_i32m4(val, mult, __RISCV_VXRM_RNU, vl);
+    // vssra rounds half up, negative values are lowered by one before a non-zero shift to round away from zero
+    vint32m4_t bias = __riscv_vand_vv_i32m4(__riscv_vsra_vx_i32m4(val, 31, vl),
+                                            __riscv_vreinterpret_v_u32m4_i32m4(__riscv_vminu_vx_u32m4(right_shift, 1, vl)), vl);
+    return __riscv_vssra_vv_i32m4(__riscv_vsub_vv_i32m4(val, bias, vl), right_shift, __RISCV_VXRM_RNU, vl);
+}
+
+// requantize_vv_i32m4 plus out_offset, clamped to the activation bounds within int8 and narrowed
+__STATIC_FORCEINLINE vint8m1_t requantize_i32m4(vint32m4_t val, vint32m4_t mult, vint32m4_t shift, int32_t out_offset, int32_t activation_min,
+                                                 int32_t activation_max, size_t vl)
+{
+    val = __riscv_vadd_vx_i32m4(requantize_vv_i32m4(val, mult, shift, vl), out_offset, vl);
+    val = __riscv_vmax_vx_i32m4(val, activation_min, vl);
+    val = __riscv_vmin_vx_i32m4(val, activation_max, vl);
+    return __riscv_vncvt_x_x_w_i8m1(__riscv_vncvt_x_x_w_i16m2(val, vl), vl);
+}
+#endif /* defined(__riscv_vector) */
+
+#endif /* __REQUANTIZE_H__ */
@@ -0,0 +1,590 @@
+/*
+ * Without vector extension, e.g. the host build, every _rvv kernel falls back
+ * to its scalar reference kernel, so the same test and benchmark code runs.
+ */
+
+#include "operators.h"
+
+#if !defined(__riscv_vector)
+
+void BatchNormalization_float16_rvv(struct onnx_node_t *node)
+{
+    BatchNormalization_float16(node);
+}
+
+void BatchNormalization_float32_rvv(struct onnx_node_t *node)
+{
+    BatchNormalization_float32(node);
+}
+
+void LayerNormalization_float16_rvv(struct onnx_node_t *node)
+{
+    LayerNormalization_float16(node);
+}
+
+void LayerNormalization_float32_rvv(struct onnx_node_t *node)
+{
+    LayerNormalization_float32(node);
+}
+
+void RMSNormalization_float16_rvv(struct onnx_node_t *node)
+{
+    RMSNormalization_float16(node);
+}
+
+void RMSNormalization_float32_rvv(struct onnx_node_t *node)
+{
+    RMSNormalization_float32(node);
+}
+
+void Softmax_float16_rvv(struct onnx_node_t *node)
+{
+    Softmax_float16(node);
+}
+
+void Softmax_float32_rvv(struct onnx_node_t *node)
+{
+    Softmax_float32(node);
+}
+
+void Topk_int32_rvv(struct onnx_node_t *n)
+{
+    Topk_int32(n);
+}
+
+void Topk_float16_rvv(struct onnx_node_t *n)
+{
+    Topk_float16(n);
+}
+
+void Topk_float32_rvv(struct onnx_node_t *n)
+{
+    Topk_float32(n);
+}
+
+void MatMul_int8_rvv(struct onnx_node_t *node)
+{
+    MatMul_int8(node);
+}
+
+void MatMul_float16_rvv(struct onnx_node_t *node)
+{
+    MatMul_float16(node);
+}
+
+void MatMul_float32_rvv(struct onnx_node_t *node)
+{
+    MatMul_float32(node);
+}
+
+int MatMulInteger_rvv(struct onnx_node_t *n)
+{
+    return MatMulInteger(n);
+}
+
+void Add_int8_rvv(struct onnx_node_t *node)
+{
+    Add_int8(node);
+}
+
+void Add_float16_rvv(struct onnx_node_t *node)
+{
+    Add_float16(node);
+}
+
+void Add_float32_rvv(struct onnx_node_t *node)
+{
+    Add_float32(node);
+}
+
+void Sub_int8_rvv(struct onnx_node_t *node)
+{
+    Sub_int8(node);
+}
+
+void Sub_float16_rvv(struct onnx_node_t *node)
+{
+    Sub_float16(node);
+}
+
+void Sub_float32_rvv(struct onnx_node_t *node)
+{
+    Sub_float32(node);
+}
+
+void Mul_int8_rvv(struct onnx_node_t *node)
+{
+    Mul_int8(node);
+}
+
+void Mul_float16_rvv(struct onnx_node_t *node)
+{
+    Mul_float16(node);
+}
+
+void Mul_float32_rvv(struct onnx_node_t *node)
+{
+    Mul_float32(node);
+}
+
+void Div_float16_rvv(struct onnx_node_t *node)
+{
+    Div_float16(node);
+}
+
+void Div_float32_rvv(struct onnx_node_t *node)
+{
+    Div_float32(node);
+}
+
+void Pow_float16_rvv(struct onnx_node_t *node)
+{
+    Pow_float16(node);
+}
+
+void Pow_float32_rvv(struct onnx_node_t *node)
+{
+    Pow_float32(node);
+}
+
+void Abs_int8_rvv(struct onnx_node_t *node)
+{
+    Abs_int8(node);
+}
+
+void Abs_int32_rvv(struct onnx_node_t *node)
+{
+    Abs_int32(node);
+}
+
+void Abs_float16_rvv(struct onnx_node_t *node)
+{
+    Abs_float16(node);
+}
+
+void Abs_float32_rvv(struct onnx_node_t *node)
+{
+    Abs_float32(node);
+}
+
+void Negate_int8_rvv(struct onnx_node_t *node)
+{
+    Negate_int8(node);
+}
+
+void Negate_int32_rvv(struct onnx_node_t *node)
+{
+    Negate_int32(node);
+}
+
+void Negate_float16_rvv(struct onnx_node_t *node)
+{
+    Negate_float16(node);
+}
+
+void Negate_float32_rvv(struct onnx_node_t *node)
+{
+    Negate_float32(node);
+}
+
+void Exp_float16_rvv(struct onnx_node_t *node)
+{
+    Exp_float16(node);
+}
+
+void Exp_float32_rvv(struct onnx_node_t *node)
+{
+    Exp_float32(node);
+}
+
+void Log_float16_rvv(struct onnx_node_t *node)
+{
+    Log_float16(node);
+}
+
+void Log_float32_rvv(struct onnx_node_t *node)
+{
+    Log_float32(node);
+}
+
+void Reciprocal_float16_rvv(struct onnx_node_t *node)
+{
+    Reciprocal_float16(node);
+}
+
+void Reciprocal_float32_rvv(struct onnx_node_t *node)
+{
+    Reciprocal_float32(node);
+}
+
+void Sqrt_float16_rvv(struct onnx_node_t *node)
+{
+    Sqrt_float16(node);
+}
+
+void Sqrt_float32_rvv(struct onnx_node_t *node)
+{
+    Sqrt_float32(node);
+}
+
+void Rsqrt_float16_rvv(struct onnx_node_t *node)
+{
+    Rsqrt_float16(node);
+}
+
+void Rsqrt_float32_rvv(struct onnx_node_t *node)
+{
+    Rsqrt_float32(node);
+}
+
+void Sin_float16_rvv(struct onnx_node_t *node)
+{
+    Sin_float16(node);
+}
+
+void Sin_float32_rvv(struct onnx_node_t *node)
+{
+    Sin_float32(node);
+}
+
+void Cos_float16_rvv(struct onnx_node_t *node)
+{
+    Cos_float16(node);
+}
+
+void Cos_float32_rvv(struct onnx_node_t *node)
+{
+    Cos_float32(node);
+}
+
+void Concat_int8_rvv(struct onnx_node_t *node)
+{
+    Concat_int8(node);
+}
+
+void Concat_int32_rvv(struct onnx_node_t *node)
+{
+    Concat_int32(node);
+}
+
+void Concat_float16_rvv(struct onnx_node_t *node)
+{
+    Concat_float16(node);
+}
+
+void Concat_float32_rvv(struct onnx_node_t *node)
+{
+    Concat_float32(node);
+}
+
+void Clamp_int8_rvv(struct onnx_node_t *node)
+{
+    Clamp_int8(node);
+}
+
+void Clamp_int32_rvv(struct onnx_node_t *node)
+{
+    Clamp_int32(node);
+}
+
+void Clamp_float16_rvv(struct onnx_node_t *node)
+{
+    Clamp_float16(node);
+}
+
+void Clamp_float32_rvv(struct onnx_node_t *node)
+{
+    Clamp_float32(node);
+}
+
+void Elu_float16_rvv(struct onnx_node_t *node)
+{
+    Elu_float16(node);
+}
+
+void Elu_float32_rvv(struct onnx_node_t *node)
+{
+    Elu_float32(node);
+}
+
+void Relu_float16_rvv(struct onnx_node_t *node)
+{
+    Relu_float16(node);
+}
+
+void Relu_float32_rvv(struct onnx_node_t *node)
+{
+    Relu_float32(node);
+}
+
+void Silu_float16_rvv(struct onnx_node_t *node)
+{
+    Silu_float16(node);
+}
+
+void Silu_float32_rvv(struct onnx_node_t *node)
+{
+    Silu_float32(node);
+}
+
+void Pad_int8_rvv(struct onnx_node_t *node)
+{
+    Pad_int8(node);
+}
+
+void Pad_int32_rvv(struct onnx_node_t *node)
+{
+    Pad_int32(node);
+}
+
+void Pad_float16_rvv(struct onnx_node_t *node)
+{
+    Pad_float16(node);
+}
+
+void Pad_float32_rvv(struct onnx_node_t *node)
+{
+    Pad_float32(node);
+}
+
+void Flip_int8_rvv(struct onnx_node_t *node)
+{
+    Flip_int8(node);
+}
+
+void Flip_int32_rvv(struct onnx_node_t *node)
+{
+    Flip_int32(node);
+}
+
+void Flip_float16_rvv(struct onnx_node_t *node)
+{
+    Flip_float16(node);
+}
+
+void Flip_float32_rvv(struct onnx_node_t *node)
+{
+    Flip_float32(node);
+}
+
+void Slice_int8_rvv(struct onnx_node_t *node)
+{
+    Slice_int8(node);
+}
+
+void Slice_int32_rvv(struct onnx_node_t *node)
+{
+    Slice_int32(node);
+}
+
+void Slice_float16_rvv(struct onnx_node_t *node)
+{
+    Slice_float16(node);
+}
+
+void Slice_float32_rvv(struct onnx_node_t *node)
+{
+    Slice_float32(node);
+}
+
+void Tile_int8_rvv(struct onnx_node_t *node)
+{
+    Tile_int8(node);
+}
+
+void Tile_int32_rvv(struct onnx_node_t *node)
+{
+    Tile_int32(node);
+}
+
+void Tile_float16_rvv(struct onnx_node_t *node)
+{
+    Tile_float16(node);
+}
+
+void Tile_float32_rvv(struct onnx_node_t *node)
+{
+    Tile_float32(node);
+}
+
+void GatherElements_int8_rvv(struct onnx_node_t *node)
+{
+    GatherElements_int8(node);
+}
+
+void GatherElements_int32_rvv(struct onnx_node_t *node)
+{
+    GatherElements_int32(node);
+}
+
+void GatherElements_float16_rvv(struct onnx_node_t *node)
+{
+    GatherElements_float16(node);
+}
+
+void GatherElements_float32_rvv(struct onnx_node_t *node)
+{
+    GatherElements_float32(node);
+}
+
+void ScatterElements_int8_rvv(struct onnx_node_t *node)
+{
+    ScatterElements_int8(node);
+}
+
+void ScatterElements_int32_rvv(struct onnx_node_t *node)
+{
+    ScatterElements_int32(node);
+}
+
+void ScatterElements_float16_rvv(struct onnx_node_t *node)
+{
+    ScatterElements_float16(node);
+}
+
+void ScatterElements_float32_rvv(struct onnx_node_t *node)
+{
+    ScatterElements_float32(node);
+}
+
+void ReduceAll_rvv(struct onnx_node_t *node)
+{
+    ReduceAll(node);
+}
+
+void ReduceAny_rvv(struct onnx_node_t *node)
+{
+    ReduceAny(node);
+}
+
+void ReduceMax_int8_rvv(struct onnx_node_t *node)
+{
+    ReduceMax_int8(node);
+}
+
+void ReduceMax_float16_rvv(struct onnx_node_t *node)
+{
+    ReduceMax_float16(node);
+}
+
+void ReduceMax_int32_rvv(struct onnx_node_t *node)
+{
+    ReduceMax_int32(node);
+}
+
+void ReduceMax_float32_rvv(struct onnx_node_t *n)
+{
+    ReduceMax_float32(n);
+}
+
+void ReduceMin_int8_rvv(struct onnx_node_t *node)
+{
+    ReduceMin_int8(node);
+}
+
+void ReduceMin_float16_rvv(struct onnx_node_t *node)
+{
+    ReduceMin_float16(node);
+}
+
+void ReduceMin_int32_rvv(struct onnx_node_t *node)
+{
+    ReduceMin_int32(node);
+}
+
+void ReduceMin_float32_rvv(struct onnx_node_t *n)
+{
+    ReduceMin_float32(n);
+}
+
+void ReduceProd_float16_rvv(struct onnx_node_t *node)
+{
+    ReduceProd_float16(node);
+}
+
+void ReduceProd_float32_rvv(struct onnx_node_t *n)
+{
+    ReduceProd_float32(n);
+}
+
+void ReduceSum_float16_rvv(struct onnx_node_t *node)
+{
+    ReduceSum_float16(node);
+}
+
+void ReduceSum_float32_rvv(struct onnx_node_t *n)
+{
+    ReduceSum_float32(n);
+}
+
+int ConvInteger_rvv(struct onnx_node_t *n)
+{
+    return ConvInteger(n);
+}
+
+void Conv_float16_rvv(struct onnx_node_t *n)
+{
+    Conv_float16(n);
+}
+
+void Conv_float32_rvv(struct onnx_node_t *n)
+{
+    Conv_float32(n);
+}
+
+int ConvTransposeInteger_rvv(struct onnx_node_t *n)
+{
+    return ConvTransposeInteger(n);
+}
+
+int ConvTranspose_float16_rvv(struct onnx_node_t *n)
+{
+    return ConvTranspose_float16(n);
+}
+
+void MaxPool_int8_rvv(struct onnx_node_t *n)
+{
+    MaxPool_int8(n);
+}
+
+void MaxPool_float16_rvv(struct onnx_node_t *n)
+{
+    MaxPool_float16(n);
+}
+
+void MaxPool_float32_rvv(struct onnx_node_t *n)
+{
+    MaxPool_float32(n);
+}
+
+void AveragePool_int8_rvv(struct onnx_node_t *n)
+{
+    AveragePool_int8(n);
+}
+
+void AveragePool_float16_rvv(struct onnx_node_t *n)
+{
+    AveragePool_float16(n);
+}
+
+void AveragePool_float32_rvv(struct onnx_node_t *n)
+{
+    AveragePool_float32(n);
+}
+
+void GlobalAveragePool_int8_rvv(struct onnx_node_t *n)
+{
+    GlobalAveragePool_int8(n);
+}
+
+void GlobalAveragePool_float16_rvv(struct onnx_node_t *n)
+{
+    GlobalAveragePool_float16(n);
+}
+
+void GlobalAveragePool_float32_rvv(struct onnx_node_t *n)
+{
+    GlobalAveragePool_float32(n);
+}
+
+#endif /* !defined(__riscv_vector) */
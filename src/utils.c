@@ -36,38 +36,125 @@ int verify_results_int32(int32_t *ref, int32_t *opt, int length)
     return flag;
 }
 
+// the whole buffer is checked, the worst mismatch is reported with its ulp error
 int verify_results_f16(float16_t *ref, float16_t *opt, int length)
 {
-
-    int8_t flag = 0;
-    float32_t f32_ref, f32_opt;
+    int worst = -1, count = 0;
+    float32_t f32_ref, f32_opt, err, max_err = 0;
 
     for (int i = 0; i < length; i++) {
         f32_ref = (float32_t)ref[i];
         f32_opt = (float32_t)opt[i];
-        if (fabs(f32_ref - f32_opt) > DELTAF32) {
-            printf("F16 Output mismatch at %d, expected %f, actual %f\r\n", i, f32_ref, f32_opt);
-            flag = 1;
-            break;
+        err = fabs(f32_ref - f32_opt);
+        if (err > DELTAF32 || isnan(f32_ref) != isnan(f32_opt)) {
+            if (worst < 0 || !(err <= max_err)) {
+                worst = i;
+                max_err = err;
+            }
+            count++;
         }
     }
+    if (worst >= 0) {
+        printf("F16 Output mismatch at %d, expected %f, actual %f, %.2f ulp, %d of %d mismatched\r\n", worst, (float32_t)ref[worst],
+               (float32_t)opt[worst], ulp_error_f16(opt[worst], (float32_t)ref[worst]), count, length);
+    }
 
-    return flag;
+    return worst >= 0;
 }
 
 int verify_results_f32(float32_t *ref, float32_t *opt, int length)
 {
-    int8_t flag = 0;
+    int worst = -1, count = 0;
+    float32_t err, max_err = 0;
 
     for (int i = 0; i < length; i++) {
-        if (fabs(ref[i] - opt[i]) > DELTAF32) {
-            printf("f32 Output mismatch at %d, expected %f, actual %f\r\n", i, ref[i], opt[i]);
-            flag = 1;
-            break;
+        err = fabs(ref[i] - opt[i]);
+        if (err > DELTAF32 || isnan(ref[i]) != isnan(opt[i])) {
+            if (worst < 0 || !(err <= max_err)) {
+                worst = i;
+                max_err = err;
+            }
+            count++;
         }
     }
+    if (worst >= 0) {
+        printf("f32 Output mismatch at %d, expected %f, actual %f, %.2f ulp, %d of %d mismatched\r\n", worst, ref[worst], opt[worst],
+               ulp_error_f32(opt[worst], ref[worst]), count, length);
+    }
 
-    return flag;
+    return worst >= 0;
+}
+
+static double ulp_error(double opt, double ref, int mant_bits, int min_exp)
+{
+    int exp;
+
+    if (isnan(opt) || isnan(ref)) {
+        return (isnan(opt) && isnan(ref)) ? 0 : INFINITY;
+    }
+    if (opt == ref) {
+        return 0;
+    }
+    // |ref| in [2^(exp-1), 2^exp), the ulp of the format there is 2^(exp-1-mant_bits)
+    frexp(ref, &exp);
+    exp = MAX(exp - 1 - mant_bits, min_exp);
+    return fabs(opt - ref) / ldexp(1.0, exp);
+}
+
+double ulp_error_f32(float32_t opt, float64_t ref)
+{
+    return ulp_error(opt, ref, 23, -149);
+}
+
+double ulp_error_f16(float16_t opt, float64_t ref)
+{
+    return ulp_error((float32_t)opt, ref, 10, -24);
+}
+
+// references below abs_floor, e.g. near the zeros of sin, count in max_abs instead of the ulp
+static void accuracy_update(struct accuracy_result_t *r, int i, double opt, double ref, double ulp, double abs_floor, int *count)
+{
+    if (fabs(ref) < abs_floor) {
+        double err = fabs(opt - ref);
+        if (!(err <= r->max_abs)) {
+            r->max_abs = isnan(err) ? INFINITY : err;
+            r->worst_abs = i;
+        }
+        return;
+    }
+    if (ulp > r->max_ulp) {
+        r->max_ulp = ulp;
+        r->worst = i;
+    }
+    r->mean_ulp += ulp;
+    (*count)++;
+    if (ref != 0 && !isnan(ref)) {
+        double rel = fabs((opt - ref) / ref);
+        if (isnan(rel)) {
+            rel = INFINITY;
+        }
+        r->max_rel = MAX(r->max_rel, rel);
+    }
+}
+
+void accuracy_f32(const float32_t *opt, const float64_t *ref, int length, double abs_floor, struct accuracy_result_t *r)
+{
+    int count = 0;
+    memset(r, 0, sizeof(*r));
+    for (int i = 0; i < length; i++) {
+        accuracy_update(r, i, opt[i], ref[i], ulp_error_f32(opt[i], ref[i]), abs_floor, &count);
+    }
+    r->mean_ulp = count ? r->mean_ulp / count : 0;
+}
+
+void accuracy_f16(const float16_t *opt, const float64_t *ref, int length, double abs_floor, struct accuracy_result_t *r)
+{
+    int count = 0;
+    memset(r, 0, sizeof(*r));
+    for (int i = 0; i < length; i++) {
+        accuracy_update(r, i, (float32_t)opt[i], ref[i], ulp_error_f16(opt[i], ref[i]), abs_floor, &count);
+    }
+    r->mean_ulp = count ? r->mean_ulp / count : 0;
 }
 
 void show_tensor_int8_impl(struct onnx_tensor_t *t, size_t offset, int dim)
@@ -13,6 +13,20 @@ int verify_results_int32(int32_t *ref, int32_t *opt, int length);
 int verify_results_f16(float16_t *ref, float16_t *opt, int length);
 int verify_results_f32(float32_t *ref, float32_t *opt, int length);
 
+struct accuracy_result_t {
+    double max_ulp;  // max error in units in the last place of the reference, references below abs_floor excluded
+    double mean_ulp; // mean error in ulp
+    double max_rel;  // max relative error, inputs with zero reference excluded
+    double max_abs;  // max absolute error of the references below abs_floor
+    int worst;       // index of the element with max_ulp
+    int worst_abs;   // index of the element with max_abs
+};
+
+double ulp_error_f32(float32_t opt, float64_t ref);
+double ulp_error_f16(float16_t opt, float64_t ref);
+void accuracy_f32(const float32_t *opt, const float64_t *ref, int length, double abs_floor, struct accuracy_result_t *r);
+void accuracy_f16(const float16_t *opt, const float64_t *ref, int length, double abs_floor, struct accuracy_result_t *r);
+
 void show_tensor_int8(struct onnx_tensor_t *t, const char *name);
 void show_tensor_bool(struct onnx_tensor_t *t, const char *name);
 void show_tensor_f16(struct onnx_tensor_t *t, const char *name);
@@ -26,7 +40,9 @@ void HeapSort_f32(float32_t *a, int32_t n);
 static inline int csrr_vlenb()
 {
     int a = 0;
+#if defined(__riscv_vector)
     asm volatile("csrr %0, vlenb" : "=r"(a) : : "memory");
+#endif
     return a;
 }
 
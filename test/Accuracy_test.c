@@ -0,0 +1,192 @@
+/*
+ * Accuracy of the elementwise math kernels against a float64 reference,
+ * float32 kernels on a dense grid of the input range, float16 kernels on
+ * every float16 value of the range, or every n-th one for wide ranges.
+ * Prints max/mean ulp error, max relative error, the worst input and the max
+ * absolute error of the outputs below abs_floor of the scalar and the rvv
+ * kernel as
+ * "ACCURACY, op, type, lo, hi, kernel, max_ulp, mean_ulp, max_rel, worst_input, max_abs".
+ * A case fails when the scalar kernel exceeds max_ulp, or the rvv kernel
+ * exceeds max_ulp_rvv or max_abs_rvv, a negative limit only reports.
+ */
+
+#include "utils.h"
+
+#define ACCURACY_POINTS 4097
+
+struct accuracy_case_t {
+    const char *name;
+    enum onnx_tensor_type_t type;
+    onnx_operator_t ref;
+    onnx_operator_t rvv;
+    double (*golden)(double);
+    float32_t lo;
+    float32_t hi;
+    double max_ulp;
+    double max_ulp_rvv;
+    double abs_floor;   // rvv outputs with a reference below it are limited by max_abs_rvv instead of the ulp
+    double max_abs_rvv;
+};
+
+static double golden_rsqrt(double x)
+{
+    return 1.0 / sqrt(x);
+}
+
+static double golden_reciprocal(double x)
+{
+    return 1.0 / x;
+}
+
+static double golden_silu(double x)
+{
+    return x / (1.0 + exp(-x));
+}
+
+#define ACCURACY_F32(op, golden, lo, hi, max_ulp, max_ulp_rvv, abs_floor, max_abs_rvv)                                                              \
+    {#op, ONNX_TENSOR_TYPE_FLOAT32, op##_float32, op##_float32_rvv, golden, lo, hi, max_ulp, max_ulp_rvv, abs_floor, max_abs_rvv}
+#define ACCURACY_F16(op, golden, lo, hi, max_ulp, max_ulp_rvv, abs_floor, max_abs_rvv)                                                              \
+    {#op, ONNX_TENSOR_TYPE_FLOAT16, op##_float16, op##_float16_rvv, golden, lo, hi, max_ulp, max_ulp_rvv, abs_floor, max_abs_rvv}
+
+// The rvv limits of the polynomial kernels are the measured error with about 10% headroom, the rvv
+// kernels have no fused ops so the error does not depend on VLEN. The series of Log around 1 is off
+// in absolute terms, so outputs below 0.25 are limited in absolute error. The truncated Taylor series
+// of Sin/Cos on [-pi, pi] is off in absolute terms everywhere, x^11/11! at pi for Sin, so all of
+// their outputs are.
+static const struct accuracy_case_t accuracy_cases[] = {
+    ACCURACY_F32(Exp, exp, -87.0f, 88.0f, 1, 72, 0, 0),
+    ACCURACY_F32(Log, log, 1e-3f, 10.0f, 1, 2, 0.25, 1e-7),
+    ACCURACY_F32(Log, log, 10.0f, 1e6f, 1, 1, 0, 0),
+    ACCURACY_F32(Sin, sin, -PI, PI, 1, 0, 2, 7.5e-3),
+    ACCURACY_F32(Sin, sin, -100.0f, 100.0f, 1, 0, 2, 7.5e-3),
+    ACCURACY_F32(Cos, cos, -PI, PI, 1, 0, 2, 2e-3),
+    ACCURACY_F32(Cos, cos, -100.0f, 100.0f, 1, 0, 2, 2e-3),
+    ACCURACY_F32(Silu, golden_silu, -20.0f, 20.0f, 2, 24, 0, 0),
+    ACCURACY_F32(Sqrt, sqrt, 0.0f, 1e4f, 1, 1, 0, 0),
+    ACCURACY_F32(Rsqrt, golden_rsqrt, 1e-3f, 1e4f, 2, 2, 0, 0),
+    ACCURACY_F32(Reciprocal, golden_reciprocal, 1e-2f, 1e2f, 1, 1, 0, 0),
+    ACCURACY_F16(Exp, exp, -9.0f, 11.0f, 1, 9, 0, 0),
+    ACCURACY_F16(Log, log, 1e-3f, 1e4f, 1, 2, 0.25, 6e-4),
+    ACCURACY_F16(Sin, sin, -PI, PI, 1, 0, 2, 7.5e-3),
+    ACCURACY_F16(Cos, cos, -PI, PI, 1, 5, 0, 0),
+    ACCURACY_F16(Silu, golden_silu, -10.0f, 10.0f, 2, 8, 0, 0),
+    ACCURACY_F16(Sqrt, sqrt, 0.0f, 1e4f, 1, 1, 0, 0),
+    ACCURACY_F16(Rsqrt, golden_rsqrt, 1e-2f, 1e4f, 2, 2, 0, 0),
+    ACCURACY_F16(Reciprocal, golden_reciprocal, 1e-2f, 1e2f, 1, 1, 0, 0),
+};
+
+static int accuracy_in_range_f16(int bits, float32_t lo, float32_t hi, float16_t *v)
+{
+    uint16_t u = (uint16_t)bits;
+    memcpy(v, &u, sizeof(*v));
+    return (float32_t)*v >= lo && (float32_t)*v <= hi;
+}
+
+// float16 values in [lo, hi], every one of them when they fit into ACCURACY_POINTS
+static int accuracy_inputs_f16(float16_t *px, float32_t lo, float32_t hi)
+{
+    float16_t v;
+    int count = 0, len = 0;
+    for (int bits = 0; bits < 0x10000; bits++) {
+        count += accuracy_in_range_f16(bits, lo, hi, &v);
+    }
+    int step = (count + ACCURACY_POINTS - 1) / ACCURACY_POINTS;
+    count = 0;
+    for (int bits = 0; bits < 0x10000; bits++) {
+        if (accuracy_in_range_f16(bits, lo, hi, &v) && count++ % step == 0) {
+            px[len++] = v;
+        }
+    }
+    return len;
+}
+
+static int accuracy_check(const struct accuracy_case_t *c, const char *kernel, const struct accuracy_result_t *r, float32_t worst,
+                          float32_t worst_abs, double max_ulp, double max_abs)
+{
+    printf("ACCURACY, %s, %s, %g, %g, %s, %.2f, %.4f, %.3e, %.9g, %.3e\r\n", c->name, c->type == ONNX_TENSOR_TYPE_FLOAT16 ? "float16" : "float32",
+           c->lo, c->hi, kernel, r->max_ulp, r->mean_ulp, r->max_rel, worst, r->max_abs);
+    if (max_ulp >= 0 && !(r->max_ulp <= max_ulp)) {
+        printf("%s_%s is %.2f ulp off at %.9g, limit %.2f ulp\r\n", c->name, kernel, r->max_ulp, worst, max_ulp);
+        return 1;
+    }
+    if (max_abs >= 0 && !(r->max_abs <= max_abs)) {
+        printf("%s_%s is %.3e off at %.9g, limit %.3e\r\n", c->name, kernel, r->max_abs, worst_abs, max_abs);
+        return 1;
+    }
+    return 0;
+}
+
+static int accuracy_case(const struct accuracy_case_t *c, struct onnx_node_t *node, float64_t *golden)
+{
+    struct onnx_tensor_t *x = node->inputs[0];
+    struct onnx_tensor_t *y = node->outputs[0];
+    struct accuracy_result_t r;
+    int len, ret = 0;
+
+    if (c->type == ONNX_TENSOR_TYPE_FLOAT16) {
+        float16_t *px = (float16_t *)x->datas;
+        len = accuracy_inputs_f16(px, c->lo, c->hi);
+        for (int i = 0; i < len; i++) {
+            golden[i] = c->golden((float32_t)px[i]);
+        }
+    } else {
+        float32_t *px = (float32_t *)x->datas;
+        len = ACCURACY_POINTS;
+        for (int i = 0; i < len; i++) {
+            px[i] = c->lo + (c->hi - c->lo) * i / (len - 1);
+            golden[i] = c->golden(px[i]);
+        }
+    }
+    x->type = y->type = c->type;
+    x->ndata = y->ndata = len;
+    x->dims[0] = y->dims[0] = len;
+
+    for (int k = 0; k < 2; k++) {
+        onnx_operator_t op = k ? c->rvv : c->ref;
+        const double abs_floor = k ? c->abs_floor : 0;
+        float32_t worst, worst_abs;
+        op(node);
+        if (c->type == ONNX_TENSOR_TYPE_FLOAT16) {
+            accuracy_f16((float16_t *)y->datas, golden, len, abs_floor, &r);
+            worst = ((float16_t *)x->datas)[r.worst];
+            worst_abs = ((float16_t *)x->datas)[r.worst_abs];
+        } else {
+            accuracy_f32((float32_t *)y->datas, golden, len, abs_floor, &r);
+            worst = ((float32_t *)x->datas)[r.worst];
+            worst_abs = ((float32_t *)x->datas)[r.worst_abs];
+        }
+        ret |= accuracy_check(c, k ? "rvv" : "ref", &r, worst, worst_abs, k ? c->max_ulp_rvv : c->max_ulp, k ? c->max_abs_rvv : 0);
+    }
+    return ret;
+}
+
+int test_accuracy(void)
+{
+    struct onnx_node_t node;
+    struct onnx_tensor_t x, y;
+    struct onnx_tensor_t *inputs[1] = {&x};
+    struct onnx_tensor_t *outputs[1] = {&y};
+    int xdims[1], ydims[1];
+    float64_t *golden = (float64_t *)MALLOC_ASSERT(sizeof(float64_t) * ACCURACY_POINTS);
+    int ret = 0;
+
+    x.ndim = y.ndim = 1;
+    x.dims = xdims;
+    y.dims = ydims;
+    x.datas = MALLOC_ASSERT(sizeof(float32_t) * ACCURACY_POINTS);
+    y.datas = MALLOC_ASSERT(sizeof(float32_t) * ACCURACY_POINTS);
+    node.priv = NULL;
+    node.ninput = 1;
+    node.inputs = inputs;
+    node.noutput = 1;
+    node.outputs = outputs;
+
+    for (int i = 0; i < sizeof(accuracy_cases) / sizeof(accuracy_cases[0]); i++) {
+        ret |= accuracy_case(&accuracy_cases[i], &node, golden);
+    }
+
+    free(x.datas);
+    free(y.datas);
+    free(golden);
+    return ret;
+}
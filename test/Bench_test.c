@@ -0,0 +1,293 @@
+/*
+ * Benchmark sweep: run every operator of bench_ops over a grid of shapes,
+ * including tail sizes and large tensors, for the scalar and the rvv kernel.
+ *
+ * Only built into the test list with ONNX_BENCH_SWEEP, every row is printed as
+ * "BENCH, op, type, shape, elems, ref_cycles, rvv_cycles, ref_cycles/elem,
+ * rvv_cycles/elem, rvv_bytes/cycle, speedup", or as a JSON array with
+ * ONNX_BENCH_JSON. Edit the shape tables below or set ONNX_BENCH_MAX_ELEMS to
+ * sweep other sizes.
+ */
+
+#include "utils.h"
+
+#ifndef ONNX_BENCH_MAX_ELEMS
+#define ONNX_BENCH_MAX_ELEMS (16384)
+#endif
+#ifndef ONNX_BENCH_REPEAT
+#define ONNX_BENCH_REPEAT (3)
+#endif
+
+enum bench_kind_t {
+    BENCH_UNARY,  // y = f(a), dims {n}
+    BENCH_BINARY, // y = f(a, b), dims {n}
+    BENCH_ROWS,   // dims {cols, rows}, e.g. Softmax
+    BENCH_NORM,   // dims {rows, cols}, e.g. LayerNormalization
+    BENCH_MATMUL, // a dims {k, m}, b dims {n, k}
+};
+
+struct bench_op_t {
+    const char *name;
+    enum onnx_tensor_type_t type;
+    enum bench_kind_t kind;
+    onnx_operator_t ref;
+    onnx_operator_t rvv;
+    void *(*param)(void);
+    void (*free_param)(void **pdat);
+};
+
+static void *bench_norm_param(void)
+{
+    return GenerateLayerNormParam(1e-5f, 0.9f);
+}
+
+static void *bench_rmsnorm_param(void)
+{
+    return GenerateRMSNormParam(1e-5f, 0.9f);
+}
+
+static void *bench_pow_param(void)
+{
+    OnnxScalar exponent;
+    exponent.v_float32 = 2.0f;
+    return GeneratePowParam(exponent);
+}
+
+#define BENCH_OP(op, TYPE, type, kind) {#op, ONNX_TENSOR_TYPE_##TYPE, kind, op##_##type, op##_##type##_rvv, NULL, NULL}
+#define BENCH_OP_PARAM(op, TYPE, type, kind, param, free_param)                                                                                      \
+    {#op, ONNX_TENSOR_TYPE_##TYPE, kind, op##_##type, op##_##type##_rvv, param, free_param}
+
+static const struct bench_op_t bench_ops[] = {
+    BENCH_OP(Abs, INT8, int8, BENCH_UNARY),
+    BENCH_OP(Abs, FLOAT16, float16, BENCH_UNARY),
+    BENCH_OP(Abs, FLOAT32, float32, BENCH_UNARY),
+    BENCH_OP(Negate, FLOAT32, float32, BENCH_UNARY),
+    BENCH_OP(Relu, FLOAT16, float16, BENCH_UNARY),
+    BENCH_OP(Relu, FLOAT32, float32, BENCH_UNARY),
+    BENCH_OP(Exp, FLOAT16, float16, BENCH_UNARY),
+    BENCH_OP(Exp, FLOAT32, float32, BENCH_UNARY),
+    BENCH_OP(Log, FLOAT32, float32, BENCH_UNARY),
+    BENCH_OP(Sqrt, FLOAT32, float32, BENCH_UNARY),
+    BENCH_OP(Rsqrt, FLOAT32, float32, BENCH_UNARY),
+    BENCH_OP(Reciprocal, FLOAT32, float32, BENCH_UNARY),
+    BENCH_OP(Sin, FLOAT32, float32, BENCH_UNARY),
+    BENCH_OP(Cos, FLOAT32, float32, BENCH_UNARY),
+    BENCH_OP(Silu, FLOAT16, float16, BENCH_UNARY),
+    BENCH_OP(Silu, FLOAT32, float32, BENCH_UNARY),
+    BENCH_OP_PARAM(Pow, FLOAT32, float32, BENCH_UNARY, bench_pow_param, FreePowParam),
+    BENCH_OP(Add, INT8, int8, BENCH_BINARY),
+    BENCH_OP(Add, FLOAT16, float16, BENCH_BINARY),
+    BENCH_OP(Add, FLOAT32, float32, BENCH_BINARY),
+    BENCH_OP(Sub, FLOAT32, float32, BENCH_BINARY),
+    BENCH_OP(Mul, INT8, int8, BENCH_BINARY),
+    BENCH_OP(Mul, FLOAT32, float32, BENCH_BINARY),
+    BENCH_OP(Div, FLOAT32, float32, BENCH_BINARY),
+    BENCH_OP(Softmax, FLOAT16, float16, BENCH_ROWS),
+    BENCH_OP(Softmax, FLOAT32, float32, BENCH_ROWS),
+    BENCH_OP_PARAM(LayerNormalization, FLOAT16, float16, BENCH_NORM, bench_norm_param, FreeLayerNormParam),
+    BENCH_OP_PARAM(LayerNormalization, FLOAT32, float32, BENCH_NORM, bench_norm_param, FreeLayerNormParam),
+    BENCH_OP_PARAM(RMSNormalization, FLOAT32, float32, BENCH_NORM, bench_rmsnorm_param, FreeRMSNormParam),
+    BENCH_OP(MatMul, INT8, int8, BENCH_MATMUL),
+    BENCH_OP(MatMul, FLOAT16, float16, BENCH_MATMUL),
+    BENCH_OP(MatMul, FLOAT32, float32, BENCH_MATMUL),
+};
+
+// element count of elementwise operators, tails around the vector length included
+static const int bench_lengths[] = {1, 3, 15, 16, 17, 63, 255, 1000, 4096, 16384, 65536, 262144};
+
+// {rows, cols} of row wise operators
+static const int bench_rows[][2] = {{1, 1000}, {4, 512}, {16, 63}, {64, 255}, {128, 128}, {512, 512}};
+
+// {m, k, n} of MatMul
+static const int bench_matmul[][3] = {{1, 64, 64}, {4, 4, 4}, {15, 17, 33}, {64, 64, 64}, {128, 128, 128}, {256, 256, 256}};
+
+BENCH_DECLARE_VAR()
+
+static const char *bench_type_name(enum onnx_tensor_type_t type)
+{
+    switch (type) {
+        case ONNX_TENSOR_TYPE_INT8:
+            return "int8";
+        case ONNX_TENSOR_TYPE_FLOAT16:
+            return "float16";
+        case ONNX_TENSOR_TYPE_FLOAT32:
+            return "float32";
+        default:
+            break;
+    }
+    return "unknown";
+}
+
+static void bench_fill(struct onnx_tensor_t *t)
+{
+    for (size_t i = 0; i < t->ndata; i++) {
+        // positive values keep Log, Sqrt and Div finite
+        float32_t v = 0.5f + rand() * 1.0f / RAND_MAX;
+        switch (t->type) {
+            case ONNX_TENSOR_TYPE_INT8:
+                ((int8_t *)t->datas)[i] = (int8_t)(rand() % 64 - 32);
+                break;
+            case ONNX_TENSOR_TYPE_FLOAT16:
+                ((float16_t *)t->datas)[i] = (float16_t)v;
+                break;
+            default:
+                ((float32_t *)t->datas)[i] = v;
+                break;
+        }
+    }
+}
+
+static void bench_tensor(struct onnx_tensor_t *t, enum onnx_tensor_type_t type, void *datas, int ndim, int d0, int d1)
+{
+    t->name = NULL;
+    t->type = type;
+    t->strides = NULL;
+    t->ndim = ndim;
+    t->dims[0] = d0;
+    t->dims[1] = d1;
+    t->ndata = (size_t)d0 * (ndim > 1 ? d1 : 1);
+    t->datas = datas;
+}
+
+static uint64_t bench_run(onnx_operator_t op, struct onnx_node_t *node)
+{
+    uint64_t best = 0;
+    op(node); // warm up caches
+    for (int r = 0; r < ONNX_BENCH_REPEAT; r++) {
+        BENCH_START(bench_sweep);
+        op(node);
+        BENCH_SAMPLE(bench_sweep);
+        uint64_t cycles = BENCH_GET_USECYC();
+        if (r == 0 || cycles < best) {
+            best = cycles;
+        }
+    }
+    return best;
+}
+
+static int bench_rows_printed = 0;
+
+static void bench_report(const struct bench_op_t *op, const char *shape, size_t elems, size_t bytes, uint64_t ref, uint64_t rvv)
+{
+    double ref_per_elem = (double)ref / elems;
+    double rvv_per_elem = (double)rvv / elems;
+    double bytes_per_cycle = rvv ? (double)bytes / rvv : 0;
+    double speedup = rvv ? (double)ref / rvv : 0;
+#if defined(ONNX_BENCH_JSON)
+    printf("%s{\"op\": \"%s\", \"type\": \"%s\", \"shape\": \"%s\", \"elems\": %lu, \"ref_cycles\": %lu, \"rvv_cycles\": %lu, "
+           "\"ref_cycles_per_elem\": %.3f, \"rvv_cycles_per_elem\": %.3f, \"rvv_bytes_per_cycle\": %.3f, \"speedup\": %.3f}\n",
+           bench_rows_printed ? "," : "", op->name, bench_type_name(op->type), shape, (unsigned long)elems, (unsigned long)ref,
+           (unsigned long)rvv, ref_per_elem, rvv_per_elem, bytes_per_cycle, speedup);
+#else
+    printf("BENCH, %s, %s, %s, %lu, %lu, %lu, %.3f, %.3f, %.3f, %.3f\n", op->name, bench_type_name(op->type), shape, (unsigned long)elems,
+           (unsigned long)ref, (unsigned long)rvv, ref_per_elem, rvv_per_elem, bytes_per_cycle, speedup);
+#endif
+    bench_rows_printed++;
+}
+
+static void bench_op(const struct bench_op_t *op, struct onnx_node_t *node, void **buf)
+{
+    int esize = onnx_tensor_type_sizeof(op->type);
+    struct onnx_tensor_t *a = node->inputs[0];
+    struct onnx_tensor_t *b = node->inputs[1];
+    struct onnx_tensor_t *y = node->outputs[0];
+    int nshape;
+    char shape[32];
+
+    switch (op->kind) {
+        case BENCH_UNARY:
+        case BENCH_BINARY:
+            nshape = sizeof(bench_lengths) / sizeof(bench_lengths[0]);
+            break;
+        case BENCH_ROWS:
+        case BENCH_NORM:
+            nshape = sizeof(bench_rows) / sizeof(bench_rows[0]);
+            break;
+        default:
+            nshape = sizeof(bench_matmul) / sizeof(bench_matmul[0]);
+            break;
+    }
+
+    node->priv = op->param ? op->param() : NULL;
+    for (int s = 0; s < nshape; s++) {
+        size_t bytes;
+        node->ninput = 1;
+        if (op->kind == BENCH_UNARY || op->kind == BENCH_BINARY) {
+            int len = bench_lengths[s];
+            if (len > ONNX_BENCH_MAX_ELEMS) {
+                continue;
+            }
+            bench_tensor(a, op->type, buf[0], 1, len, 1);
+            bench_tensor(b, op->type, buf[1], 1, len, 1);
+            bench_tensor(y, op->type, buf[2], 1, len, 1);
+            node->ninput = op->kind == BENCH_BINARY ? 2 : 1;
+            snprintf(shape, sizeof(shape), "%d", len);
+        } else if (op->kind == BENCH_ROWS || op->kind == BENCH_NORM) {
+            int rows = bench_rows[s][0], cols = bench_rows[s][1];
+            if (rows * cols > ONNX_BENCH_MAX_ELEMS) {
+                continue;
+            }
+            int d0 = op->kind == BENCH_ROWS ? cols : rows;
+            int d1 = op->kind == BENCH_ROWS ? rows : cols;
+            bench_tensor(a, op->type, buf[0], 2, d0, d1);
+            bench_tensor(y, op->type, buf[2], 2, d0, d1);
+            snprintf(shape, sizeof(shape), "%dx%d", rows, cols);
+        } else {
+            int m = bench_matmul[s][0], k = bench_matmul[s][1], n = bench_matmul[s][2];
+            if (m * k > ONNX_BENCH_MAX_ELEMS || k * n > ONNX_BENCH_MAX_ELEMS || m * n > ONNX_BENCH_MAX_ELEMS) {
+                continue;
+            }
+            bench_tensor(a, op->type, buf[0], 2, k, m);
+            bench_tensor(b, op->type, buf[1], 2, n, k);
+            bench_tensor(y, op->type, buf[2], 2, n, m);
+            node->ninput = 2;
+            snprintf(shape, sizeof(shape), "%dx%dx%d", m, k, n);
+        }
+        bench_fill(a);
+        bench_fill(b);
+        bytes = (a->ndata + (node->ninput > 1 ? b->ndata : 0) + y->ndata) * esize;
+
+        uint64_t ref = bench_run(op->ref, node);
+        uint64_t rvv = bench_run(op->rvv, node);
+        bench_report(op, shape, y->ndata, bytes, ref, rvv);
+    }
+    if (op->free_param) {
+        op->free_param(&node->priv);
+    }
+    node->priv = NULL;
+}
+
+int test_bench(void)
+{
+    struct onnx_node_t node;
+    struct onnx_tensor_t tensors[3];
+    struct onnx_tensor_t *inputs[2] = {&tensors[0], &tensors[1]};
+    struct onnx_tensor_t *outputs[1] = {&tensors[2]};
+    int dims[3][2];
+    void *buf[3];
+
+    for (int i = 0; i < 3; i++) {
+        tensors[i].dims = dims[i];
+        buf[i] = MALLOC_ASSERT(ONNX_BENCH_MAX_ELEMS * sizeof(float32_t));
+    }
+    node.inputs = inputs;
+    node.outputs = outputs;
+    node.noutput = 1;
+
+#if defined(ONNX_BENCH_JSON)
+    printf("[\n");
+#else
+    printf("BENCH, op, type, shape, elems, ref_cycles, rvv_cycles, ref_cycles/elem, rvv_cycles/elem, rvv_bytes/cycle, speedup\n");
+#endif
+    for (int i = 0; i < sizeof(bench_ops) / sizeof(bench_ops[0]); i++) {
+        bench_op(&bench_ops[i], &node, buf);
+    }
+#if defined(ONNX_BENCH_JSON)
+    printf("]\n");
+#endif
+
+    for (int i = 0; i < 3; i++) {
+        free(buf[i]);
+    }
+    return 0;
+}
@@ -7,7 +7,7 @@ BENCH_DECLARE_VAR()
 #define IN_SZ (8)
 #define OUT_SZ (8)
 
-int test_convinteger(void)
+static int test_convinteger_winograd(void)
 {
     struct onnx_node_t *node;
     int ret = 0;
@@ -118,7 +118,7 @@ int test_convinteger(void)
     node->outputs[0] = output_rvv;
     node->priv = GenerateConvIntegerParam(0, 0, 1, 1, 1, 1, 1, 1, -128, 127, input, filter, output_rvv, 1);
 
-    // run rvv test
+    // run rvv test, the filter is transformed by GenerateConvIntegerParam
     BENCH_START(ConvInteger_int8_rvv);
     ConvInteger_rvv(node);
     BENCH_END(ConvInteger_int8_rvv);
@@ -127,6 +127,27 @@ int test_convinteger(void)
     // verify result
     ret |= verify_results_int8(output_ref->datas, output_rvv->datas, node->outputs[0]->ndata);
 
+    // filter bound after GenerateConvIntegerParam, transformed by the first call
+    void *filter_datas = filter->datas;
+    filter->datas = NULL;
+    node->priv = GenerateConvIntegerParam(0, 0, 1, 1, 1, 1, 1, 1, -128, 127, input, filter, output_rvv, 1);
+    filter->datas = filter_datas;
+    memset(output_rvv->datas, 0, sizeof(int8_t) * output_rvv->ndata);
+    BENCH_START(ConvInteger_int8_rvv_with_kernel_transform);
+    ConvInteger_rvv(node);
+    BENCH_END(ConvInteger_int8_rvv_with_kernel_transform);
+    FreeConvIntegerParam(&node->priv);
+    ret |= verify_results_int8(output_ref->datas, output_rvv->datas, node->outputs[0]->ndata);
+
+    // AUTO takes F(2x2,3x3) for 96 full range channels, the sums of random data are far from the overflow of F(4x4,3x3)
+    node->priv = GenerateConvIntegerParamAlgo(0, 0, 1, 1, 1, 1, 1, 1, -128, 127, input, filter, output_rvv, 1, CONV_INTEGER_ALGO_WINOGRAD43);
+    memset(output_rvv->datas, 0, sizeof(int8_t) * output_rvv->ndata);
+    BENCH_START(ConvInteger_int8_rvv_winograd43);
+    ConvInteger_rvv(node);
+    BENCH_END(ConvInteger_int8_rvv_winograd43);
+    FreeConvIntegerParam(&node->priv);
+    ret |= verify_results_int8(output_ref->datas, output_rvv->datas, node->outputs[0]->ndata);
+
     free(input->datas);
     free(filter->datas);
     free(bias->datas);
@@ -153,4 +174,274 @@ int test_convinteger(void)
     free(node);
 
     return ret;
-}
\ No newline at end of file
+}
+
+// kernel size, stride, dilation and groups not handled by the winograd kernel, forced algorithms of 3x3 layers and fused epilogues
+struct convinteger_case_t {
+    const char *name;
+    int in_ch, out_ch, in_w, in_h;
+    int kernel_w, kernel_h, stride, dilation, pad, groups;
+    enum conv_integer_algo_t algo;
+    enum onnx_activation_t activation;
+    int residual;
+};
+
+static const struct convinteger_case_t convinteger_cases[] = {
+    {"1x1", 32, 48, 8, 8, 1, 1, 1, 1, 0, 1},
+    {"1x1_expand", 24, 96, 7, 5, 1, 1, 1, 1, 0, 1},
+    {"1x1_stride2", 32, 16, 9, 9, 1, 1, 2, 1, 0, 1},
+    {"5x5_stride2", 16, 24, 11, 9, 5, 5, 2, 1, 2, 1},
+    {"3x3_stride2", 24, 20, 9, 9, 3, 3, 2, 1, 1, 1},
+    {"3x3_dilation2", 8, 16, 10, 10, 3, 3, 1, 2, 2, 1},
+    {"3x3_group4", 16, 32, 8, 8, 3, 3, 1, 1, 1, 4},
+    {"3x3_depthwise", 16, 16, 8, 8, 3, 3, 1, 1, 1, 16},
+    {"3x3_depthwise_stride2", 40, 40, 9, 9, 3, 3, 2, 1, 1, 40},
+    {"5x5_depthwise", 24, 24, 7, 7, 5, 5, 1, 1, 2, 24},
+    {"3x3_single_channel", 1, 1, 8, 8, 3, 3, 1, 1, 1, 1},
+    {"3x3_single_channel_winograd23", 1, 1, 7, 9, 3, 3, 1, 1, 1, 1, CONV_INTEGER_ALGO_WINOGRAD23},
+    {"3x3_winograd43", 16, 24, 14, 14, 3, 3, 1, 1, 1, 1, CONV_INTEGER_ALGO_WINOGRAD43},
+    {"3x3_winograd43_nopad", 8, 16, 10, 10, 3, 3, 1, 1, 0, 1, CONV_INTEGER_ALGO_WINOGRAD43},
+    {"3x3_im2col", 8, 16, 9, 9, 3, 3, 1, 1, 1, 1, CONV_INTEGER_ALGO_IM2COL},
+    {"3x3_winograd23", 16, 24, 12, 12, 3, 3, 1, 1, 1, 1, CONV_INTEGER_ALGO_WINOGRAD23},
+    {"3x3_winograd23_odd", 8, 20, 9, 7, 3, 3, 1, 1, 0, 1, CONV_INTEGER_ALGO_WINOGRAD23},
+    {"1x1_residual_relu", 32, 48, 8, 8, 1, 1, 1, 1, 0, 1, CONV_INTEGER_ALGO_AUTO, ONNX_ACTIVATION_RELU, 1},
+    {"3x3_stride2_residual_clamp", 24, 20, 9, 9, 3, 3, 2, 1, 1, 1, CONV_INTEGER_ALGO_AUTO, ONNX_ACTIVATION_CLAMP, 1},
+    {"3x3_depthwise_silu", 16, 16, 8, 8, 3, 3, 1, 1, 1, 16, CONV_INTEGER_ALGO_AUTO, ONNX_ACTIVATION_SILU, 0},
+    {"3x3_im2col_relu6", 8, 16, 9, 9, 3, 3, 1, 1, 1, 1, CONV_INTEGER_ALGO_IM2COL, ONNX_ACTIVATION_RELU6, 0},
+    {"3x3_winograd43_residual_silu", 16, 24, 14, 14, 3, 3, 1, 1, 1, 1, CONV_INTEGER_ALGO_WINOGRAD43, ONNX_ACTIVATION_SILU, 1},
+};
+
+static struct onnx_tensor_t *convinteger_tensor(enum onnx_tensor_type_t type, int d0, int d1, int d2, int d3, int ndim, int lo, int hi)
+{
+    int dims[4] = {d0, d1, d2, d3};
+    struct onnx_tensor_t *t = onnx_tensor_alloc(type, dims, ndim);
+    for (int i = 0; i < t->ndata; i++) {
+        int v = lo + rand() % (hi - lo + 1);
+        if (type == ONNX_TENSOR_TYPE_INT8) {
+            ((int8_t *)t->datas)[i] = v;
+        } else {
+            ((int32_t *)t->datas)[i] = v;
+        }
+    }
+    return t;
+}
+
+static int test_convinteger_case(const struct convinteger_case_t *c)
+{
+    const int out_w = (c->in_w + 2 * c->pad - c->dilation * (c->kernel_w - 1) - 1) / c->stride + 1;
+    const int out_h = (c->in_h + 2 * c->pad - c->dilation * (c->kernel_h - 1) - 1) / c->stride + 1;
+    struct onnx_tensor_t *inputs[5], *outputs[1];
+    struct onnx_tensor_t *output_ref, *output_rvv, *residual;
+    struct onnx_node_t node;
+    int ret = 0;
+
+    inputs[0] = convinteger_tensor(ONNX_TENSOR_TYPE_INT8, c->in_ch, c->in_w, c->in_h, 1, 4, -128, 127);
+    inputs[1] = convinteger_tensor(ONNX_TENSOR_TYPE_INT8, c->in_ch / c->groups, c->kernel_w, c->kernel_h, c->out_ch, 4, -128, 127);
+    inputs[2] = convinteger_tensor(ONNX_TENSOR_TYPE_INT32, c->out_ch, 1, 1, 1, 1, -1000, 1000);
+    inputs[3] = convinteger_tensor(ONNX_TENSOR_TYPE_INT32, c->out_ch, 1, 1, 1, 1, 0x20000000, 0x7fffffff);
+    inputs[4] = convinteger_tensor(ONNX_TENSOR_TYPE_INT32, c->out_ch, 1, 1, 1, 1, -9, 1);
+    output_ref = convinteger_tensor(ONNX_TENSOR_TYPE_INT8, c->out_ch, out_w, out_h, 1, 4, 0, 0);
+    output_rvv = convinteger_tensor(ONNX_TENSOR_TYPE_INT8, c->out_ch, out_w, out_h, 1, 4, 0, 0);
+    residual = convinteger_tensor(ONNX_TENSOR_TYPE_INT8, c->out_ch, out_w, out_h, 1, 4, -128, 127);
+    const struct onnx_epilogue_t epilogue = {c->activation, -1.0f, 2.0f, c->residual ? residual : NULL, 0.08f, 3, 0.05f};
+    node.inputs = inputs;
+    node.ninput = 5;
+    node.outputs = outputs;
+    node.noutput = 1;
+
+    for (int rvv = 0; rvv < 2; rvv++) {
+        struct onnx_tensor_t *output = rvv ? output_rvv : output_ref;
+        node.outputs[0] = output;
+        node.priv = GenerateConvIntegerParamAlgo(7, -5, c->stride, c->stride, c->dilation, c->dilation, c->pad, c->pad, -100, 110, inputs[0],
+                                                 inputs[1], output, rvv, c->algo);
+        if (c->activation != ONNX_ACTIVATION_NONE || c->residual) {
+            // the epilogue replaces the previous one instead of narrowing it further
+            const struct onnx_epilogue_t narrow = {ONNX_ACTIVATION_CLAMP, 0.0f, 0.1f, NULL, 0.0f, 0, 0.05f};
+            if (rvv) {
+                ret |= SetConvIntegerEpilogue(node.priv, &narrow) != 0;
+            }
+            ret |= SetConvIntegerEpilogue(node.priv, &epilogue) != 0;
+        }
+        BENCH_START(ConvInteger_int8_case);
+        ret |= rvv ? ConvInteger_rvv(&node) : ConvInteger(&node);
+        BENCH_SAMPLE(ConvInteger_int8_case);
+        printf("CSV, ConvInteger_int8%s_%s, %lu\r\n", rvv ? "_rvv" : "", c->name, (unsigned long)BENCH_GET_USECYC());
+        FreeConvIntegerParam(&node.priv);
+    }
+    // every algorithm requantizes the exact sum like requantize()
+    if (memcmp(output_ref->datas, output_rvv->datas, output_rvv->ndata) != 0) {
+        verify_results_int8(output_ref->datas, output_rvv->datas, output_rvv->ndata);
+        printf("ConvInteger %s mismatch\r\n", c->name);
+        ret = 1;
+    }
+    for (int i = 0; i < output_ref->ndata; i++) {
+        // relu bounds the output by its zero point -5
+        if ((c->activation == ONNX_ACTIVATION_RELU || c->activation == ONNX_ACTIVATION_RELU6) && ((int8_t *)output_ref->datas)[i] < -5) {
+            printf("ConvInteger %s below the relu bound\r\n", c->name);
+            ret = 1;
+            break;
+        }
+    }
+
+    onnx_tensor_free(residual);
+    onnx_tensor_free(output_ref);
+    onnx_tensor_free(output_rvv);
+    for (int i = 4; i >= 0; i--) {
+        onnx_tensor_free(inputs[i]);
+    }
+    return ret;
+}
+
+// the image of a case pushed in bands of 1, 3 and 2 rows against ConvInteger on the whole image, two images per stream
+static int test_convinteger_stream_case(const struct convinteger_case_t *c)
+{
+    static const int bands[3] = {1, 3, 2};
+    const int out_w = (c->in_w + 2 * c->pad - c->dilation * (c->kernel_w - 1) - 1) / c->stride + 1;
+    const int out_h = (c->in_h + 2 * c->pad - c->dilation * (c->kernel_h - 1) - 1) / c->stride + 1;
+    const int in_row = c->in_w * c->in_ch;
+    const int out_row = out_w * c->out_ch;
+    struct onnx_tensor_t *inputs[5], *outputs[1];
+    struct onnx_tensor_t *input, *output_ref, *output_stream;
+    struct onnx_tensor_t band, rows;
+    struct onnx_node_t node;
+    int ret = 0;
+
+    inputs[0] = convinteger_tensor(ONNX_TENSOR_TYPE_INT8, c->in_ch, c->in_w, c->in_h, 1, 4, -128, 127);
+    inputs[1] = convinteger_tensor(ONNX_TENSOR_TYPE_INT8, c->in_ch / c->groups, c->kernel_w, c->kernel_h, c->out_ch, 4, -128, 127);
+    inputs[2] = convinteger_tensor(ONNX_TENSOR_TYPE_INT32, c->out_ch, 1, 1, 1, 1, -1000, 1000);
+    inputs[3] = convinteger_tensor(ONNX_TENSOR_TYPE_INT32, c->out_ch, 1, 1, 1, 1, 0x20000000, 0x7fffffff);
+    inputs[4] = convinteger_tensor(ONNX_TENSOR_TYPE_INT32, c->out_ch, 1, 1, 1, 1, -9, 1);
+    output_ref = convinteger_tensor(ONNX_TENSOR_TYPE_INT8, c->out_ch, out_w, out_h, 1, 4, 0, 0);
+    output_stream = convinteger_tensor(ONNX_TENSOR_TYPE_INT8, c->out_ch, out_w, out_h, 1, 4, 0, 0);
+    node.inputs = inputs;
+    node.ninput = 5;
+    node.outputs = outputs;
+    node.noutput = 1;
+
+    node.outputs[0] = output_ref;
+    node.priv = GenerateConvIntegerParam(7, -5, c->stride, c->stride, c->dilation, c->dilation, c->pad, c->pad, -100, 110, inputs[0], inputs[1],
+                                         output_ref, 0);
+    ret |= ConvInteger(&node);
+    FreeConvIntegerParam(&node.priv);
+
+    input = inputs[0];
+    band = *input;
+    rows = *output_stream;
+    node.inputs[0] = &band;
+    node.outputs[0] = &rows;
+    for (int rvv = 0; rvv < 2; rvv++) {
+        node.priv = GenerateConvIntegerStreamParam(7, -5, c->stride, c->stride, c->dilation, c->dilation, c->pad, c->pad, -100, 110, input,
+                                                   inputs[1], output_stream, rvv);
+        for (int image = 0; image < 2; image++) {
+            int32_t written = 0;
+            memset(output_stream->datas, 0, output_stream->ndata);
+            BENCH_START(ConvIntegerStream_int8_case);
+            for (int y = 0, k = 0; y < c->in_h; y += band.ndata / in_row, k++) {
+                band.datas = (int8_t *)input->datas + y * in_row;
+                band.ndata = MIN(bands[k % 3], c->in_h - y) * in_row;
+                rows.datas = (int8_t *)output_stream->datas + written * out_row;
+                rows.ndata = (out_h - written) * out_row;
+                int32_t count;
+                if (ConvIntegerStream(&node, &count) != 0) {
+                    ret = 1;
+                    break;
+                }
+                written += count;
+            }
+            BENCH_SAMPLE(ConvIntegerStream_int8_case);
+            if (written != out_h || verify_results_int8(output_ref->datas, output_stream->datas, output_stream->ndata)) {
+                printf("ConvIntegerStream %s%s image %d mismatch, %d of %d rows\r\n", c->name, rvv ? " rvv" : "", image, written, out_h);
+                ret = 1;
+            }
+        }
+        printf("CSV, ConvIntegerStream_int8%s_%s, %lu\r\n", rvv ? "_rvv" : "", c->name, (unsigned long)BENCH_GET_USECYC());
+        FreeConvIntegerStreamParam(&node.priv);
+    }
+    inputs[0] = input;
+
+    onnx_tensor_free(output_ref);
+    onnx_tensor_free(output_stream);
+    for (int i = 4; i >= 0; i--) {
+        onnx_tensor_free(inputs[i]);
+    }
+    return ret;
+}
+
+/*
+ * Sums far beyond what 576 times fits into int32, F(4x4,3x3) sums chunks of
+ * input channels: 32 channels at -128 in one chunk, 300 channels near the
+ * largest input magnitude of offset 127 in three, with AUTO and forced.
+ */
+struct convinteger_overflow_case_t {
+    int in_ch, in_offset;
+    int in_lo, in_hi, shift;
+    enum conv_integer_algo_t algo;
+};
+
+static const struct convinteger_overflow_case_t convinteger_overflow_cases[] = {
+    {32, 0, -128, -128, -17, CONV_INTEGER_ALGO_AUTO},
+    {32, 0, -128, -128, -17, CONV_INTEGER_ALGO_WINOGRAD43},
+    {300, 127, 100, 127, -21, CONV_INTEGER_ALGO_AUTO},
+    {300, 127, 100, 127, -21, CONV_INTEGER_ALGO_WINOGRAD43},
+};
+
+static int test_convinteger_winograd_overflow(const struct convinteger_overflow_case_t *c)
+{
+    const int out_ch = 16, size = 8;
+    struct onnx_tensor_t *inputs[5], *outputs[1];
+    struct onnx_tensor_t *output_ref, *output_rvv;
+    struct onnx_node_t node;
+    int ret = 0;
+
+    inputs[0] = convinteger_tensor(ONNX_TENSOR_TYPE_INT8, c->in_ch, size, size, 1, 4, c->in_lo, c->in_hi);
+    inputs[1] = convinteger_tensor(ONNX_TENSOR_TYPE_INT8, c->in_ch, 3, 3, out_ch, 4, -128, -100);
+    inputs[2] = convinteger_tensor(ONNX_TENSOR_TYPE_INT32, out_ch, 1, 1, 1, 1, -1000, 1000);
+    inputs[3] = convinteger_tensor(ONNX_TENSOR_TYPE_INT32, out_ch, 1, 1, 1, 1, 0x40000000, 0x7fffffff);
+    inputs[4] = convinteger_tensor(ONNX_TENSOR_TYPE_INT32, out_ch, 1, 1, 1, 1, c->shift, c->shift + 1);
+    output_ref = convinteger_tensor(ONNX_TENSOR_TYPE_INT8, out_ch, size, size, 1, 4, 0, 0);
+    output_rvv = convinteger_tensor(ONNX_TENSOR_TYPE_INT8, out_ch, size, size, 1, 4, 0, 0);
+    node.inputs = inputs;
+    node.ninput = 5;
+    node.outputs = outputs;
+    node.noutput = 1;
+
+    for (int rvv = 0; rvv < 2; rvv++) {
+        node.outputs[0] = rvv ? output_rvv : output_ref;
+        node.priv = GenerateConvIntegerParamAlgo(c->in_offset, 0, 1, 1, 1, 1, 1, 1, -128, 127, inputs[0], inputs[1], node.outputs[0], rvv,
+                                                 c->algo);
+        ret |= rvv ? ConvInteger_rvv(&node) : ConvInteger(&node);
+        FreeConvIntegerParam(&node.priv);
+    }
+    if (memcmp(output_ref->datas, output_rvv->datas, output_rvv->ndata) != 0) {
+        verify_results_int8(output_ref->datas, output_rvv->datas, output_rvv->ndata);
+        printf("ConvInteger winograd overflow %d channels algo %d mismatch\r\n", c->in_ch, c->algo);
+        ret = 1;
+    }
+
+    onnx_tensor_free(output_ref);
+    onnx_tensor_free(output_rvv);
+    for (int i = 4; i >= 0; i--) {
+        onnx_tensor_free(inputs[i]);
+    }
+    return ret;
+}
+
+int test_convinteger(void)
+{
+    int ret = test_convinteger_winograd();
+
+    for (int i = 0; i < sizeof(convinteger_overflow_cases) / sizeof(convinteger_overflow_cases[0]); i++) {
+        ret |= test_convinteger_winograd_overflow(&convinteger_overflow_cases[i]);
+    }
+
+    for (int i = 0; i < sizeof(convinteger_cases) / sizeof(convinteger_cases[0]); i++) {
+        ret |= test_convinteger_case(&convinteger_cases[i]);
+    }
+    for (int i = 0; i < sizeof(convinteger_cases) / sizeof(convinteger_cases[0]); i++) {
+        // the epilogue is not part of the stream
+        if (convinteger_cases[i].activation == ONNX_ACTIVATION_NONE && !convinteger_cases[i].residual) {
+            ret |= test_convinteger_stream_case(&convinteger_cases[i]);
+        }
+    }
+    return ret;
+}
@@ -0,0 +1,235 @@
+#include "utils.h"
+
+BENCH_DECLARE_VAR()
+
+// strides with taps of uneven count per phase, padding, output_padding, dilation and groups
+struct conv_transpose_case_t {
+    const char *name;
+    int in_ch, out_ch, in_w, in_h;
+    int kernel, stride, dilation, pad, output_padding, groups;
+};
+
+static const struct conv_transpose_case_t conv_transpose_cases[] = {
+    {"2x2_stride2", 32, 16, 6, 5, 2, 2, 1, 0, 0, 1},
+    {"3x3_stride1_pad1", 16, 24, 7, 7, 3, 1, 1, 1, 0, 1},
+    {"3x3_stride2_pad1_outpad1", 24, 20, 5, 6, 3, 2, 1, 1, 1, 1},
+    {"4x4_stride2_pad1", 16, 40, 6, 6, 4, 2, 1, 1, 0, 1},
+    {"5x5_stride3_pad2_outpad2", 8, 12, 4, 5, 5, 3, 1, 2, 2, 1},
+    {"3x3_stride2_dilation2", 12, 8, 5, 5, 3, 2, 2, 1, 1, 1},
+    {"3x3_stride2_group4", 16, 32, 5, 5, 3, 2, 1, 1, 1, 4},
+};
+
+static int conv_transpose_output_size(const struct conv_transpose_case_t *c, int input)
+{
+    return (input - 1) * c->stride - 2 * c->pad + c->dilation * (c->kernel - 1) + c->output_padding + 1;
+}
+
+static struct onnx_tensor_t *conv_transpose_tensor(enum onnx_tensor_type_t type, int d0, int d1, int d2, int d3, int ndim, int range)
+{
+    int dims[4] = {d0, d1, d2, d3};
+    struct onnx_tensor_t *t = onnx_tensor_alloc(type, dims, ndim);
+    for (int i = 0; i < t->ndata; i++) {
+        const int v = range ? rand() % (2 * range + 1) - range : 0;
+        if (type == ONNX_TENSOR_TYPE_INT8) {
+            ((int8_t *)t->datas)[i] = (int8_t)v;
+        } else if (type == ONNX_TENSOR_TYPE_INT32) {
+            ((int32_t *)t->datas)[i] = v;
+        } else {
+            ((float16_t *)t->datas)[i] = (float16_t)(v / 16.0f);
+        }
+    }
+    return t;
+}
+
+/*
+ * Scatters every input pixel into the output in float32, the definition of
+ * ConvTranspose. in_offset is added to int8 inputs.
+ */
+static float32_t *conv_transpose_scatter(const struct conv_transpose_case_t *c, const struct onnx_tensor_t *x, const struct onnx_tensor_t *w,
+                                         const struct onnx_tensor_t *b, int out_w, int out_h, int in_offset)
+{
+    const int in_ch = c->in_ch / c->groups;
+    const int out_ch = c->out_ch / c->groups;
+    const _Bool quantized = x->type == ONNX_TENSOR_TYPE_INT8;
+    float32_t *y = (float32_t *)MALLOC_ASSERT(out_w * out_h * c->out_ch * sizeof(float32_t));
+
+    for (int i = 0; i < out_w * out_h; i++) {
+        for (int oc = 0; oc < c->out_ch; oc++) {
+            y[i * c->out_ch + oc] = quantized ? ((int32_t *)b->datas)[oc] : (float32_t)((float16_t *)b->datas)[oc];
+        }
+    }
+    for (int iy = 0; iy < c->in_h; iy++) {
+        for (int ix = 0; ix < c->in_w; ix++) {
+            for (int ic = 0; ic < c->in_ch; ic++) {
+                const int idx = (iy * c->in_w + ix) * c->in_ch + ic;
+                const float32_t v = quantized ? ((int8_t *)x->datas)[idx] + in_offset : (float32_t)((float16_t *)x->datas)[idx];
+                const int g = ic / in_ch;
+                for (int ky = 0; ky < c->kernel; ky++) {
+                    const int oy = iy * c->stride - c->pad + ky * c->dilation;
+                    for (int kx = 0; kx < c->kernel; kx++) {
+                        const int ox = ix * c->stride - c->pad + kx * c->dilation;
+                        if (oy < 0 || oy >= out_h || ox < 0 || ox >= out_w) {
+                            continue;
+                        }
+                        for (int oc = 0; oc < out_ch; oc++) {
+                            const int widx = ((ic * c->kernel + ky) * c->kernel + kx) * out_ch + oc;
+                            const float32_t k = quantized ? ((int8_t *)w->datas)[widx] : (float32_t)((float16_t *)w->datas)[widx];
+                            y[(oy * out_w + ox) * c->out_ch + g * out_ch + oc] += v * k;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return y;
+}
+
+static int test_convtranspose_int8_case(const struct conv_transpose_case_t *c)
+{
+    const int out_w = conv_transpose_output_size(c, c->in_w);
+    const int out_h = conv_transpose_output_size(c, c->in_h);
+    const int in_offset = 3, out_offset = -5;
+    struct onnx_tensor_t *inputs[5], *outputs[1];
+    struct onnx_tensor_t *output_ref, *output_rvv;
+    struct onnx_node_t node;
+    int ret = 0;
+
+    inputs[0] = conv_transpose_tensor(ONNX_TENSOR_TYPE_INT8, c->in_ch, c->in_w, c->in_h, 1, 4, 4);
+    inputs[1] = conv_transpose_tensor(ONNX_TENSOR_TYPE_INT8, c->out_ch / c->groups, c->kernel, c->kernel, c->in_ch, 4, 3);
+    inputs[2] = conv_transpose_tensor(ONNX_TENSOR_TYPE_INT32, c->out_ch, 1, 1, 1, 1, 40);
+    inputs[3] = conv_transpose_tensor(ONNX_TENSOR_TYPE_INT32, c->out_ch, 1, 1, 1, 1, 0);
+    inputs[4] = conv_transpose_tensor(ONNX_TENSOR_TYPE_INT32, c->out_ch, 1, 1, 1, 1, 0);
+    output_ref = conv_transpose_tensor(ONNX_TENSOR_TYPE_INT8, c->out_ch, out_w, out_h, 1, 4, 0);
+    output_rvv = conv_transpose_tensor(ONNX_TENSOR_TYPE_INT8, c->out_ch, out_w, out_h, 1, 4, 0);
+    node.inputs = inputs;
+    node.ninput = 5;
+    node.outputs = outputs;
+    node.noutput = 1;
+
+    // identity requantization first, so the output is the clamped accumulator, then scales with rounding
+    for (int quant = 0; quant < 2; quant++) {
+        for (int oc = 0; oc < c->out_ch; oc++) {
+            ((int32_t *)inputs[3]->datas)[oc] = quant ? 0x40000000 + rand() % 0x3fffffff : 0x40000000;
+            ((int32_t *)inputs[4]->datas)[oc] = quant ? rand() % 3 - 2 : 1;
+        }
+        for (int rvv = 0; rvv < 2; rvv++) {
+            struct onnx_tensor_t *output = rvv ? output_rvv : output_ref;
+            node.outputs[0] = output;
+            node.priv = GenerateConvTransposeIntegerParam(in_offset, out_offset, c->stride, c->stride, c->dilation, c->dilation, c->pad, c->pad,
+                                                          c->output_padding, c->output_padding, -128, 127, inputs[0], inputs[1], output, rvv);
+            BENCH_START(ConvTranspose_case);
+            if ((rvv ? ConvTransposeInteger_rvv(&node) : ConvTransposeInteger(&node)) != 0) {
+                printf("ConvTranspose int8 %s failed\r\n", c->name);
+                ret = 1;
+            }
+            BENCH_SAMPLE(ConvTranspose_case);
+            printf("CSV, ConvTranspose_int8%s_%s, %lu\r\n", rvv ? "_rvv" : "", c->name, (unsigned long)BENCH_GET_USECYC());
+            FreeConvTransposeParam(&node.priv);
+        }
+        // same accumulation and rounding, both kernels are exact
+        if (memcmp(output_ref->datas, output_rvv->datas, output_rvv->ndata) != 0) {
+            verify_results_int8(output_ref->datas, output_rvv->datas, output_rvv->ndata);
+            printf("ConvTranspose int8 %s mismatch\r\n", c->name);
+            ret = 1;
+        }
+        if (quant == 0) {
+            float32_t *y = conv_transpose_scatter(c, inputs[0], inputs[1], inputs[2], out_w, out_h, in_offset);
+            for (int i = 0; i < output_ref->ndata; i++) {
+                const int32_t ref = MIN(MAX((int32_t)y[i] + out_offset, -128), 127);
+                if (((int8_t *)output_ref->datas)[i] != ref) {
+                    printf("ConvTranspose int8 %s differs from the scatter at %d, expected %d, actual %d\r\n", c->name, i, ref,
+                           ((int8_t *)output_ref->datas)[i]);
+                    ret = 1;
+                    break;
+                }
+            }
+            free(y);
+        }
+    }
+
+    onnx_tensor_free(output_rvv);
+    onnx_tensor_free(output_ref);
+    for (int i = 4; i >= 0; i--) {
+        onnx_tensor_free(inputs[i]);
+    }
+    return ret;
+}
+
+static int test_convtranspose_float16_case(const struct conv_transpose_case_t *c)
+{
+    const int out_w = conv_transpose_output_size(c, c->in_w);
+    const int out_h = conv_transpose_output_size(c, c->in_h);
+    struct onnx_tensor_t *inputs[3], *outputs[1];
+    struct onnx_tensor_t *output_ref, *output_rvv, *scatter;
+    struct onnx_node_t node;
+    int ret = 0;
+
+    inputs[0] = conv_transpose_tensor(ONNX_TENSOR_TYPE_FLOAT16, c->in_ch, c->in_w, c->in_h, 1, 4, 16);
+    inputs[1] = conv_transpose_tensor(ONNX_TENSOR_TYPE_FLOAT16, c->out_ch / c->groups, c->kernel, c->kernel, c->in_ch, 4, 4);
+    inputs[2] = conv_transpose_tensor(ONNX_TENSOR_TYPE_FLOAT16, c->out_ch, 1, 1, 1, 1, 16);
+    output_ref = conv_transpose_tensor(ONNX_TENSOR_TYPE_FLOAT16, c->out_ch, out_w, out_h, 1, 4, 0);
+    output_rvv = conv_transpose_tensor(ONNX_TENSOR_TYPE_FLOAT16, c->out_ch, out_w, out_h, 1, 4, 0);
+    scatter = conv_transpose_tensor(ONNX_TENSOR_TYPE_FLOAT16, c->out_ch, out_w, out_h, 1, 4, 0);
+    node.inputs = inputs;
+    node.ninput = 3;
+    node.outputs = outputs;
+    node.noutput = 1;
+
+    for (int rvv = 0; rvv < 2; rvv++) {
+        struct onnx_tensor_t *output = rvv ? output_rvv : output_ref;
+        node.outputs[0] = output;
+        node.priv = GenerateConvTransposeParam(c->stride, c->stride, c->dilation, c->dilation, c->pad, c->pad, c->output_padding, c->output_padding,
+                                               inputs[0], inputs[1], output, rvv);
+        BENCH_START(ConvTranspose_case);
+        if ((rvv ? ConvTranspose_float16_rvv(&node) : ConvTranspose_float16(&node)) != 0) {
+            printf("ConvTranspose float16 %s failed\r\n", c->name);
+            ret = 1;
+        }
+        BENCH_SAMPLE(ConvTranspose_case);
+        printf("CSV, ConvTranspose_float16%s_%s, %lu\r\n", rvv ? "_rvv" : "", c->name, (unsigned long)BENCH_GET_USECYC());
+        FreeConvTransposeParam(&node.priv);
+    }
+    // an output one column wider than the parameters is rejected
+    struct onnx_tensor_t *wide = conv_transpose_tensor(ONNX_TENSOR_TYPE_FLOAT16, c->out_ch, out_w + 1, out_h, 1, 4, 0);
+    for (int rvv = 0; rvv < 2; rvv++) {
+        node.outputs[0] = rvv ? output_rvv : output_ref;
+        node.priv = GenerateConvTransposeParam(c->stride, c->stride, c->dilation, c->dilation, c->pad, c->pad, c->output_padding, c->output_padding,
+                                               inputs[0], inputs[1], node.outputs[0], rvv);
+        node.outputs[0] = wide;
+        if ((rvv ? ConvTranspose_float16_rvv(&node) : ConvTranspose_float16(&node)) == 0) {
+            printf("ConvTranspose float16%s %s accepts a wrong output shape\r\n", rvv ? "_rvv" : "", c->name);
+            ret = 1;
+        }
+        FreeConvTransposeParam(&node.priv);
+    }
+    onnx_tensor_free(wide);
+    float32_t *y = conv_transpose_scatter(c, inputs[0], inputs[1], inputs[2], out_w, out_h, 0);
+    for (int i = 0; i < scatter->ndata; i++) {
+        ((float16_t *)scatter->datas)[i] = (float16_t)y[i];
+    }
+    free(y);
+    if (verify_results_f16(scatter->datas, output_ref->datas, output_ref->ndata) ||
+        verify_results_f16(output_ref->datas, output_rvv->datas, output_rvv->ndata)) {
+        printf("ConvTranspose float16 %s mismatch\r\n", c->name);
+        ret = 1;
+    }
+
+    onnx_tensor_free(scatter);
+    onnx_tensor_free(output_rvv);
+    onnx_tensor_free(output_ref);
+    for (int i = 2; i >= 0; i--) {
+        onnx_tensor_free(inputs[i]);
+    }
+    return ret;
+}
+
+int test_convtranspose(void)
+{
+    int ret = 0;
+
+    for (int i = 0; i < sizeof(conv_transpose_cases) / sizeof(conv_transpose_cases[0]); i++) {
+        ret |= test_convtranspose_int8_case(&conv_transpose_cases[i]);
+        ret |= test_convtranspose_float16_case(&conv_transpose_cases[i]);
+    }
+    return ret;
+}
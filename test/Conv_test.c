@@ -0,0 +1,146 @@
+#include "utils.h"
+
+BENCH_DECLARE_VAR()
+
+// im2col layers of every kernel size, stride, dilation and group count, and Winograd layers with 16 or more channels, all checked against a
+// direct convolution in double
+struct conv_case_t {
+    const char *name;
+    int in_ch, out_ch, in_w, in_h;
+    int kernel_w, kernel_h, stride, dilation, pad, groups;
+    int bias;
+};
+
+static const struct conv_case_t conv_cases[] = {
+    {"1x1", 32, 48, 8, 8, 1, 1, 1, 1, 0, 1, 1},
+    {"1x1_stride2", 32, 16, 9, 9, 1, 1, 2, 1, 0, 1, 0},
+    {"3x3", 8, 20, 9, 7, 3, 3, 1, 1, 1, 1, 1},
+    {"3x3_stride2", 24, 20, 9, 9, 3, 3, 2, 1, 1, 1, 1},
+    {"3x3_dilation2", 8, 16, 10, 10, 3, 3, 1, 2, 2, 1, 0},
+    {"3x3_group4", 16, 32, 8, 8, 3, 3, 1, 1, 1, 4, 1},
+    {"5x5_stride2", 16, 24, 11, 9, 5, 5, 2, 1, 2, 1, 1},
+    {"3x3_winograd43", 16, 24, 14, 14, 3, 3, 1, 1, 1, 1, 1},
+    {"3x3_winograd43_nopad", 24, 16, 10, 11, 3, 3, 1, 1, 0, 1, 0},
+};
+
+static struct onnx_tensor_t *conv_tensor(enum onnx_tensor_type_t type, int d0, int d1, int d2, int d3, int ndim, float32_t range)
+{
+    int dims[4] = {d0, d1, d2, d3};
+    struct onnx_tensor_t *t = onnx_tensor_alloc(type, dims, ndim);
+    for (int i = 0; i < t->ndata; i++) {
+        float32_t v = range * (2.0f * rand() / RAND_MAX - 1.0f);
+        if (type == ONNX_TENSOR_TYPE_FLOAT16) {
+            ((float16_t *)t->datas)[i] = (float16_t)v;
+        } else {
+            ((float32_t *)t->datas)[i] = v;
+        }
+    }
+    return t;
+}
+
+// the direct convolution of one case in double, rounded into a tensor of the input type
+static struct onnx_tensor_t *conv_direct(const struct conv_case_t *c, const struct onnx_tensor_t *x, const struct onnx_tensor_t *w,
+                                         const struct onnx_tensor_t *b, int out_w, int out_h)
+{
+    const int in_ch = c->in_ch / c->groups;
+    const int out_ch = c->out_ch / c->groups;
+    const _Bool half = x->type == ONNX_TENSOR_TYPE_FLOAT16;
+    struct onnx_tensor_t *y = conv_tensor(x->type, c->out_ch, out_w, out_h, 1, 4, 0.0f);
+
+    for (int oy = 0; oy < out_h; oy++) {
+        for (int ox = 0; ox < out_w; ox++) {
+            for (int oc = 0; oc < c->out_ch; oc++) {
+                const int g = oc / out_ch;
+                double sum = 0;
+                if (c->bias) {
+                    sum = half ? (double)((float16_t *)b->datas)[oc] : (double)((float32_t *)b->datas)[oc];
+                }
+                for (int ky = 0; ky < c->kernel_h; ky++) {
+                    const int iy = oy * c->stride - c->pad + ky * c->dilation;
+                    for (int kx = 0; kx < c->kernel_w; kx++) {
+                        const int ix = ox * c->stride - c->pad + kx * c->dilation;
+                        if (iy < 0 || iy >= c->in_h || ix < 0 || ix >= c->in_w) {
+                            continue;
+                        }
+                        for (int ic = 0; ic < in_ch; ic++) {
+                            const int idx = (iy * c->in_w + ix) * c->in_ch + g * in_ch + ic;
+                            const int widx = ((oc * c->kernel_h + ky) * c->kernel_w + kx) * in_ch + ic;
+                            sum += half ? (double)((float16_t *)x->datas)[idx] * (double)((float16_t *)w->datas)[widx]
+                                        : (double)((float32_t *)x->datas)[idx] * (double)((float32_t *)w->datas)[widx];
+                        }
+                    }
+                }
+                const int i = (oy * out_w + ox) * c->out_ch + oc;
+                if (half) {
+                    ((float16_t *)y->datas)[i] = (float16_t)sum;
+                } else {
+                    ((float32_t *)y->datas)[i] = (float32_t)sum;
+                }
+            }
+        }
+    }
+    return y;
+}
+
+static int test_conv_case(const struct conv_case_t *c, enum onnx_tensor_type_t type)
+{
+    const int out_w = (c->in_w + 2 * c->pad - c->dilation * (c->kernel_w - 1) - 1) / c->stride + 1;
+    const int out_h = (c->in_h + 2 * c->pad - c->dilation * (c->kernel_h - 1) - 1) / c->stride + 1;
+    const _Bool half = type == ONNX_TENSOR_TYPE_FLOAT16;
+    struct onnx_tensor_t *inputs[3], *outputs[1];
+    struct onnx_tensor_t *output_ref, *output_rvv;
+    struct onnx_node_t node;
+    int ret = 0;
+
+    inputs[0] = conv_tensor(type, c->in_ch, c->in_w, c->in_h, 1, 4, 1.0f);
+    inputs[1] = conv_tensor(type, c->in_ch / c->groups, c->kernel_w, c->kernel_h, c->out_ch, 4, 0.25f);
+    inputs[2] = conv_tensor(type, c->out_ch, 1, 1, 1, 1, 1.0f);
+    output_ref = conv_tensor(type, c->out_ch, out_w, out_h, 1, 4, 0.0f);
+    output_rvv = conv_tensor(type, c->out_ch, out_w, out_h, 1, 4, 0.0f);
+    node.inputs = inputs;
+    node.ninput = c->bias ? 3 : 2;
+    node.outputs = outputs;
+    node.noutput = 1;
+
+    for (int rvv = 0; rvv < 2; rvv++) {
+        struct onnx_tensor_t *output = rvv ? output_rvv : output_ref;
+        node.outputs[0] = output;
+        node.priv = GenerateConvParam(c->stride, c->stride, c->dilation, c->dilation, c->pad, c->pad, inputs[0], inputs[1], output, rvv);
+        BENCH_START(Conv_case);
+        if (half) {
+            rvv ? Conv_float16_rvv(&node) : Conv_float16(&node);
+        } else {
+            rvv ? Conv_float32_rvv(&node) : Conv_float32(&node);
+        }
+        BENCH_SAMPLE(Conv_case);
+        printf("CSV, Conv_%s%s_%s, %lu\r\n", half ? "float16" : "float32", rvv ? "_rvv" : "", c->name, (unsigned long)BENCH_GET_USECYC());
+        FreeConvParam(&node.priv);
+    }
+    struct onnx_tensor_t *direct = conv_direct(c, inputs[0], inputs[1], inputs[2], out_w, out_h);
+    if (half ? verify_results_f16(direct->datas, output_ref->datas, output_ref->ndata) ||
+                   verify_results_f16(output_ref->datas, output_rvv->datas, output_rvv->ndata)
+             : verify_results_f32(direct->datas, output_ref->datas, output_ref->ndata) ||
+                   verify_results_f32(output_ref->datas, output_rvv->datas, output_rvv->ndata)) {
+        printf("Conv %s %s mismatch\r\n", half ? "float16" : "float32", c->name);
+        ret = 1;
+    }
+
+    onnx_tensor_free(direct);
+    onnx_tensor_free(output_rvv);
+    onnx_tensor_free(output_ref);
+    for (int i = 2; i >= 0; i--) {
+        onnx_tensor_free(inputs[i]);
+    }
+    return ret;
+}
+
+int test_conv(void)
+{
+    int ret = 0;
+
+    for (int i = 0; i < sizeof(conv_cases) / sizeof(conv_cases[0]); i++) {
+        ret |= test_conv_case(&conv_cases[i], ONNX_TENSOR_TYPE_FLOAT32);
+        ret |= test_conv_case(&conv_cases[i], ONNX_TENSOR_TYPE_FLOAT16);
+    }
+    return ret;
+}
@@ -0,0 +1,51 @@
+#include "utils.h"
+
+static int check_kernel(const char *op, enum onnx_tensor_type_t type, onnx_operator_t expected)
+{
+    onnx_operator_t k = onnx_dispatch_find(op, type);
+    if (k != expected) {
+        printf("Dispatch mismatch for %s type %d\r\n", op, type);
+        return 1;
+    }
+    return 0;
+}
+
+int test_dispatch(void)
+{
+    int ret = 0;
+
+    onnx_dispatch_init(0);
+    int has_v = (onnx_dispatch_isa() & ONNX_ISA_V) != 0;
+    printf("dispatch isa = 0x%x, vlen = %d\r\n", (unsigned)onnx_dispatch_isa(), onnx_dispatch_vlen());
+
+    ret |= check_kernel("Abs", ONNX_TENSOR_TYPE_FLOAT32, has_v ? Abs_float32_rvv : Abs_float32);
+    ret |= check_kernel("Topk", ONNX_TENSOR_TYPE_INT32, has_v ? Topk_int32_rvv : Topk_int32);
+    ret |= check_kernel("ReduceAll", ONNX_TENSOR_TYPE_BOOL, has_v ? ReduceAll_rvv : ReduceAll);
+    ret |= check_kernel("Softmax", ONNX_TENSOR_TYPE_FLOAT16,
+                        (onnx_dispatch_isa() & ONNX_ISA_ZVFH) ? Softmax_float16_rvv : Softmax_float16);
+    ret |= check_kernel("Abs", ONNX_TENSOR_TYPE_FLOAT64, NULL);
+    ret |= check_kernel("NoSuchOp", ONNX_TENSOR_TYPE_FLOAT32, NULL);
+    // every VLEN, GenerateConvIntegerParam avoids the kernel that needs 128
+    if (onnx_dispatch_find_status("ConvInteger", ONNX_TENSOR_TYPE_INT8) != (has_v ? ConvInteger_rvv : ConvInteger)) {
+        printf("Dispatch mismatch for ConvInteger\r\n");
+        ret = 1;
+    }
+
+    // VPU Lite has no vslide and segment load/store
+    onnx_dispatch_init(ONNX_ISA_VPU_LITE);
+    ret |= check_kernel("Abs", ONNX_TENSOR_TYPE_FLOAT32, has_v ? Abs_float32_rvv : Abs_float32);
+    ret |= check_kernel("Topk", ONNX_TENSOR_TYPE_INT32, Topk_int32);
+    ret |= check_kernel("ReduceProd", ONNX_TENSOR_TYPE_FLOAT32, ReduceProd_float32);
+    if (onnx_dispatch_find_status("ConvInteger", ONNX_TENSOR_TYPE_INT8) != ConvInteger) {
+        printf("Dispatch mismatch for ConvInteger on VPU Lite\r\n");
+        ret = 1;
+    }
+
+    // no vector unit at all
+    onnx_dispatch_init(ONNX_ISA_V);
+    ret |= check_kernel("MatMul", ONNX_TENSOR_TYPE_INT8, MatMul_int8);
+
+    onnx_dispatch_init(0);
+
+    return ret;
+}
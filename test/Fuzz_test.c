@@ -0,0 +1,830 @@
+/*
+ * Differential test of the rvv kernels against the scalar ones on random
+ * shapes and parameters. Dimensions are drawn uniformly or from 1, small
+ * primes and VLMAX +-1 of every LMUL, so the tails of the strip mining loops
+ * and the 4/2/1 row blocks of MatMul are hit. Case i runs seed
+ * ONNX_FUZZ_SEED + i on kernel seed % FUZZ_NOPS, so every kernel gets
+ * ONNX_FUZZ_ITERS cases. A mismatch prints the seed, build with
+ * -DONNX_FUZZ_SEED=<seed> -DONNX_FUZZ_CASES=1 to replay only that case.
+ * The quantized and pooling ops draw NHWC shapes, kernel, stride, dilation,
+ * padding, groups, zero points and requantization, ConvInteger in every
+ * algorithm of the rvv kernel.
+ */
+
+#include "utils.h"
+
+#ifndef ONNX_FUZZ_SEED
+#define ONNX_FUZZ_SEED (1)
+#endif
+#ifndef ONNX_FUZZ_ITERS
+#define ONNX_FUZZ_ITERS (64) // cases of every kernel
+#endif
+
+#define FUZZ_MAX_ELEMS (4096) // elements of every input and output buffer
+#define FUZZ_VLENB (16)       // vlenb assumed without vector unit, VLEN = 128
+
+enum fuzz_kind_t {
+    FUZZ_UNARY,
+    FUZZ_BINARY,
+    FUZZ_CLAMP,
+    FUZZ_ELU,
+    FUZZ_POW,
+    FUZZ_SOFTMAX,
+    FUZZ_NORM,
+    FUZZ_MATMUL,
+    FUZZ_PAD,
+    FUZZ_FLIP,
+    FUZZ_TILE,
+    FUZZ_SLICE,
+    FUZZ_CONCAT,
+    FUZZ_CONV_INTEGER,
+    FUZZ_MATMUL_INTEGER,
+    FUZZ_CONV_TRANSPOSE,
+    FUZZ_POOL,
+    FUZZ_GLOBAL_POOL,
+};
+
+struct fuzz_op_t {
+    const char *name;
+    enum onnx_tensor_type_t type;
+    enum fuzz_kind_t kind;
+    onnx_operator_t ref;
+    onnx_operator_t rvv;
+    float32_t lo; // input range
+    float32_t hi;
+    float32_t atol; // |ref - rvv| <= atol + rtol * |ref|, both zero for exact match
+    float32_t rtol;
+    int max_len; // longest reduction, 0 for FUZZ_MAX_ELEMS
+    int variant; // algorithm of ConvInteger, int32 output of MatMulInteger
+};
+
+// everything drawn for one case, the kernels get the same parameters
+struct fuzz_case_t {
+    int rows, cols, k;
+    int rows2, cols2; // second input of Concat
+    int axis;
+    int pads[4]; // top, bottom, left, right
+    int flip[2];
+    int repeats[2];
+    int start[2], end[2], step[2];
+    float32_t s0, s1; // Clamp min/max, Pad value, Pow exponent, Elu alpha
+};
+
+/*
+ * One case of the NHWC ops, dims[0] is the channel. MatMulInteger is
+ * [m, k] x [k, n] with m = in_h, k = in_ch and n = out_ch.
+ */
+struct fuzz_quant_t {
+    int in_ch, out_ch, in_w, in_h, out_w, out_h;
+    int kernel, stride, dilation, pad, output_padding, groups;
+    int in_offset, out_offset, b_offset;
+    int act_min, act_max;
+    int channels; // multipliers and shifts, out_ch or 1 per tensor
+    int bias;     // whether the optional bias is given
+    int count_include_pad;
+};
+
+#define FUZZ_I8(op, kind) {#op "_int8", ONNX_TENSOR_TYPE_INT8, kind, op##_int8, op##_int8_rvv, -128, 127, 0, 0, 0}
+#define FUZZ_I32(op, kind) {#op "_int32", ONNX_TENSOR_TYPE_INT32, kind, op##_int32, op##_int32_rvv, -100000, 100000, 0, 0, 0}
+#define FUZZ_F16(op, kind, lo, hi, atol, rtol, max_len)                                                                                              \
+    {#op "_float16", ONNX_TENSOR_TYPE_FLOAT16, kind, op##_float16, op##_float16_rvv, lo, hi, atol, rtol, max_len}
+#define FUZZ_F32(op, kind, lo, hi, atol, rtol, max_len)                                                                                              \
+    {#op "_float32", ONNX_TENSOR_TYPE_FLOAT32, kind, op##_float32, op##_float32_rvv, lo, hi, atol, rtol, max_len}
+// the int kernels and the float16 ConvTranspose return a status, they are called by fuzz_quant_run
+#define FUZZ_CONV_I8(algo)                                                                                                                           \
+    {"ConvInteger_int8_" #algo, ONNX_TENSOR_TYPE_INT8, FUZZ_CONV_INTEGER, NULL, NULL, -128, 127, 0, 0, 0, CONV_INTEGER_ALGO_##algo}
+
+// float16 accumulations are rounded at every step, their length is capped
+static const struct fuzz_op_t fuzz_ops[] = {
+    FUZZ_I8(Abs, FUZZ_UNARY),
+    FUZZ_I32(Abs, FUZZ_UNARY),
+    FUZZ_F16(Abs, FUZZ_UNARY, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_F32(Abs, FUZZ_UNARY, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_I8(Negate, FUZZ_UNARY),
+    FUZZ_I32(Negate, FUZZ_UNARY),
+    FUZZ_F16(Negate, FUZZ_UNARY, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_F32(Negate, FUZZ_UNARY, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_F16(Relu, FUZZ_UNARY, -10.0f, 10.0f, 0, 0, 0),
+    FUZZ_F32(Relu, FUZZ_UNARY, -10.0f, 10.0f, 0, 0, 0),
+    FUZZ_F16(Exp, FUZZ_UNARY, -8.0f, 8.0f, 1e-2f, 1e-2f, 0),
+    FUZZ_F32(Exp, FUZZ_UNARY, -20.0f, 20.0f, 1e-3f, 1e-3f, 0),
+    FUZZ_F16(Log, FUZZ_UNARY, 1e-2f, 1e3f, 1e-2f, 1e-2f, 0),
+    FUZZ_F32(Log, FUZZ_UNARY, 1e-3f, 1e5f, 1e-3f, 1e-3f, 0),
+    FUZZ_F16(Sin, FUZZ_UNARY, -10.0f, 10.0f, 1e-2f, 1e-2f, 0),
+    FUZZ_F32(Sin, FUZZ_UNARY, -100.0f, 100.0f, 1e-3f, 1e-3f, 0),
+    FUZZ_F16(Cos, FUZZ_UNARY, -10.0f, 10.0f, 1e-2f, 1e-2f, 0),
+    FUZZ_F32(Cos, FUZZ_UNARY, -100.0f, 100.0f, 1e-3f, 1e-3f, 0),
+    FUZZ_F16(Sqrt, FUZZ_UNARY, 0.0f, 1e3f, 1e-2f, 1e-2f, 0),
+    FUZZ_F32(Sqrt, FUZZ_UNARY, 0.0f, 1e5f, 1e-3f, 1e-3f, 0),
+    FUZZ_F16(Rsqrt, FUZZ_UNARY, 1e-2f, 1e3f, 1e-2f, 1e-2f, 0),
+    FUZZ_F32(Rsqrt, FUZZ_UNARY, 1e-3f, 1e5f, 1e-3f, 1e-3f, 0),
+    FUZZ_F16(Reciprocal, FUZZ_UNARY, 1e-1f, 1e2f, 1e-2f, 1e-2f, 0),
+    FUZZ_F32(Reciprocal, FUZZ_UNARY, 1e-2f, 1e3f, 1e-3f, 1e-3f, 0),
+    FUZZ_F16(Silu, FUZZ_UNARY, -10.0f, 10.0f, 1e-2f, 1e-2f, 0),
+    FUZZ_F32(Silu, FUZZ_UNARY, -20.0f, 20.0f, 1e-3f, 1e-3f, 0),
+    FUZZ_I8(Add, FUZZ_BINARY),
+    FUZZ_F16(Add, FUZZ_BINARY, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_F32(Add, FUZZ_BINARY, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_I8(Sub, FUZZ_BINARY),
+    FUZZ_F16(Sub, FUZZ_BINARY, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_F32(Sub, FUZZ_BINARY, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_I8(Mul, FUZZ_BINARY),
+    FUZZ_F16(Mul, FUZZ_BINARY, -10.0f, 10.0f, 0, 0, 0),
+    FUZZ_F32(Mul, FUZZ_BINARY, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_F16(Div, FUZZ_BINARY, 0.5f, 10.0f, 1e-2f, 1e-2f, 0),
+    FUZZ_F32(Div, FUZZ_BINARY, 0.5f, 100.0f, 1e-3f, 1e-3f, 0),
+    FUZZ_I8(Clamp, FUZZ_CLAMP),
+    FUZZ_I32(Clamp, FUZZ_CLAMP),
+    FUZZ_F16(Clamp, FUZZ_CLAMP, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_F32(Clamp, FUZZ_CLAMP, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_F16(Elu, FUZZ_ELU, -5.0f, 5.0f, 1e-2f, 1e-2f, 0),
+    FUZZ_F32(Elu, FUZZ_ELU, -10.0f, 10.0f, 1e-3f, 1e-3f, 0),
+    FUZZ_F16(Pow, FUZZ_POW, 0.1f, 10.0f, 1e-2f, 2e-2f, 0),
+    FUZZ_F32(Pow, FUZZ_POW, 0.1f, 10.0f, 1e-3f, 1e-3f, 0),
+    FUZZ_F16(Softmax, FUZZ_SOFTMAX, -8.0f, 8.0f, 1e-2f, 5e-2f, 256),
+    FUZZ_F32(Softmax, FUZZ_SOFTMAX, -20.0f, 20.0f, 1e-4f, 1e-3f, 0),
+    FUZZ_F16(LayerNormalization, FUZZ_NORM, -4.0f, 4.0f, 1e-1f, 5e-2f, 256),
+    FUZZ_F32(LayerNormalization, FUZZ_NORM, -100.0f, 100.0f, 1e-3f, 1e-3f, 0),
+    FUZZ_F16(RMSNormalization, FUZZ_NORM, -4.0f, 4.0f, 1e-1f, 5e-2f, 256),
+    FUZZ_F32(RMSNormalization, FUZZ_NORM, -100.0f, 100.0f, 1e-3f, 1e-3f, 0),
+    FUZZ_I8(MatMul, FUZZ_MATMUL),
+    FUZZ_F16(MatMul, FUZZ_MATMUL, -1.0f, 1.0f, 1e-1f, 2e-2f, 64),
+    FUZZ_F32(MatMul, FUZZ_MATMUL, -1.0f, 1.0f, 1e-3f, 1e-3f, 0),
+    FUZZ_I8(Pad, FUZZ_PAD),
+    FUZZ_I32(Pad, FUZZ_PAD),
+    FUZZ_F16(Pad, FUZZ_PAD, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_F32(Pad, FUZZ_PAD, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_I8(Flip, FUZZ_FLIP),
+    FUZZ_I32(Flip, FUZZ_FLIP),
+    FUZZ_F16(Flip, FUZZ_FLIP, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_F32(Flip, FUZZ_FLIP, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_I8(Tile, FUZZ_TILE),
+    FUZZ_I32(Tile, FUZZ_TILE),
+    FUZZ_F16(Tile, FUZZ_TILE, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_F32(Tile, FUZZ_TILE, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_I8(Slice, FUZZ_SLICE),
+    FUZZ_I32(Slice, FUZZ_SLICE),
+    FUZZ_F16(Slice, FUZZ_SLICE, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_F32(Slice, FUZZ_SLICE, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_I8(Concat, FUZZ_CONCAT),
+    FUZZ_I32(Concat, FUZZ_CONCAT),
+    FUZZ_F16(Concat, FUZZ_CONCAT, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_F32(Concat, FUZZ_CONCAT, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_CONV_I8(AUTO),
+    FUZZ_CONV_I8(IM2COL),
+    FUZZ_CONV_I8(WINOGRAD23),
+    FUZZ_CONV_I8(WINOGRAD43),
+    {"MatMulInteger_int8", ONNX_TENSOR_TYPE_INT8, FUZZ_MATMUL_INTEGER, NULL, NULL, -128, 127, 0, 0, 0, 0},
+    {"MatMulInteger_int32", ONNX_TENSOR_TYPE_INT8, FUZZ_MATMUL_INTEGER, NULL, NULL, -128, 127, 0, 0, 0, 1},
+    {"ConvTransposeInteger_int8", ONNX_TENSOR_TYPE_INT8, FUZZ_CONV_TRANSPOSE, NULL, NULL, -128, 127, 0, 0, 0, 0},
+    {"ConvTranspose_float16", ONNX_TENSOR_TYPE_FLOAT16, FUZZ_CONV_TRANSPOSE, NULL, NULL, -1.0f, 1.0f, 1e-2f, 1e-2f, 0, 0},
+    FUZZ_I8(MaxPool, FUZZ_POOL),
+    FUZZ_F16(MaxPool, FUZZ_POOL, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_F32(MaxPool, FUZZ_POOL, -100.0f, 100.0f, 0, 0, 0),
+    FUZZ_I8(AveragePool, FUZZ_POOL),
+    FUZZ_F16(AveragePool, FUZZ_POOL, -10.0f, 10.0f, 1e-2f, 1e-2f, 0),
+    FUZZ_F32(AveragePool, FUZZ_POOL, -100.0f, 100.0f, 1e-4f, 1e-5f, 0),
+    FUZZ_I8(GlobalAveragePool, FUZZ_GLOBAL_POOL),
+    FUZZ_F16(GlobalAveragePool, FUZZ_GLOBAL_POOL, -10.0f, 10.0f, 1e-2f, 1e-2f, 0),
+    FUZZ_F32(GlobalAveragePool, FUZZ_GLOBAL_POOL, -100.0f, 100.0f, 1e-4f, 1e-5f, 0),
+};
+
+#define FUZZ_NOPS ((int)(sizeof(fuzz_ops) / sizeof(fuzz_ops[0])))
+#ifndef ONNX_FUZZ_CASES
+#define ONNX_FUZZ_CASES (ONNX_FUZZ_ITERS * FUZZ_NOPS)
+#endif
+
+static uint32_t fuzz_state;
+
+static void fuzz_srand(uint32_t seed)
+{
+    fuzz_state = seed * 2654435761u ^ 0x9e3779b9u;
+    if (fuzz_state == 0) {
+        fuzz_state = 1;
+    }
+}
+
+// xorshift32, the sequence is the same on every target and libc
+static uint32_t fuzz_rand(void)
+{
+    fuzz_state ^= fuzz_state << 13;
+    fuzz_state ^= fuzz_state >> 17;
+    fuzz_state ^= fuzz_state << 5;
+    return fuzz_state;
+}
+
+// uniform in [lo, hi]
+static int fuzz_range(int lo, int hi)
+{
+    return lo + (int)(fuzz_rand() % (uint32_t)(hi - lo + 1));
+}
+
+static float32_t fuzz_uniform(float32_t lo, float32_t hi)
+{
+    return lo + (hi - lo) * (float32_t)(fuzz_rand() >> 8) / (float32_t)(1 << 24);
+}
+
+// a length in [1, max], one in three is 1, a prime or VLMAX +-1 of m1, m2, m4 or m8
+static int fuzz_dim(int max, int elem_size)
+{
+    static const int primes[] = {1, 2, 3, 5, 7, 13, 31, 61, 127, 251};
+    int vlenb = csrr_vlenb() ? csrr_vlenb() : FUZZ_VLENB;
+    int d;
+
+    switch (fuzz_range(0, 5)) {
+        case 0:
+            d = primes[fuzz_range(0, sizeof(primes) / sizeof(primes[0]) - 1)];
+            break;
+        case 1:
+            d = vlenb / elem_size << fuzz_range(0, 3);
+            d += fuzz_range(-1, 1);
+            break;
+        default:
+            d = fuzz_range(1, max);
+            break;
+    }
+    return MIN(MAX(d, 1), max);
+}
+
+static void fuzz_shape(struct onnx_tensor_t *t, int dim0, int dim1)
+{
+    t->dims[0] = dim0;
+    t->dims[1] = dim1;
+    t->strides[0] = 1;
+    t->strides[1] = dim0;
+    t->ndata = dim0 * dim1;
+}
+
+// uniform in [lo, hi] of the type of t
+static void fuzz_fill(struct onnx_tensor_t *t, float32_t lo, float32_t hi)
+{
+    for (int i = 0; i < t->ndata; i++) {
+        switch (t->type) {
+            case ONNX_TENSOR_TYPE_INT8:
+                ((int8_t *)t->datas)[i] = (int8_t)fuzz_range((int)lo, (int)hi);
+                break;
+            case ONNX_TENSOR_TYPE_INT32:
+                ((int32_t *)t->datas)[i] = fuzz_range((int)lo, (int)hi);
+                break;
+            case ONNX_TENSOR_TYPE_FLOAT16:
+                ((float16_t *)t->datas)[i] = (float16_t)fuzz_uniform(lo, hi);
+                break;
+            default:
+                ((float32_t *)t->datas)[i] = fuzz_uniform(lo, hi);
+                break;
+        }
+    }
+}
+
+static OnnxScalar fuzz_scalar(const struct fuzz_op_t *op, float32_t v)
+{
+    OnnxScalar s;
+    switch (op->type) {
+        case ONNX_TENSOR_TYPE_INT8:
+            s.v_int8 = (int8_t)v;
+            break;
+        case ONNX_TENSOR_TYPE_INT32:
+            s.v_int32 = (int32_t)v;
+            break;
+        case ONNX_TENSOR_TYPE_FLOAT16:
+            s.v_float16 = (float16_t)v;
+            break;
+        default:
+            s.v_float32 = v;
+            break;
+    }
+    return s;
+}
+
+// draw shapes and parameters, return the number of output elements
+static int fuzz_draw(const struct fuzz_op_t *op, struct fuzz_case_t *c)
+{
+    int size = onnx_tensor_type_sizeof(op->type);
+    int max_len = op->max_len ? op->max_len : FUZZ_MAX_ELEMS;
+
+    c->rows = c->cols = c->k = 1;
+    switch (op->kind) {
+        case FUZZ_SOFTMAX:
+        case FUZZ_NORM:
+            c->cols = fuzz_dim(max_len, size);
+            c->rows = fuzz_dim(FUZZ_MAX_ELEMS / c->cols, size);
+            return c->rows * c->cols;
+        case FUZZ_MATMUL:
+            // rows of a cover every remainder of the 4 row blocks
+            c->rows = fuzz_dim(35, size);
+            c->cols = fuzz_dim(FUZZ_MAX_ELEMS / c->rows, size);
+            c->k = fuzz_dim(MIN(max_len, FUZZ_MAX_ELEMS / MAX(c->rows, c->cols)), size);
+            return c->rows * c->cols;
+        case FUZZ_PAD:
+            c->cols = fuzz_dim(FUZZ_MAX_ELEMS, size);
+            c->rows = fuzz_dim(FUZZ_MAX_ELEMS / c->cols, size);
+            for (int i = 0; i < 4; i++) {
+                c->pads[i] = fuzz_range(0, 4);
+            }
+            c->s0 = fuzz_uniform(op->lo, op->hi);
+            return (c->rows + c->pads[0] + c->pads[1]) * (c->cols + c->pads[2] + c->pads[3]);
+        case FUZZ_TILE:
+            c->cols = fuzz_dim(FUZZ_MAX_ELEMS, size);
+            c->rows = fuzz_dim(FUZZ_MAX_ELEMS / c->cols, size);
+            c->repeats[0] = fuzz_range(1, 3);
+            c->repeats[1] = fuzz_range(1, 3);
+            return c->rows * c->repeats[0] * c->cols * c->repeats[1];
+        case FUZZ_SLICE:
+            c->cols = fuzz_dim(FUZZ_MAX_ELEMS, size);
+            c->rows = fuzz_dim(FUZZ_MAX_ELEMS / c->cols, size);
+            for (int i = 0; i < 2; i++) {
+                int d = i ? c->cols : c->rows;
+                c->start[i] = fuzz_range(0, d - 1);
+                c->end[i] = fuzz_range(c->start[i] + 1, d);
+                c->step[i] = fuzz_range(1, 4);
+                if (fuzz_range(0, 3) == 0) {
+                    // end <= 0 counts from the end
+                    c->end[i] -= d;
+                }
+            }
+            return c->rows * c->cols;
+        case FUZZ_CONCAT:
+            c->axis = fuzz_range(0, 1);
+            c->cols = fuzz_dim(FUZZ_MAX_ELEMS / 2, size);
+            c->rows = fuzz_dim(FUZZ_MAX_ELEMS / 2 / c->cols, size);
+            c->cols2 = c->axis ? fuzz_dim(FUZZ_MAX_ELEMS / 2 / c->rows, size) : c->cols;
+            c->rows2 = c->axis ? c->rows : fuzz_dim(FUZZ_MAX_ELEMS / 2 / c->cols, size);
+            return c->rows * c->cols + c->rows2 * c->cols2;
+        default:
+            break;
+    }
+
+    // elementwise, one row
+    c->cols = fuzz_dim(FUZZ_MAX_ELEMS, size);
+    c->flip[0] = fuzz_range(0, 1);
+    c->flip[1] = fuzz_range(0, 1);
+    if (op->kind == FUZZ_FLIP) {
+        c->rows = fuzz_dim(FUZZ_MAX_ELEMS / c->cols, size);
+    } else if (op->kind == FUZZ_CLAMP) {
+        c->s0 = fuzz_uniform(op->lo, 0);
+        c->s1 = fuzz_uniform(0, op->hi);
+    } else if (op->kind == FUZZ_ELU) {
+        c->s0 = fuzz_uniform(0.1f, 2.0f);
+    } else if (op->kind == FUZZ_POW) {
+        // integer exponents half of the time
+        c->s0 = fuzz_range(0, 1) ? (float32_t)fuzz_range(-2, 3) : fuzz_uniform(-2.0f, 3.0f);
+    }
+    return c->rows * c->cols;
+}
+
+static void *fuzz_param(const struct fuzz_op_t *op, struct fuzz_case_t *c)
+{
+    static const int axes[2] = {0, 1};
+
+    switch (op->kind) {
+        case FUZZ_CLAMP:
+            return GenerateClampParam(fuzz_scalar(op, c->s0), fuzz_scalar(op, c->s1));
+        case FUZZ_ELU:
+            return GenerateEluParam(c->s0);
+        case FUZZ_POW:
+            return GeneratePowParam(fuzz_scalar(op, c->s0));
+        case FUZZ_NORM:
+            return op->ref == LayerNormalization_float16 || op->ref == LayerNormalization_float32 ? GenerateLayerNormParam(1e-5f, 0.9f)
+                                                                                                  : GenerateRMSNormParam(1e-5f, 0.9f);
+        case FUZZ_PAD:
+            return GeneratePadParam(fuzz_scalar(op, c->s0), c->pads[0], c->pads[1], c->pads[2], c->pads[3]);
+        case FUZZ_FLIP:
+            return GenerateFlipParam(c->flip[0], c->flip[1]);
+        case FUZZ_SLICE:
+            // the kernels adjust end in place, every run gets its own copy
+            return GenerateSliceParam(2, (int *)axes, c->start, c->end, c->step);
+        case FUZZ_CONCAT:
+            return &c->axis;
+        default:
+            return NULL;
+    }
+}
+
+static void fuzz_free_param(const struct fuzz_op_t *op, void **priv)
+{
+    switch (op->kind) {
+        case FUZZ_CLAMP:
+            FreeClampParam(priv);
+            break;
+        case FUZZ_ELU:
+            FreeEluParam(priv);
+            break;
+        case FUZZ_POW:
+            FreePowParam(priv);
+            break;
+        case FUZZ_NORM:
+            if (op->ref == LayerNormalization_float16 || op->ref == LayerNormalization_float32) {
+                FreeLayerNormParam(priv);
+            } else {
+                FreeRMSNormParam(priv);
+            }
+            break;
+        case FUZZ_PAD:
+            FreePadParam(priv);
+            break;
+        case FUZZ_FLIP:
+            FreeFlipParam(priv);
+            break;
+        case FUZZ_SLICE:
+            FreeSliceParam(priv);
+            break;
+        default:
+            *priv = NULL;
+            break;
+    }
+}
+
+static void fuzz_setup(const struct fuzz_op_t *op, const struct fuzz_case_t *c, struct onnx_node_t *node)
+{
+    struct onnx_tensor_t *a = node->inputs[0];
+    struct onnx_tensor_t *b = node->inputs[1];
+    struct onnx_tensor_t *y = node->outputs[0];
+
+    node->ninput = 1;
+    a->type = b->type = y->type = op->type;
+    fuzz_shape(a, c->cols, c->rows);
+    fuzz_shape(y, c->cols, c->rows);
+
+    switch (op->kind) {
+        case FUZZ_BINARY:
+            node->ninput = 2;
+            fuzz_shape(b, c->cols, c->rows);
+            break;
+        case FUZZ_NORM:
+            // N = dims[0] rows of D = dims[1]
+            fuzz_shape(a, c->rows, c->cols);
+            fuzz_shape(y, c->rows, c->cols);
+            break;
+        case FUZZ_MATMUL:
+            node->ninput = 2;
+            fuzz_shape(a, c->k, c->rows);
+            fuzz_shape(b, c->cols, c->k);
+            break;
+        case FUZZ_PAD:
+            fuzz_shape(y, c->cols + c->pads[2] + c->pads[3], c->rows + c->pads[0] + c->pads[1]);
+            break;
+        case FUZZ_TILE:
+            node->ninput = 2;
+            b->type = ONNX_TENSOR_TYPE_INT32;
+            fuzz_shape(b, 2, 1);
+            ((int32_t *)b->datas)[0] = c->repeats[0];
+            ((int32_t *)b->datas)[1] = c->repeats[1];
+            break;
+        case FUZZ_CONCAT:
+            node->ninput = 2;
+            fuzz_shape(b, c->cols2, c->rows2);
+            fuzz_shape(y, c->axis ? c->cols + c->cols2 : c->cols, c->axis ? c->rows : c->rows + c->rows2);
+            break;
+        default:
+            break;
+    }
+}
+
+// index of the first element of the type out of tolerance, -1 when all match
+static int fuzz_compare(const struct fuzz_op_t *op, enum onnx_tensor_type_t type, const void *ref, const void *opt, int length, double *r,
+                        double *o)
+{
+    for (int i = 0; i < length; i++) {
+        switch (type) {
+            case ONNX_TENSOR_TYPE_INT8:
+                *r = ((int8_t *)ref)[i];
+                *o = ((int8_t *)opt)[i];
+                break;
+            case ONNX_TENSOR_TYPE_INT32:
+                *r = ((int32_t *)ref)[i];
+                *o = ((int32_t *)opt)[i];
+                break;
+            case ONNX_TENSOR_TYPE_FLOAT16:
+                *r = ((float16_t *)ref)[i];
+                *o = ((float16_t *)opt)[i];
+                break;
+            default:
+                *r = ((float32_t *)ref)[i];
+                *o = ((float32_t *)opt)[i];
+                break;
+        }
+        if (!(fabs(*r - *o) <= op->atol + op->rtol * fabs(*r)) && !(isnan(*r) && isnan(*o))) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// kernel, stride, dilation and padding of a convolution, the Winograd algorithms get the 3x3 layers they take
+static void fuzz_quant_draw_conv(const struct fuzz_op_t *op, struct fuzz_quant_t *q)
+{
+    const int winograd =
+        op->kind == FUZZ_CONV_INTEGER && (op->variant == CONV_INTEGER_ALGO_WINOGRAD23 || op->variant == CONV_INTEGER_ALGO_WINOGRAD43);
+    const int transpose = op->kind == FUZZ_CONV_TRANSPOSE;
+
+    q->in_ch = fuzz_dim(48, 1);
+    q->out_ch = fuzz_dim(48, 1);
+    if (winograd) {
+        q->kernel = 3;
+        q->pad = fuzz_range(0, 1);
+    } else {
+        q->kernel = fuzz_range(0, 2) * 2 + 1;
+        q->stride = fuzz_range(1, transpose ? 3 : 2);
+        q->dilation = fuzz_range(0, 3) ? 1 : 2;
+        q->pad = fuzz_range(0, q->dilation * (q->kernel - 1) / 2);
+        switch (fuzz_range(0, 3)) {
+            case 0:
+                // depthwise
+                q->groups = q->out_ch = q->in_ch;
+                break;
+            case 1:
+                q->groups = fuzz_range(1, 2) * 2;
+                q->in_ch = MAX(q->in_ch / q->groups, 1) * q->groups;
+                q->out_ch = MAX(q->out_ch / q->groups, 1) * q->groups;
+                break;
+            default:
+                break;
+        }
+    }
+
+    const int extent = q->dilation * (q->kernel - 1) + 1;
+    if (transpose) {
+        q->in_w = fuzz_range(1, 8);
+        q->in_h = fuzz_range(1, 8);
+        q->output_padding = fuzz_range(0, q->stride - 1);
+        q->out_w = (q->in_w - 1) * q->stride - 2 * q->pad + extent + q->output_padding;
+        q->out_h = (q->in_h - 1) * q->stride - 2 * q->pad + extent + q->output_padding;
+    } else {
+        q->in_w = fuzz_range(MAX(extent - 2 * q->pad, 1), 12);
+        q->in_h = fuzz_range(MAX(extent - 2 * q->pad, 1), 12);
+        q->out_w = (q->in_w + 2 * q->pad - extent) / q->stride + 1;
+        q->out_h = (q->in_h + 2 * q->pad - extent) / q->stride + 1;
+    }
+    q->channels = q->out_ch;
+}
+
+static void fuzz_quant_draw(const struct fuzz_op_t *op, struct fuzz_quant_t *q)
+{
+    memset(q, 0, sizeof(*q));
+    q->kernel = q->stride = q->dilation = q->groups = 1;
+    q->in_offset = fuzz_range(-127, 128);
+    q->out_offset = fuzz_range(-128, 127);
+    q->b_offset = fuzz_range(-127, 128);
+    q->act_min = fuzz_range(-128, 0);
+    q->act_max = fuzz_range(0, 127);
+    q->bias = fuzz_range(0, 3) != 0;
+    q->count_include_pad = fuzz_range(0, 1);
+
+    switch (op->kind) {
+        case FUZZ_MATMUL_INTEGER:
+            // m covers every remainder of the row blocks
+            q->in_h = fuzz_dim(35, 1);
+            q->in_ch = fuzz_dim(300, 1);
+            q->out_ch = fuzz_dim(130, 1);
+            q->channels = fuzz_range(0, 1) ? q->out_ch : 1;
+            break;
+        case FUZZ_POOL:
+        case FUZZ_GLOBAL_POOL:
+            q->in_ch = q->out_ch = fuzz_dim(200, onnx_tensor_type_sizeof(op->type));
+            q->kernel = fuzz_range(1, 5);
+            q->stride = fuzz_range(1, 3);
+            q->pad = fuzz_range(0, q->kernel / 2);
+            q->in_w = fuzz_range(MAX(q->kernel - 2 * q->pad, 1), 12);
+            q->in_h = fuzz_range(MAX(q->kernel - 2 * q->pad, 1), 12);
+            q->out_w = op->kind == FUZZ_GLOBAL_POOL ? 1 : (q->in_w + 2 * q->pad - q->kernel) / q->stride + 1;
+            q->out_h = op->kind == FUZZ_GLOBAL_POOL ? 1 : (q->in_h + 2 * q->pad - q->kernel) / q->stride + 1;
+            break;
+        default:
+            fuzz_quant_draw_conv(op, q);
+            break;
+    }
+}
+
+static struct onnx_tensor_t *fuzz_tensor(enum onnx_tensor_type_t type, int d0, int d1, int d2, int d3, int ndim, float32_t lo, float32_t hi)
+{
+    int dims[4] = {d0, d1, d2, d3};
+    struct onnx_tensor_t *t = onnx_tensor_alloc(type, dims, ndim);
+    fuzz_fill(t, lo, hi);
+    return t;
+}
+
+// input, filter or b, bias, multiply and shift of the node, NULL where the op has none
+static void fuzz_quant_inputs(const struct fuzz_op_t *op, const struct fuzz_quant_t *q, struct onnx_tensor_t **inputs)
+{
+    const enum onnx_tensor_type_t type = op->type;
+    const float32_t w_lo = type == ONNX_TENSOR_TYPE_INT8 ? -128 : op->lo;
+    const float32_t w_hi = type == ONNX_TENSOR_TYPE_INT8 ? 127 : op->hi;
+
+    memset(inputs, 0, 5 * sizeof(*inputs));
+    switch (op->kind) {
+        case FUZZ_POOL:
+        case FUZZ_GLOBAL_POOL:
+            inputs[0] = fuzz_tensor(type, q->in_ch, q->in_w, q->in_h, 1, 4, op->lo, op->hi);
+            return;
+        case FUZZ_MATMUL_INTEGER:
+            inputs[0] = fuzz_tensor(type, q->in_ch, q->in_h, 1, 1, 2, op->lo, op->hi);
+            inputs[1] = fuzz_tensor(type, q->out_ch, q->in_ch, 1, 1, 2, w_lo, w_hi);
+            break;
+        case FUZZ_CONV_TRANSPOSE:
+            inputs[0] = fuzz_tensor(type, q->in_ch, q->in_w, q->in_h, 1, 4, op->lo, op->hi);
+            inputs[1] = fuzz_tensor(type, q->out_ch / q->groups, q->kernel, q->kernel, q->in_ch, 4, w_lo, w_hi);
+            break;
+        default:
+            inputs[0] = fuzz_tensor(type, q->in_ch, q->in_w, q->in_h, 1, 4, op->lo, op->hi);
+            inputs[1] = fuzz_tensor(type, q->in_ch / q->groups, q->kernel, q->kernel, q->out_ch, 4, w_lo, w_hi);
+            break;
+    }
+    if (type != ONNX_TENSOR_TYPE_INT8) {
+        // float16 ConvTranspose, the bias is the optional third input
+        inputs[2] = q->bias ? fuzz_tensor(type, q->out_ch, 1, 1, 1, 1, op->lo, op->hi) : NULL;
+        return;
+    }
+    // the bias is optional for MatMulInteger only
+    inputs[2] = q->bias || op->kind != FUZZ_MATMUL_INTEGER ? fuzz_tensor(ONNX_TENSOR_TYPE_INT32, q->out_ch, 1, 1, 1, 1, -5000, 5000) : NULL;
+    inputs[3] = fuzz_tensor(ONNX_TENSOR_TYPE_INT32, q->channels, 1, 1, 1, 1, 0, 0);
+    inputs[4] = fuzz_tensor(ONNX_TENSOR_TYPE_INT32, q->channels, 1, 1, 1, 1, -14, 1);
+    for (int i = 0; i < q->channels; i++) {
+        ((int32_t *)inputs[3]->datas)[i] = 0x20000000 + (int32_t)(fuzz_rand() % 0x60000000u);
+    }
+}
+
+// run the scalar or the rvv kernel with parameters generated for it, the status of the kernels that return one
+static int fuzz_quant_run(const struct fuzz_op_t *op, const struct fuzz_quant_t *q, struct onnx_node_t *node, int rvv)
+{
+    const struct onnx_tensor_t *x = node->inputs[0];
+    const struct onnx_tensor_t *w = node->inputs[1];
+    const struct onnx_tensor_t *y = node->outputs[0];
+    int status = 0;
+
+    switch (op->kind) {
+        case FUZZ_CONV_INTEGER:
+            node->priv = GenerateConvIntegerParamAlgo(q->in_offset, q->out_offset, q->stride, q->stride, q->dilation, q->dilation, q->pad, q->pad,
+                                                      q->act_min, q->act_max, x, w, y, rvv, (enum conv_integer_algo_t)op->variant);
+            status = rvv ? ConvInteger_rvv(node) : ConvInteger(node);
+            FreeConvIntegerParam(&node->priv);
+            break;
+        case FUZZ_MATMUL_INTEGER:
+            node->priv = GenerateMatMulIntegerParam(q->in_offset, q->b_offset, q->out_offset, q->act_min, q->act_max, w, rvv);
+            status = rvv ? MatMulInteger_rvv(node) : MatMulInteger(node);
+            FreeMatMulIntegerParam(&node->priv);
+            break;
+        case FUZZ_CONV_TRANSPOSE:
+            if (op->type == ONNX_TENSOR_TYPE_INT8) {
+                node->priv = GenerateConvTransposeIntegerParam(q->in_offset, q->out_offset, q->stride, q->stride, q->dilation, q->dilation, q->pad,
+                                                               q->pad, q->output_padding, q->output_padding, q->act_min, q->act_max, x, w, y, rvv);
+                status = rvv ? ConvTransposeInteger_rvv(node) : ConvTransposeInteger(node);
+            } else {
+                node->priv = GenerateConvTransposeParam(q->stride, q->stride, q->dilation, q->dilation, q->pad, q->pad, q->output_padding,
+                                                        q->output_padding, x, w, y, rvv);
+                status = rvv ? ConvTranspose_float16_rvv(node) : ConvTranspose_float16(node);
+            }
+            FreeConvTransposeParam(&node->priv);
+            break;
+        case FUZZ_POOL:
+            node->priv = GeneratePoolParam(q->kernel, q->kernel, q->stride, q->stride, q->pad, q->pad, q->count_include_pad, q->out_offset);
+            (rvv ? op->rvv : op->ref)(node);
+            FreePoolParam(&node->priv);
+            break;
+        default:
+            node->priv = NULL;
+            (rvv ? op->rvv : op->ref)(node);
+            break;
+    }
+    return status;
+}
+
+static int fuzz_quant_case(uint32_t seed, const struct fuzz_op_t *op)
+{
+    const enum onnx_tensor_type_t out_type = op->variant && op->kind == FUZZ_MATMUL_INTEGER ? ONNX_TENSOR_TYPE_INT32 : op->type;
+    struct onnx_tensor_t *inputs[5], *outputs[1], *y[2];
+    struct onnx_node_t node;
+    struct fuzz_quant_t q;
+    int status[2], ret = 0;
+    double r, o;
+
+    fuzz_quant_draw(op, &q);
+    fuzz_quant_inputs(op, &q, inputs);
+    node.inputs = inputs;
+    node.ninput = op->kind == FUZZ_POOL || op->kind == FUZZ_GLOBAL_POOL ? 1 : op->type == ONNX_TENSOR_TYPE_INT8 ? 5 : 3;
+    node.outputs = outputs;
+    node.noutput = 1;
+
+    for (int rvv = 0; rvv < 2; rvv++) {
+        if (op->kind == FUZZ_MATMUL_INTEGER) {
+            y[rvv] = fuzz_tensor(out_type, q.out_ch, q.in_h, 1, 1, 2, 0, 0);
+        } else {
+            y[rvv] = fuzz_tensor(out_type, q.out_ch, q.out_w, q.out_h, 1, 4, 0, 0);
+        }
+        // elements neither kernel writes differ
+        memset(y[rvv]->datas, rvv ? 0xa5 : 0x5a, y[rvv]->ndata * onnx_tensor_type_sizeof(out_type));
+        node.outputs[0] = y[rvv];
+        status[rvv] = fuzz_quant_run(op, &q, &node, rvv);
+    }
+
+    int i = -1;
+    if (status[0] != 0 || status[1] != 0 || (i = fuzz_compare(op, out_type, y[0]->datas, y[1]->datas, y[0]->ndata, &r, &o)) >= 0) {
+        printf("fuzz seed %u: %s in [%d, %d, %d] out [%d, %d, %d] kernel %d stride %d dilation %d pad %d groups %d, ", (unsigned)seed, op->name,
+               q.in_h, q.in_w, q.in_ch, q.out_h, q.out_w, q.out_ch, q.kernel, q.stride, q.dilation, q.pad, q.groups);
+        if (i < 0) {
+            printf("status %d rvv %d\r\n", status[0], status[1]);
+        } else {
+            printf("y[%d] ref %.9g rvv %.9g\r\n", i, r, o);
+        }
+        ret = 1;
+    }
+
+    onnx_tensor_free(y[1]);
+    onnx_tensor_free(y[0]);
+    for (int k = 4; k >= 0; k--) {
+        if (inputs[k] != NULL) {
+            onnx_tensor_free(inputs[k]);
+        }
+    }
+    return ret;
+}
+
+static int fuzz_case(uint32_t seed, struct onnx_node_t *node, void *golden)
+{
+    const struct fuzz_op_t *op = &fuzz_ops[seed % FUZZ_NOPS];
+    struct onnx_tensor_t *y = node->outputs[0];
+    struct fuzz_case_t c;
+    int ydims[2] = {0, 0};
+    size_t ndata = 0;
+    double r, o;
+    int size = onnx_tensor_type_sizeof(op->type);
+
+    fuzz_srand(seed);
+    if (op->kind >= FUZZ_CONV_INTEGER) {
+        return fuzz_quant_case(seed, op);
+    }
+    while (fuzz_draw(op, &c) > FUZZ_MAX_ELEMS) {
+    }
+    fuzz_setup(op, &c, node);
+    fuzz_fill(node->inputs[0], op->lo, op->hi);
+    if (node->ninput > 1 && op->kind != FUZZ_TILE) {
+        fuzz_fill(node->inputs[1], op->lo, op->hi);
+    }
+
+    for (int k = 0; k < 2; k++) {
+        fuzz_setup(op, &c, node);
+        node->priv = fuzz_param(op, &c);
+        memset(y->datas, 0x5a, FUZZ_MAX_ELEMS * size);
+        if (k == 0) {
+            op->ref(node);
+            memcpy(golden, y->datas, y->ndata * size);
+            ndata = y->ndata;
+            ydims[0] = y->dims[0];
+            ydims[1] = y->dims[1];
+        } else {
+            op->rvv(node);
+        }
+        fuzz_free_param(op, &node->priv);
+    }
+
+    int i = -1;
+    if (y->ndata != ndata || y->dims[0] != ydims[0] || y->dims[1] != ydims[1] ||
+        (i = fuzz_compare(op, op->type, golden, y->datas, ndata, &r, &o)) >= 0) {
+        printf("fuzz seed %u: %s rows %d cols %d k %d, ", (unsigned)seed, op->name, c.rows, c.cols, c.k);
+        if (i < 0) {
+            printf("output shape [%d, %d] != [%d, %d]\r\n", y->dims[1], y->dims[0], ydims[1], ydims[0]);
+        } else {
+            printf("y[%d] ref %.9g rvv %.9g\r\n", i, r, o);
+        }
+        return 1;
+    }
+    return 0;
+}
+
+int test_fuzz(void)
+{
+    struct onnx_node_t node;
+    struct onnx_tensor_t a, b, y;
+    struct onnx_tensor_t *inputs[2] = {&a, &b};
+    struct onnx_tensor_t *outputs[1] = {&y};
+    int dims[3][2], strides[3][2];
+    struct onnx_tensor_t *tensors[3] = {&a, &b, &y};
+    void *golden = MALLOC_ASSERT(sizeof(float32_t) * FUZZ_MAX_ELEMS);
+    int ret = 0, nfail = 0;
+
+    for (int i = 0; i < 3; i++) {
+        tensors[i]->ndim = 2;
+        tensors[i]->dims = dims[i];
+        tensors[i]->strides = strides[i];
+        tensors[i]->datas = MALLOC_ASSERT(sizeof(float32_t) * FUZZ_MAX_ELEMS);
+    }
+    node.inputs = inputs;
+    node.outputs = outputs;
+    node.noutput = 1;
+
+    printf("fuzz seed %u, %d cases of %d kernels\r\n", (unsigned)ONNX_FUZZ_SEED, ONNX_FUZZ_CASES, FUZZ_NOPS);
+    for (int i = 0; i < ONNX_FUZZ_CASES; i++) {
+        if (fuzz_case((uint32_t)ONNX_FUZZ_SEED + i, &node, golden)) {
+            ret = 1;
+            nfail++;
+        }
+    }
+    if (nfail) {
+        printf("fuzz: %d of %d cases mismatched\r\n", nfail, ONNX_FUZZ_CASES);
+    }
+
+    for (int i = 0; i < 3; i++) {
+        free(tensors[i]->datas);
+    }
+    free(golden);
+    return ret;
+}
@@ -0,0 +1,105 @@
+#include "utils.h"
+
+#define TEST_DATA_LEN 4096
+#define NUM_NODES 4
+
+BENCH_DECLARE_VAR()
+
+static struct onnx_tensor_t *graph_tensor_f32(void *datas)
+{
+    struct onnx_tensor_t *t = (struct onnx_tensor_t *)MALLOC_ASSERT(sizeof(struct onnx_tensor_t));
+    t->name = NULL;
+    t->type = ONNX_TENSOR_TYPE_FLOAT32;
+    t->ndim = 1;
+    t->dims = (int *)MALLOC_ASSERT(sizeof(int) * t->ndim);
+    t->dims[0] = TEST_DATA_LEN;
+    t->strides = NULL;
+    t->ndata = TEST_DATA_LEN;
+    t->datas = datas;
+    return t;
+}
+
+static struct onnx_node_t *graph_node(struct onnx_tensor_t *a, struct onnx_tensor_t *b, struct onnx_tensor_t *y)
+{
+    struct onnx_node_t *node = (struct onnx_node_t *)MALLOC_ASSERT(sizeof(struct onnx_node_t));
+    node->priv = NULL;
+    node->ninput = b ? 2 : 1;
+    node->inputs = (struct onnx_tensor_t **)MALLOC_ASSERT(sizeof(struct onnx_tensor_t *) * node->ninput);
+    node->inputs[0] = a;
+    if (b) {
+        node->inputs[1] = b;
+    }
+    node->noutput = 1;
+    node->outputs = (struct onnx_tensor_t **)MALLOC_ASSERT(sizeof(struct onnx_tensor_t *) * node->noutput);
+    node->outputs[0] = y;
+    return node;
+}
+
+int test_graph(void)
+{
+    float32_t golden[TEST_DATA_LEN];
+    struct onnx_tensor_t *t[5];
+    struct onnx_node_t *node[NUM_NODES];
+    int ret = 0;
+
+    // y = |-|x|| + |x|, t1 stays alive until the last node
+    t[0] = graph_tensor_f32(MALLOC_ASSERT(sizeof(float32_t) * TEST_DATA_LEN));
+    for (int i = 1; i < 5; i++) {
+        t[i] = graph_tensor_f32(NULL);
+    }
+    float32_t *px = (float32_t *)t[0]->datas;
+    for (int i = 0; i < TEST_DATA_LEN; i++) {
+        px[i] = rand() * 2.0 / RAND_MAX - 1.0;
+        golden[i] = 2 * fabsf(px[i]);
+    }
+
+    node[0] = graph_node(t[0], NULL, t[1]);
+    node[1] = graph_node(t[1], NULL, t[2]);
+    node[2] = graph_node(t[2], NULL, t[3]);
+    node[3] = graph_node(t[3], t[1], t[4]);
+
+    struct onnx_graph_t *g = onnx_graph_alloc(NUM_NODES);
+    onnx_graph_add_node(g, node[0], Abs_float32_rvv);
+    onnx_graph_add_node(g, node[1], Negate_float32_rvv);
+    onnx_graph_add_node(g, node[2], Abs_float32_rvv);
+    onnx_graph_add_node(g, node[3], Add_float32_rvv);
+
+    // 4 intermediate tensors, at most 3 of them alive at the same time
+    size_t need = onnx_graph_plan(g);
+    if (need != 3 * sizeof(float32_t) * TEST_DATA_LEN) {
+        printf("Graph arena size mismatch, expected %d, actual %d\r\n", (int)(3 * sizeof(float32_t) * TEST_DATA_LEN), (int)need);
+        ret = 1;
+    }
+    ret |= onnx_graph_prepare(g, NULL, 0);
+
+#if defined(ONNX_PROFILE)
+    onnx_profile_reset();
+#endif
+    BENCH_START(Graph_float32_rvv);
+    ret |= onnx_graph_run(g);
+    BENCH_END(Graph_float32_rvv);
+#if defined(ONNX_PROFILE)
+    if (onnx_profile_count() != NUM_NODES) {
+        printf("Graph profile has %d events, expected %d\r\n", onnx_profile_count(), NUM_NODES);
+        ret = 1;
+    }
+    onnx_profile_summary();
+    onnx_profile_trace();
+#endif
+
+    ret |= verify_results_f32(golden, (float32_t *)t[4]->datas, TEST_DATA_LEN);
+
+    onnx_graph_free(g);
+    for (int i = 0; i < NUM_NODES; i++) {
+        free(node[i]->inputs);
+        free(node[i]->outputs);
+        free(node[i]);
+    }
+    free(t[0]->datas);
+    for (int i = 0; i < 5; i++) {
+        free(t[i]->dims);
+        free(t[i]);
+    }
+
+    return ret;
+}
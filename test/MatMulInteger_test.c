@@ -0,0 +1,167 @@
+#include "requantize.h"
+
+BENCH_DECLARE_VAR()
+
+// zero points of a and b, per tensor and per column requantization, int32 output, edge rows and columns
+struct matmul_integer_case_t {
+    const char *name;
+    int m, k, n;
+    int a_offset, b_offset;
+    int per_channel;
+    int int32_output;
+};
+
+static const struct matmul_integer_case_t matmul_integer_cases[] = {
+    {"1x64x48_symmetric", 1, 64, 48, 0, 0, 0, 0},
+    {"7x33x70_per_tensor", 7, 33, 70, 3, 0, 0, 0},
+    {"37x300x129_per_channel", 37, 300, 129, 128, -5, 1, 0},
+    {"13x96x40_int32", 13, 96, 40, -7, 11, 0, 1},
+};
+
+static struct onnx_tensor_t *matmul_integer_tensor(enum onnx_tensor_type_t type, int d0, int d1, int range)
+{
+    int dims[2] = {d0, d1};
+    struct onnx_tensor_t *t = onnx_tensor_alloc(type, dims, 2);
+    for (int i = 0; i < t->ndata; i++) {
+        const int v = range ? rand() % (2 * range + 1) - range : 0;
+        if (type == ONNX_TENSOR_TYPE_INT8) {
+            ((int8_t *)t->datas)[i] = (int8_t)v;
+        } else {
+            ((int32_t *)t->datas)[i] = v;
+        }
+    }
+    return t;
+}
+
+// the definition in 64 bit, requantized like ConvInteger for an int8 output
+static int matmul_integer_check_ref(const struct matmul_integer_case_t *c, struct onnx_tensor_t **inputs, const struct onnx_tensor_t *y,
+                                    int out_offset)
+{
+    const int8_t *a = (const int8_t *)inputs[0]->datas;
+    const int8_t *b = (const int8_t *)inputs[1]->datas;
+    const int32_t *bias = (const int32_t *)inputs[2]->datas;
+    const int32_t *mult = (const int32_t *)inputs[3]->datas;
+    const int32_t *shift = (const int32_t *)inputs[4]->datas;
+
+    for (int i = 0; i < c->m; i++) {
+        for (int j = 0; j < c->n; j++) {
+            int64_t sum = bias[j];
+            for (int kk = 0; kk < c->k; kk++) {
+                sum += (int64_t)(a[i * c->k + kk] + c->a_offset) * (b[kk * c->n + j] + c->b_offset);
+            }
+            int32_t ref = (int32_t)sum;
+            int32_t val;
+            if (c->int32_output) {
+                val = ((int32_t *)y->datas)[i * c->n + j];
+            } else {
+                const int ch = c->per_channel ? j : 0;
+                ref = MIN(MAX(requantize(ref, mult[ch], shift[ch]) + out_offset, -128), 127);
+                val = ((int8_t *)y->datas)[i * c->n + j];
+            }
+            if (val != ref) {
+                printf("MatMulInteger %s differs from the reference at (%d, %d), expected %d, actual %d\r\n", c->name, i, j, ref, val);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+static int test_matmulinteger_case(const struct matmul_integer_case_t *c)
+{
+    const enum onnx_tensor_type_t out_type = c->int32_output ? ONNX_TENSOR_TYPE_INT32 : ONNX_TENSOR_TYPE_INT8;
+    const int channels = c->per_channel ? c->n : 1;
+    const int out_offset = -5;
+    struct onnx_tensor_t *inputs[5], *outputs[1];
+    struct onnx_tensor_t *output_ref, *output_rvv;
+    struct onnx_node_t node;
+    int ret = 0;
+
+    inputs[0] = matmul_integer_tensor(ONNX_TENSOR_TYPE_INT8, c->k, c->m, 127);
+    inputs[1] = matmul_integer_tensor(ONNX_TENSOR_TYPE_INT8, c->n, c->k, 127);
+    inputs[2] = matmul_integer_tensor(ONNX_TENSOR_TYPE_INT32, c->n, 1, 1000);
+    inputs[3] = matmul_integer_tensor(ONNX_TENSOR_TYPE_INT32, channels, 1, 0);
+    inputs[4] = matmul_integer_tensor(ONNX_TENSOR_TYPE_INT32, channels, 1, 0);
+    for (int ch = 0; ch < channels; ch++) {
+        ((int32_t *)inputs[3]->datas)[ch] = 0x40000000 + rand() % 0x3fffffff;
+        ((int32_t *)inputs[4]->datas)[ch] = -(rand() % 4) - 7;
+    }
+    output_ref = matmul_integer_tensor(out_type, c->n, c->m, 0);
+    output_rvv = matmul_integer_tensor(out_type, c->n, c->m, 0);
+    node.inputs = inputs;
+    node.ninput = 5;
+    node.outputs = outputs;
+    node.noutput = 1;
+
+    for (int rvv = 0; rvv < 2; rvv++) {
+        node.outputs[0] = rvv ? output_rvv : output_ref;
+        node.priv = GenerateMatMulIntegerParam(c->a_offset, c->b_offset, out_offset, -128, 127, inputs[1], rvv);
+        BENCH_START(MatMulInteger_case);
+        if ((rvv ? MatMulInteger_rvv(&node) : MatMulInteger(&node)) != 0) {
+            printf("MatMulInteger %s failed\r\n", c->name);
+            ret = 1;
+        }
+        BENCH_SAMPLE(MatMulInteger_case);
+        printf("CSV, MatMulInteger%s_%s, %lu\r\n", rvv ? "_rvv" : "", c->name, (unsigned long)BENCH_GET_USECYC());
+        FreeMatMulIntegerParam(&node.priv);
+    }
+    ret |= matmul_integer_check_ref(c, inputs, output_ref, out_offset);
+    // the offsets are added after the products but the sums are the same in int32
+    if (memcmp(output_ref->datas, output_rvv->datas, output_rvv->ndata * onnx_tensor_type_sizeof(out_type)) != 0) {
+        printf("MatMulInteger %s mismatch\r\n", c->name);
+        ret = 1;
+    }
+
+    onnx_tensor_free(output_rvv);
+    onnx_tensor_free(output_ref);
+    for (int i = 4; i >= 0; i--) {
+        onnx_tensor_free(inputs[i]);
+    }
+    return ret;
+}
+
+// shapes and requantization parameters that don't fit are rejected
+static int test_matmulinteger_check(void)
+{
+    struct onnx_tensor_t *inputs[5], *outputs[1];
+    struct onnx_node_t node;
+    int ret = 0;
+
+    inputs[0] = matmul_integer_tensor(ONNX_TENSOR_TYPE_INT8, 16, 4, 1);
+    inputs[1] = matmul_integer_tensor(ONNX_TENSOR_TYPE_INT8, 8, 16, 1);
+    inputs[2] = NULL;
+    inputs[3] = matmul_integer_tensor(ONNX_TENSOR_TYPE_INT32, 3, 1, 0);
+    inputs[4] = matmul_integer_tensor(ONNX_TENSOR_TYPE_INT32, 3, 1, 0);
+    outputs[0] = matmul_integer_tensor(ONNX_TENSOR_TYPE_INT8, 8, 4, 0);
+    node.inputs = inputs;
+    node.ninput = 5;
+    node.outputs = outputs;
+    node.noutput = 1;
+
+    for (int rvv = 0; rvv < 2; rvv++) {
+        node.priv = GenerateMatMulIntegerParam(0, 0, 0, -128, 127, inputs[1], rvv);
+        // 3 multipliers for 8 columns
+        if ((rvv ? MatMulInteger_rvv(&node) : MatMulInteger(&node)) != -1) {
+            printf("MatMulInteger accepts 3 multipliers for 8 columns\r\n");
+            ret = 1;
+        }
+        FreeMatMulIntegerParam(&node.priv);
+    }
+
+    onnx_tensor_free(outputs[0]);
+    onnx_tensor_free(inputs[4]);
+    onnx_tensor_free(inputs[3]);
+    onnx_tensor_free(inputs[1]);
+    onnx_tensor_free(inputs[0]);
+    return ret;
+}
+
+int test_matmulinteger(void)
+{
+    int ret = 0;
+    for (int i = 0; i < sizeof(matmul_integer_cases) / sizeof(matmul_integer_cases[0]); i++) {
+        ret |= test_matmulinteger_case(&matmul_integer_cases[i]);
+    }
+    ret |= test_matmulinteger_check();
+    return ret;
+}
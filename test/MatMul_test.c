@@ -19,6 +19,7 @@ int test_matmul_int8(void)
     node->inputs = (struct onnx_tensor_t **)MALLOC_ASSERT(sizeof(struct onnx_tensor_t *) * node->ninput);
     node->inputs[0] = (struct onnx_tensor_t *)MALLOC_ASSERT(sizeof(struct onnx_tensor_t));
     node->inputs[0]->ndata = M * K;
+    node->inputs[0]->type = ONNX_TENSOR_TYPE_INT8;
     node->inputs[0]->datas = MALLOC_ASSERT(sizeof(int8_t) * node->inputs[0]->ndata);
     node->inputs[0]->ndim = 2;
     node->inputs[0]->dims = (int *)MALLOC_ASSERT(sizeof(int) * node->inputs[0]->ndim);
@@ -31,6 +32,7 @@ int test_matmul_int8(void)
 
     node->inputs[1] = (struct onnx_tensor_t *)MALLOC_ASSERT(sizeof(struct onnx_tensor_t));
     node->inputs[1]->ndata = K * N;
+    node->inputs[1]->type = ONNX_TENSOR_TYPE_INT8;
     node->inputs[1]->datas = MALLOC_ASSERT(sizeof(int8_t) * node->inputs[1]->ndata);
     node->inputs[1]->ndim = 2;
     node->inputs[1]->dims = (int *)MALLOC_ASSERT(sizeof(int) * node->inputs[1]->ndim);
@@ -45,6 +47,7 @@ int test_matmul_int8(void)
     node->outputs = (struct onnx_tensor_t **)MALLOC_ASSERT(sizeof(struct onnx_tensor_t *) * node->noutput);
     node->outputs[0] = (struct onnx_tensor_t *)MALLOC_ASSERT(sizeof(struct onnx_tensor_t));
     node->outputs[0]->ndata = M * N;
+    node->outputs[0]->type = ONNX_TENSOR_TYPE_INT8;
     node->outputs[0]->datas = MALLOC_ASSERT(sizeof(int8_t) * node->outputs[0]->ndata);
     node->outputs[0]->ndim = 2;
     node->outputs[0]->dims = (int *)MALLOC_ASSERT(sizeof(int) * node->outputs[0]->ndim);
@@ -95,6 +98,7 @@ int test_matmul_f16(void)
     node->inputs = (struct onnx_tensor_t **)MALLOC_ASSERT(sizeof(struct onnx_tensor_t *) * node->ninput);
     node->inputs[0] = (struct onnx_tensor_t *)MALLOC_ASSERT(sizeof(struct onnx_tensor_t));
     node->inputs[0]->ndata = M * K;
+    node->inputs[0]->type = ONNX_TENSOR_TYPE_FLOAT16;
     node->inputs[0]->datas = MALLOC_ASSERT(sizeof(float16_t) * node->inputs[0]->ndata);
     node->inputs[0]->ndim = 2;
     node->inputs[0]->dims = (int *)MALLOC_ASSERT(sizeof(int) * node->inputs[0]->ndim);
@@ -107,6 +111,7 @@ int test_matmul_f16(void)
 
     node->inputs[1] = (struct onnx_tensor_t *)MALLOC_ASSERT(sizeof(struct onnx_tensor_t));
     node->inputs[1]->ndata = K * N;
+    node->inputs[1]->type = ONNX_TENSOR_TYPE_FLOAT16;
     node->inputs[1]->datas = MALLOC_ASSERT(sizeof(float16_t) * node->inputs[1]->ndata);
     node->inputs[1]->ndim = 2;
     node->inputs[1]->dims = (int *)MALLOC_ASSERT(sizeof(int) * node->inputs[1]->ndim);
@@ -121,6 +126,7 @@ int test_matmul_f16(void)
     node->outputs = (struct onnx_tensor_t **)MALLOC_ASSERT(sizeof(struct onnx_tensor_t *) * node->noutput);
     node->outputs[0] = (struct onnx_tensor_t *)MALLOC_ASSERT(sizeof(struct onnx_tensor_t));
     node->outputs[0]->ndata = M * N;
+    node->outputs[0]->type = ONNX_TENSOR_TYPE_FLOAT16;
     node->outputs[0]->datas = MALLOC_ASSERT(sizeof(float16_t) * node->outputs[0]->ndata);
     node->outputs[0]->ndim = 2;
     node->outputs[0]->dims = (int *)MALLOC_ASSERT(sizeof(int) * node->outputs[0]->ndim);
@@ -164,11 +170,13 @@ int test_matmul_f32(void)
     int ret = 0;
 
     node = (struct onnx_node_t *)MALLOC_ASSERT(sizeof(struct onnx_node_t));
+    node->priv = NULL;
     node->ninput = 2;
 
     node->inputs = (struct onnx_tensor_t **)MALLOC_ASSERT(sizeof(struct onnx_tensor_t *) * node->ninput);
     node->inputs[0] = (struct onnx_tensor_t *)MALLOC_ASSERT(sizeof(struct onnx_tensor_t));
     node->inputs[0]->ndata = M * K;
+    node->inputs[0]->type = ONNX_TENSOR_TYPE_FLOAT32;
     node->inputs[0]->datas = MALLOC_ASSERT(sizeof(float32_t) * node->inputs[0]->ndata);
     node->inputs[0]->ndim = 2;
     node->inputs[0]->dims = (int *)MALLOC_ASSERT(sizeof(int) * node->inputs[0]->ndim);
@@ -181,6 +189,7 @@ int test_matmul_f32(void)
 
     node->inputs[1] = (struct onnx_tensor_t *)MALLOC_ASSERT(sizeof(struct onnx_tensor_t));
     node->inputs[1]->ndata = K * N;
+    node->inputs[1]->type = ONNX_TENSOR_TYPE_FLOAT32;
     node->inputs[1]->datas = MALLOC_ASSERT(sizeof(float32_t) * node->inputs[1]->ndata);
     node->inputs[1]->ndim = 2;
     node->inputs[1]->dims = (int *)MALLOC_ASSERT(sizeof(int) * node->inputs[1]->ndim);
@@ -195,6 +204,7 @@ int test_matmul_f32(void)
     node->outputs = (struct onnx_tensor_t **)MALLOC_ASSERT(sizeof(struct onnx_tensor_t *) * node->noutput);
     node->outputs[0] = (struct onnx_tensor_t *)MALLOC_ASSERT(sizeof(struct onnx_tensor_t));
     node->outputs[0]->ndata = M * N;
+    node->outputs[0]->type = ONNX_TENSOR_TYPE_FLOAT32;
     node->outputs[0]->datas = MALLOC_ASSERT(sizeof(float32_t) * node->outputs[0]->ndata);
     node->outputs[0]->ndim = 2;
     node->outputs[0]->dims = (int *)MALLOC_ASSERT(sizeof(int) * node->outputs[0]->ndim);
@@ -230,11 +240,342 @@ int test_matmul_f32(void)
     return ret;
 }
 
+static struct onnx_tensor_t *matmul_tensor(enum onnx_tensor_type_t type, int d0, int d1)
+{
+    int dims[2] = {d0, d1};
+    struct onnx_tensor_t *t = onnx_tensor_alloc(type, dims, 2);
+    for (int i = 0; i < t->ndata; i++) {
+        float32_t v = 2.0f * rand() / RAND_MAX - 1.0f;
+        if (type == ONNX_TENSOR_TYPE_FLOAT16) {
+            ((float16_t *)t->datas)[i] = (float16_t)v;
+        } else {
+            ((float32_t *)t->datas)[i] = v;
+        }
+    }
+    return t;
+}
+
+// epilogue fused into the store, 15 rows hit the 4, 2 and 1 row blocks, 75 x 300 x 300 the edges of
+// every block of the blocked GEMM with the epilogue on the last block of K only. The rvv kernel runs
+// with B prepacked by GenerateMatMulParam, which takes 3 rows to the blocked GEMM too, and with B
+// packed per call.
+static int test_matmul_epilogue(enum onnx_tensor_type_t type, int m, int k, int n)
+{
+    const struct onnx_epilogue_t epilogues[] = {
+        {ONNX_ACTIVATION_RELU6, 0.0f, 0.0f, NULL, 0.0f, 0, 0.0f},
+        {ONNX_ACTIVATION_CLAMP, -0.5f, 1.5f, NULL, 1.0f, 0, 0.0f},
+        {ONNX_ACTIVATION_SILU, 0.0f, 0.0f, NULL, 0.5f, 0, 0.0f},
+    };
+    const _Bool half = type == ONNX_TENSOR_TYPE_FLOAT16;
+    struct onnx_tensor_t *inputs[2], *outputs[1];
+    struct onnx_tensor_t *residual, *output_ref, *output_rvv;
+    struct onnx_tensor_t shape;
+    struct onnx_node_t node;
+    void *param_ref, *param_rvv[2];
+    int ret = 0;
+
+    inputs[0] = matmul_tensor(type, k, m);
+    inputs[1] = matmul_tensor(type, n, k);
+    residual = matmul_tensor(type, n, m);
+    output_ref = matmul_tensor(type, n, m);
+    output_rvv = matmul_tensor(type, n, m);
+    node.inputs = inputs;
+    node.ninput = 2;
+    node.outputs = outputs;
+    node.noutput = 1;
+
+    // without datas B is not packed ahead
+    shape = *inputs[1];
+    shape.datas = NULL;
+    param_ref = GenerateMatMulParam(inputs[1], 0);
+    param_rvv[0] = GenerateMatMulParam(inputs[1], 1);
+    param_rvv[1] = GenerateMatMulParam(&shape, 1);
+
+    for (int i = 0; i < sizeof(epilogues) / sizeof(epilogues[0]); i++) {
+        struct onnx_epilogue_t e = epilogues[i];
+        // the clamp and silu cases add the residual
+        e.residual = e.residual_scale != 0.0f ? residual : NULL;
+        SetMatMulEpilogue(param_ref, &e);
+        node.priv = param_ref;
+        node.outputs[0] = output_ref;
+        half ? MatMul_float16(&node) : MatMul_float32(&node);
+        for (int j = 0; j < 2; j++) {
+            SetMatMulEpilogue(param_rvv[j], &e);
+            node.priv = param_rvv[j];
+            node.outputs[0] = output_rvv;
+            half ? MatMul_float16_rvv(&node) : MatMul_float32_rvv(&node);
+            if (half ? verify_results_f16(output_ref->datas, output_rvv->datas, output_rvv->ndata)
+                     : verify_results_f32(output_ref->datas, output_rvv->datas, output_rvv->ndata)) {
+                printf("MatMul %s epilogue %d mismatch, %s B\r\n", half ? "float16" : "float32", e.activation, j ? "unpacked" : "prepacked");
+                ret = 1;
+            }
+        }
+    }
+
+    // a residual of the other float type is rejected
+    struct onnx_tensor_t *mismatch = matmul_tensor(half ? ONNX_TENSOR_TYPE_FLOAT32 : ONNX_TENSOR_TYPE_FLOAT16, n, m);
+    struct onnx_epilogue_t e = epilogues[1];
+    e.residual = mismatch;
+    if (SetMatMulEpilogue(param_ref, &e) != -1 || SetMatMulEpilogue(param_rvv[0], &e) != -1) {
+        printf("MatMul %s epilogue accepts a residual of another type\r\n", half ? "float16" : "float32");
+        ret = 1;
+    }
+    onnx_tensor_free(mismatch);
+    FreeMatMulParam(&param_rvv[1]);
+    FreeMatMulParam(&param_rvv[0]);
+    FreeMatMulParam(&param_ref);
+
+    // float32 sums of float16 run the epilogue in float32 too
+    if (half) {
+        param_ref = GenerateMatMulParamAccumulate(inputs[1], 0, MATMUL_ACCUMULATE_FLOAT32);
+        param_rvv[0] = GenerateMatMulParamAccumulate(inputs[1], 1, MATMUL_ACCUMULATE_FLOAT32);
+        for (int i = 0; i < sizeof(epilogues) / sizeof(epilogues[0]); i++) {
+            struct onnx_epilogue_t e = epilogues[i];
+            e.residual = e.residual_scale != 0.0f ? residual : NULL;
+            SetMatMulEpilogue(param_ref, &e);
+            SetMatMulEpilogue(param_rvv[0], &e);
+            node.priv = param_ref;
+            node.outputs[0] = output_ref;
+            MatMul_float16(&node);
+            node.priv = param_rvv[0];
+            node.outputs[0] = output_rvv;
+            MatMul_float16_rvv(&node);
+            if (verify_results_f16(output_ref->datas, output_rvv->datas, output_rvv->ndata)) {
+                printf("MatMul float16 epilogue %d mismatch, float32 sums\r\n", e.activation);
+                ret = 1;
+            }
+        }
+        FreeMatMulParam(&param_rvv[0]);
+        FreeMatMulParam(&param_ref);
+    }
+    onnx_tensor_free(output_rvv);
+    onnx_tensor_free(output_ref);
+    onnx_tensor_free(residual);
+    onnx_tensor_free(inputs[1]);
+    onnx_tensor_free(inputs[0]);
+    return ret;
+}
+
+// |y - ref| in float16 ulps of ref, sums that cancel below 1/16 take the ulp of 1/16
+static double matmul_error_ulp(float16_t y, double ref)
+{
+    int exp;
+    frexp(MAX(fabs(ref), 0.0625), &exp);
+    return fabs((double)y - ref) / ldexp(1.0, exp - 11);
+}
+
+// float16 sums against float32 sums of a long dot product, the rvv kernels against the scalar ones. The
+// products of two float16 are exact in float32, so both sum in the same order to the same bits.
+static int test_matmul_accumulate(int m, int k, int n)
+{
+    const enum matmul_accumulate_t modes[] = {MATMUL_ACCUMULATE_NATIVE, MATMUL_ACCUMULATE_FLOAT32};
+    struct onnx_tensor_t *inputs[2], *outputs[1];
+    struct onnx_tensor_t *output_ref, *output_rvv;
+    struct onnx_node_t node;
+    double max_error[2] = {0.0, 0.0};
+    int ret = 0;
+
+    inputs[0] = matmul_tensor(ONNX_TENSOR_TYPE_FLOAT16, k, m);
+    inputs[1] = matmul_tensor(ONNX_TENSOR_TYPE_FLOAT16, n, k);
+    output_ref = matmul_tensor(ONNX_TENSOR_TYPE_FLOAT16, n, m);
+    output_rvv = matmul_tensor(ONNX_TENSOR_TYPE_FLOAT16, n, m);
+    node.inputs = inputs;
+    node.ninput = 2;
+    node.outputs = outputs;
+    node.noutput = 1;
+
+    for (int i = 0; i < 2; i++) {
+        node.priv = GenerateMatMulParamAccumulate(inputs[1], 0, modes[i]);
+        node.outputs[0] = output_ref;
+        MatMul_float16(&node);
+        FreeMatMulParam(&node.priv);
+
+        node.priv = GenerateMatMulParamAccumulate(inputs[1], 1, modes[i]);
+        node.outputs[0] = output_rvv;
+        BENCH_START(MatMul_float16_accumulate);
+        MatMul_float16_rvv(&node);
+        BENCH_SAMPLE(MatMul_float16_accumulate);
+        printf("CSV, MatMul_float16_rvv_%s_%dx%dx%d, %lu\r\n", i ? "acc32" : "acc16", m, k, n, (unsigned long)BENCH_GET_USECYC());
+        FreeMatMulParam(&node.priv);
+
+        if (modes[i] == MATMUL_ACCUMULATE_FLOAT32 ? memcmp(output_ref->datas, output_rvv->datas, output_rvv->ndata * sizeof(float16_t)) != 0
+                                                  : verify_results_f16(output_ref->datas, output_rvv->datas, output_rvv->ndata)) {
+            printf("MatMul float16 %s sums mismatch\r\n", i ? "float32" : "float16");
+            ret = 1;
+        }
+        for (int r = 0; r < m; r++) {
+            for (int c = 0; c < n; c++) {
+                double ref = 0.0;
+                for (int kk = 0; kk < k; kk++) {
+                    ref += (double)((float16_t *)inputs[0]->datas)[r * k + kk] * (double)((float16_t *)inputs[1]->datas)[kk * n + c];
+                }
+                max_error[i] = MAX(max_error[i], matmul_error_ulp(((float16_t *)output_rvv->datas)[r * n + c], ref));
+            }
+        }
+    }
+    printf("MatMul float16 %dx%dx%d max error %.2f ulp with float16 sums, %.2f ulp with float32 sums\r\n", m, k, n, max_error[0], max_error[1]);
+    // rounded once to float16 plus the float32 rounding of the sums
+    if (max_error[1] > 1.0 || max_error[1] > max_error[0]) {
+        printf("MatMul float16 with float32 sums is off by %.2f ulp\r\n", max_error[1]);
+        ret = 1;
+    }
+
+    onnx_tensor_free(output_rvv);
+    onnx_tensor_free(output_ref);
+    onnx_tensor_free(inputs[1]);
+    onnx_tensor_free(inputs[0]);
+    return ret;
+}
+
+// shapes in numpy order [batch..., rows, cols], a missing batch dim is 1
+struct matmul_batch_case_t {
+    const char *name;
+    int andim, bndim;
+    int a[4], b[4];
+    _Bool prepack;
+};
+
+// no broadcast, one b for all batches, broadcast on both sides, b shared by 2 batches and large enough for
+// the blocked GEMM, a b per batch packed on the thread of its batch, many small per-head products, the last
+// two with B prepacked per batch
+static const struct matmul_batch_case_t matmul_batch_cases[] = {
+    {"2x3", 4, 4, {2, 3, 5, 17}, {2, 3, 17, 9}, 0},
+    {"2x3_shared_b", 4, 2, {2, 3, 5, 17}, {17, 9}, 0},
+    {"broadcast", 3, 4, {3, 6, 20}, {2, 1, 20, 11}, 0},
+    {"gemm_shared_b", 4, 3, {2, 3, 9, 96}, {3, 96, 100}, 0},
+    {"gemm_per_batch", 3, 3, {4, 9, 300}, {4, 300, 72}, 0},
+    {"heads", 3, 3, {16, 7, 8}, {16, 8, 7}, 1},
+    {"gemm_prepacked", 2, 3, {9, 96}, {2, 96, 100}, 1},
+};
+
+static struct onnx_tensor_t *matmul_batch_tensor(enum onnx_tensor_type_t type, const int *shape, int ndim)
+{
+    int dims[4];
+    for (int d = 0; d < ndim; d++) {
+        dims[d] = shape[ndim - 1 - d];
+    }
+    struct onnx_tensor_t *t = onnx_tensor_alloc(type, dims, ndim);
+    for (int i = 0; i < t->ndata; i++) {
+        const float32_t v = 2.0f * rand() / RAND_MAX - 1.0f;
+        if (type == ONNX_TENSOR_TYPE_INT8) {
+            ((int8_t *)t->datas)[i] = rand() % 7 - 3;
+        } else if (type == ONNX_TENSOR_TYPE_FLOAT16) {
+            ((float16_t *)t->datas)[i] = (float16_t)v;
+        } else {
+            ((float32_t *)t->datas)[i] = v;
+        }
+    }
+    return t;
+}
+
+static const char *matmul_type_name(enum onnx_tensor_type_t type)
+{
+    return type == ONNX_TENSOR_TYPE_INT8 ? "int8" : type == ONNX_TENSOR_TYPE_FLOAT16 ? "float16" : "float32";
+}
+
+static void matmul_run(enum onnx_tensor_type_t type, struct onnx_node_t *node, int rvv)
+{
+    if (type == ONNX_TENSOR_TYPE_INT8) {
+        rvv ? MatMul_int8_rvv(node) : MatMul_int8(node);
+    } else if (type == ONNX_TENSOR_TYPE_FLOAT16) {
+        rvv ? MatMul_float16_rvv(node) : MatMul_float16(node);
+    } else {
+        rvv ? MatMul_float32_rvv(node) : MatMul_float32(node);
+    }
+}
+
+// the 2-D MatMul on the matrices of every batch, scalar and rvv N-D MatMul against it
+static int test_matmul_batch(enum onnx_tensor_type_t type, const struct matmul_batch_case_t *c)
+{
+    const size_t esize = onnx_tensor_type_sizeof(type);
+    int a[4] = {1, 1, 0, 0}, b[4] = {1, 1, 0, 0}, y[4];
+    struct onnx_tensor_t *inputs[2], *outputs[1];
+    struct onnx_tensor_t *output_ref, *output, *output_rvv;
+    struct onnx_node_t node;
+    int ret = 0;
+
+    // the shapes padded to 4 dims
+    memcpy(a + 4 - c->andim, c->a, c->andim * sizeof(int));
+    memcpy(b + 4 - c->bndim, c->b, c->bndim * sizeof(int));
+    y[0] = MAX(a[0], b[0]);
+    y[1] = MAX(a[1], b[1]);
+    y[2] = a[2];
+    y[3] = b[3];
+    inputs[0] = matmul_batch_tensor(type, c->a, c->andim);
+    inputs[1] = matmul_batch_tensor(type, c->b, c->bndim);
+    output_ref = matmul_batch_tensor(type, y + 4 - MAX(c->andim, c->bndim), MAX(c->andim, c->bndim));
+    output = matmul_batch_tensor(type, y + 4 - MAX(c->andim, c->bndim), MAX(c->andim, c->bndim));
+    output_rvv = matmul_batch_tensor(type, y + 4 - MAX(c->andim, c->bndim), MAX(c->andim, c->bndim));
+    node.inputs = inputs;
+    node.ninput = 2;
+    node.outputs = outputs;
+    node.noutput = 1;
+    node.priv = NULL;
+
+    for (int i = 0; i < y[0]; i++) {
+        for (int j = 0; j < y[1]; j++) {
+            struct onnx_tensor_t a2 = *inputs[0], b2 = *inputs[1], y2 = *output_ref;
+            struct onnx_tensor_t *inputs2[2] = {&a2, &b2}, *outputs2[1] = {&y2};
+            // a dim of 1 is broadcast, i % 1 == 0
+            a2.datas = (char *)a2.datas + ((i % a[0]) * a[1] + j % a[1]) * a[2] * a[3] * esize;
+            b2.datas = (char *)b2.datas + ((i % b[0]) * b[1] + j % b[1]) * b[2] * b[3] * esize;
+            y2.datas = (char *)y2.datas + (i * y[1] + j) * y[2] * y[3] * esize;
+            a2.ndim = b2.ndim = y2.ndim = 2;
+            node.inputs = inputs2;
+            node.outputs = outputs2;
+            matmul_run(type, &node, 0);
+        }
+    }
+    node.inputs = inputs;
+    node.outputs = outputs;
+
+    node.outputs[0] = output;
+    matmul_run(type, &node, 0);
+    if (memcmp(output_ref->datas, output->datas, output->ndata * esize) != 0) {
+        printf("MatMul %s batch %s mismatch\r\n", matmul_type_name(type), c->name);
+        ret = 1;
+    }
+
+    node.priv = c->prepack && type != ONNX_TENSOR_TYPE_INT8 ? GenerateMatMulParam(inputs[1], 1) : NULL;
+    node.outputs[0] = output_rvv;
+    BENCH_START(MatMul_batch);
+    matmul_run(type, &node, 1);
+    BENCH_SAMPLE(MatMul_batch);
+    printf("CSV, MatMul_%s_rvv_batch_%s, %lu\r\n", matmul_type_name(type), c->name, (unsigned long)BENCH_GET_USECYC());
+    if (node.priv != NULL) {
+        FreeMatMulParam(&node.priv);
+    }
+    if (type == ONNX_TENSOR_TYPE_INT8 ? verify_results_int8(output_ref->datas, output_rvv->datas, output_rvv->ndata)
+        : type == ONNX_TENSOR_TYPE_FLOAT16 ? verify_results_f16(output_ref->datas, output_rvv->datas, output_rvv->ndata)
+                                           : verify_results_f32(output_ref->datas, output_rvv->datas, output_rvv->ndata)) {
+        printf("MatMul %s batch %s rvv mismatch\r\n", matmul_type_name(type), c->name);
+        ret = 1;
+    }
+
+    onnx_tensor_free(output_rvv);
+    onnx_tensor_free(output);
+    onnx_tensor_free(output_ref);
+    onnx_tensor_free(inputs[1]);
+    onnx_tensor_free(inputs[0]);
+    return ret;
+}
+
 int test_matmul(void)
 {
     int ret = 0;
     ret |= test_matmul_int8();
     ret |= test_matmul_f16();
     ret |= test_matmul_f32();
+    ret |= test_matmul_epilogue(ONNX_TENSOR_TYPE_FLOAT32, 15, 40, 37);
+    ret |= test_matmul_epilogue(ONNX_TENSOR_TYPE_FLOAT16, 15, 40, 37);
+    ret |= test_matmul_epilogue(ONNX_TENSOR_TYPE_FLOAT32, 75, 300, 300);
+    ret |= test_matmul_epilogue(ONNX_TENSOR_TYPE_FLOAT16, 75, 300, 300);
+    ret |= test_matmul_epilogue(ONNX_TENSOR_TYPE_FLOAT32, 3, 300, 40);
+    ret |= test_matmul_accumulate(30, 512, 130);
+    for (int i = 0; i < sizeof(matmul_batch_cases) / sizeof(matmul_batch_cases[0]); i++) {
+        ret |= test_matmul_batch(ONNX_TENSOR_TYPE_INT8, &matmul_batch_cases[i]);
+        ret |= test_matmul_batch(ONNX_TENSOR_TYPE_FLOAT16, &matmul_batch_cases[i]);
+        ret |= test_matmul_batch(ONNX_TENSOR_TYPE_FLOAT32, &matmul_batch_cases[i]);
+    }
     return ret;
 }
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "utils.h"
+
+#define NUM_THREADS 4
+#define LOOP_LEN 1003
+#define LOOP_GRAIN 3
+#define M 128
+#define N 128
+#define K 128
+
+BENCH_DECLARE_VAR()
+
+static void parallel_count(void *arg, int start, int end)
+{
+    int *count = (int *)arg;
+    if (start % LOOP_GRAIN != 0) {
+        count[start] = -LOOP_LEN;
+    }
+    for (int i = start; i < end; i++) {
+        count[i]++;
+    }
+}
+
+static void parallel_nested(void *arg, int start, int end)
+{
+    int *count = (int *)arg;
+    for (int i = start; i < end; i++) {
+        onnx_parallel_for(LOOP_GRAIN, 1, parallel_count, count + i * LOOP_GRAIN);
+    }
+}
+
+static int check_count(int *count, int length)
+{
+    for (int i = 0; i < length; i++) {
+        if (count[i] != 1) {
+            printf("Parallel loop index %d counted %d times\r\n", i, count[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int test_parallel_for(void)
+{
+    int *count = (int *)MALLOC_ASSERT(sizeof(int) * LOOP_LEN);
+    int ret = 0;
+
+    memset(count, 0, sizeof(int) * LOOP_LEN);
+    onnx_parallel_for(LOOP_LEN, LOOP_GRAIN, parallel_count, count);
+    ret |= check_count(count, LOOP_LEN);
+
+    memset(count, 0, sizeof(int) * LOOP_LEN);
+    onnx_parallel_for(LOOP_LEN / LOOP_GRAIN, 1, parallel_nested, count);
+    ret |= check_count(count, LOOP_LEN / LOOP_GRAIN * LOOP_GRAIN);
+
+    free(count);
+    return ret;
+}
+
+static struct onnx_tensor_t *parallel_tensor_f32(int rows, int cols)
+{
+    struct onnx_tensor_t *t = (struct onnx_tensor_t *)MALLOC_ASSERT(sizeof(struct onnx_tensor_t));
+    t->type = ONNX_TENSOR_TYPE_FLOAT32;
+    t->ndim = 2;
+    t->dims = (int *)MALLOC_ASSERT(sizeof(int) * t->ndim);
+    t->dims[0] = cols;
+    t->dims[1] = rows;
+    t->ndata = rows * cols;
+    t->datas = MALLOC_ASSERT(sizeof(float32_t) * t->ndata);
+    float32_t *p = (float32_t *)t->datas;
+    for (int i = 0; i < t->ndata; i++) {
+        p[i] = rand() * 1.0 / RAND_MAX;
+    }
+    return t;
+}
+
+static void parallel_tensor_free(struct onnx_tensor_t *t)
+{
+    free(t->datas);
+    free(t->dims);
+    free(t);
+}
+
+int test_parallel_matmul(void)
+{
+    struct onnx_node_t *node;
+    float32_t golden[M * N];
+    float32_t opt[M * N];
+    int ret = 0;
+
+    node = (struct onnx_node_t *)MALLOC_ASSERT(sizeof(struct onnx_node_t));
+    node->priv = NULL;
+    node->ninput = 2;
+    node->inputs = (struct onnx_tensor_t **)MALLOC_ASSERT(sizeof(struct onnx_tensor_t *) * node->ninput);
+    node->inputs[0] = parallel_tensor_f32(M, K);
+    node->inputs[1] = parallel_tensor_f32(K, N);
+    node->noutput = 1;
+    node->outputs = (struct onnx_tensor_t **)MALLOC_ASSERT(sizeof(struct onnx_tensor_t *) * node->noutput);
+    node->outputs[0] = parallel_tensor_f32(M, N);
+
+    onnx_parallel_init(1);
+    BENCH_START(MatMul_float32_rvv_1thread);
+    MatMul_float32_rvv(node);
+    BENCH_END(MatMul_float32_rvv_1thread);
+    memcpy(golden, node->outputs[0]->datas, node->outputs[0]->ndata * sizeof(float32_t));
+
+    int nthreads = onnx_parallel_init(NUM_THREADS);
+    printf("parallel threads = %d\r\n", nthreads);
+    memset(node->outputs[0]->datas, 0, node->outputs[0]->ndata * sizeof(float32_t));
+    BENCH_START(MatMul_float32_rvv_parallel);
+    MatMul_float32_rvv(node);
+    BENCH_END(MatMul_float32_rvv_parallel);
+    memcpy(opt, node->outputs[0]->datas, node->outputs[0]->ndata * sizeof(float32_t));
+
+    ret |= verify_results_f32(golden, opt, node->outputs[0]->ndata);
+
+    parallel_tensor_free(node->inputs[0]);
+    parallel_tensor_free(node->inputs[1]);
+    parallel_tensor_free(node->outputs[0]);
+    free(node->inputs);
+    free(node->outputs);
+    free(node);
+
+    return ret;
+}
+
+int test_parallel(void)
+{
+    int ret = 0;
+
+    onnx_parallel_init(NUM_THREADS);
+    ret |= test_parallel_for();
+    ret |= test_parallel_matmul();
+    onnx_parallel_deinit();
+
+    return ret;
+}
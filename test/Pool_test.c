@@ -0,0 +1,170 @@
+#include "utils.h"
+
+BENCH_DECLARE_VAR()
+
+// square windows with and without padding, channel counts that leave a vector tail, windows entirely in the padding
+struct pool_case_t {
+    const char *name;
+    int ch, in_w, in_h;
+    int kernel, stride, pad;
+    int count_include_pad;
+};
+
+static const struct pool_case_t pool_cases[] = {
+    {"2x2_stride2", 37, 8, 8, 2, 2, 0, 0},
+    {"3x3_stride2_pad1", 24, 9, 7, 3, 2, 1, 0},
+    {"3x3_pad1_include_pad", 70, 6, 6, 3, 1, 1, 1},
+    {"5x5_pad2", 16, 7, 9, 5, 1, 2, 0},
+    {"7x7", 130, 7, 7, 7, 1, 0, 0},
+    {"1x1_pad1", 19, 5, 4, 1, 1, 1, 0},
+    {"1x1_pad1_include_pad", 19, 5, 4, 1, 1, 1, 1},
+};
+
+enum pool_op_t {
+    POOL_MAX = 0,
+    POOL_AVERAGE,
+    POOL_GLOBAL_AVERAGE,
+};
+
+static const char *pool_names[3] = {"MaxPool", "AveragePool", "GlobalAveragePool"};
+
+// [op][int8, float16, float32][scalar, rvv]
+static const onnx_operator_t pool_kernels[3][3][2] = {
+    {{MaxPool_int8, MaxPool_int8_rvv}, {MaxPool_float16, MaxPool_float16_rvv}, {MaxPool_float32, MaxPool_float32_rvv}},
+    {{AveragePool_int8, AveragePool_int8_rvv}, {AveragePool_float16, AveragePool_float16_rvv}, {AveragePool_float32, AveragePool_float32_rvv}},
+    {{GlobalAveragePool_int8, GlobalAveragePool_int8_rvv},
+     {GlobalAveragePool_float16, GlobalAveragePool_float16_rvv},
+     {GlobalAveragePool_float32, GlobalAveragePool_float32_rvv}},
+};
+
+static struct onnx_tensor_t *pool_tensor(enum onnx_tensor_type_t type, int d0, int d1, int d2)
+{
+    int dims[4] = {d0, d1, d2, 1};
+    struct onnx_tensor_t *t = onnx_tensor_alloc(type, dims, 4);
+    for (int i = 0; i < t->ndata; i++) {
+        if (type == ONNX_TENSOR_TYPE_INT8) {
+            ((int8_t *)t->datas)[i] = rand() % 256 - 128;
+        } else if (type == ONNX_TENSOR_TYPE_FLOAT16) {
+            ((float16_t *)t->datas)[i] = (float16_t)(4.0f * rand() / RAND_MAX - 2.0f);
+        } else {
+            ((float32_t *)t->datas)[i] = 4.0f * rand() / RAND_MAX - 2.0f;
+        }
+    }
+    return t;
+}
+
+// int8 averages against the sum divided in double precision and rounded half away from zero, the zero point
+// of a window entirely in the padding
+static int pool_check_average_s8(const struct pool_case_t *c, enum pool_op_t op, const struct onnx_tensor_t *x, const struct onnx_tensor_t *y,
+                                 int zero_point)
+{
+    const int8_t *px = (const int8_t *)x->datas;
+    const int8_t *py = (const int8_t *)y->datas;
+    for (int oy = 0; oy < y->dims[2]; oy++) {
+        for (int ox = 0; ox < y->dims[1]; ox++) {
+            for (int ch = 0; ch < c->ch; ch++) {
+                int sum = 0, valid = 0, count;
+                for (int ky = 0; ky < (op == POOL_GLOBAL_AVERAGE ? c->in_h : c->kernel); ky++) {
+                    for (int kx = 0; kx < (op == POOL_GLOBAL_AVERAGE ? c->in_w : c->kernel); kx++) {
+                        const int iy = op == POOL_GLOBAL_AVERAGE ? ky : oy * c->stride - c->pad + ky;
+                        const int ix = op == POOL_GLOBAL_AVERAGE ? kx : ox * c->stride - c->pad + kx;
+                        if (iy >= 0 && iy < c->in_h && ix >= 0 && ix < c->in_w) {
+                            sum += px[(iy * c->in_w + ix) * c->ch + ch];
+                            valid++;
+                        }
+                    }
+                }
+                count = op == POOL_AVERAGE && c->count_include_pad ? c->kernel * c->kernel : valid;
+                sum += (count - valid) * zero_point;
+                const int ref = count == 0 ? zero_point : (int)round((double)sum / count);
+                const int out = py[(oy * y->dims[1] + ox) * c->ch + ch];
+                if (out != ref) {
+                    printf("%s int8 %s rounds %d / %d to %d, expected %d\r\n", pool_names[op], c->name, sum, count, out, ref);
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// float outputs of finite inputs have no NaN, a window entirely in the padding averages to 0 instead of 0 / 0
+static int pool_check_nan(const struct onnx_tensor_t *y)
+{
+    for (int i = 0; i < y->ndata; i++) {
+        const float32_t v = y->type == ONNX_TENSOR_TYPE_FLOAT16 ? (float32_t)((float16_t *)y->datas)[i] : ((float32_t *)y->datas)[i];
+        if (isnan(v)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int test_pool_case(const struct pool_case_t *c, enum pool_op_t op, enum onnx_tensor_type_t type)
+{
+    const int global = op == POOL_GLOBAL_AVERAGE;
+    const int out_w = global ? 1 : (c->in_w + 2 * c->pad - c->kernel) / c->stride + 1;
+    const int out_h = global ? 1 : (c->in_h + 2 * c->pad - c->kernel) / c->stride + 1;
+    const int t = type == ONNX_TENSOR_TYPE_INT8 ? 0 : type == ONNX_TENSOR_TYPE_FLOAT16 ? 1 : 2;
+    const char *type_name = t == 0 ? "int8" : t == 1 ? "float16" : "float32";
+    const int zero_point = -3;
+    struct onnx_tensor_t *inputs[1], *outputs[1];
+    struct onnx_tensor_t *output_ref, *output_rvv;
+    struct onnx_node_t node;
+    int ret = 0;
+
+    inputs[0] = pool_tensor(type, c->ch, c->in_w, c->in_h);
+    output_ref = pool_tensor(type, c->ch, out_w, out_h);
+    output_rvv = pool_tensor(type, c->ch, out_w, out_h);
+    node.inputs = inputs;
+    node.ninput = 1;
+    node.outputs = outputs;
+    node.noutput = 1;
+
+    for (int rvv = 0; rvv < 2; rvv++) {
+        node.outputs[0] = rvv ? output_rvv : output_ref;
+        node.priv = global ? NULL : GeneratePoolParam(c->kernel, c->kernel, c->stride, c->stride, c->pad, c->pad, c->count_include_pad, zero_point);
+        BENCH_START(Pool_case);
+        pool_kernels[op][t][rvv](&node);
+        BENCH_SAMPLE(Pool_case);
+        printf("CSV, %s_%s%s_%s, %lu\r\n", pool_names[op], type_name, rvv ? "_rvv" : "", c->name, (unsigned long)BENCH_GET_USECYC());
+        if (!global) {
+            FreePoolParam(&node.priv);
+        }
+    }
+    if (t == 0 ? verify_results_int8(output_ref->datas, output_rvv->datas, output_rvv->ndata)
+        : t == 1 ? verify_results_f16(output_ref->datas, output_rvv->datas, output_rvv->ndata)
+                 : verify_results_f32(output_ref->datas, output_rvv->datas, output_rvv->ndata)) {
+        printf("%s %s %s mismatch\r\n", pool_names[op], type_name, c->name);
+        ret = 1;
+    }
+    if (t == 0 && op != POOL_MAX) {
+        // verify_results_int8 allows an off by one, the rounding is checked exactly
+        ret |= pool_check_average_s8(c, op, inputs[0], output_ref, zero_point);
+        ret |= pool_check_average_s8(c, op, inputs[0], output_rvv, zero_point);
+    }
+    if (t != 0 && (pool_check_nan(output_ref) || pool_check_nan(output_rvv))) {
+        printf("%s %s %s has NaN outputs\r\n", pool_names[op], type_name, c->name);
+        ret = 1;
+    }
+
+    onnx_tensor_free(output_rvv);
+    onnx_tensor_free(output_ref);
+    onnx_tensor_free(inputs[0]);
+    return ret;
+}
+
+int test_pool(void)
+{
+    static const enum onnx_tensor_type_t types[3] = {ONNX_TENSOR_TYPE_INT8, ONNX_TENSOR_TYPE_FLOAT16, ONNX_TENSOR_TYPE_FLOAT32};
+    int ret = 0;
+
+    for (int i = 0; i < sizeof(pool_cases) / sizeof(pool_cases[0]); i++) {
+        for (int op = POOL_MAX; op <= POOL_GLOBAL_AVERAGE; op++) {
+            for (int t = 0; t < 3; t++) {
+                ret |= test_pool_case(&pool_cases[i], (enum pool_op_t)op, types[t]);
+            }
+        }
+    }
+    return ret;
+}
@@ -0,0 +1,85 @@
+#include "requantize.h"
+
+/*
+ * requantize() against the same rounding in 64-bit arithmetic, and the rvv
+ * routines against requantize() bit for bit, on random values, rounding ties
+ * and the ends of the int32 range.
+ */
+
+#define REQUANTIZE_LEN (1024)
+
+// (val << shift) * mult / 2^31 rounded half up, then shifted right rounding half away from zero
+static int32_t requantize_ref(int32_t val, int32_t mult, int32_t shift)
+{
+    const int64_t p = (int64_t)val * ((int64_t)1 << (shift > 0 ? shift : 0)) * mult;
+    int64_t q = (p + ((int64_t)1 << 30)) >> 31;
+    if (shift < 0) {
+        const int64_t half = (int64_t)1 << (-shift - 1);
+        q = q >= 0 ? (q + half) >> -shift : -((-q + half) >> -shift);
+    }
+    return (int32_t)q;
+}
+
+static void requantize_cases(int32_t *val, int32_t *mult, int32_t *shift, int len)
+{
+    static const int32_t edges[] = {0, 1, -1, 2, -2, 3, -3, INT32_MAX, INT32_MIN, INT32_MAX - 1, INT32_MIN + 1};
+
+    for (int i = 0; i < len; i++) {
+        shift[i] = rand() % 39 - 30; // [-30, 8]
+        mult[i] = i % 4 == 0 ? 0x40000000 : (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+        if (mult[i] == INT32_MIN) {
+            mult[i] = INT32_MAX;
+        }
+        if (i % 8 == 1) {
+            val[i] = edges[rand() % (sizeof(edges) / sizeof(edges[0]))];
+        } else if (i % 4 == 0 && shift[i] < 0) {
+            // mult = 2^30 halves val, odd multiples of half of the right shift are ties
+            val[i] = ((rand() % 1001 - 500) * 2 + 1) * (1 << MIN(-shift[i], 20));
+        } else {
+            val[i] = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+        }
+        if (shift[i] > 0) {
+            // the left shift of requantize() must not overflow
+            val[i] >>= shift[i];
+        }
+    }
+}
+
+int test_requantize(void)
+{
+    int32_t val[REQUANTIZE_LEN], mult[REQUANTIZE_LEN], shift[REQUANTIZE_LEN], res[REQUANTIZE_LEN];
+    int ret = 0;
+
+    requantize_cases(val, mult, shift, REQUANTIZE_LEN);
+    for (int i = 0; i < REQUANTIZE_LEN; i++) {
+        res[i] = requantize(val[i], mult[i], shift[i]);
+        if (res[i] != requantize_ref(val[i], mult[i], shift[i])) {
+            printf("requantize(%d, %d, %d) = %d, expected %d\r\n", val[i], mult[i], shift[i], res[i], requantize_ref(val[i], mult[i], shift[i]));
+            ret = 1;
+            break;
+        }
+    }
+
+#if defined(__riscv_vector)
+    int8_t res8[REQUANTIZE_LEN];
+    int32_t vres[REQUANTIZE_LEN];
+    const int32_t out_offset = -7, act_min = -100, act_max = 120;
+    size_t avl = REQUANTIZE_LEN, vl;
+    for (int i = 0; (vl = __riscv_vsetvl_e32m4(avl)) > 0; avl -= vl, i += vl) {
+        vint32m4_t v = __riscv_vle32_v_i32m4(val + i, vl);
+        vint32m4_t m = __riscv_vle32_v_i32m4(mult + i, vl);
+        vint32m4_t s = __riscv_vle32_v_i32m4(shift + i, vl);
+        __riscv_vse32_v_i32m4(vres + i, requantize_vv_i32m4(v, m, s, vl), vl);
+        __riscv_vse8_v_i8m1(res8 + i, requantize_i32m4(v, m, s, out_offset, act_min, act_max, vl), vl);
+    }
+    for (int i = 0; i < REQUANTIZE_LEN; i++) {
+        const int32_t ref8 = MIN(MAX(res[i] + out_offset, act_min), act_max);
+        if (vres[i] != res[i] || res8[i] != ref8) {
+            printf("requantize_i32m4(%d, %d, %d) = %d / %d, expected %d / %d\r\n", val[i], mult[i], shift[i], vres[i], res8[i], res[i], ref8);
+            ret = 1;
+            break;
+        }
+    }
+#endif
+    return ret;
+}
@@ -0,0 +1,124 @@
+#include "utils.h"
+
+#define NUM_TENSORS 16
+#define POOL_SIZE (128 * 1024)
+
+BENCH_DECLARE_VAR()
+
+static int check_tensor(struct onnx_tensor_t *t, enum onnx_tensor_type_t type, int *dims, int ndim)
+{
+    size_t ndata = 1;
+    int stride = 1;
+
+    if (t == NULL || t->type != type || t->ndim != ndim || ((uintptr_t)t->datas % ONNX_TENSOR_ALIGN) != 0) {
+        printf("Tensor header mismatch\r\n");
+        return 1;
+    }
+    for (int i = 0; i < ndim; i++) {
+        if (t->dims[i] != dims[i] || t->strides[i] != stride) {
+            printf("Tensor dims/strides mismatch at %d, expected %d/%d, actual %d/%d\r\n", i, dims[i], stride, t->dims[i], t->strides[i]);
+            return 1;
+        }
+        stride *= dims[i];
+        ndata *= dims[i];
+    }
+    if (t->ndata != ndata) {
+        printf("Tensor ndata mismatch, expected %d, actual %d\r\n", (int)ndata, (int)t->ndata);
+        return 1;
+    }
+    return 0;
+}
+
+int test_tensor_heap(void)
+{
+    int dims[4] = {96, 8, 8, 1};
+    struct onnx_tensor_t *t[NUM_TENSORS];
+    int ret = 0;
+
+    onnx_tensor_pool_init(NULL, 0);
+
+    BENCH_START(Tensor_alloc_heap);
+    for (int i = 0; i < NUM_TENSORS; i++) {
+        t[i] = onnx_tensor_alloc(ONNX_TENSOR_TYPE_INT8, dims, 4);
+    }
+    BENCH_END(Tensor_alloc_heap);
+
+    for (int i = 0; i < NUM_TENSORS; i++) {
+        ret |= check_tensor(t[i], ONNX_TENSOR_TYPE_INT8, dims, 4);
+        memset(t[i]->datas, i, t[i]->ndata);
+    }
+
+    int new_dims[2] = {48, 16};
+    ret |= onnx_tensor_reinit(t[0], ONNX_TENSOR_TYPE_FLOAT16, new_dims, 2);
+    ret |= check_tensor(t[0], ONNX_TENSOR_TYPE_FLOAT16, new_dims, 2);
+    if (onnx_tensor_reinit(t[0], ONNX_TENSOR_TYPE_FLOAT32, dims, 4) == 0) {
+        printf("Tensor reinit should fail when the block is too small\r\n");
+        ret = 1;
+    }
+
+    for (int i = 0; i < NUM_TENSORS; i++) {
+        onnx_tensor_free(t[i]);
+    }
+
+    return ret;
+}
+
+int test_tensor_pool(void)
+{
+    int dims[4] = {96, 8, 8, 1};
+    struct onnx_tensor_t *t[NUM_TENSORS];
+    void *pool = MALLOC_ASSERT(POOL_SIZE);
+    int ret = 0;
+
+    onnx_tensor_pool_init(pool, POOL_SIZE);
+
+    BENCH_START(Tensor_alloc_pool);
+    for (int i = 0; i < NUM_TENSORS; i++) {
+        t[i] = onnx_tensor_alloc(ONNX_TENSOR_TYPE_INT8, dims, 4);
+    }
+    BENCH_END(Tensor_alloc_pool);
+
+    for (int i = 0; i < NUM_TENSORS; i++) {
+        ret |= check_tensor(t[i], ONNX_TENSOR_TYPE_INT8, dims, 4);
+        memset(t[i]->datas, i, t[i]->ndata);
+    }
+
+    // only the last tensor gives its memory back
+    size_t used = onnx_tensor_pool_used();
+    onnx_tensor_free(t[0]);
+    if (onnx_tensor_pool_used() != used) {
+        printf("Tensor pool should not shrink when freeing a middle tensor\r\n");
+        ret = 1;
+    }
+    onnx_tensor_free(t[NUM_TENSORS - 1]);
+    if (onnx_tensor_pool_used() >= used) {
+        printf("Tensor pool should shrink when freeing the last tensor\r\n");
+        ret = 1;
+    }
+
+    onnx_tensor_pool_reset();
+    if (onnx_tensor_pool_used() != 0) {
+        printf("Tensor pool reset failed\r\n");
+        ret = 1;
+    }
+
+    // too large for the pool
+    int big_dims[2] = {POOL_SIZE, 2};
+    if (onnx_tensor_alloc(ONNX_TENSOR_TYPE_INT8, big_dims, 2) != NULL) {
+        printf("Tensor pool should be exhausted\r\n");
+        ret = 1;
+    }
+
+    onnx_tensor_pool_init(NULL, 0);
+    free(pool);
+
+    return ret;
+}
+
+int test_tensor(void)
+{
+    int ret = 0;
+    ret |= test_tensor_heap();
+    ret |= test_tensor_pool();
+    return ret;
+}
@@ -6,27 +6,38 @@ typedef struct {
 } TestFunc;
 
 extern int test_abs(void);
+extern int test_accuracy(void);
 extern int test_add(void);
 extern int test_batchnormalization(void);
+extern int test_bench(void);
 extern int test_clamp(void);
 extern int test_concat(void);
+extern int test_conv(void);
 extern int test_convinteger(void);
+extern int test_convtranspose(void);
 extern int test_cos(void);
+extern int test_dispatch(void);
 extern int test_div(void);
 extern int test_elu(void);
 extern int test_exp(void);
 extern int test_flip(void);
+extern int test_fuzz(void);
 extern int test_gatherelements(void);
+extern int test_graph(void);
 extern int test_layernormalization(void);
 extern int test_log(void);
 extern int test_matmul(void);
+extern int test_matmulinteger(void);
 extern int test_mul(void);
 extern int test_negate(void);
 extern int test_pad(void);
+extern int test_parallel(void);
+extern int test_pool(void);
 extern int test_pow(void);
 extern int test_reciprocal(void);
 extern int test_reduce(void);
 extern int test_Relu(void);
+extern int test_requantize(void);
 extern int test_rmsnormalization(void);
 extern int test_rsqrt(void);
 extern int test_scatterelements(void);
@@ -36,32 +47,43 @@ extern int test_slice(void);
 extern int test_softmax(void);
 extern int test_sqrt(void);
 extern int test_sub(void);
+extern int test_tensor(void);
 extern int test_tile(void);
 extern int test_topk(void);
 
 TestFunc tests[] = {
     {test_abs, "test_abs"},
+    {test_accuracy, "test_accuracy"},
     {test_add, "test_add"},
     {test_batchnormalization, "test_batchnormalization"},
     {test_clamp, "test_clamp"},
     {test_concat, "test_concat"},
+    {test_conv, "test_conv"},
     {test_convinteger, "test_convinteger"},
+    {test_convtranspose, "test_convtranspose"},
     {test_cos, "test_cos"},
+    {test_dispatch, "test_dispatch"},
     {test_div, "test_div"},
     {test_elu, "test_elu"},
     {test_exp, "test_exp"},
     {test_flip, "test_flip"},
+    {test_fuzz, "test_fuzz"},
     {test_gatherelements, "test_gatherelements"},
+    {test_graph, "test_graph"},
     {test_layernormalization, "test_layernormalization"},
     {test_log, "test_log"},
     {test_matmul, "test_matmul"},
+    {test_matmulinteger, "test_matmulinteger"},
     {test_mul, "test_mul"},
     {test_negate, "test_negate"},
     {test_pad, "test_pad"},
+    {test_parallel, "test_parallel"},
+    {test_pool, "test_pool"},
     {test_pow, "test_pow"},
     {test_reciprocal, "test_reciprocal"},
     {test_reduce, "test_reduce"},
     {test_Relu, "test_Relu"},
+    {test_requantize, "test_requantize"},
     {test_rmsnormalization, "test_rmsnormalization"},
     {test_rsqrt, "test_rsqrt"},
     {test_scatterelements, "test_scatterelements"},
@@ -71,18 +93,26 @@ TestFunc tests[] = {
     {test_softmax, "test_softmax"},
     {test_sqrt, "test_sqrt"},
     {test_sub, "test_sub"},
+    {test_tensor, "test_tensor"},
     {test_tile, "test_tile"},
     {test_topk, "test_topk"},
+#if defined(ONNX_BENCH_SWEEP)
+    {test_bench, "test_bench"},
+#endif
 };
 
 int main(void)
 {
     int has_failed = 0;
     int results[sizeof(tests) / sizeof(tests[0])];
-#ifndef __riscv_vector
+#if !defined(__riscv_vector) && !defined(ONNX_HOST_BUILD)
 #error "Not support this cpu arch, need v ext!!"
 #endif
+#if defined(__riscv_vector)
     printf("\r\nvlen = %d bits\r\n\r\n", csrr_vlenb() * 8); // vlen = vlenb * 8
+#else
+    printf("\r\nno vector extension, _rvv kernels fall back to scalar\r\n\r\n");
+#endif
 
 #ifdef CSR_BF16
     __RV_CSR_SET(CSR_MFP16MODE, 0x1);